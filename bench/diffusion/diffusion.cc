@@ -0,0 +1,120 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <CLI/CLI.hpp>
+
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/spdlog.h>
+
+#include <kami/executor.h>
+#include <kami/kami.h>
+#include <kami/propertylayer2d.h>
+#include <kami/stencilengine2d.h>
+
+/**
+ * Time a number of passes over a layer, in nanoseconds per pass
+ */
+double time_passes(
+        unsigned int passes,
+        const std::function<void()>& pass
+) {
+    pass();
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < passes; i++)
+        pass();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / passes;
+}
+
+int main(
+        int argc,
+        char** argv
+) {
+    std::string ident = "diffusion";
+    CLI::App app{ident};
+    unsigned int maximum_x = 8192, maximum_y = 8192, max_steps = 10, kernel_width = 3,
+            thread_count = kami::Executor::default_thread_count(), tile_x = 512, tile_y = 32,
+            initial_seed = kami::Constants::ADAMS_CONSTANT;
+
+    app.add_option("-x", maximum_x, "Set the width of the field")->check(CLI::PositiveNumber);
+    app.add_option("-y", maximum_y, "Set the height of the field")->check(CLI::PositiveNumber);
+    app.add_option("-n", max_steps, "Set the number of steps to time")->check(CLI::PositiveNumber);
+    app.add_option("-k", kernel_width, "Set the kernel width")->check(CLI::IsMember(std::vector<unsigned int>{3, 5}));
+    app.add_option("-t", thread_count, "Set the number of worker threads")->check(CLI::NonNegativeNumber);
+    app.add_option("--tile-x", tile_x, "Set the tile width")->check(CLI::PositiveNumber);
+    app.add_option("--tile-y", tile_y, "Set the tile height")->check(CLI::PositiveNumber);
+    app.add_option("-s", initial_seed, "Set the initial seed")->check(CLI::Number);
+    CLI11_PARSE(app, argc, argv);
+
+    auto console = spdlog::stdout_color_st(ident);
+    console->info("Compiled with Kami/{}", kami::version.to_string());
+    console->info("Diffusing a {} by {} field with a {} by {} kernel, {} worker threads", maximum_x, maximum_y,
+                  kernel_width, kernel_width, thread_count);
+
+    kami::PropertyLayer2D<double> layer(maximum_x, maximum_y, true, true);
+    kami::PropertyLayer2D<double> copy(maximum_x, maximum_y, true, true);
+    std::mt19937 rng(initial_seed);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    for (auto& value : layer.get_values())
+        value = dist(rng);
+
+    auto kernel = kami::StencilKernel2D<double>::diffusion(0.5);
+    if (kernel_width == 5) {
+        std::vector<double> weights(25, 0.5 / 24.0);
+        weights[12] = 0.5;
+        kernel = kami::StencilKernel2D<double>(weights);
+    }
+
+    kami::Executor executor(thread_count);
+    kami::StencilEngine2D<double> engine(tile_x, tile_y);
+
+    // Each pass reads the field once and writes it once
+    auto bytes = 2.0 * static_cast<double>(layer.get_values().size_bytes());
+    auto report = [&](const char* label, double ns) {
+        console->info("{:>10}: {:.2f} ms per step, {:.2f} GB/s", label, ns / 1.0e6, bytes / ns);
+    };
+
+    report("copy", time_passes(max_steps, [&]() {
+        auto source = layer.get_values();
+        auto* target = copy.get_values().data();
+        executor.parallel_for(0, source.size(), 0, [&](std::size_t begin, std::size_t end) {
+            std::copy(source.begin() + begin, source.begin() + end, target + begin);
+        });
+    }));
+    report("serial", time_passes(max_steps, [&]() {
+        engine.step(layer, kernel);
+    }));
+    report("parallel", time_passes(max_steps, [&]() {
+        engine.step(layer, kernel, 1, &executor);
+    }));
+}
@@ -0,0 +1,276 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+#include <CLI/CLI.hpp>
+
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/spdlog.h>
+
+#ifdef __linux__
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#endif
+
+#include <kami/agent.h>
+#include <kami/kami.h>
+#include <kami/model.h>
+#include <kami/population.h>
+#include <kami/sequential.h>
+
+/**
+ * The hardware events counted
+ */
+enum class Event {
+    Instructions,
+    Cycles,
+    BranchMisses
+};
+
+/**
+ * A hardware event counter, where the platform allows one
+ */
+class EventCounter {
+public:
+    explicit EventCounter(Event event) {
+#ifdef __linux__
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        switch (event) {
+            case Event::Instructions:
+                attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+            case Event::Cycles:
+                attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+            case Event::BranchMisses:
+                attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+                break;
+        }
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        _fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+        static_cast<void>(event);
+#endif
+    }
+
+    ~EventCounter() {
+#ifdef __linux__
+        if (_fd >= 0)
+            close(_fd);
+#endif
+    }
+
+    void start() {
+#ifdef __linux__
+        if (_fd >= 0) {
+            ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    std::optional<std::uint64_t> stop() {
+#ifdef __linux__
+        std::uint64_t count;
+        if (_fd >= 0) {
+            ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(_fd, &count, sizeof(count)) == sizeof(count))
+                return count;
+        }
+#endif
+        return std::nullopt;
+    }
+
+private:
+    int _fd = -1;
+};
+
+/**
+ * Each kind of agent does a little different work, so each has its own
+ * `step()` implementation and its own branch history
+ */
+template<int Kind>
+class KindAgent
+        : public kami::Agent {
+public:
+    kami::AgentID step(std::shared_ptr<kami::Model>) override {
+        for (int i = 0; i <= Kind; i++) {
+            if ((static_cast<int>(_state * 16.0) + i) % (Kind + 2) == 0)
+                _state = std::fmod(_state * (1.5 + Kind) + 0.25, 1.0);
+            else
+                _state = std::fmod(_state + 0.125 / (Kind + 1), 1.0);
+        }
+        return get_agent_id();
+    }
+
+private:
+    double _state = 0.5;
+};
+
+class TypeGroupModel
+        : public kami::Model {
+public:
+    TypeGroupModel(
+            unsigned int agent_count,
+            unsigned int seed
+    ) {
+        auto scheduler = std::make_shared<kami::SequentialScheduler>();
+        auto population = std::make_shared<kami::Population>();
+        set_scheduler(scheduler);
+        set_population(population);
+
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> dist(0, 7);
+        for (unsigned int i = 0; i < agent_count; i++)
+            population->add_agent(make_agent(dist(rng)));
+    }
+
+    std::shared_ptr<kami::SequentialScheduler> get_sequential_scheduler() {
+        return std::static_pointer_cast<kami::SequentialScheduler>(_sched);
+    }
+
+    /**
+     * The agent list in the order the scheduler groups it, so that it can
+     * be stepped with per-agent lookups still in place
+     */
+    std::vector<kami::AgentID> get_grouped_agent_list() {
+        std::unordered_map<std::type_index, std::size_t> group_index;
+        std::vector<std::vector<kami::AgentID>> groups;
+        for (auto& agent_id : *_pop->get_agent_list()) {
+            auto agent = _pop->get_agent_by_id(agent_id);
+            auto [group, inserted] = group_index.try_emplace(std::type_index(typeid(*agent)), groups.size());
+            if (inserted)
+                groups.emplace_back();
+            groups[group->second].push_back(agent_id);
+        }
+
+        std::vector<kami::AgentID> agent_list;
+        for (auto& group : groups)
+            agent_list.insert(agent_list.end(), group.begin(), group.end());
+        return agent_list;
+    }
+
+private:
+    static std::shared_ptr<kami::Agent> make_agent(int kind) {
+        switch (kind) {
+            case 0:
+                return std::make_shared<KindAgent<0>>();
+            case 1:
+                return std::make_shared<KindAgent<1>>();
+            case 2:
+                return std::make_shared<KindAgent<2>>();
+            case 3:
+                return std::make_shared<KindAgent<3>>();
+            case 4:
+                return std::make_shared<KindAgent<4>>();
+            case 5:
+                return std::make_shared<KindAgent<5>>();
+            case 6:
+                return std::make_shared<KindAgent<6>>();
+            default:
+                return std::make_shared<KindAgent<7>>();
+        }
+    }
+};
+
+int main(
+        int argc,
+        char** argv
+) {
+    std::string ident = "typegroup";
+    CLI::App app{ident};
+    unsigned int agent_count = 100000, max_steps = 50, initial_seed = kami::Constants::ADAMS_CONSTANT;
+
+    app.add_option("-c", agent_count, "Set the number of agents")->check(CLI::PositiveNumber);
+    app.add_option("-n", max_steps, "Set the number of steps to run the model")->check(CLI::PositiveNumber);
+    app.add_option("-s", initial_seed, "Set the initial seed")->check(CLI::Number);
+    CLI11_PARSE(app, argc, argv);
+
+    auto console = spdlog::stdout_color_st(ident);
+    console->info("Compiled with Kami/{}", kami::version.to_string());
+    console->info("Stepping {} agents of 8 classes for {} steps", agent_count, max_steps);
+
+    auto model = std::make_shared<TypeGroupModel>(agent_count, initial_seed);
+    auto scheduler = model->get_sequential_scheduler();
+    auto grouped_agent_list = model->get_grouped_agent_list();
+    EventCounter instructions(Event::Instructions), cycles(Event::Cycles), branch_misses(Event::BranchMisses);
+
+    // Grouping changes two things: the order of dispatch, and, through
+    // the cached agents, the per-agent population lookup.  The middle
+    // run keeps the lookup with the grouped order, to separate the two.
+    auto run = [&](const char* label, auto&& step) {
+        step();
+
+        auto start = std::chrono::steady_clock::now();
+        instructions.start();
+        cycles.start();
+        branch_misses.start();
+        for (unsigned int i = 0; i < max_steps; i++)
+            step();
+        auto misses = branch_misses.stop();
+        auto cycle_count = cycles.stop();
+        auto instruction_count = instructions.stop();
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+        auto agent_steps = static_cast<double>(agent_count) * max_steps;
+        console->info("{:>15}: {:.1f} ns per agent step", label, elapsed.count() / agent_steps);
+        if (instruction_count && cycle_count && misses)
+            console->info(
+                    "{:>15}: {:.2f} IPC, {:.1f} instructions and {:.2f} branch misses per agent step", label,
+                    static_cast<double>(*instruction_count) / static_cast<double>(*cycle_count),
+                    static_cast<double>(*instruction_count) / agent_steps,
+                    static_cast<double>(*misses) / agent_steps);
+        else
+            console->info("{:>15}: hardware counters unavailable, try `perf stat` instead", label);
+    };
+
+    scheduler->set_group_by_type(false);
+    run("interleaved", [&model]() { model->step(); });
+    run("grouped", [&model, &scheduler, &grouped_agent_list]() {
+        scheduler->step(model, std::make_unique<std::vector<kami::AgentID>>(grouped_agent_list));
+    });
+    scheduler->set_group_by_type(true);
+    run("grouped, cached", [&model]() { model->step(); });
+}
@@ -54,9 +54,11 @@ std::optional<kami::GridCoord2D> PersonAgent::move_agent(std::shared_ptr<kami::R
     auto domain = model->get_domain();
     auto world = std::static_pointer_cast<kami::MultiGrid2D>(domain);
 
-    auto move_list = world->get_neighborhood(agent_id, false, kami::GridNeighborhoodType::Moore);
-    std::uniform_int_distribution<int> dist(0, (int) move_list->size() - 1);
-    auto new_location = *std::next(move_list->begin(), dist(*rng));
+    auto new_location_opt = world->random_neighbor_cell(world->get_location_by_agent(agent_id), false,
+                                                        kami::GridNeighborhoodType::Moore, *rng);
+    if (!new_location_opt)
+        return std::nullopt;
+    auto new_location = new_location_opt.value();
 
     console->trace("Moving Agent {} to location {}", agent_id, new_location);
     world->move_agent(agent_id, new_location);
@@ -75,23 +77,14 @@ std::optional<kami::AgentID> PersonAgent::do_business(std::shared_ptr<kami::Repo
     auto population = model->get_population();
 
     auto location = world->get_location_by_agent(agent_id);
-    auto cell_mates_opt = world->get_location_contents(location);
-
-    if (!cell_mates_opt)
-        return std::nullopt;
 
     // Note, here we reverse the logic from that used in the Mesa
     // implementation.  We prefer the guard clause to the nested
     // if statements.  See Fowler.
-    auto cell_mates = cell_mates_opt;
-    if (cell_mates->size() < 2)
+    auto customer_id_opt = world->random_other_agent_at(location, agent_id, *rng);
+    if (!customer_id_opt)
         return std::nullopt;
-
-    auto customer_id = agent_id;
-    std::uniform_int_distribution<int> dist(0, (int) cell_mates->size() - 1);
-    do {            // There aren't enough do loops, ya know?
-        customer_id = *std::next(cell_mates->begin(), dist(*rng));
-    } while (customer_id == agent_id);
+    auto customer_id = customer_id_opt.value();
 
     std::bernoulli_distribution coin_flip(0.5);
     if (coin_flip(*rng))
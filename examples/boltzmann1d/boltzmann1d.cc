@@ -92,12 +92,10 @@ std::optional<kami::GridCoord1D> MoneyAgent1D::move_agent(std::shared_ptr<kami::
         throw (std::domain_error("model is missing domain"));
     auto world = std::static_pointer_cast<kami::MultiGrid1D>(domain);
 
-    auto move_list_opt = world->get_neighborhood(agent_id, false);
-    if (!move_list_opt)
+    auto new_location_opt = world->random_neighbor_cell(world->get_location_by_agent(agent_id), false, *rng);
+    if (!new_location_opt)
         return std::nullopt;
-    auto move_list = move_list_opt;
-    std::uniform_int_distribution<int> dist(0, (int) move_list->size() - 1);
-    auto new_location = *std::next(move_list->begin(), dist(*rng));
+    auto new_location = new_location_opt.value();
 
     console->trace("Moving Agent {} to location {}", agent_id, new_location);
     world->move_agent(agent_id, new_location);
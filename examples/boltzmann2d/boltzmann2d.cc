@@ -92,12 +92,11 @@ std::optional<kami::GridCoord2D> MoneyAgent2D::move_agent(const std::shared_ptr<
         throw (std::domain_error("model is missing domain"));
     auto world = std::static_pointer_cast<kami::MultiGrid2D>(domain);
 
-    auto move_list_opt = world->get_neighborhood(agent_id, false, kami::GridNeighborhoodType::VonNeumann);
-    if (!move_list_opt)
+    auto new_location_opt = world->random_neighbor_cell(world->get_location_by_agent(agent_id), false,
+                                                        kami::GridNeighborhoodType::VonNeumann, *rng);
+    if (!new_location_opt)
         return std::nullopt;
-    auto move_list = move_list_opt;
-    std::uniform_int_distribution<int> dist(0, (int) move_list->size() - 1);
-    auto new_location = *std::next(move_list->begin(), dist(*rng));
+    auto new_location = new_location_opt.value();
 
     console->trace("Moving Agent {} to location {}", agent_id, new_location);
     world->move_agent(agent_id, new_location);
@@ -121,17 +120,10 @@ std::optional<kami::AgentID> MoneyAgent2D::give_money(const std::shared_ptr<kami
     auto population = std::static_pointer_cast<kami::Population>(agents);
 
     auto location = world->get_location_by_agent(agent_id);
-    auto cell_mates_opt = world->get_location_contents(location);
-
-    if (!cell_mates_opt)
-        return std::nullopt;
-
-    auto cell_mates = cell_mates_opt;
-    if (cell_mates->size() < 2)
+    if (world->get_location_view(location).size() < 2)
         return std::nullopt;
 
-    std::uniform_int_distribution<int> dist(0, (int) cell_mates->size() - 1);
-    auto other_agent_id = *std::next(cell_mates->begin(), dist(*rng));
+    auto other_agent_id = world->random_agent_at(location, *rng).value();
     auto other_agent = std::static_pointer_cast<MoneyAgent2D>(population->get_agent_by_id(other_agent_id));
 
     console->trace("Agent {} giving unit of wealth to agent {}", agent_id, other_agent_id);
@@ -29,6 +29,7 @@
 #define KAMI_AGENT_H
 //! @endcond
 
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -60,12 +61,28 @@ namespace kami {
          */
         long long _id;
 
+        /**
+         * @brief Constructs an identifier with the given value.
+         */
+        explicit AgentID(long long id);
+
     public:
         /**
          * @brief Constructs a new unique identifier.
          */
         AgentID();
 
+        /**
+         * @brief Get the null identifier.
+         *
+         * @details The null identifier is never assigned to an `Agent`,
+         * so it may be used as a sentinel, such as to mark an empty
+         * cell in dense storage.
+         *
+         * @return the null `AgentID`
+         */
+        [[nodiscard]] static AgentID null();
+
         /**
          * @brief Convert the identifier to a human-readable string.
          *
@@ -128,6 +145,8 @@ namespace kami {
                 std::ostream& lhs,
                 const AgentID& rhs
         );
+
+        friend struct std::hash<AgentID>;
     };
 
     /**
@@ -232,4 +251,15 @@ namespace kami {
 
 }  // namespace kami
 
+//! @cond SuppressHashMethod
+namespace std {
+    template<>
+    struct hash<kami::AgentID> {
+        size_t operator()(const kami::AgentID& key) const {
+            return hash<long long>()(key._id);
+        }
+    };
+}  // namespace std
+//! @endcond
+
 #endif  // KAMI_AGENT_H
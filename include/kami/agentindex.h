@@ -0,0 +1,237 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef KAMI_AGENTINDEX_H
+//! @cond SuppressGuard
+#define KAMI_AGENTINDEX_H
+//! @endcond
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <kami/agent.h>
+
+namespace kami {
+
+    /**
+     * @brief A flat map from `AgentID` to a small value
+     *
+     * @details The index is an open-addressing hash table with linear
+     * probing, holding its keys and values in two flat arrays.  Empty
+     * slots hold `AgentID::null()`.  Lookups touch one or two adjacent
+     * slots in the common case, and updating a value through `find()`
+     * happens in place.  The table grows to keep at most half of its slots
+     * full, and erasure shifts later entries back rather than leaving
+     * tombstones, so lookups do not degrade with churn.
+     *
+     * Pointers returned by `find()` remain valid until the next insertion
+     * or erasure.
+     *
+     * @tparam T the value type, which must be default-constructible
+     */
+    template<typename T>
+    class AgentIndex {
+        static_assert(std::is_default_constructible_v<T>, "AgentIndex values must be default-constructible");
+
+    public:
+        /**
+         * @brief Constructs an empty index
+         */
+        AgentIndex() = default;
+
+        /**
+         * @brief Find the value for an agent
+         *
+         * @param[in] agent_id the `AgentID` to look up
+         *
+         * @returns a pointer to the value, or `nullptr` if absent
+         */
+        [[nodiscard]] T* find(const AgentID agent_id) {
+            auto slot = find_slot(agent_id);
+            return slot == npos ? nullptr : &_values[slot];
+        }
+
+        /**
+         * @brief Find the value for an agent
+         *
+         * @param[in] agent_id the `AgentID` to look up
+         *
+         * @returns a pointer to the value, or `nullptr` if absent
+         */
+        [[nodiscard]] const T* find(const AgentID agent_id) const {
+            auto slot = find_slot(agent_id);
+            return slot == npos ? nullptr : &_values[slot];
+        }
+
+        /**
+         * @brief Inquire if an agent is in the index
+         */
+        [[nodiscard]] bool contains(const AgentID agent_id) const {
+            return find_slot(agent_id) != npos;
+        }
+
+        /**
+         * @brief Add an agent to the index
+         *
+         * @details As with `std::map::insert()`, an existing value is left
+         * unchanged.
+         *
+         * @param[in] agent_id the `AgentID` to add
+         * @param[in] value the value for the agent
+         *
+         * @returns true if the agent was added, false if already present
+         */
+        bool insert(
+                const AgentID agent_id,
+                const T& value
+        ) {
+            if (2 * (_size + 1) > _keys.size())
+                rehash(_keys.empty() ? 16 : 2 * _keys.size());
+
+            auto slot = home_slot(agent_id);
+            while (_keys[slot] != AgentID::null()) {
+                if (_keys[slot] == agent_id)
+                    return false;
+                slot = (slot + 1) & _mask;
+            }
+
+            _keys[slot] = agent_id;
+            _values[slot] = value;
+            _size++;
+            return true;
+        }
+
+        /**
+         * @brief Remove an agent from the index
+         *
+         * @param[in] agent_id the `AgentID` to remove
+         *
+         * @returns true if the agent was removed, false if absent
+         */
+        bool erase(const AgentID agent_id) {
+            auto slot = find_slot(agent_id);
+            if (slot == npos)
+                return false;
+
+            // Shift back any later entries that probed past this slot
+            auto next = (slot + 1) & _mask;
+            while (_keys[next] != AgentID::null()) {
+                auto home = home_slot(_keys[next]);
+                if (((next - home) & _mask) >= ((next - slot) & _mask)) {
+                    _keys[slot] = _keys[next];
+                    _values[slot] = std::move(_values[next]);
+                    slot = next;
+                }
+                next = (next + 1) & _mask;
+            }
+
+            _keys[slot] = AgentID::null();
+            _values[slot] = T();
+            _size--;
+            return true;
+        }
+
+        /**
+         * @brief Get the number of agents in the index
+         */
+        [[nodiscard]] std::size_t size() const {
+            return _size;
+        }
+
+        /**
+         * @brief Inquire if the index is empty
+         */
+        [[nodiscard]] bool empty() const {
+            return _size == 0;
+        }
+
+        /**
+         * @brief Ensure room for at least `count` agents without growing
+         */
+        void reserve(std::size_t count) {
+            std::size_t capacity = 16;
+            while (capacity < 2 * count)
+                capacity *= 2;
+            if (capacity > _keys.size())
+                rehash(capacity);
+        }
+
+    private:
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        std::vector<AgentID> _keys;
+        std::vector<T> _values;
+        std::size_t _size = 0;
+        std::size_t _mask = 0;
+        unsigned int _shift = 64;
+
+        [[nodiscard]] std::size_t home_slot(const AgentID agent_id) const {
+            // Fibonacci hashing spreads sequential identifiers evenly
+            auto hash = static_cast<std::uint64_t>(std::hash<AgentID>()(agent_id));
+            return static_cast<std::size_t>((hash * 0x9e3779b97f4a7c15ULL) >> _shift);
+        }
+
+        [[nodiscard]] std::size_t find_slot(const AgentID agent_id) const {
+            if (_size == 0)
+                return npos;
+
+            for (auto slot = home_slot(agent_id); _keys[slot] != AgentID::null(); slot = (slot + 1) & _mask)
+                if (_keys[slot] == agent_id)
+                    return slot;
+            return npos;
+        }
+
+        void rehash(std::size_t capacity) {
+            auto keys = std::move(_keys);
+            auto values = std::move(_values);
+
+            _keys.assign(capacity, AgentID::null());
+            _values.assign(capacity, T());
+            _mask = capacity - 1;
+            _shift = 64;
+            for (auto c = capacity; c > 1; c >>= 1)
+                _shift--;
+
+            for (std::size_t i = 0; i < keys.size(); i++) {
+                if (keys[i] == AgentID::null())
+                    continue;
+
+                auto slot = home_slot(keys[i]);
+                while (_keys[slot] != AgentID::null())
+                    slot = (slot + 1) & _mask;
+                _keys[slot] = keys[i];
+                _values[slot] = std::move(values[i]);
+            }
+        }
+    };
+
+}  // namespace kami
+
+#endif  // KAMI_AGENTINDEX_H
@@ -0,0 +1,253 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef KAMI_BUDGETED_H
+//! @cond SuppressGuard
+#define KAMI_BUDGETED_H
+//! @endcond
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <kami/agent.h>
+#include <kami/kami.h>
+#include <kami/model.h>
+#include <kami/scheduler.h>
+#include <kami/sequential.h>
+
+namespace kami {
+
+    /**
+     * @brief Will execute agent steps until a per-step time budget is spent.
+     *
+     * @details A budgeted scheduler is meant for interactive and soft
+     * real-time runs where each step of the model must complete in a
+     * bounded amount of time, regardless of the size of the `Population`.
+     * Each call to `step()` executes agents, one at a time, until the
+     * time budget is used up.  The agents not yet executed are carried
+     * over and executed first on the following call to `step()`.  Only
+     * once every carried-over agent has been executed is a new round of
+     * agents, drawn from the list provided, begun.  Every agent is
+     * therefore executed exactly once per round and no agent waits more
+     * than one round.  At least one agent is executed on each call, so
+     * the model always makes progress.
+     *
+     * Within a round, agents are executed in the order provided, which
+     * is round-robin order across the `Population`, or in descending
+     * order of a priority function, if one is given.
+     *
+     * Agents deleted from the `Population` while carried over are
+     * skipped.  Agents added to the `Population` join the next round.
+     */
+    class LIBKAMI_EXPORT BudgetedScheduler
+            : public SequentialScheduler {
+    public:
+        /**
+         * @brief A function returning the priority of an `Agent`
+         *
+         * @details Higher priority agents are executed first.
+         */
+        typedef std::function<double(const std::shared_ptr<Agent>&)> Priority;
+
+        /**
+         * @brief Constructor.
+         *
+         * @details Agents are executed in round-robin order.
+         *
+         * @param[in] budget the time budget available to each step
+         */
+        explicit BudgetedScheduler(std::chrono::nanoseconds budget);
+
+        /**
+         * @brief Constructor.
+         *
+         * @details Agents are executed in descending order of priority,
+         * with ties executed in the order provided.  The priority of each
+         * agent is taken once, at the start of each round.
+         *
+         * @param[in] budget the time budget available to each step
+         * @param[in] priority a function returning the priority of an agent
+         */
+        BudgetedScheduler(
+                std::chrono::nanoseconds budget,
+                Priority priority
+        );
+
+        /**
+         * @brief Execute a single time step.
+         *
+         * @details This method will execute the agents carried over
+         * from the previous step, or, if there are none, the agents in
+         * the `Population` associated with `model`, until the time budget
+         * is used up.  The agent list is only taken from the `Population`
+         * at the start of each round.
+         *
+         * @param model a reference copy of the model
+         *
+         * @returns returns vector of agents successfully stepped
+         */
+        std::unique_ptr<std::vector<AgentID>> step(std::shared_ptr<Model> model) override;
+
+        /**
+         * @brief Execute a single time step for a `ReporterModel`
+         *
+         * @details This method will execute the agents carried over
+         * from the previous step, or, if there are none, the agents in
+         * the `Population` associated with `model`, until the time budget
+         * is used up.  The agent list is only taken from the `Population`
+         * at the start of each round.
+         *
+         * @param model a reference copy of the `ReporterModel`
+         *
+         * @returns returns vector of agents successfully stepped
+         */
+        std::unique_ptr<std::vector<AgentID>> step(std::shared_ptr<ReporterModel> model) override;
+
+        /**
+         * @brief Execute a single time step.
+         *
+         * @details This method will execute the agents carried over
+         * from the previous step, or, if there are none, the agents
+         * provided, until the time budget is used up.
+         *
+         * @param model a reference copy of the model
+         * @param agent_list list of agents to execute in the next round
+         *
+         * @returns returns vector of agents successfully stepped
+         */
+        std::unique_ptr<std::vector<AgentID>>
+        step(
+                std::shared_ptr<Model> model,
+                std::unique_ptr<std::vector<AgentID>> agent_list
+        ) override;
+
+        /**
+         * @brief Execute a single time step for a `ReporterModel`
+         *
+         * @details This method will execute the agents carried over
+         * from the previous step, or, if there are none, the agents
+         * provided, until the time budget is used up.
+         *
+         * @param model a reference copy of the `ReporterModel`
+         * @param agent_list list of agents to execute in the next round
+         *
+         * @returns returns vector of agents successfully stepped
+         */
+        std::unique_ptr<std::vector<AgentID>>
+        step(
+                std::shared_ptr<ReporterModel> model,
+                std::unique_ptr<std::vector<AgentID>> agent_list
+        ) override;
+
+        /**
+         * @brief Set the time budget
+         *
+         * @param[in] budget the time budget available to each step
+         *
+         * @returns the time budget
+         */
+        std::chrono::nanoseconds set_budget(std::chrono::nanoseconds budget);
+
+        /**
+         * @brief Get the time budget
+         *
+         * @returns the time budget available to each step
+         */
+        [[nodiscard]] std::chrono::nanoseconds get_budget() const;
+
+        /**
+         * @brief Get the number of agents deferred by the last step
+         *
+         * @returns the number of agents carried over to the next step
+         */
+        [[nodiscard]] std::size_t get_deferred_count() const;
+
+        /**
+         * @brief Get the number of deferrals over all steps
+         *
+         * @details Each agent carried over by a step counts once for
+         * that step.
+         *
+         * @returns the total number of deferrals
+         */
+        [[nodiscard]] unsigned long long get_total_deferred() const;
+
+        /**
+         * @brief Get the longest wait of any agent executed so far
+         *
+         * @details The wait of an agent is the number of steps from the
+         * start of its round to the step it was executed in.  An agent
+         * executed in the same step its round began has waited zero steps.
+         *
+         * @returns the longest wait, in steps
+         */
+        [[nodiscard]] unsigned int get_max_wait() const;
+
+        /**
+         * @brief Get the average wait of all agents executed so far
+         *
+         * @returns the average wait, in steps
+         *
+         * @see `get_max_wait()`
+         */
+        [[nodiscard]] double get_mean_wait() const;
+
+        /**
+         * @brief Get the duration of the last step
+         *
+         * @details The duration may exceed the budget by the time needed
+         * to execute the last agent of the step.
+         *
+         * @returns the time used by the last step
+         */
+        [[nodiscard]] std::chrono::nanoseconds get_last_duration() const;
+
+    private:
+        std::chrono::nanoseconds _budget;
+        Priority _priority = nullptr;
+
+        std::deque<std::pair<AgentID, unsigned int>> _pending;
+
+        std::size_t _deferred_count = 0;
+        unsigned long long _total_deferred = 0;
+        unsigned long long _total_wait = 0;
+        unsigned long long _total_executed = 0;
+        unsigned int _max_wait = 0;
+        std::chrono::nanoseconds _last_duration{0};
+
+        void start_round(
+                const std::shared_ptr<Population>& population,
+                const std::vector<AgentID>& agent_list
+        );
+    };
+
+}  // namespace kami
+
+#endif  // KAMI_BUDGETED_H
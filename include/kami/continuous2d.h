@@ -0,0 +1,426 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef KAMI_CONTINUOUS2D_H
+//! @cond SuppressGuard
+#define KAMI_CONTINUOUS2D_H
+//! @endcond
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <kami/agent.h>
+#include <kami/agentindex.h>
+#include <kami/domain.h>
+#include <kami/executor.h>
+#include <kami/kami.h>
+#include <kami/stencil.h>
+
+namespace kami {
+
+    /**
+     * @brief Two-dimensional real-valued coordinates
+     */
+    class LIBKAMI_EXPORT ContinuousCoord2D
+            : public Coord {
+    public:
+        /**
+         * @brief Constructor for two-dimensional real-valued coordinates
+         */
+        ContinuousCoord2D(
+                double x_coord,
+                double y_coord
+        );
+
+        /**
+         * @brief Get the coordinate in the first dimension or `x`.
+         */
+        [[nodiscard]] double x() const;
+
+        /**
+         * @brief Get the coordinate in the second dimension or `y`.
+         */
+        [[nodiscard]] double y() const;
+
+        /**
+         * @brief Convert the coordinate to a human-readable string.
+         *
+         * @return a human-readable form of the `Coord` as `std::string`.
+         */
+        [[nodiscard]] std::string to_string() const override;
+
+        /**
+         * @brief Find the Euclidean distance between two points
+         *
+         * @details The coordinate is not aware of the space it is in, so
+         * the direct path is measured, without accounting for any
+         * wrapping.
+         *
+         * @see `ContinuousSpace2D::distance()`
+         *
+         * @param p the point to measure the distance to
+         *
+         * @returns the distance as a `double`
+         */
+        [[nodiscard]] double distance(const ContinuousCoord2D& p) const;
+
+        /**
+         * @brief Test if two coordinates are equal
+         */
+        friend bool operator==(
+                const ContinuousCoord2D&,
+                const ContinuousCoord2D&
+        );
+
+        /**
+         * @brief Test if two coordinates are not equal
+         */
+        friend bool operator!=(
+                const ContinuousCoord2D&,
+                const ContinuousCoord2D&
+        );
+
+        /**
+         * @brief Output a given coordinate to the specified stream
+         */
+        friend std::ostream& operator<<(
+                std::ostream&,
+                const ContinuousCoord2D&
+        );
+
+    private:
+        double _x_coord, _y_coord;
+    };
+
+    /**
+     * @brief A two-dimensional continuous space
+     *
+     * @details Agents have real-valued positions in `[0, width)` by
+     * `[0, height)`, and the space may wrap around in either dimension.
+     * Positions are held in flat arrays, and radius queries are answered
+     * from a uniform grid of bins laid over the space, so a query only
+     * examines the agents in the bins it overlaps.  With bins about as
+     * large as the typical query radius, a query takes time proportional
+     * to the number of agents found.
+     *
+     * The bins are not updated as agents move.  Instead, the index is
+     * rebuilt from scratch, by a counting sort of the agents by bin, the
+     * first time it is needed after any change.  The sort copies each
+     * agent's position alongside it, so a query reads the agents of a bin
+     * from consecutive memory.  Models that move every agent each step
+     * should call `rebuild_index()` with an `Executor` once the moves are
+     * done, which divides the sort among threads and makes the queries
+     * that follow safe to run concurrently.
+     */
+    class LIBKAMI_EXPORT ContinuousSpace2D
+            : public Domain {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * @details The space is divided into bins at least `bin_size` on
+         * a side.  Bins are stretched slightly if needed, so that a whole
+         * number of them spans each dimension.
+         *
+         * @param[in] width the length of the space in the first dimension
+         * @param[in] height the length of the space in the second dimension
+         * @param[in] bin_size the smallest length of the side of a bin
+         * @param[in] wrap_x should the space wrap around on itself in the
+         * first dimension
+         * @param[in] wrap_y should the space wrap around on itself in the
+         * second dimension
+         */
+        ContinuousSpace2D(
+                double width,
+                double height,
+                double bin_size,
+                bool wrap_x = false,
+                bool wrap_y = false
+        );
+
+        /**
+         * @brief Place agent in the space at the specified location.
+         *
+         * @details In a dimension that wraps, the coordinate is wrapped
+         * into the space.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to add.
+         * @param[in] coord the coordinates of the agent.
+         *
+         * @returns the `AgentID` of the agent added
+         */
+        AgentID add_agent(
+                AgentID agent_id,
+                const ContinuousCoord2D& coord
+        );
+
+        /**
+         * @brief Remove agent from the space.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to remove.
+         *
+         * @returns the `AgentID` of the agent removed
+         */
+        AgentID delete_agent(AgentID agent_id);
+
+        /**
+         * @brief Move an agent to the specified location.
+         *
+         * @details The move is made in place.  In a dimension that wraps,
+         * the coordinate is wrapped into the space.  If the destination is
+         * invalid, an exception is thrown and the agent remains where it
+         * was.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to move.
+         * @param[in] coord the coordinates of the destination.
+         *
+         * @returns the `AgentID` of the agent moved
+         */
+        AgentID move_agent(
+                AgentID agent_id,
+                const ContinuousCoord2D& coord
+        );
+
+        /**
+         * @brief Inquire if the specified location is within the space.
+         *
+         * @param[in] coord the coordinates of the query.
+         *
+         * @return true if the location is valid, false otherwise.
+         */
+        [[nodiscard]] bool is_location_valid(const ContinuousCoord2D& coord) const;
+
+        /**
+         * @brief Get the location of the specified agent.
+         *
+         * @param[in] agent_id the `AgentID` of the agent in question.
+         *
+         * @return the location of the specified `Agent`
+         */
+        [[nodiscard]] ContinuousCoord2D get_location_by_agent(const AgentID& agent_id) const;
+
+        /**
+         * @brief Find the shortest distance between two points in the space
+         *
+         * @details In a dimension that wraps, the shorter way around is
+         * measured.
+         *
+         * @param[in] p the first point.
+         * @param[in] q the second point.
+         *
+         * @return the Euclidean distance between the points
+         */
+        [[nodiscard]] double distance(
+                const ContinuousCoord2D& p,
+                const ContinuousCoord2D& q
+        ) const;
+
+        /**
+         * @brief Get the agents within a radius of the specified location
+         *
+         * @param[in] coord the coordinates of the center.
+         * @param[in] radius the radius of the query.
+         *
+         * @return the `AgentID`s of the agents at most `radius` from the
+         * center, in index order.
+         */
+        [[nodiscard]] std::unique_ptr<std::vector<AgentID>> get_agents_in_radius(
+                const ContinuousCoord2D& coord,
+                double radius
+        ) const;
+
+        /**
+         * @brief Visit each agent within a radius of the specified location
+         *
+         * @details Nothing is allocated.  Agents are visited bin by bin,
+         * in row-major order, and in the order they were added within
+         * each bin.  The space must not be modified during the visit.
+         *
+         * @param[in] coord the coordinates of the center.
+         * @param[in] radius the radius of the query.
+         * @param[in] visitor a callable taking an `AgentID`.  If it returns
+         * `bool`, returning false ends the visit.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         */
+        template<typename Visitor>
+        bool for_each_agent_in_radius(
+                const ContinuousCoord2D& coord,
+                double radius,
+                Visitor&& visitor
+        ) const;
+
+        /**
+         * @brief Rebuild the bin index
+         *
+         * @details The index is rebuilt automatically when a query needs
+         * it, but rebuilding it explicitly allows an `Executor` to share
+         * the work.  Rebuilding an index that is current does nothing.
+         *
+         * @param[in] executor the `Executor` to use, or `nullptr` to
+         * rebuild on the calling thread only.
+         */
+        void rebuild_index(Executor* executor = nullptr) const;
+
+        /**
+         * @brief Get the number of agents in the space
+         */
+        [[nodiscard]] std::size_t get_agent_count() const;
+
+        /**
+         * @brief Get the length of the space in the `x` dimension.
+         */
+        [[nodiscard]] double get_width() const;
+
+        /**
+         * @brief Get the length of the space in the `y` dimension.
+         */
+        [[nodiscard]] double get_height() const;
+
+        /**
+         * @brief Inquire to whether the space wraps in the `x` dimension.
+         */
+        [[nodiscard]] bool get_wrap_x() const;
+
+        /**
+         * @brief Inquire to whether the space wraps in the `y` dimension.
+         */
+        [[nodiscard]] bool get_wrap_y() const;
+
+        /**
+         * @brief Get the number of bins in the `x` dimension.
+         */
+        [[nodiscard]] std::size_t get_bin_count_x() const;
+
+        /**
+         * @brief Get the number of bins in the `y` dimension.
+         */
+        [[nodiscard]] std::size_t get_bin_count_y() const;
+
+    private:
+        friend class KDTree2D;
+
+        double _width, _height;
+        bool _wrap_x, _wrap_y;
+        std::size_t _bins_x, _bins_y;
+        double _inverse_bin_width, _inverse_bin_height;
+
+        // Agents in the order they were added, less swap-removals
+        std::vector<AgentID> _agent_ids;
+        std::vector<double> _agent_x, _agent_y;
+        AgentIndex<std::uint32_t> _agent_slots;
+
+        // Agents sorted by bin, with copies of their positions
+        mutable std::vector<std::uint32_t> _bin_start;
+        mutable std::vector<AgentID> _sorted_ids;
+        mutable std::vector<double> _sorted_x, _sorted_y;
+        mutable std::vector<std::uint32_t> _agent_bins;
+        mutable std::atomic<bool> _index_stale{true};
+        mutable std::mutex _index_mutex;
+
+        [[nodiscard]] std::pair<double, double> wrap_location(const ContinuousCoord2D& coord) const;
+
+        [[nodiscard]] inline std::size_t bin_of(
+                double x,
+                double y
+        ) const {
+            auto bin_x = std::min(_bins_x - 1, static_cast<std::size_t>(x * _inverse_bin_width));
+            auto bin_y = std::min(_bins_y - 1, static_cast<std::size_t>(y * _inverse_bin_height));
+            return bin_y * _bins_x + bin_x;
+        }
+
+        /**
+         * @brief Get the bins overlapped by an interval in one dimension
+         *
+         * @return the first and last bins, which are unwrapped and may lie
+         * outside `[0, bins)` in a wrapping dimension
+         */
+        [[nodiscard]] static std::pair<int, int> bin_range(
+                double center,
+                double radius,
+                std::size_t bins,
+                double inverse_bin_size,
+                bool wrap
+        );
+
+        [[nodiscard]] static inline double displacement(
+                double delta,
+                double length,
+                bool wrap
+        ) {
+            if (wrap) {
+                if (delta > 0.5 * length)
+                    delta -= length;
+                else if (delta < -0.5 * length)
+                    delta += length;
+            }
+            return delta;
+        }
+    };
+
+    template<typename Visitor>
+    bool ContinuousSpace2D::for_each_agent_in_radius(
+            const ContinuousCoord2D& coord,
+            const double radius,
+            Visitor&& visitor
+    ) const {
+        if (!(radius >= 0.0))
+            return true;
+        rebuild_index();
+
+        const auto center_x = coord.x();
+        const auto center_y = coord.y();
+        const auto radius_squared = radius * radius;
+        const auto [x_first, x_last] = bin_range(center_x, radius, _bins_x, _inverse_bin_width, _wrap_x);
+        const auto [y_first, y_last] = bin_range(center_y, radius, _bins_y, _inverse_bin_height, _wrap_y);
+
+        for (auto y = y_first; y <= y_last; y++) {
+            auto row = static_cast<std::size_t>(stencil::wrap(y, static_cast<int>(_bins_y))) * _bins_x;
+            for (auto x = x_first; x <= x_last; x++) {
+                auto bin = row + static_cast<std::size_t>(stencil::wrap(x, static_cast<int>(_bins_x)));
+                for (auto i = _bin_start[bin]; i < _bin_start[bin + 1]; i++) {
+                    auto dx = displacement(_sorted_x[i] - center_x, _width, _wrap_x);
+                    auto dy = displacement(_sorted_y[i] - center_y, _height, _wrap_y);
+                    if (dx * dx + dy * dy <= radius_squared && !stencil::visit(visitor, _sorted_ids[i]))
+                        return false;
+                }
+            }
+        }
+        return true;
+    }
+
+}  // namespace kami
+
+#endif  // KAMI_CONTINUOUS2D_H
@@ -0,0 +1,138 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef KAMI_CSRGRAPH_H
+//! @cond SuppressGuard
+#define KAMI_CSRGRAPH_H
+//! @endcond
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <kami/kami.h>
+#include <kami/network.h>
+
+namespace kami {
+
+    /**
+     * @brief A network graph in compressed sparse row form
+     *
+     * @details The neighbors of all nodes are stored back to back in one
+     * array, sorted within each node, with a second array giving where each
+     * node's neighbors begin.  This is compact and fast to walk, but the
+     * graph cannot be changed once built.
+     *
+     * @see `DynamicGraph`
+     */
+    class LIBKAMI_EXPORT CSRGraph
+            : public NetworkGraph {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * @param[in] node_count the number of nodes in the graph.
+         * @param[in] edges the edges of the graph, as pairs of nodes.
+         * @param[in] directed are the edges directed, from the first node of
+         * each pair to the second.
+         *
+         * @throws error::OptionInvalid if an edge names a node outside the
+         * graph.
+         */
+        CSRGraph(
+                unsigned int node_count,
+                std::span<const std::pair<unsigned int, unsigned int>> edges,
+                bool directed = false
+        );
+
+        /**
+         * @brief Load a graph from an edge list file
+         *
+         * @details Each line of the file holds one edge, as two node numbers
+         * separated by whitespace, optionally followed by a comment
+         * starting with `#` or `%`.  Blank lines and lines starting with
+         * `#` or `%` are ignored.  Any other text after the two numbers,
+         * such as a weight column, is an error.
+         *
+         * @param[in] path the path of the file.
+         * @param[in] directed are the edges directed.
+         * @param[in] node_count the number of nodes in the graph, or zero to
+         * use one more than the largest node number in the file.
+         *
+         * @return a pointer to the graph
+         *
+         * @throws error::ResourceNotAvailable if the file cannot be read.
+         * @throws error::OptionInvalid if a line cannot be parsed, or has
+         * more than two columns.
+         */
+        static std::shared_ptr<CSRGraph> load_edge_list(
+                const std::string& path,
+                bool directed = false,
+                unsigned int node_count = 0
+        );
+
+        [[nodiscard]] unsigned int get_node_count() const override;
+
+        [[nodiscard]] std::size_t get_edge_count() const override;
+
+        [[nodiscard]] bool is_directed() const override;
+
+        [[nodiscard]] std::span<const unsigned int> get_neighbors(unsigned int node) const override;
+
+        /**
+         * @details Neighbors are sorted, so this is a binary search.
+         */
+        [[nodiscard]] bool has_edge(
+                unsigned int from,
+                unsigned int to
+        ) const override;
+
+        /**
+         * @brief Get the offsets of each node's neighbors
+         *
+         * @details The neighbors of node `n` are at `get_offsets()[n]` up
+         * to `get_offsets()[n + 1]` in `get_targets()`.
+         */
+        [[nodiscard]] std::span<const std::size_t> get_offsets() const;
+
+        /**
+         * @brief Get the neighbors of all nodes, back to back
+         */
+        [[nodiscard]] std::span<const unsigned int> get_targets() const;
+
+    private:
+        unsigned int _node_count;
+        bool _directed;
+        std::vector<std::size_t> _offsets;
+        std::vector<unsigned int> _targets;
+    };
+
+}  // namespace kami
+
+#endif  // KAMI_CSRGRAPH_H
@@ -0,0 +1,202 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef KAMI_DYNAMICGRAPH_H
+//! @cond SuppressGuard
+#define KAMI_DYNAMICGRAPH_H
+//! @endcond
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <kami/csrgraph.h>
+#include <kami/kami.h>
+#include <kami/network.h>
+
+namespace kami {
+
+    /**
+     * @brief A network graph whose edges may be added and removed
+     *
+     * @details The neighbors of each node are kept in a row of slots in one
+     * shared pool, with spare capacity at the end of each row.  A row that
+     * fills up moves to the end of the pool with twice the capacity,
+     * leaving its old slots abandoned; once more than half of the pool is
+     * abandoned, the rows are compacted.  A hash table maps each edge to
+     * its slot, so adding and removing an edge take amortized constant
+     * time.  Removal moves the last neighbor of the row into the vacated
+     * slot, so the order of neighbors is unspecified.
+     *
+     * Walking neighbors is nearly as fast as in a `CSRGraph`, but the rows
+     * are scattered through the pool.  For phases of a step that only
+     * query, `freeze()` makes a compact snapshot.
+     *
+     * @see `CSRGraph`
+     */
+    class LIBKAMI_EXPORT DynamicGraph
+            : public NetworkGraph {
+    public:
+        /**
+         * @brief Constructor for a graph without edges
+         *
+         * @param[in] node_count the number of nodes in the graph.
+         * @param[in] directed are the edges directed.
+         */
+        explicit DynamicGraph(
+                unsigned int node_count,
+                bool directed = false
+        );
+
+        /**
+         * @brief Constructor copying the edges of another graph
+         *
+         * @param[in] graph the graph to copy.
+         */
+        explicit DynamicGraph(const NetworkGraph& graph);
+
+        /**
+         * @brief Add an edge to the graph
+         *
+         * @param[in] from a node in the graph.
+         * @param[in] to a node in the graph.
+         *
+         * @return true if the edge was added, false if it was already
+         * present or is a self-loop.
+         *
+         * @throws error::OptionInvalid if either node is outside the graph.
+         */
+        bool add_edge(
+                unsigned int from,
+                unsigned int to
+        );
+
+        /**
+         * @brief Remove an edge from the graph
+         *
+         * @param[in] from a node in the graph.
+         * @param[in] to a node in the graph.
+         *
+         * @return true if the edge was removed, false if it was absent.
+         */
+        bool delete_edge(
+                unsigned int from,
+                unsigned int to
+        );
+
+        [[nodiscard]] unsigned int get_node_count() const override;
+
+        [[nodiscard]] std::size_t get_edge_count() const override;
+
+        [[nodiscard]] bool is_directed() const override;
+
+        [[nodiscard]] std::span<const unsigned int> get_neighbors(unsigned int node) const override;
+
+        /**
+         * @details This is a hash table lookup.
+         */
+        [[nodiscard]] bool has_edge(
+                unsigned int from,
+                unsigned int to
+        ) const override;
+
+        /**
+         * @brief Make a compact, read-only copy of the graph
+         *
+         * @details The copy does not follow later changes to this graph.
+         * It has the same nodes, so a `NetworkDomain` may switch between
+         * the two with `NetworkDomain::set_graph()`.
+         *
+         * @return a pointer to the copy
+         */
+        [[nodiscard]] std::shared_ptr<CSRGraph> freeze() const;
+
+        /**
+         * @brief Move all rows back to back, reclaiming abandoned slots
+         *
+         * @details This happens automatically as rows move, and is only
+         * needed to return memory early.  Spare capacity within rows is
+         * kept.
+         */
+        void compact();
+
+    private:
+        struct Row {
+            std::size_t begin;
+            std::uint32_t size;
+            std::uint32_t capacity;
+        };
+
+        static constexpr std::uint64_t no_edge = UINT64_MAX;
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        unsigned int _node_count;
+        bool _directed;
+        std::vector<Row> _rows;
+        std::vector<unsigned int> _pool;
+        std::size_t _abandoned = 0;
+
+        // The slot of each edge within its row, keyed by `edge_key()`
+        std::vector<std::uint64_t> _edge_keys;
+        std::vector<std::uint32_t> _edge_slots;
+        std::size_t _edge_entries = 0;
+        std::size_t _edge_mask = 0;
+        unsigned int _edge_shift = 64;
+
+        [[nodiscard]] static std::uint64_t edge_key(
+                unsigned int from,
+                unsigned int to
+        );
+
+        [[nodiscard]] std::size_t home_slot(std::uint64_t key) const;
+
+        [[nodiscard]] std::size_t find_edge(std::uint64_t key) const;
+
+        void insert_edge(
+                std::uint64_t key,
+                std::uint32_t slot
+        );
+
+        void erase_edge(std::size_t index);
+
+        void rehash_edges(std::size_t capacity);
+
+        void push_neighbor(
+                unsigned int from,
+                unsigned int to
+        );
+
+        void remove_neighbor(
+                unsigned int from,
+                unsigned int to
+        );
+    };
+
+}  // namespace kami
+
+#endif  // KAMI_DYNAMICGRAPH_H
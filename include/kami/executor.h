@@ -0,0 +1,243 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef KAMI_EXECUTOR_H
+//! @cond SuppressGuard
+#define KAMI_EXECUTOR_H
+//! @endcond
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <kami/kami.h>
+
+namespace kami {
+
+    class TaskGraph;
+
+    /**
+     * @brief A shared, work-stealing thread pool
+     *
+     * @details An `Executor` owns a fixed set of worker threads, each
+     * with its own task queue.  Workers take tasks from their own queue
+     * first, newest first, and steal the oldest tasks from the other
+     * workers when they run dry.  A thread that waits on the `Executor`,
+     * for instance by calling `parallel_for()` or `run()`, executes
+     * pending tasks while it waits.  Accordingly, parallel work may be
+     * nested freely without deadlocking the pool and the calling thread
+     * is never left idle.
+     *
+     * A `Model` owns a single `Executor` and every parallel feature in
+     * Kami draws on it, so that schedulers, domains, and reporters
+     * never compete for cores with pools of their own.  An `Executor`
+     * with no worker threads runs all of its work on the waiting
+     * thread, in order, which is useful for debugging.
+     *
+     * @see `Model::get_executor()`
+     * @see `TaskGraph`
+     */
+    class LIBKAMI_EXPORT Executor {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * @param[in] thread_count the number of worker threads to start.
+         * The thread waiting on the `Executor` also executes tasks, so
+         * the default is one fewer than the number of hardware threads.
+         */
+        explicit Executor(unsigned int thread_count = default_thread_count());
+
+        /**
+         * @brief Destructor
+         *
+         * @details Stops and joins all worker threads.  Work must not be
+         * submitted to an `Executor` while it is being destroyed.
+         */
+        ~Executor();
+
+        Executor(const Executor&) = delete;
+
+        Executor& operator=(const Executor&) = delete;
+
+        /**
+         * @brief Get the number of worker threads
+         *
+         * @returns the number of worker threads, not counting the thread
+         * waiting on the `Executor`
+         */
+        [[nodiscard]] unsigned int get_thread_count() const;
+
+        /**
+         * @brief Get the number of threads that may run tasks concurrently
+         *
+         * @details This is the number of worker threads plus the thread
+         * waiting on the `Executor`, and is the natural number of pieces
+         * to divide work into.
+         *
+         * @returns the concurrency of the `Executor`
+         */
+        [[nodiscard]] unsigned int get_concurrency() const;
+
+        /**
+         * @brief Get the default number of worker threads
+         *
+         * @returns one fewer than the number of hardware threads available
+         */
+        static unsigned int default_thread_count();
+
+        /**
+         * @brief Execute a function over a range in parallel
+         *
+         * @details The range `[begin, end)` is divided into contiguous
+         * chunks of at most `grain` elements and `body` is called once
+         * for each chunk with the bounds of that chunk.  The call returns
+         * once every chunk has completed.  If any chunk throws, the first
+         * exception thrown is rethrown here after all chunks complete.
+         *
+         * @param[in] begin the first index of the range
+         * @param[in] end one past the last index of the range
+         * @param[in] grain the maximum size of each chunk; zero selects a
+         * grain that gives each thread a few chunks
+         * @param[in] body the function to call on each chunk
+         */
+        void parallel_for(
+                std::size_t begin,
+                std::size_t end,
+                std::size_t grain,
+                const std::function<void(std::size_t, std::size_t)>& body
+        );
+
+        /**
+         * @brief Execute a task graph
+         *
+         * @details Every task in the graph is executed once, after all of
+         * the tasks it depends on have completed.  Independent tasks may
+         * run concurrently.  The call returns once every task has
+         * completed.  If a task throws, the tasks depending on it are
+         * skipped and the first exception thrown is rethrown here.
+         *
+         * @param[in] graph the `TaskGraph` to execute
+         */
+        void run(const TaskGraph& graph);
+
+    private:
+        struct Group;
+
+        struct Task {
+            std::function<void()> fn;
+            Group* group;
+        };
+
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        void submit(Task task);
+
+        bool try_execute(int self);
+
+        void wait(Group& group);
+
+        void work(int self);
+
+        static void execute(Task& task);
+
+        std::vector<std::unique_ptr<Queue>> _queues;
+        std::vector<std::thread> _threads;
+        std::atomic<std::size_t> _queued{0};
+        std::atomic<bool> _stop{false};
+        std::mutex _sleep_mutex;
+        std::condition_variable _sleep;
+    };
+
+    /**
+     * @brief A directed acyclic graph of tasks
+     *
+     * @details A `TaskGraph` describes work, such as the phases of a
+     * single model step, as a set of tasks and the dependencies between
+     * them.  The graph is executed by `Executor::run()`, which runs
+     * independent tasks concurrently.  A graph may be run any number of
+     * times, for instance once per step.
+     *
+     * @see `Executor`
+     */
+    class LIBKAMI_EXPORT TaskGraph {
+    public:
+        /**
+         * @brief Add a task to the graph
+         *
+         * @param[in] task the function to execute
+         *
+         * @returns the index of the new task, for use with
+         * `add_dependency()`
+         */
+        std::size_t add_task(std::function<void()> task);
+
+        /**
+         * @brief Require one task to complete before another starts
+         *
+         * @param[in] before the index of the task that must complete first
+         * @param[in] after the index of the task that must wait
+         */
+        void add_dependency(
+                std::size_t before,
+                std::size_t after
+        );
+
+        /**
+         * @brief Get the number of tasks in the graph
+         */
+        [[nodiscard]] std::size_t size() const;
+
+        /**
+         * @brief Remove all tasks from the graph
+         */
+        void clear();
+
+    private:
+        friend class Executor;
+
+        struct Node {
+            std::function<void()> fn;
+            std::vector<std::size_t> successors;
+            std::size_t predecessor_count = 0;
+        };
+
+        std::vector<Node> _nodes;
+    };
+
+}  // namespace kami
+
+#endif  // KAMI_EXECUTOR_H
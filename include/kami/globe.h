@@ -0,0 +1,496 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef KAMI_GLOBE_H
+//! @cond SuppressGuard
+#define KAMI_GLOBE_H
+//! @endcond
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <numbers>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <kami/agent.h>
+#include <kami/agentindex.h>
+#include <kami/domain.h>
+#include <kami/executor.h>
+#include <kami/kami.h>
+#include <kami/stencil.h>
+
+namespace kami {
+
+    /**
+     * @brief Coordinates on the surface of a sphere
+     *
+     * @details Latitude and longitude are in degrees, with north and east
+     * positive.
+     */
+    class LIBKAMI_EXPORT GlobeCoord
+            : public Coord {
+    public:
+        /**
+         * @brief Constructor for latitude and longitude
+         */
+        GlobeCoord(
+                double latitude,
+                double longitude
+        );
+
+        /**
+         * @brief Get the latitude, in degrees.
+         */
+        [[nodiscard]] double latitude() const;
+
+        /**
+         * @brief Get the longitude, in degrees.
+         */
+        [[nodiscard]] double longitude() const;
+
+        /**
+         * @brief Convert the coordinate to a human-readable string.
+         *
+         * @return a human-readable form of the `Coord` as `std::string`.
+         */
+        [[nodiscard]] std::string to_string() const override;
+
+        /**
+         * @brief Find the great-circle distance between two points
+         *
+         * @details The coordinate is not aware of the size of the sphere,
+         * so the distance is the angle between the points, measured from
+         * the center, by the haversine formula.
+         *
+         * @see `Globe::distance()`
+         *
+         * @param p the point to measure the distance to
+         *
+         * @returns the angle in radians, in `[0, pi]`
+         */
+        [[nodiscard]] double distance(const GlobeCoord& p) const;
+
+        /**
+         * @brief Test if two coordinates are equal
+         */
+        friend bool operator==(
+                const GlobeCoord&,
+                const GlobeCoord&
+        );
+
+        /**
+         * @brief Test if two coordinates are not equal
+         */
+        friend bool operator!=(
+                const GlobeCoord&,
+                const GlobeCoord&
+        );
+
+        /**
+         * @brief Output a given coordinate to the specified stream
+         */
+        friend std::ostream& operator<<(
+                std::ostream&,
+                const GlobeCoord&
+        );
+
+    private:
+        double _latitude, _longitude;
+    };
+
+    /**
+     * @brief A domain on the surface of a sphere
+     *
+     * @details Agents have latitude and longitude positions, and distances
+     * are measured along great circles.  Each agent's position is also
+     * kept as a unit vector, in flat arrays, so that comparing distances
+     * takes a dot product rather than trigonometry.
+     *
+     * Radius queries are answered from a hierarchical, equal-area cell
+     * index, the nested HEALPix scheme.  The sphere is divided into 12
+     * base cells of equal area, and each cell at one level into 4 of equal
+     * area at the next, so that at level `L` there are `12 * 4^L` cells.
+     * Cells are numbered so that the children of cell `c` are `4c` to
+     * `4c + 3`, and agents sorted by cell at the finest level are also
+     * sorted by cell at every coarser one.  A query descends from the base
+     * cells, passing over any cell that is too far away or holds no
+     * agents, so its cost is in proportion to the cells it touches.  With
+     * cells about as large as the typical query radius, that is close to
+     * the number of agents found.
+     *
+     * As in `ContinuousSpace2D`, the index is rebuilt by a counting sort
+     * the first time it is needed after any change.
+     */
+    class LIBKAMI_EXPORT Globe
+            : public Domain {
+    public:
+        /**
+         * @brief The mean radius of the Earth, in kilometers
+         */
+        static constexpr double earth_radius = 6371.0088;
+
+        /**
+         * @brief The finest level of the cell index
+         *
+         * @details At level 10 there are over 12 million cells, about 6
+         * kilometers across on the Earth.
+         */
+        static constexpr unsigned int maximum_level = 10;
+
+        /**
+         * @brief Constructor
+         *
+         * @param[in] radius the radius of the sphere, in the units of
+         * distance to be used.
+         * @param[in] level the level of the cell index, where cells are
+         * about `58.6 / 2^level` degrees across.
+         *
+         * @throws error::OptionInvalid if the radius is not positive or the
+         * level is above `maximum_level`.
+         */
+        explicit Globe(
+                double radius = earth_radius,
+                unsigned int level = 6
+        );
+
+        /**
+         * @brief Place agent on the globe at the specified location.
+         *
+         * @details Longitudes are wrapped into `[-180, 180)`.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to add.
+         * @param[in] coord the coordinates of the agent.
+         *
+         * @returns the `AgentID` of the agent added
+         */
+        AgentID add_agent(
+                AgentID agent_id,
+                const GlobeCoord& coord
+        );
+
+        /**
+         * @brief Remove agent from the globe.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to remove.
+         *
+         * @returns the `AgentID` of the agent removed
+         */
+        AgentID delete_agent(AgentID agent_id);
+
+        /**
+         * @brief Move an agent to the specified location.
+         *
+         * @details The move is made in place.  If the destination is
+         * invalid, an exception is thrown and the agent remains where it
+         * was.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to move.
+         * @param[in] coord the coordinates of the destination.
+         *
+         * @returns the `AgentID` of the agent moved
+         */
+        AgentID move_agent(
+                AgentID agent_id,
+                const GlobeCoord& coord
+        );
+
+        /**
+         * @brief Inquire if the specified location is valid.
+         *
+         * @param[in] coord the coordinates of the query.
+         *
+         * @return true if the latitude is within `[-90, 90]` and the
+         * longitude is finite, false otherwise.
+         */
+        [[nodiscard]] bool is_location_valid(const GlobeCoord& coord) const;
+
+        /**
+         * @brief Get the location of the specified agent.
+         *
+         * @param[in] agent_id the `AgentID` of the agent in question.
+         *
+         * @return the location of the specified `Agent`
+         */
+        [[nodiscard]] GlobeCoord get_location_by_agent(const AgentID& agent_id) const;
+
+        /**
+         * @brief Find the great-circle distance between two points
+         *
+         * @param[in] p the first point.
+         * @param[in] q the second point.
+         *
+         * @return the distance, in the units of the radius
+         */
+        [[nodiscard]] double distance(
+                const GlobeCoord& p,
+                const GlobeCoord& q
+        ) const;
+
+        /**
+         * @brief Find the great-circle distances from a point to many agents
+         *
+         * @details The agents' unit vectors are first gathered into flat
+         * arrays.  The distances are then found in one branch-free pass,
+         * using half-angle identities and a rational arctangent in place
+         * of `std::atan2`, which the compiler vectorizes when
+         * `-fno-math-errno` is in effect.
+         *
+         * @param[in] coord the point to measure from.
+         * @param[in] agent_ids the agents to measure to.
+         * @param[out] distances the distance to each agent, in the units of
+         * the radius.  It must be as long as `agent_ids`.
+         *
+         * @throws error::AgentNotFound if an agent is not on the globe.
+         * @throws error::OptionInvalid if `distances` is too short.
+         */
+        void get_distances(
+                const GlobeCoord& coord,
+                std::span<const AgentID> agent_ids,
+                std::span<double> distances
+        ) const;
+
+        /**
+         * @brief Get the agents within a radius of the specified location
+         *
+         * @param[in] coord the coordinates of the center.
+         * @param[in] radius the great-circle radius of the query, in the
+         * units of the radius of the sphere.
+         *
+         * @return the `AgentID`s of the agents at most `radius` from the
+         * center, in index order.
+         */
+        [[nodiscard]] std::unique_ptr<std::vector<AgentID>> get_agents_in_radius(
+                const GlobeCoord& coord,
+                double radius
+        ) const;
+
+        /**
+         * @brief Visit each agent within a radius of the specified location
+         *
+         * @details Nothing is allocated.  Agents are visited in cell order,
+         * and in the order they were added within each cell.  The globe
+         * must not be modified during the visit.
+         *
+         * @param[in] coord the coordinates of the center.
+         * @param[in] radius the great-circle radius of the query, in the
+         * units of the radius of the sphere.
+         * @param[in] visitor a callable taking an `AgentID`.  If it returns
+         * `bool`, returning false ends the visit.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         */
+        template<typename Visitor>
+        bool for_each_agent_in_radius(
+                const GlobeCoord& coord,
+                double radius,
+                Visitor&& visitor
+        ) const;
+
+        /**
+         * @brief Rebuild the cell index
+         *
+         * @details The index is rebuilt automatically when a query needs
+         * it, but rebuilding it explicitly allows an `Executor` to share
+         * the work.  Rebuilding an index that is current does nothing.
+         *
+         * @param[in] executor the `Executor` to use, or `nullptr` to
+         * rebuild on the calling thread only.
+         */
+        void rebuild_index(Executor* executor = nullptr) const;
+
+        /**
+         * @brief Get the number of agents on the globe
+         */
+        [[nodiscard]] std::size_t get_agent_count() const;
+
+        /**
+         * @brief Get the radius of the sphere.
+         */
+        [[nodiscard]] double get_radius() const;
+
+        /**
+         * @brief Get the level of the cell index.
+         */
+        [[nodiscard]] unsigned int get_level() const;
+
+        /**
+         * @brief Get the number of cells at the level of the cell index.
+         */
+        [[nodiscard]] std::size_t get_cell_count() const;
+
+        /**
+         * @brief Get the cell containing a location
+         *
+         * @param[in] coord a valid location.
+         * @param[in] level the level of the cell, at most `maximum_level`.
+         *
+         * @return the nested HEALPix number of the cell
+         */
+        [[nodiscard]] static std::uint32_t get_cell(
+                const GlobeCoord& coord,
+                unsigned int level
+        );
+
+        /**
+         * @brief Get the center of a cell
+         *
+         * @param[in] cell the nested HEALPix number of the cell.
+         * @param[in] level the level of the cell, at most `maximum_level`.
+         *
+         * @return the location of the center of the cell
+         */
+        [[nodiscard]] static GlobeCoord get_cell_center(
+                std::uint32_t cell,
+                unsigned int level
+        );
+
+        /**
+         * @brief Get the largest angle from the center of a cell to any
+         * point in it
+         *
+         * @param[in] level the level of the cells.
+         *
+         * @return the angle in radians
+         */
+        [[nodiscard]] static double get_cell_radius(unsigned int level);
+
+    private:
+        struct Vector {
+            double x, y, z;
+        };
+
+        double _radius;
+        unsigned int _level;
+        std::array<double, maximum_level + 1> _cell_radii{};
+
+        // Agents in the order they were added, less swap-removals
+        std::vector<AgentID> _agent_ids;
+        std::vector<double> _agent_latitudes, _agent_longitudes;
+        std::vector<double> _agent_x, _agent_y, _agent_z;
+        std::vector<std::uint32_t> _agent_cells;
+        AgentIndex<std::uint32_t> _agent_slots;
+
+        // Agents sorted by cell, with copies of their unit vectors
+        mutable std::vector<std::uint32_t> _cell_start;
+        mutable std::vector<AgentID> _sorted_ids;
+        mutable std::vector<double> _sorted_x, _sorted_y, _sorted_z;
+        mutable std::atomic<bool> _index_stale{true};
+        mutable std::mutex _index_mutex;
+
+        [[nodiscard]] static Vector to_vector(
+                double latitude,
+                double longitude
+        );
+
+        [[nodiscard]] static std::uint32_t vector_cell(
+                const Vector& v,
+                unsigned int level
+        );
+
+        [[nodiscard]] static Vector cell_vector(
+                std::uint32_t cell,
+                unsigned int level
+        );
+
+        [[nodiscard]] GlobeCoord normalize(const GlobeCoord& coord) const;
+
+        void place(
+                std::size_t slot,
+                const GlobeCoord& coord
+        );
+    };
+
+    template<typename Visitor>
+    bool Globe::for_each_agent_in_radius(
+            const GlobeCoord& coord,
+            const double radius,
+            Visitor&& visitor
+    ) const {
+        if (!(radius >= 0.0) || !is_location_valid(coord))
+            return true;
+        rebuild_index();
+
+        const auto center = to_vector(coord.latitude(), coord.longitude());
+        const auto angle = radius / _radius;
+
+        // Agents and cells are compared by the cosine of their angle from
+        // the center, which grows as the angle shrinks
+        auto threshold = [](double a) {
+            return a >= std::numbers::pi ? -2.0 : std::cos(a);
+        };
+        const auto agent_threshold = threshold(angle);
+        std::array<double, maximum_level + 1> cell_thresholds{};
+        for (unsigned int level = 0; level <= _level; level++)
+            cell_thresholds[level] = threshold(angle + _cell_radii[level]);
+
+        // Descend depth-first from the base cells, largest number first,
+        // so that cells come off the stack in increasing order
+        struct Frame {
+            std::uint32_t cell;
+            unsigned int level;
+        };
+        std::array<Frame, 12 + 3 * maximum_level> stack;
+        std::size_t depth = 0;
+        for (std::uint32_t face = 12; face-- > 0;)
+            stack[depth++] = Frame{face, 0};
+
+        while (depth > 0) {
+            auto [cell, level] = stack[--depth];
+            auto shift = 2 * (_level - level);
+            auto begin = _cell_start[static_cast<std::size_t>(cell) << shift];
+            auto end = _cell_start[static_cast<std::size_t>(cell + 1) << shift];
+            if (begin == end)
+                continue;
+
+            auto v = cell_vector(cell, level);
+            if (v.x * center.x + v.y * center.y + v.z * center.z < cell_thresholds[level])
+                continue;
+
+            if (level < _level) {
+                for (std::uint32_t child = 4; child-- > 0;)
+                    stack[depth++] = Frame{4 * cell + child, level + 1};
+                continue;
+            }
+
+            for (auto i = begin; i < end; i++)
+                if (_sorted_x[i] * center.x + _sorted_y[i] * center.y + _sorted_z[i] * center.z >= agent_threshold &&
+                    !stencil::visit(visitor, _sorted_ids[i]))
+                    return false;
+        }
+        return true;
+    }
+
+}  // namespace kami
+
+#endif  // KAMI_GLOBE_H
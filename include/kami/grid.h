@@ -29,6 +29,7 @@
 #define KAMI_GRID_H
 //! @endcond
 
+#include <memory>
 #include <string>
 
 #include <kami/domain.h>
@@ -59,7 +60,64 @@ namespace kami {
          * @details Von Neumann neighborhood types do not include
          * diagonally-adjacent cells as neighbors.
          */
-        VonNeumann
+        VonNeumann,
+
+        /**
+         * @brief Euclidean neighborhood
+         *
+         * @details Euclidean neighborhood types include those cells whose
+         * centers lie within a disc of the given radius.  At radius one,
+         * this is the same as the von Neumann neighborhood.
+         */
+        Euclidean,
+
+        /**
+         * @brief Edge neighborhood
+         *
+         * @details At radius `r`, the Edge neighborhood is the Moore
+         * neighborhood less the cells more than `2r` steps away along the
+         * axes.  On three-dimensional grids this drops the corners, giving
+         * at radius one the 18-neighborhood of cells that share a face or
+         * an edge with the center, between the von Neumann 6-neighborhood
+         * and the Moore 26-neighborhood.  On one- and two-dimensional grids
+         * no cell of the Moore neighborhood is more than `2r` steps away,
+         * so the Edge neighborhood is the Moore neighborhood, diagonal
+         * cells included.
+         */
+        Edge
+    };
+
+    /**
+     * @brief Policies for settling competing moves onto one cell
+     *
+     * @details When a batch of moves is applied to a grid that allows only
+     * one agent per cell, several agents may claim the same cell.  Exactly
+     * one claim wins, chosen by the policy; the others are refused and
+     * their agents stay where they were.
+     *
+     * @see `SoloGrid2D::move_agents()`
+     */
+    enum class GridConflictPolicy {
+        /**
+         * @brief The earliest claim in the batch wins
+         */
+        First,
+
+        /**
+         * @brief A claim chosen at random wins
+         *
+         * @details The choice is a function of a seed and the claiming
+         * agents only, so it is reproducible and does not depend on the
+         * order of the batch or the number of threads.
+         */
+        Random,
+
+        /**
+         * @brief The claim with the highest priority wins
+         *
+         * @details Ties go to the earliest claim in the batch.
+         */
+        Priority
     };
 
     /**
@@ -29,18 +29,25 @@
 #define KAMI_GRID1D_H
 //! @endcond
 
+#include <cstddef>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <memory>
+#include <optional>
+#include <random>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include <kami/agent.h>
+#include <kami/agentindex.h>
 #include <kami/domain.h>
 #include <kami/error.h>
 #include <kami/grid.h>
 #include <kami/kami.h>
+#include <kami/stencil.h>
 
 namespace kami {
 
@@ -302,6 +309,177 @@ namespace kami {
                 bool include_center
         ) const;
 
+        /**
+         * @brief Visit each cell in the neighborhood of the specified location
+         *
+         * @details Neighbors are visited in increasing order using a stencil
+         * fixed at compile time, and nothing is allocated.  Cells away from
+         * the ends of the grid skip wrapping and validity checks entirely.
+         * On a wrapped grid with fewer than three cells, the same cell may
+         * be visited more than once.
+         *
+         * @param[in] coord the coordinates of the specified location.
+         * @param[in] include_center should the center-point be visited.
+         * @param[in] visitor a callable taking a `const GridCoord1D&`.  If it
+         * returns `bool`, returning false ends the visit.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         */
+        template<typename Visitor>
+        bool for_each_neighbor(
+                const GridCoord1D& coord,
+                bool include_center,
+                Visitor&& visitor
+        ) const;
+
+        /**
+         * @brief Visit each cell within a radius of the specified location
+         *
+         * @details Cells are visited in increasing order.  Stencils up to
+         * `stencil::max_static_radius` are fixed at compile time; larger
+         * ones are generated once and cached.  Cells at least `radius` from
+         * the ends of the grid skip wrapping and validity checks entirely.
+         * On a wrapped grid with fewer than `2 * radius + 1` cells, the same
+         * cell may be visited more than once.
+         *
+         * @param[in] coord the coordinates of the specified location.
+         * @param[in] include_center should the center-point be visited.
+         * @param[in] radius the radius of the neighborhood.
+         * @param[in] visitor a callable taking a `const GridCoord1D&`.  If it
+         * returns `bool`, returning false ends the visit.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         */
+        template<typename Visitor>
+        bool for_each_neighbor(
+                const GridCoord1D& coord,
+                bool include_center,
+                unsigned int radius,
+                Visitor&& visitor
+        ) const;
+
+        /**
+         * @brief Visit each agent in the neighborhood of the specified location
+         *
+         * @details This fuses `for_each_neighbor()` and
+         * `get_location_contents()`: cell storage is scanned directly, and
+         * no containers are built.  Cells are visited in increasing order;
+         * the order of agents within a cell is unspecified.  The grid must
+         * not be modified during the visit.
+         *
+         * @param[in] coord the coordinates of the specified location.
+         * @param[in] include_center should agents at the center-point be
+         * visited.
+         * @param[in] radius the radius of the neighborhood.
+         * @param[in] visitor a callable taking an `AgentID`.  If it returns
+         * `bool`, returning false ends the visit.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         */
+        template<typename Visitor>
+        bool for_each_agent_in_neighborhood(
+                const GridCoord1D& coord,
+                bool include_center,
+                unsigned int radius,
+                Visitor&& visitor
+        ) const;
+
+        /**
+         * @brief Visit each matching agent in the neighborhood of the specified
+         * location
+         *
+         * @param[in] coord the coordinates of the specified location.
+         * @param[in] include_center should agents at the center-point be
+         * visited.
+         * @param[in] radius the radius of the neighborhood.
+         * @param[in] filter a predicate taking an `AgentID`; only agents for
+         * which it returns true are visited.
+         * @param[in] visitor a callable taking an `AgentID`.  If it returns
+         * `bool`, returning false ends the visit.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         */
+        template<typename Filter, typename Visitor>
+        bool for_each_agent_in_neighborhood(
+                const GridCoord1D& coord,
+                bool include_center,
+                unsigned int radius,
+                Filter&& filter,
+                Visitor&& visitor
+        ) const;
+
+        /**
+         * @brief Choose a random cell in the neighborhood of the specified
+         * location
+         *
+         * @details Each cell of the neighborhood is equally likely.  Away
+         * from the ends of the grid, this is a single draw from the stencil.
+         * Nothing is allocated.
+         *
+         * @param[in] coord the coordinates of the specified location.
+         * @param[in] include_center may the center-point be chosen.
+         * @param[in] rng a uniform random bit generator.
+         *
+         * @return the chosen cell, or nothing if the neighborhood is empty.
+         */
+        template<typename URBG>
+        std::optional<GridCoord1D> random_neighbor_cell(
+                const GridCoord1D& coord,
+                bool include_center,
+                URBG& rng
+        ) const;
+
+        /**
+         * @brief Choose a random cell within a radius of the specified location
+         *
+         * @param[in] coord the coordinates of the specified location.
+         * @param[in] include_center may the center-point be chosen.
+         * @param[in] radius the radius of the neighborhood.
+         * @param[in] rng a uniform random bit generator.
+         *
+         * @return the chosen cell, or nothing if the neighborhood is empty.
+         */
+        template<typename URBG>
+        std::optional<GridCoord1D> random_neighbor_cell(
+                const GridCoord1D& coord,
+                bool include_center,
+                unsigned int radius,
+                URBG& rng
+        ) const;
+
+        /**
+         * @brief Choose a random agent at the specified location
+         *
+         * @param[in] coord the coordinates of the specified location.
+         * @param[in] rng a uniform random bit generator.
+         *
+         * @return the `AgentID` of the chosen agent, or nothing if the
+         * location is empty.
+         */
+        template<typename URBG>
+        std::optional<AgentID> random_agent_at(
+                const GridCoord1D& coord,
+                URBG& rng
+        ) const;
+
+        /**
+         * @brief Choose a random agent at the specified location, other than
+         * the one given
+         *
+         * @param[in] coord the coordinates of the specified location.
+         * @param[in] agent_id the `AgentID` of the agent to exclude.
+         * @param[in] rng a uniform random bit generator.
+         *
+         * @return the `AgentID` of the chosen agent, or nothing if there is
+         * no other agent at the location.
+         */
+        template<typename URBG>
+        std::optional<AgentID> random_other_agent_at(
+                const GridCoord1D& coord,
+                AgentID agent_id,
+                URBG& rng
+        ) const;
+
         /**
          * @brief Get the size of the grid in the `x` dimension.
          *
@@ -328,9 +506,9 @@ namespace kami {
         std::unique_ptr<std::unordered_multimap<GridCoord1D, AgentID>> _agent_grid;
 
         /**
-         * @brief A map containing the grid location of each agent.
+         * @brief The x-coordinate of each agent, keyed by `AgentID`
          */
-        std::unique_ptr<std::map<AgentID, GridCoord1D>> _agent_index;
+        AgentIndex<int> _agent_index;
 
         /**
          * @brief Automatically adjust a coordinate location for wrapping.
@@ -341,6 +519,42 @@ namespace kami {
          */
         [[nodiscard]] GridCoord1D coord_wrap(const GridCoord1D& coord) const;
 
+        /**
+         * @brief Inquire if a stencil centered on a location lies wholly on
+         * the grid
+         *
+         * @param[in] coord the coordinates of the center.
+         * @param[in] radius the largest offset in the stencil.
+         *
+         * @return true if no cell of the stencil needs wrapping or checking
+         */
+        [[nodiscard]] inline bool is_interior(
+                const GridCoord1D& coord,
+                int radius
+        ) const {
+            return coord.x() >= radius && coord.x() < static_cast<int>(_maximum_x) - radius;
+        }
+
+        /**
+         * @brief Visit each cell of a stencil centered on a location
+         *
+         * @param[in] coord the coordinates of the center.
+         * @param[in] include_center should the center-point be visited.
+         * @param[in] radius the largest offset in the stencil.
+         * @param[in] offsets the stencil.
+         * @param[in] visitor the visitor.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         */
+        template<typename Offsets, typename Visitor>
+        bool visit_stencil(
+                const GridCoord1D& coord,
+                bool include_center,
+                int radius,
+                const Offsets& offsets,
+                Visitor& visitor
+        ) const;
+
     private:
         unsigned int _maximum_x;
         bool _wrap_x;
@@ -360,4 +574,190 @@ namespace std {
 }  // namespace std
 //! @endcond
 
+namespace kami {
+
+    template<typename Visitor>
+    bool Grid1D::for_each_neighbor(
+            const GridCoord1D& coord,
+            const bool include_center,
+            Visitor&& visitor
+    ) const {
+        return for_each_neighbor(coord, include_center, 1, visitor);
+    }
+
+    template<typename Visitor>
+    bool Grid1D::for_each_neighbor(
+            const GridCoord1D& coord,
+            const bool include_center,
+            const unsigned int radius,
+            Visitor&& visitor
+    ) const {
+        return stencil::with_1d(radius, [&](const auto& offsets) {
+            return visit_stencil(coord, include_center, static_cast<int>(radius), offsets, visitor);
+        });
+    }
+
+    template<typename URBG>
+    std::optional<GridCoord1D> Grid1D::random_neighbor_cell(
+            const GridCoord1D& coord,
+            const bool include_center,
+            URBG& rng
+    ) const {
+        return random_neighbor_cell(coord, include_center, 1, rng);
+    }
+
+    template<typename URBG>
+    std::optional<GridCoord1D> Grid1D::random_neighbor_cell(
+            const GridCoord1D& coord,
+            const bool include_center,
+            const unsigned int radius,
+            URBG& rng
+    ) const {
+        return stencil::with_1d(radius, [&](const auto& offsets) -> std::optional<GridCoord1D> {
+            const auto r = static_cast<int>(radius);
+
+            if (is_interior(coord, r)) {
+                const auto center = offsets.size() / 2;
+                const auto count = include_center ? offsets.size() : offsets.size() - 1;
+                if (count == 0)
+                    return std::nullopt;
+
+                auto index = std::uniform_int_distribution<std::size_t>(0, count - 1)(rng);
+                if (!include_center && index >= center)
+                    index++;
+                return GridCoord1D(coord.x() + offsets[index].dx);
+            }
+
+            std::size_t count = 0;
+            auto counter = [&count](const GridCoord1D&) {
+                count++;
+            };
+            visit_stencil(coord, include_center, r, offsets, counter);
+            if (count == 0)
+                return std::nullopt;
+
+            auto index = std::uniform_int_distribution<std::size_t>(0, count - 1)(rng);
+            std::optional<GridCoord1D> chosen;
+            auto chooser = [&index, &chosen](const GridCoord1D& cell) {
+                if (index-- > 0)
+                    return true;
+                chosen = cell;
+                return false;
+            };
+            visit_stencil(coord, include_center, r, offsets, chooser);
+            return chosen;
+        });
+    }
+
+    template<typename URBG>
+    std::optional<AgentID> Grid1D::random_agent_at(
+            const GridCoord1D& coord,
+            URBG& rng
+    ) const {
+        if (!is_location_valid(coord))
+            throw error::LocationInvalid("Coordinates " + coord.to_string() + " are invalid");
+
+        auto agent_range = _agent_grid->equal_range(coord);
+        auto count = static_cast<std::size_t>(std::distance(agent_range.first, agent_range.second));
+        if (count == 0)
+            return std::nullopt;
+
+        auto index = std::uniform_int_distribution<std::size_t>(0, count - 1)(rng);
+        return std::next(agent_range.first, static_cast<std::ptrdiff_t>(index))->second;
+    }
+
+    template<typename URBG>
+    std::optional<AgentID> Grid1D::random_other_agent_at(
+            const GridCoord1D& coord,
+            const AgentID agent_id,
+            URBG& rng
+    ) const {
+        if (!is_location_valid(coord))
+            throw error::LocationInvalid("Coordinates " + coord.to_string() + " are invalid");
+
+        auto agent_range = _agent_grid->equal_range(coord);
+        std::size_t count = 0;
+        for (auto i = agent_range.first; i != agent_range.second; i++)
+            if (i->second != agent_id)
+                count++;
+        if (count == 0)
+            return std::nullopt;
+
+        auto index = std::uniform_int_distribution<std::size_t>(0, count - 1)(rng);
+        for (auto i = agent_range.first; i != agent_range.second; i++)
+            if (i->second != agent_id && index-- == 0)
+                return i->second;
+        return std::nullopt;
+    }
+
+    template<typename Offsets, typename Visitor>
+    bool Grid1D::visit_stencil(
+            const GridCoord1D& coord,
+            const bool include_center,
+            const int radius,
+            const Offsets& offsets,
+            Visitor& visitor
+    ) const {
+        const auto x = coord.x();
+        const auto maximum_x = static_cast<int>(_maximum_x);
+
+        // Interior cells need neither wrapping nor validity checks
+        if (is_interior(coord, radius)) {
+            for (const auto& offset : offsets) {
+                if (!include_center && offset.dx == 0)
+                    continue;
+                if (!stencil::visit(visitor, GridCoord1D(x + offset.dx)))
+                    return false;
+            }
+            return true;
+        }
+
+        for (const auto& offset : offsets) {
+            if (!include_center && offset.dx == 0)
+                continue;
+
+            auto new_x = x + offset.dx;
+            if (_wrap_x)
+                new_x = stencil::wrap(new_x, maximum_x);
+            if (new_x < 0 || new_x >= maximum_x)
+                continue;
+            if (!stencil::visit(visitor, GridCoord1D(new_x)))
+                return false;
+        }
+        return true;
+    }
+
+    template<typename Visitor>
+    bool Grid1D::for_each_agent_in_neighborhood(
+            const GridCoord1D& coord,
+            const bool include_center,
+            const unsigned int radius,
+            Visitor&& visitor
+    ) const {
+        return for_each_neighbor(coord, include_center, radius, [this, &visitor](const GridCoord1D& cell) {
+            auto agent_range = _agent_grid->equal_range(cell);
+
+            for (auto i = agent_range.first; i != agent_range.second; i++)
+                if (!stencil::visit(visitor, i->second))
+                    return false;
+            return true;
+        });
+    }
+
+    template<typename Filter, typename Visitor>
+    bool Grid1D::for_each_agent_in_neighborhood(
+            const GridCoord1D& coord,
+            const bool include_center,
+            const unsigned int radius,
+            Filter&& filter,
+            Visitor&& visitor
+    ) const {
+        return for_each_agent_in_neighborhood(coord, include_center, radius,
+                                              [&filter, &visitor](const AgentID agent_id) {
+                                                  return !filter(agent_id) || stencil::visit(visitor, agent_id);
+                                              });
+    }
+
+}  // namespace kami
+
 #endif  // KAMI_GRID1D_H
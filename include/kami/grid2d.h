@@ -30,18 +30,27 @@
 //! @endcond
 
 #include <cmath>
+#include <cstddef>
 #include <cstdlib>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <optional>
+#include <random>
 #include <set>
+#include <span>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include <kami/agent.h>
+#include <kami/agentindex.h>
 #include <kami/domain.h>
+#include <kami/error.h>
 #include <kami/grid.h>
 #include <kami/kami.h>
+#include <kami/stencil.h>
 
 namespace kami {
 
@@ -116,6 +125,51 @@ namespace kami {
                 GridDistanceType distance_type = GridDistanceType::Euclidean
         ) const;
 
+        /**
+         * @brief Find the distance between two points
+         *
+         * @details As with the other forms, the direct path is measured,
+         * without accounting for any toroidal wrapping of the underlying
+         * `Grid2D`.
+         *
+         * @param p the point to measure the distance to
+         * @param distance_type specify the distance type
+         *
+         * @returns the distance as a `double`
+         *
+         * @see `Grid2D::distance()`
+         */
+        [[nodiscard]] double distance(
+                const GridCoord2D& p,
+                GridDistanceType distance_type = GridDistanceType::Euclidean
+        ) const;
+
+        /**
+         * @brief Find the distances from this point to many points
+         *
+         * @details The points are given as two parallel arrays of
+         * coordinates.  The metric is chosen once for the whole batch, and
+         * the distances are found in a single loop without branches, which
+         * the compiler vectorizes.  The direct path is measured, without
+         * accounting for any toroidal wrapping.
+         *
+         * @param x the coordinates of the points in the first dimension
+         * @param y the coordinates of the points in the second dimension,
+         * as many as in `x`
+         * @param distances the distance to each point, as long as `x`
+         * @param distance_type specify the distance type
+         *
+         * @throws error::OptionInvalid if the arrays differ in length.
+         *
+         * @see `Grid2D::get_distances()`
+         */
+        void distance(
+                std::span<const int> x,
+                std::span<const int> y,
+                std::span<double> distances,
+                GridDistanceType distance_type = GridDistanceType::Euclidean
+        ) const;
+
         /**
          * @brief Test if two coordinates are equal
          */
@@ -178,36 +232,32 @@ namespace kami {
                 const GridCoord2D& rhs
         );
 
-    protected:
+    private:
+        int _x_coord, _y_coord;
+    };
+
+    /**
+     * @brief An intended move of an agent on a two-dimensional grid
+     *
+     * @see `Grid2D::move_agents()`
+     */
+    struct LIBKAMI_EXPORT GridMove2D {
         /**
-         * @brief Find the distance between two points using the Chebyshev metric
-         *
-         * @param p the point to measure the distance to
-         *
-         * @returns the distance as a `double`
+         * @brief The `AgentID` of the agent to move
          */
-        inline double distance_chebyshev(std::shared_ptr<GridCoord2D>& p) const;
+        AgentID agent_id;
 
         /**
-         * @brief Find the distance between two points using the Euclidean metric
-         *
-         * @param p the point to measure the distance to
-         *
-         * @returns the distance as a `double`
+         * @brief The coordinates of the destination
          */
-        inline double distance_euclidean(std::shared_ptr<GridCoord2D>& p) const;
+        GridCoord2D coord;
 
         /**
-         * @brief Find the distance between two points using the Manhattan metric
-         *
-         * @param p the point to measure the distance to
+         * @brief The priority of the move, used to settle competing claims
          *
-         * @returns the distance as a `double`
+         * @see `GridConflictPolicy::Priority`
          */
-        inline double distance_manhattan(std::shared_ptr<GridCoord2D>& p) const;
-
-    private:
-        int _x_coord, _y_coord;
+        double priority = 0.0;
     };
 
     /**
@@ -269,10 +319,10 @@ namespace kami {
          *
          * @returns false if the agent is not removed, otherwise, true.
          */
-        AgentID delete_agent(
+        virtual AgentID delete_agent(
                 AgentID agent_id,
                 const GridCoord2D& coord
-        );
+        ) = 0;
 
         /**
          * @brief Move an agent to the specified location.
@@ -280,11 +330,24 @@ namespace kami {
          * @param[in] agent_id the `AgentID` of the agent to move.
          * @param[in] coord the coordinates of the agent.
          */
-        AgentID move_agent(
+        virtual AgentID move_agent(
                 AgentID agent_id,
                 const GridCoord2D& coord
         );
 
+        /**
+         * @brief Move many agents at once.
+         *
+         * @details Every move is checked before any is made, so if an
+         * agent is not on the grid, appears twice, or has an invalid
+         * destination, an exception is thrown and the grid is unchanged.
+         *
+         * @param[in] moves the moves to make.
+         *
+         * @returns the `AgentID`s of the agents moved, in the order given
+         */
+        virtual std::unique_ptr<std::vector<AgentID>> move_agents(const std::vector<GridMove2D>& moves);
+
         /**
          * @brief Inquire if the specified location is empty.
          *
@@ -293,7 +356,7 @@ namespace kami {
          * @return true if the location has no `Agent`s occupying it, false
          * otherwise.
          */
-        [[nodiscard]] bool is_location_empty(const GridCoord2D& coord) const;
+        [[nodiscard]] virtual bool is_location_empty(const GridCoord2D& coord) const = 0;
 
         /**
          * @brief Inquire if the specified location is valid within the grid.
@@ -323,8 +386,22 @@ namespace kami {
          * to that object will update the state of the gird.  Further, the pointer
          * should not be deleted when no longer used.
          */
-        [[nodiscard]] std::shared_ptr<std::set<AgentID>>
-        get_location_contents(const GridCoord2D& coord) const;
+        [[nodiscard]] virtual std::shared_ptr<std::set<AgentID>>
+        get_location_contents(const GridCoord2D& coord) const = 0;
+
+        /**
+         * @brief Get a view of the contents of the specified location.
+         *
+         * @details Unlike `get_location_contents()`, this does not copy
+         * or allocate.  The view is into the grid's own storage and is
+         * only valid until the grid is next modified.  The order of the
+         * agents within the view is unspecified.
+         *
+         * @param[in] coord the coordinates of a valid location.
+         *
+         * @return a span of the `AgentID`s at the location.
+         */
+        [[nodiscard]] virtual std::span<const AgentID> get_location_view(const GridCoord2D& coord) const = 0;
 
         /**
          * @brief Inquire to whether the grid wraps in the `x` dimension.
@@ -380,6 +457,245 @@ namespace kami {
                 GridNeighborhoodType neighborhood_type
         ) const;
 
+        /**
+         * @brief Visit each cell in the neighborhood of the specified location
+         *
+         * @details Neighbors are visited in row-major scan order using
+         * stencils fixed at compile time, and nothing is allocated.  Cells
+         * away from the edges of the grid skip wrapping and validity checks
+         * entirely.  Off-grid neighbors of cells on an unwrapped edge are
+         * not visited.  On a wrapped grid with fewer than three cells in a
+         * dimension, the same cell may be visited more than once.
+         *
+         * @param[in] coord the coordinates of the specified location.
+         * @param[in] include_center should the center-point be visited.
+         * @param[in] neighborhood_type the neighborhood type.
+         * @param[in] visitor a callable taking a `const GridCoord2D&`.  If it
+         * returns `bool`, returning false ends the visit.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         *
+         * @see `NeighborhoodType`
+         */
+        template<typename Visitor>
+        bool for_each_neighbor(
+                const GridCoord2D& coord,
+                bool include_center,
+                GridNeighborhoodType neighborhood_type,
+                Visitor&& visitor
+        ) const;
+
+        /**
+         * @brief Visit each cell within a radius of the specified location
+         *
+         * @details Cells are visited in row-major scan order.  Stencils up
+         * to `stencil::max_static_radius` are fixed at compile time; larger
+         * ones are generated once and cached.  Cells at least `radius` from
+         * the edges of the grid skip wrapping and validity checks entirely.
+         * On a wrapped grid with fewer than `2 * radius + 1` cells in a
+         * dimension, the same cell may be visited more than once.
+         *
+         * @param[in] coord the coordinates of the specified location.
+         * @param[in] include_center should the center-point be visited.
+         * @param[in] neighborhood_type the neighborhood type.
+         * @param[in] radius the radius of the neighborhood.
+         * @param[in] visitor a callable taking a `const GridCoord2D&`.  If it
+         * returns `bool`, returning false ends the visit.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         *
+         * @see `NeighborhoodType`
+         */
+        template<typename Visitor>
+        bool for_each_neighbor(
+                const GridCoord2D& coord,
+                bool include_center,
+                GridNeighborhoodType neighborhood_type,
+                unsigned int radius,
+                Visitor&& visitor
+        ) const;
+
+        /**
+         * @brief Visit each agent in the neighborhood of the specified location
+         *
+         * @details This fuses `for_each_neighbor()` and
+         * `get_location_view()`: cell storage is scanned directly, and no
+         * containers are built.  Cells are visited in row-major scan order;
+         * the order of agents within a cell is unspecified.  The grid must
+         * not be modified during the visit.
+         *
+         * @param[in] coord the coordinates of the specified location.
+         * @param[in] include_center should agents at the center-point be
+         * visited.
+         * @param[in] neighborhood_type the neighborhood type.
+         * @param[in] radius the radius of the neighborhood.
+         * @param[in] visitor a callable taking an `AgentID`.  If it returns
+         * `bool`, returning false ends the visit.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         */
+        template<typename Visitor>
+        bool for_each_agent_in_neighborhood(
+                const GridCoord2D& coord,
+                bool include_center,
+                GridNeighborhoodType neighborhood_type,
+                unsigned int radius,
+                Visitor&& visitor
+        ) const;
+
+        /**
+         * @brief Visit each matching agent in the neighborhood of the specified
+         * location
+         *
+         * @param[in] coord the coordinates of the specified location.
+         * @param[in] include_center should agents at the center-point be
+         * visited.
+         * @param[in] neighborhood_type the neighborhood type.
+         * @param[in] radius the radius of the neighborhood.
+         * @param[in] filter a predicate taking an `AgentID`; only agents for
+         * which it returns true are visited.
+         * @param[in] visitor a callable taking an `AgentID`.  If it returns
+         * `bool`, returning false ends the visit.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         */
+        template<typename Filter, typename Visitor>
+        bool for_each_agent_in_neighborhood(
+                const GridCoord2D& coord,
+                bool include_center,
+                GridNeighborhoodType neighborhood_type,
+                unsigned int radius,
+                Filter&& filter,
+                Visitor&& visitor
+        ) const;
+
+        /**
+         * @brief Choose a random cell in the neighborhood of the specified
+         * location
+         *
+         * @details Each cell of the neighborhood is equally likely.  Away
+         * from the edges of the grid, this is a single draw from the
+         * stencil.  Near an unwrapped edge, where some of the stencil is off
+         * the grid, the cells on the grid are counted first.  Nothing is
+         * allocated.
+         *
+         * @param[in] coord the coordinates of the specified location.
+         * @param[in] include_center may the center-point be chosen.
+         * @param[in] neighborhood_type the neighborhood type.
+         * @param[in] rng a uniform random bit generator.
+         *
+         * @return the chosen cell, or nothing if the neighborhood is empty.
+         */
+        template<typename URBG>
+        std::optional<GridCoord2D> random_neighbor_cell(
+                const GridCoord2D& coord,
+                bool include_center,
+                GridNeighborhoodType neighborhood_type,
+                URBG& rng
+        ) const;
+
+        /**
+         * @brief Choose a random cell within a radius of the specified location
+         *
+         * @param[in] coord the coordinates of the specified location.
+         * @param[in] include_center may the center-point be chosen.
+         * @param[in] neighborhood_type the neighborhood type.
+         * @param[in] radius the radius of the neighborhood.
+         * @param[in] rng a uniform random bit generator.
+         *
+         * @return the chosen cell, or nothing if the neighborhood is empty.
+         */
+        template<typename URBG>
+        std::optional<GridCoord2D> random_neighbor_cell(
+                const GridCoord2D& coord,
+                bool include_center,
+                GridNeighborhoodType neighborhood_type,
+                unsigned int radius,
+                URBG& rng
+        ) const;
+
+        /**
+         * @brief Choose a random agent at the specified location
+         *
+         * @details This is a single draw from the cell's storage.
+         *
+         * @param[in] coord the coordinates of the specified location.
+         * @param[in] rng a uniform random bit generator.
+         *
+         * @return the `AgentID` of the chosen agent, or nothing if the
+         * location is empty.
+         */
+        template<typename URBG>
+        std::optional<AgentID> random_agent_at(
+                const GridCoord2D& coord,
+                URBG& rng
+        ) const;
+
+        /**
+         * @brief Choose a random agent at the specified location, other than
+         * the one given
+         *
+         * @details Draws are repeated only when the excluded agent is
+         * drawn, so at most two draws are expected.
+         *
+         * @param[in] coord the coordinates of the specified location.
+         * @param[in] agent_id the `AgentID` of the agent to exclude.
+         * @param[in] rng a uniform random bit generator.
+         *
+         * @return the `AgentID` of the chosen agent, or nothing if there is
+         * no other agent at the location.
+         */
+        template<typename URBG>
+        std::optional<AgentID> random_other_agent_at(
+                const GridCoord2D& coord,
+                AgentID agent_id,
+                URBG& rng
+        ) const;
+
+        /**
+         * @brief Find the distance between two points on the grid
+         *
+         * @details Unlike `GridCoord2D::distance()`, the shorter way around
+         * is taken in each dimension that wraps.
+         *
+         * @param[in] p the first point.
+         * @param[in] q the second point.
+         * @param[in] distance_type specify the distance type.
+         *
+         * @return the distance as a `double`
+         */
+        [[nodiscard]] double distance(
+                const GridCoord2D& p,
+                const GridCoord2D& q,
+                GridDistanceType distance_type = GridDistanceType::Euclidean
+        ) const;
+
+        /**
+         * @brief Find the distances from one point to many on the grid
+         *
+         * @details The points are given as two parallel arrays of
+         * coordinates, which must lie on the grid.  The shorter way around
+         * is taken in each dimension that wraps.  As with
+         * `GridCoord2D::distance()`, the batch is measured in a single loop
+         * without branches, which the compiler vectorizes.
+         *
+         * @param[in] origin the point to measure from.
+         * @param[in] x the coordinates of the points in the first dimension.
+         * @param[in] y the coordinates of the points in the second
+         * dimension, as many as in `x`.
+         * @param[out] distances the distance to each point, as long as `x`.
+         * @param[in] distance_type specify the distance type.
+         *
+         * @throws error::OptionInvalid if the arrays differ in length.
+         */
+        void get_distances(
+                const GridCoord2D& origin,
+                std::span<const int> x,
+                std::span<const int> y,
+                std::span<double> distances,
+                GridDistanceType distance_type = GridDistanceType::Euclidean
+        ) const;
+
         /**
          * @brief Get the size of the grid in the `x` dimension.
          *
@@ -418,15 +734,11 @@ namespace kami {
                 GridCoord2D(-1, 0), GridCoord2D(-1, 1)};
 
         /**
-         * @brief  A map containing the `AgentID`s of all agents assigned to this
-         * grid.
-         */
-        std::unique_ptr<std::unordered_multimap<GridCoord2D, AgentID>> _agent_grid;
-
-        /**
-         * @brief A map containing the grid location of each agent.
+         * @brief The cell offset of each agent, keyed by `AgentID`
+         *
+         * @see `coord_index()`
          */
-        std::unique_ptr<std::map<AgentID, GridCoord2D>> _agent_index;
+        AgentIndex<std::size_t> _agent_index;
 
         /**
          * @brief Automatically adjust a coordinate location for wrapping.
@@ -437,11 +749,262 @@ namespace kami {
          */
         [[nodiscard]] GridCoord2D coord_wrap(const GridCoord2D& coord) const;
 
+        /**
+         * @brief Get the offset of a cell in row-major order
+         *
+         * @details This is the index of the cell in dense per-cell
+         * storage of `get_maximum_x() * get_maximum_y()` elements.
+         *
+         * @param[in] coord the coordinates of a valid location.
+         *
+         * @return the offset of the cell
+         */
+        [[nodiscard]] inline std::size_t coord_index(const GridCoord2D& coord) const {
+            return static_cast<std::size_t>(coord.y()) * _maximum_x + static_cast<std::size_t>(coord.x());
+        }
+
+        /**
+         * @brief Get the coordinates of a cell from its row-major offset
+         *
+         * @param[in] index the offset of the cell.
+         *
+         * @return the coordinates of the cell
+         *
+         * @see `coord_index()`
+         */
+        [[nodiscard]] inline GridCoord2D index_coord(const std::size_t index) const {
+            return {static_cast<int>(index % _maximum_x), static_cast<int>(index / _maximum_x)};
+        }
+
+        /**
+         * @brief Inquire if a stencil centered on a location lies wholly on
+         * the grid
+         *
+         * @param[in] coord the coordinates of the center.
+         * @param[in] radius the largest offset in the stencil.
+         *
+         * @return true if no cell of the stencil needs wrapping or checking
+         */
+        [[nodiscard]] inline bool is_interior(
+                const GridCoord2D& coord,
+                int radius
+        ) const {
+            return coord.x() >= radius && coord.x() < static_cast<int>(_maximum_x) - radius &&
+                   coord.y() >= radius && coord.y() < static_cast<int>(_maximum_y) - radius;
+        }
+
+        /**
+         * @brief Visit each cell of a stencil centered on a location
+         *
+         * @param[in] coord the coordinates of the center.
+         * @param[in] include_center should the center-point be visited.
+         * @param[in] radius the largest offset in the stencil.
+         * @param[in] offsets the stencil.
+         * @param[in] visitor the visitor.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         */
+        template<typename Offsets, typename Visitor>
+        bool visit_stencil(
+                const GridCoord2D& coord,
+                bool include_center,
+                int radius,
+                const Offsets& offsets,
+                Visitor& visitor
+        ) const;
+
     private:
         unsigned int _maximum_x, _maximum_y;
         bool _wrap_x, _wrap_y;
     };
 
+    template<typename Visitor>
+    bool Grid2D::for_each_neighbor(
+            const GridCoord2D& coord,
+            const bool include_center,
+            const GridNeighborhoodType neighborhood_type,
+            Visitor&& visitor
+    ) const {
+        return for_each_neighbor(coord, include_center, neighborhood_type, 1, visitor);
+    }
+
+    template<typename Visitor>
+    bool Grid2D::for_each_neighbor(
+            const GridCoord2D& coord,
+            const bool include_center,
+            const GridNeighborhoodType neighborhood_type,
+            const unsigned int radius,
+            Visitor&& visitor
+    ) const {
+        return stencil::with_2d(neighborhood_type, radius, [&](const auto& offsets) {
+            return visit_stencil(coord, include_center, static_cast<int>(radius), offsets, visitor);
+        });
+    }
+
+    template<typename Visitor>
+    bool Grid2D::for_each_agent_in_neighborhood(
+            const GridCoord2D& coord,
+            const bool include_center,
+            const GridNeighborhoodType neighborhood_type,
+            const unsigned int radius,
+            Visitor&& visitor
+    ) const {
+        return for_each_neighbor(coord, include_center, neighborhood_type, radius,
+                                 [this, &visitor](const GridCoord2D& cell) {
+                                     for (auto agent_id : get_location_view(cell))
+                                         if (!stencil::visit(visitor, agent_id))
+                                             return false;
+                                     return true;
+                                 });
+    }
+
+    template<typename Filter, typename Visitor>
+    bool Grid2D::for_each_agent_in_neighborhood(
+            const GridCoord2D& coord,
+            const bool include_center,
+            const GridNeighborhoodType neighborhood_type,
+            const unsigned int radius,
+            Filter&& filter,
+            Visitor&& visitor
+    ) const {
+        return for_each_agent_in_neighborhood(coord, include_center, neighborhood_type, radius,
+                                              [&filter, &visitor](const AgentID agent_id) {
+                                                  return !filter(agent_id) || stencil::visit(visitor, agent_id);
+                                              });
+    }
+
+    template<typename URBG>
+    std::optional<GridCoord2D> Grid2D::random_neighbor_cell(
+            const GridCoord2D& coord,
+            const bool include_center,
+            const GridNeighborhoodType neighborhood_type,
+            URBG& rng
+    ) const {
+        return random_neighbor_cell(coord, include_center, neighborhood_type, 1, rng);
+    }
+
+    template<typename URBG>
+    std::optional<GridCoord2D> Grid2D::random_neighbor_cell(
+            const GridCoord2D& coord,
+            const bool include_center,
+            const GridNeighborhoodType neighborhood_type,
+            const unsigned int radius,
+            URBG& rng
+    ) const {
+        return stencil::with_2d(neighborhood_type, radius, [&](const auto& offsets) -> std::optional<GridCoord2D> {
+            const auto r = static_cast<int>(radius);
+
+            if (is_interior(coord, r)) {
+                // Stencils are symmetric, so the center is in the middle
+                const auto center = offsets.size() / 2;
+                const auto count = include_center ? offsets.size() : offsets.size() - 1;
+                if (count == 0)
+                    return std::nullopt;
+
+                auto index = std::uniform_int_distribution<std::size_t>(0, count - 1)(rng);
+                if (!include_center && index >= center)
+                    index++;
+                return GridCoord2D(coord.x() + offsets[index].dx, coord.y() + offsets[index].dy);
+            }
+
+            std::size_t count = 0;
+            auto counter = [&count](const GridCoord2D&) {
+                count++;
+            };
+            visit_stencil(coord, include_center, r, offsets, counter);
+            if (count == 0)
+                return std::nullopt;
+
+            auto index = std::uniform_int_distribution<std::size_t>(0, count - 1)(rng);
+            std::optional<GridCoord2D> chosen;
+            auto chooser = [&index, &chosen](const GridCoord2D& cell) {
+                if (index-- > 0)
+                    return true;
+                chosen = cell;
+                return false;
+            };
+            visit_stencil(coord, include_center, r, offsets, chooser);
+            return chosen;
+        });
+    }
+
+    template<typename URBG>
+    std::optional<AgentID> Grid2D::random_agent_at(
+            const GridCoord2D& coord,
+            URBG& rng
+    ) const {
+        if (!is_location_valid(coord))
+            throw error::LocationInvalid("Coordinates " + coord.to_string() + " are invalid");
+
+        auto agent_ids = get_location_view(coord);
+        if (agent_ids.empty())
+            return std::nullopt;
+        return agent_ids[std::uniform_int_distribution<std::size_t>(0, agent_ids.size() - 1)(rng)];
+    }
+
+    template<typename URBG>
+    std::optional<AgentID> Grid2D::random_other_agent_at(
+            const GridCoord2D& coord,
+            const AgentID agent_id,
+            URBG& rng
+    ) const {
+        if (!is_location_valid(coord))
+            throw error::LocationInvalid("Coordinates " + coord.to_string() + " are invalid");
+
+        auto agent_ids = get_location_view(coord);
+        if (agent_ids.empty() || (agent_ids.size() == 1 && agent_ids[0] == agent_id))
+            return std::nullopt;
+
+        std::uniform_int_distribution<std::size_t> dist(0, agent_ids.size() - 1);
+        while (true) {
+            auto other_agent_id = agent_ids[dist(rng)];
+            if (other_agent_id != agent_id)
+                return other_agent_id;
+        }
+    }
+
+    template<typename Offsets, typename Visitor>
+    bool Grid2D::visit_stencil(
+            const GridCoord2D& coord,
+            const bool include_center,
+            const int radius,
+            const Offsets& offsets,
+            Visitor& visitor
+    ) const {
+        const auto x = coord.x();
+        const auto y = coord.y();
+        const auto maximum_x = static_cast<int>(_maximum_x);
+        const auto maximum_y = static_cast<int>(_maximum_y);
+
+        // Interior cells need neither wrapping nor validity checks
+        if (is_interior(coord, radius)) {
+            for (const auto& offset : offsets) {
+                if (!include_center && offset.dx == 0 && offset.dy == 0)
+                    continue;
+                if (!stencil::visit(visitor, GridCoord2D(x + offset.dx, y + offset.dy)))
+                    return false;
+            }
+            return true;
+        }
+
+        for (const auto& offset : offsets) {
+            if (!include_center && offset.dx == 0 && offset.dy == 0)
+                continue;
+
+            auto new_x = x + offset.dx;
+            auto new_y = y + offset.dy;
+            if (_wrap_x)
+                new_x = stencil::wrap(new_x, maximum_x);
+            if (_wrap_y)
+                new_y = stencil::wrap(new_y, maximum_y);
+            if (new_x < 0 || new_x >= maximum_x || new_y < 0 || new_y >= maximum_y)
+                continue;
+            if (!stencil::visit(visitor, GridCoord2D(new_x, new_y)))
+                return false;
+        }
+        return true;
+    }
+
 }  // namespace kami
 
 //! @cond SuppressHashMethod
@@ -0,0 +1,723 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef KAMI_GRID3D_H
+//! @cond SuppressGuard
+#define KAMI_GRID3D_H
+//! @endcond
+
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <span>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <kami/agent.h>
+#include <kami/agentindex.h>
+#include <kami/domain.h>
+#include <kami/error.h>
+#include <kami/grid.h>
+#include <kami/kami.h>
+#include <kami/stencil.h>
+
+namespace kami {
+
+    /**
+     * @brief Three-dimensional coordinates
+     */
+    class LIBKAMI_EXPORT GridCoord3D
+            : public GridCoord {
+    public:
+        /**
+         * @brief Constructor for three-dimensional coordinates
+         */
+        GridCoord3D(
+                int x_coord,
+                int y_coord,
+                int z_coord
+        );
+
+        /**
+         * @brief Get the coordinate in the first dimension or `x`.
+         */
+        [[nodiscard]] int x() const;
+
+        /**
+         * @brief Get the coordinate in the second dimension or `y`.
+         */
+        [[nodiscard]] int y() const;
+
+        /**
+         * @brief Get the coordinate in the third dimension or `z`.
+         */
+        [[nodiscard]] int z() const;
+
+        /**
+         * @brief Convert the coordinate to a human-readable string.
+         *
+         * @return a human-readable form of the `Coord` as `std::string`.
+         */
+        [[nodiscard]] std::string to_string() const override;
+
+        /**
+         * @brief Find the distance between two points
+         *
+         * @details Find the distance between two points using the
+         * Euclidean metric, without accounting for any wrapping of the
+         * underlying `Grid3D`.
+         *
+         * @param p the point to measure the distance to
+         *
+         * @returns the distance as a `double`
+         */
+        double distance(std::shared_ptr<Coord>& p) const override;
+
+        /**
+         * @brief Find the distance between two points
+         *
+         * @details Find the distance between two points using the
+         * specified metric, without accounting for any wrapping of the
+         * underlying `Grid3D`.
+         *
+         * @param p the point to measure the distance to
+         * @param distance_type specify the distance type
+         *
+         * @returns the distance as a `double`
+         */
+        double distance(
+                std::shared_ptr<GridCoord3D>& p,
+                GridDistanceType distance_type = GridDistanceType::Euclidean
+        ) const;
+
+        /**
+         * @brief Test if two coordinates are equal
+         */
+        friend bool operator==(
+                const GridCoord3D&,
+                const GridCoord3D&
+        );
+
+        /**
+         * @brief Test if two coordinates are not equal
+         */
+        friend bool operator!=(
+                const GridCoord3D&,
+                const GridCoord3D&
+        );
+
+        /**
+         * @brief Output a given coordinate to the specified stream
+         */
+        friend std::ostream& operator<<(
+                std::ostream&,
+                const GridCoord3D&
+        );
+
+        /**
+         * @brief Add two coordinates together
+         */
+        friend GridCoord3D operator+(
+                const GridCoord3D& lhs,
+                const GridCoord3D& rhs
+        );
+
+        /**
+         * @brief Subtract one coordinate from another
+         */
+        friend GridCoord3D operator-(
+                const GridCoord3D& lhs,
+                const GridCoord3D& rhs
+        );
+
+        /**
+         * @brief Multiply a coordinate by a scalar
+         *
+         * @details If any component of the resulting value is not a whole number, it is
+         * truncated following the same rules as `int`.
+         */
+        friend GridCoord3D operator*(
+                const GridCoord3D& lhs,
+                double rhs
+        );
+
+        /**
+         * @brief Multiply a coordinate by a scalar
+         *
+         * @details If any component of the resulting value is not a whole number, it is
+         * truncated following the same rules as `int`.
+         */
+        friend GridCoord3D operator*(
+                double lhs,
+                const GridCoord3D& rhs
+        );
+
+    private:
+        int _x_coord, _y_coord, _z_coord;
+    };
+
+    /**
+     * @brief A three-dimensional grid where each cell may contain agents
+     *
+     * @details The grid may wrap around in any dimension.  Per-cell storage
+     * in subclasses is laid out in bricks of `brick_size` cells on a side,
+     * each brick contiguous in memory, so that the cells of a neighborhood
+     * share a few cache lines rather than lying whole planes apart.  Grids
+     * whose lengths are not multiples of `brick_size` are padded up to the
+     * next brick.
+     *
+     * @see `MultiGrid3D`
+     * @see `SoloGrid3D`
+     */
+    class LIBKAMI_EXPORT Grid3D
+            : public GridDomain {
+    public:
+        /**
+         * @brief The length of a side of a storage brick, in cells
+         */
+        static constexpr unsigned int brick_size = 4;
+
+        /**
+         * @brief Constructor
+         *
+         * @param[in] maximum_x the length of the grid in the first dimension
+         * @param[in] maximum_y the length of the grid in the second dimension
+         * @param[in] maximum_z the length of the grid in the third dimension
+         * @param[in] wrap_x should the grid wrap around on itself in the first
+         * dimension
+         * @param[in] wrap_y should the grid wrap around on itself in the second
+         * dimension
+         * @param[in] wrap_z should the grid wrap around on itself in the third
+         * dimension
+         */
+        explicit Grid3D(
+                unsigned int maximum_x,
+                unsigned int maximum_y,
+                unsigned int maximum_z,
+                bool wrap_x = false,
+                bool wrap_y = false,
+                bool wrap_z = false
+        );
+
+        /**
+         * @brief Place agent on the grid at the specified location.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to add.
+         * @param[in] coord the coordinates of the agent.
+         *
+         * @returns the `AgentID` of the agent placed
+         */
+        virtual AgentID add_agent(
+                AgentID agent_id,
+                const GridCoord3D& coord
+        ) = 0;
+
+        /**
+         * @brief Remove agent from the grid.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to remove.
+         *
+         * @returns the `AgentID` of the agent removed
+         */
+        AgentID delete_agent(AgentID agent_id);
+
+        /**
+         * @brief Remove agent from the grid at the specified location
+         *
+         * @param[in] agent_id the `AgentID` of the agent to remove.
+         * @param[in] coord the coordinates of the agent.
+         *
+         * @returns the `AgentID` of the agent removed
+         */
+        virtual AgentID delete_agent(
+                AgentID agent_id,
+                const GridCoord3D& coord
+        ) = 0;
+
+        /**
+         * @brief Move an agent to the specified location.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to move.
+         * @param[in] coord the coordinates of the destination.
+         *
+         * @returns the `AgentID` of the agent moved
+         */
+        virtual AgentID move_agent(
+                AgentID agent_id,
+                const GridCoord3D& coord
+        ) = 0;
+
+        /**
+         * @brief Inquire if the specified location is empty.
+         *
+         * @param[in] coord the coordinates of the query.
+         *
+         * @return true if the location has no `Agent`s occupying it, false
+         * otherwise.
+         */
+        [[nodiscard]] virtual bool is_location_empty(const GridCoord3D& coord) const = 0;
+
+        /**
+         * @brief Inquire if the specified location is valid within the grid.
+         *
+         * @param[in] coord the coordinates of the query.
+         *
+         * @return true if the location specified is valid, false otherwise.
+         */
+        [[nodiscard]] bool is_location_valid(const GridCoord3D& coord) const;
+
+        /**
+         * @brief Get the location of the specified agent.
+         *
+         * @param[in] agent_id the `AgentID` of the agent in question.
+         *
+         * @return the location of the specified `Agent`
+         */
+        [[nodiscard]] GridCoord3D get_location_by_agent(const AgentID& agent_id) const;
+
+        /**
+         * @brief Get the contents of the specified location.
+         *
+         * @param[in] coord the coordinates of the query.
+         *
+         * @return a pointer to a `set` of `AgentID`s.
+         */
+        [[nodiscard]] virtual std::shared_ptr<std::set<AgentID>>
+        get_location_contents(const GridCoord3D& coord) const = 0;
+
+        /**
+         * @brief Get a view of the contents of the specified location.
+         *
+         * @details The view is into the grid's own storage and is only
+         * valid until the grid is next modified.  The order of the agents
+         * within the view is unspecified.
+         *
+         * @param[in] coord the coordinates of a valid location.
+         *
+         * @return a span of the `AgentID`s at the location.
+         */
+        [[nodiscard]] virtual std::span<const AgentID> get_location_view(const GridCoord3D& coord) const = 0;
+
+        /**
+         * @brief Inquire to whether the grid wraps in the `x` dimension.
+         */
+        [[nodiscard]] bool get_wrap_x() const;
+
+        /**
+         * @brief Inquire to whether the grid wraps in the `y` dimension.
+         */
+        [[nodiscard]] bool get_wrap_y() const;
+
+        /**
+         * @brief Inquire to whether the grid wraps in the `z` dimension.
+         */
+        [[nodiscard]] bool get_wrap_z() const;
+
+        /**
+         * @brief Get the size of the grid in the `x` dimension.
+         */
+        [[nodiscard]] unsigned int get_maximum_x() const;
+
+        /**
+         * @brief Get the size of the grid in the `y` dimension.
+         */
+        [[nodiscard]] unsigned int get_maximum_y() const;
+
+        /**
+         * @brief Get the size of the grid in the `z` dimension.
+         */
+        [[nodiscard]] unsigned int get_maximum_z() const;
+
+        /**
+         * @brief Return the neighborhood of the specified Agent
+         *
+         * @param[in] agent_id the `AgentID` of the agent in question.
+         * @param[in] include_center should the center-point, occupied by the agent,
+         * be in the list.
+         * @param[in] neighborhood_type the neighborhood type.
+         *
+         * @return a set of `GridCoord3D` that includes all of the coordinates
+         * for all adjacent points.
+         */
+        [[nodiscard]] std::shared_ptr<std::unordered_set<GridCoord3D>>
+        get_neighborhood(
+                AgentID agent_id,
+                bool include_center,
+                GridNeighborhoodType neighborhood_type
+        ) const;
+
+        /**
+         * @brief Return the neighborhood of the specified location
+         *
+         * @details On three-dimensional grids, the von Neumann, edge, and
+         * Moore neighborhoods are the 6-, 18-, and 26-neighborhoods.
+         *
+         * @param[in] coord the coordinates of the specified location.
+         * @param[in] include_center should the center-point be in the list.
+         * @param[in] neighborhood_type the neighborhood type.
+         *
+         * @return a set of `GridCoord3D` that includes all of the coordinates
+         * for all adjacent points.
+         */
+        [[nodiscard]] std::shared_ptr<std::unordered_set<GridCoord3D>>
+        get_neighborhood(
+                const GridCoord3D& coord,
+                bool include_center,
+                GridNeighborhoodType neighborhood_type
+        ) const;
+
+        /**
+         * @brief Visit each cell in the neighborhood of the specified location
+         *
+         * @details Neighbors are visited in scan order, by increasing `z`,
+         * `y`, and then `x`, and nothing is allocated.  Cells away from the
+         * edges of the grid skip wrapping and validity checks entirely.
+         * Off-grid neighbors of cells on an unwrapped edge are not visited.
+         *
+         * @param[in] coord the coordinates of the specified location.
+         * @param[in] include_center should the center-point be visited.
+         * @param[in] neighborhood_type the neighborhood type.
+         * @param[in] visitor a callable taking a `const GridCoord3D&`.  If it
+         * returns `bool`, returning false ends the visit.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         */
+        template<typename Visitor>
+        bool for_each_neighbor(
+                const GridCoord3D& coord,
+                bool include_center,
+                GridNeighborhoodType neighborhood_type,
+                Visitor&& visitor
+        ) const;
+
+        /**
+         * @brief Visit each cell within a radius of the specified location
+         *
+         * @param[in] coord the coordinates of the specified location.
+         * @param[in] include_center should the center-point be visited.
+         * @param[in] neighborhood_type the neighborhood type.
+         * @param[in] radius the radius of the neighborhood.
+         * @param[in] visitor a callable taking a `const GridCoord3D&`.  If it
+         * returns `bool`, returning false ends the visit.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         *
+         * @see `stencil::with_3d()`
+         */
+        template<typename Visitor>
+        bool for_each_neighbor(
+                const GridCoord3D& coord,
+                bool include_center,
+                GridNeighborhoodType neighborhood_type,
+                unsigned int radius,
+                Visitor&& visitor
+        ) const;
+
+        /**
+         * @brief Visit each agent in the neighborhood of the specified location
+         *
+         * @details Cell storage is scanned directly, and no containers are
+         * built.  The grid must not be modified during the visit.
+         *
+         * @param[in] coord the coordinates of the specified location.
+         * @param[in] include_center should agents at the center-point be
+         * visited.
+         * @param[in] neighborhood_type the neighborhood type.
+         * @param[in] radius the radius of the neighborhood.
+         * @param[in] visitor a callable taking an `AgentID`.  If it returns
+         * `bool`, returning false ends the visit.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         */
+        template<typename Visitor>
+        bool for_each_agent_in_neighborhood(
+                const GridCoord3D& coord,
+                bool include_center,
+                GridNeighborhoodType neighborhood_type,
+                unsigned int radius,
+                Visitor&& visitor
+        ) const;
+
+        /**
+         * @brief Visit each matching agent in the neighborhood of the specified
+         * location
+         *
+         * @param[in] coord the coordinates of the specified location.
+         * @param[in] include_center should agents at the center-point be
+         * visited.
+         * @param[in] neighborhood_type the neighborhood type.
+         * @param[in] radius the radius of the neighborhood.
+         * @param[in] filter a predicate taking an `AgentID`; only agents for
+         * which it returns true are visited.
+         * @param[in] visitor a callable taking an `AgentID`.  If it returns
+         * `bool`, returning false ends the visit.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         */
+        template<typename Filter, typename Visitor>
+        bool for_each_agent_in_neighborhood(
+                const GridCoord3D& coord,
+                bool include_center,
+                GridNeighborhoodType neighborhood_type,
+                unsigned int radius,
+                Filter&& filter,
+                Visitor&& visitor
+        ) const;
+
+    protected:
+        /**
+         * @brief The cell offset of each agent, keyed by `AgentID`
+         *
+         * @see `coord_index()`
+         */
+        AgentIndex<std::size_t> _agent_index;
+
+        /**
+         * @brief Automatically adjust a coordinate location for wrapping.
+         *
+         * @param[in] coord the coordinates of the specified location.
+         *
+         * @return the adjusted coordinate wrapped if appropriate.
+         */
+        [[nodiscard]] GridCoord3D coord_wrap(const GridCoord3D& coord) const;
+
+        /**
+         * @brief Get the number of cells of per-cell storage
+         *
+         * @details This counts the padding of partial bricks, so it is at
+         * least `get_maximum_x() * get_maximum_y() * get_maximum_z()`.
+         */
+        [[nodiscard]] std::size_t cell_capacity() const;
+
+        /**
+         * @brief Get the offset of a cell in brick order
+         *
+         * @details Bricks are numbered in row-major order, and the cells
+         * within each brick in row-major order after them.
+         *
+         * @param[in] coord the coordinates of a valid location.
+         *
+         * @return the offset of the cell
+         */
+        [[nodiscard]] inline std::size_t coord_index(const GridCoord3D& coord) const {
+            auto x = static_cast<std::size_t>(coord.x());
+            auto y = static_cast<std::size_t>(coord.y());
+            auto z = static_cast<std::size_t>(coord.z());
+            auto brick = ((z >> brick_shift) * _bricks_y + (y >> brick_shift)) * _bricks_x + (x >> brick_shift);
+
+            return (brick << (3 * brick_shift)) |
+                   ((z & brick_mask) << (2 * brick_shift)) |
+                   ((y & brick_mask) << brick_shift) |
+                   (x & brick_mask);
+        }
+
+        /**
+         * @brief Get the coordinates of a cell from its offset
+         *
+         * @param[in] index the offset of the cell.
+         *
+         * @return the coordinates of the cell
+         *
+         * @see `coord_index()`
+         */
+        [[nodiscard]] inline GridCoord3D index_coord(std::size_t index) const {
+            auto brick = index >> (3 * brick_shift);
+            auto brick_x = brick % _bricks_x;
+            auto brick_y = (brick / _bricks_x) % _bricks_y;
+            auto brick_z = brick / _bricks_x / _bricks_y;
+
+            return {static_cast<int>((brick_x << brick_shift) | (index & brick_mask)),
+                    static_cast<int>((brick_y << brick_shift) | ((index >> brick_shift) & brick_mask)),
+                    static_cast<int>((brick_z << brick_shift) | ((index >> (2 * brick_shift)) & brick_mask))};
+        }
+
+        /**
+         * @brief Inquire if a stencil centered on a location lies wholly on
+         * the grid
+         *
+         * @param[in] coord the coordinates of the center.
+         * @param[in] radius the largest offset in the stencil.
+         *
+         * @return true if no cell of the stencil needs wrapping or checking
+         */
+        [[nodiscard]] inline bool is_interior(
+                const GridCoord3D& coord,
+                int radius
+        ) const {
+            return coord.x() >= radius && coord.x() < static_cast<int>(_maximum_x) - radius &&
+                   coord.y() >= radius && coord.y() < static_cast<int>(_maximum_y) - radius &&
+                   coord.z() >= radius && coord.z() < static_cast<int>(_maximum_z) - radius;
+        }
+
+        /**
+         * @brief Visit each cell of a stencil centered on a location
+         *
+         * @param[in] coord the coordinates of the center.
+         * @param[in] include_center should the center-point be visited.
+         * @param[in] radius the largest offset in the stencil.
+         * @param[in] offsets the stencil.
+         * @param[in] visitor the visitor.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         */
+        template<typename Offsets, typename Visitor>
+        bool visit_stencil(
+                const GridCoord3D& coord,
+                bool include_center,
+                int radius,
+                const Offsets& offsets,
+                Visitor& visitor
+        ) const;
+
+    private:
+        static constexpr unsigned int brick_shift = 2;
+        static constexpr std::size_t brick_mask = brick_size - 1;
+        static_assert(brick_size == 1u << brick_shift);
+
+        unsigned int _maximum_x, _maximum_y, _maximum_z;
+        bool _wrap_x, _wrap_y, _wrap_z;
+        std::size_t _bricks_x, _bricks_y, _bricks_z;
+    };
+
+    template<typename Visitor>
+    bool Grid3D::for_each_neighbor(
+            const GridCoord3D& coord,
+            const bool include_center,
+            const GridNeighborhoodType neighborhood_type,
+            Visitor&& visitor
+    ) const {
+        return for_each_neighbor(coord, include_center, neighborhood_type, 1, visitor);
+    }
+
+    template<typename Visitor>
+    bool Grid3D::for_each_neighbor(
+            const GridCoord3D& coord,
+            const bool include_center,
+            const GridNeighborhoodType neighborhood_type,
+            const unsigned int radius,
+            Visitor&& visitor
+    ) const {
+        return stencil::with_3d(neighborhood_type, radius, [&](const auto& offsets) {
+            return visit_stencil(coord, include_center, static_cast<int>(radius), offsets, visitor);
+        });
+    }
+
+    template<typename Visitor>
+    bool Grid3D::for_each_agent_in_neighborhood(
+            const GridCoord3D& coord,
+            const bool include_center,
+            const GridNeighborhoodType neighborhood_type,
+            const unsigned int radius,
+            Visitor&& visitor
+    ) const {
+        return for_each_neighbor(coord, include_center, neighborhood_type, radius,
+                                 [this, &visitor](const GridCoord3D& cell) {
+                                     for (auto agent_id : get_location_view(cell))
+                                         if (!stencil::visit(visitor, agent_id))
+                                             return false;
+                                     return true;
+                                 });
+    }
+
+    template<typename Filter, typename Visitor>
+    bool Grid3D::for_each_agent_in_neighborhood(
+            const GridCoord3D& coord,
+            const bool include_center,
+            const GridNeighborhoodType neighborhood_type,
+            const unsigned int radius,
+            Filter&& filter,
+            Visitor&& visitor
+    ) const {
+        return for_each_agent_in_neighborhood(coord, include_center, neighborhood_type, radius,
+                                              [&filter, &visitor](const AgentID agent_id) {
+                                                  return !filter(agent_id) || stencil::visit(visitor, agent_id);
+                                              });
+    }
+
+    template<typename Offsets, typename Visitor>
+    bool Grid3D::visit_stencil(
+            const GridCoord3D& coord,
+            const bool include_center,
+            const int radius,
+            const Offsets& offsets,
+            Visitor& visitor
+    ) const {
+        const auto x = coord.x();
+        const auto y = coord.y();
+        const auto z = coord.z();
+        const auto maximum_x = static_cast<int>(_maximum_x);
+        const auto maximum_y = static_cast<int>(_maximum_y);
+        const auto maximum_z = static_cast<int>(_maximum_z);
+
+        // Interior cells need neither wrapping nor validity checks
+        if (is_interior(coord, radius)) {
+            for (const auto& offset : offsets) {
+                if (!include_center && offset.dx == 0 && offset.dy == 0 && offset.dz == 0)
+                    continue;
+                if (!stencil::visit(visitor, GridCoord3D(x + offset.dx, y + offset.dy, z + offset.dz)))
+                    return false;
+            }
+            return true;
+        }
+
+        for (const auto& offset : offsets) {
+            if (!include_center && offset.dx == 0 && offset.dy == 0 && offset.dz == 0)
+                continue;
+
+            auto new_x = x + offset.dx;
+            auto new_y = y + offset.dy;
+            auto new_z = z + offset.dz;
+            if (_wrap_x)
+                new_x = stencil::wrap(new_x, maximum_x);
+            if (_wrap_y)
+                new_y = stencil::wrap(new_y, maximum_y);
+            if (_wrap_z)
+                new_z = stencil::wrap(new_z, maximum_z);
+            if (new_x < 0 || new_x >= maximum_x || new_y < 0 || new_y >= maximum_y ||
+                new_z < 0 || new_z >= maximum_z)
+                continue;
+            if (!stencil::visit(visitor, GridCoord3D(new_x, new_y, new_z)))
+                return false;
+        }
+        return true;
+    }
+
+}  // namespace kami
+
+//! @cond SuppressHashMethod
+namespace std {
+    template<>
+    struct hash<kami::GridCoord3D> {
+        size_t operator()(const kami::GridCoord3D& key) const {
+            return ((hash<int>()(key.x()) ^ (hash<int>()(key.y()) << 1)) >> 1) ^ (hash<int>()(key.z()) << 1);
+        }
+    };
+}  // namespace std
+//! @endcond
+
+#endif  // KAMI_GRID3D_H
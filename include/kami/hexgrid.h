@@ -0,0 +1,655 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef KAMI_HEXGRID_H
+//! @cond SuppressGuard
+#define KAMI_HEXGRID_H
+//! @endcond
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <span>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <kami/agent.h>
+#include <kami/agentindex.h>
+#include <kami/domain.h>
+#include <kami/error.h>
+#include <kami/grid.h>
+#include <kami/kami.h>
+#include <kami/stencil.h>
+
+namespace kami {
+
+    /**
+     * @brief Axial coordinates on a hexagonal grid
+     *
+     * @details Hexes are pointy-topped.  The axial coordinates `q` and `r`
+     * run along two of the three hex axes, with `r` counting rows; the
+     * third, cube coordinate `s` is implied by `q + r + s == 0`.
+     *
+     * @see `HexGrid`
+     */
+    class LIBKAMI_EXPORT HexCoord
+            : public GridCoord {
+    public:
+        /**
+         * @brief The axial offsets of the six neighbors of a hex
+         *
+         * @details Directions run counterclockwise, starting with east.
+         */
+        static const std::array<HexCoord, 6> directions;
+
+        /**
+         * @brief Constructor for axial coordinates
+         */
+        HexCoord(
+                int q_coord,
+                int r_coord
+        );
+
+        /**
+         * @brief Get the axial coordinate `q`.
+         */
+        [[nodiscard]] int q() const;
+
+        /**
+         * @brief Get the axial coordinate `r`, which is also the row.
+         */
+        [[nodiscard]] int r() const;
+
+        /**
+         * @brief Get the implied cube coordinate `s`, or `-q - r`.
+         */
+        [[nodiscard]] int s() const;
+
+        /**
+         * @brief Convert the coordinate to a human-readable string.
+         *
+         * @return a human-readable form of the `Coord` as `std::string`.
+         */
+        [[nodiscard]] std::string to_string() const override;
+
+        /**
+         * @brief Find the distance between two points
+         *
+         * @details Find the hex distance, or the number of steps between
+         * neighboring hexes, without accounting for any wrapping of the
+         * underlying `HexGrid`.
+         *
+         * @param p the point to measure the distance to
+         *
+         * @returns the distance as a `double`
+         */
+        double distance(std::shared_ptr<Coord>& p) const override;
+
+        /**
+         * @brief Find the distance between two points
+         *
+         * @details Find the hex distance, or the number of steps between
+         * neighboring hexes, without accounting for any wrapping of the
+         * underlying `HexGrid`.
+         *
+         * @param p the point to measure the distance to
+         *
+         * @returns the distance as an `int`
+         */
+        [[nodiscard]] int distance(const HexCoord& p) const;
+
+        /**
+         * @brief Test if two coordinates are equal
+         */
+        friend bool operator==(
+                const HexCoord&,
+                const HexCoord&
+        );
+
+        /**
+         * @brief Test if two coordinates are not equal
+         */
+        friend bool operator!=(
+                const HexCoord&,
+                const HexCoord&
+        );
+
+        /**
+         * @brief Output a given coordinate to the specified stream
+         */
+        friend std::ostream& operator<<(
+                std::ostream&,
+                const HexCoord&
+        );
+
+        /**
+         * @brief Add two coordinates together
+         */
+        friend HexCoord operator+(
+                const HexCoord& lhs,
+                const HexCoord& rhs
+        );
+
+        /**
+         * @brief Subtract one coordinate from another
+         */
+        friend HexCoord operator-(
+                const HexCoord& lhs,
+                const HexCoord& rhs
+        );
+
+    private:
+        int _q_coord, _r_coord;
+    };
+
+    /**
+     * @brief A hexagonal grid where each cell may contain agents
+     *
+     * @details The grid is a rectangle of `maximum_x` columns and `maximum_y`
+     * rows of pointy-topped hexes, with odd rows shoved right by half a hex.
+     * Cells are addressed with axial `HexCoord`s but stored densely in this
+     * offset layout, row by row.  The six neighbors of every cell are
+     * computed once, on construction, so radius-one neighborhood queries are
+     * table lookups.
+     *
+     * The grid may wrap around in either dimension.  Wrapping rows requires
+     * an even number of them, so that the shove of each row is preserved.
+     *
+     * @see `MultiHexGrid`
+     * @see `SoloHexGrid`
+     */
+    class LIBKAMI_EXPORT HexGrid
+            : public GridDomain {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * @param[in] maximum_x the number of columns in the grid
+         * @param[in] maximum_y the number of rows in the grid
+         * @param[in] wrap_x should the grid wrap around on itself across
+         * columns
+         * @param[in] wrap_y should the grid wrap around on itself across rows
+         *
+         * @throws error::OptionInvalid if `wrap_y` is set and `maximum_y` is
+         * odd, or if the grid is too large to index.
+         */
+        explicit HexGrid(
+                unsigned int maximum_x,
+                unsigned int maximum_y,
+                bool wrap_x = false,
+                bool wrap_y = false
+        );
+
+        /**
+         * @brief Place agent on the grid at the specified location.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to add.
+         * @param[in] coord the coordinates of the agent.
+         *
+         * @returns the `AgentID` of the agent placed
+         */
+        virtual AgentID add_agent(
+                AgentID agent_id,
+                const HexCoord& coord
+        ) = 0;
+
+        /**
+         * @brief Remove agent from the grid.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to remove.
+         *
+         * @returns the `AgentID` of the agent removed
+         */
+        AgentID delete_agent(AgentID agent_id);
+
+        /**
+         * @brief Remove agent from the grid at the specified location
+         *
+         * @param[in] agent_id the `AgentID` of the agent to remove.
+         * @param[in] coord the coordinates of the agent.
+         *
+         * @returns the `AgentID` of the agent removed
+         */
+        virtual AgentID delete_agent(
+                AgentID agent_id,
+                const HexCoord& coord
+        ) = 0;
+
+        /**
+         * @brief Move an agent to the specified location.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to move.
+         * @param[in] coord the coordinates of the destination.
+         *
+         * @returns the `AgentID` of the agent moved
+         */
+        virtual AgentID move_agent(
+                AgentID agent_id,
+                const HexCoord& coord
+        ) = 0;
+
+        /**
+         * @brief Inquire if the specified location is empty.
+         *
+         * @param[in] coord the coordinates of the query.
+         *
+         * @return true if the location has no `Agent`s occupying it, false
+         * otherwise.
+         */
+        [[nodiscard]] virtual bool is_location_empty(const HexCoord& coord) const = 0;
+
+        /**
+         * @brief Inquire if the specified location is valid within the grid.
+         *
+         * @param[in] coord the coordinates of the query.
+         *
+         * @return true if the location specified is valid, false otherwise.
+         */
+        [[nodiscard]] bool is_location_valid(const HexCoord& coord) const;
+
+        /**
+         * @brief Get the location of the specified agent.
+         *
+         * @param[in] agent_id the `AgentID` of the agent in question.
+         *
+         * @return the location of the specified `Agent`
+         */
+        [[nodiscard]] HexCoord get_location_by_agent(const AgentID& agent_id) const;
+
+        /**
+         * @brief Get the contents of the specified location.
+         *
+         * @param[in] coord the coordinates of the query.
+         *
+         * @return a pointer to a `set` of `AgentID`s.
+         */
+        [[nodiscard]] virtual std::shared_ptr<std::set<AgentID>>
+        get_location_contents(const HexCoord& coord) const = 0;
+
+        /**
+         * @brief Get a view of the contents of the specified location.
+         *
+         * @details The view is into the grid's own storage and is only
+         * valid until the grid is next modified.  The order of the agents
+         * within the view is unspecified.
+         *
+         * @param[in] coord the coordinates of a valid location.
+         *
+         * @return a span of the `AgentID`s at the location.
+         */
+        [[nodiscard]] std::span<const AgentID> get_location_view(const HexCoord& coord) const;
+
+        /**
+         * @brief Inquire to whether the grid wraps across columns.
+         */
+        [[nodiscard]] bool get_wrap_x() const;
+
+        /**
+         * @brief Inquire to whether the grid wraps across rows.
+         */
+        [[nodiscard]] bool get_wrap_y() const;
+
+        /**
+         * @brief Get the number of columns in the grid.
+         */
+        [[nodiscard]] unsigned int get_maximum_x() const;
+
+        /**
+         * @brief Get the number of rows in the grid.
+         */
+        [[nodiscard]] unsigned int get_maximum_y() const;
+
+        /**
+         * @brief Find the distance between two points on the grid
+         *
+         * @details Unlike `HexCoord::distance()`, this takes the shortest
+         * way around a wrapped grid.
+         *
+         * @param[in] p the first point, which must be valid.
+         * @param[in] q the second point, which must be valid.
+         *
+         * @return the number of steps between neighboring hexes
+         */
+        [[nodiscard]] int distance(
+                const HexCoord& p,
+                const HexCoord& q
+        ) const;
+
+        /**
+         * @brief Return the neighborhood of the specified Agent
+         *
+         * @param[in] agent_id the `AgentID` of the agent in question.
+         * @param[in] include_center should the center-point, occupied by the agent,
+         * be in the list.
+         *
+         * @return a set of `HexCoord` that includes all of the coordinates
+         * for all adjacent points.
+         */
+        [[nodiscard]] std::shared_ptr<std::unordered_set<HexCoord>>
+        get_neighborhood(
+                AgentID agent_id,
+                bool include_center
+        ) const;
+
+        /**
+         * @brief Return the neighborhood of the specified location
+         *
+         * @param[in] coord the coordinates of the specified location.
+         * @param[in] include_center should the center-point be in the list.
+         *
+         * @return a set of `HexCoord` that includes all of the coordinates
+         * for all adjacent points.
+         */
+        [[nodiscard]] std::shared_ptr<std::unordered_set<HexCoord>>
+        get_neighborhood(
+                const HexCoord& coord,
+                bool include_center
+        ) const;
+
+        /**
+         * @brief Visit each neighbor of the specified location
+         *
+         * @details Neighbors are read from the neighbor table and visited
+         * in the order of `HexCoord::directions`, and nothing is allocated.
+         * Off-grid neighbors of cells on an unwrapped edge are not visited.
+         *
+         * @param[in] coord the coordinates of a valid location.
+         * @param[in] include_center should the center-point be visited.
+         * @param[in] visitor a callable taking a `const HexCoord&`.  If it
+         * returns `bool`, returning false ends the visit.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         */
+        template<typename Visitor>
+        bool for_each_neighbor(
+                const HexCoord& coord,
+                bool include_center,
+                Visitor&& visitor
+        ) const;
+
+        /**
+         * @brief Visit each cell within a radius of the specified location
+         *
+         * @details Cells are visited in order of increasing `q` and then
+         * `r` offset from the center.  Radius one reads the neighbor table
+         * instead.
+         *
+         * @param[in] coord the coordinates of a valid location.
+         * @param[in] include_center should the center-point be visited.
+         * @param[in] radius the largest hex distance from the center.
+         * @param[in] visitor a callable taking a `const HexCoord&`.  If it
+         * returns `bool`, returning false ends the visit.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         */
+        template<typename Visitor>
+        bool for_each_neighbor(
+                const HexCoord& coord,
+                bool include_center,
+                unsigned int radius,
+                Visitor&& visitor
+        ) const;
+
+        /**
+         * @brief Visit each agent in the neighborhood of the specified location
+         *
+         * @details Cell storage is scanned directly, and no containers are
+         * built.  The grid must not be modified during the visit.
+         *
+         * @param[in] coord the coordinates of a valid location.
+         * @param[in] include_center should agents at the center-point be
+         * visited.
+         * @param[in] radius the largest hex distance from the center.
+         * @param[in] visitor a callable taking an `AgentID`.  If it returns
+         * `bool`, returning false ends the visit.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         */
+        template<typename Visitor>
+        bool for_each_agent_in_neighborhood(
+                const HexCoord& coord,
+                bool include_center,
+                unsigned int radius,
+                Visitor&& visitor
+        ) const;
+
+        /**
+         * @brief Visit each matching agent in the neighborhood of the specified
+         * location
+         *
+         * @param[in] coord the coordinates of a valid location.
+         * @param[in] include_center should agents at the center-point be
+         * visited.
+         * @param[in] radius the largest hex distance from the center.
+         * @param[in] filter a predicate taking an `AgentID`; only agents for
+         * which it returns true are visited.
+         * @param[in] visitor a callable taking an `AgentID`.  If it returns
+         * `bool`, returning false ends the visit.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         */
+        template<typename Filter, typename Visitor>
+        bool for_each_agent_in_neighborhood(
+                const HexCoord& coord,
+                bool include_center,
+                unsigned int radius,
+                Filter&& filter,
+                Visitor&& visitor
+        ) const;
+
+    protected:
+        /**
+         * @brief Marks a missing neighbor in the neighbor table
+         */
+        static constexpr std::uint32_t no_neighbor = UINT32_MAX;
+
+        /**
+         * @brief The cell offset of each agent, keyed by `AgentID`
+         *
+         * @see `coord_index()`
+         */
+        AgentIndex<std::size_t> _agent_index;
+
+        /**
+         * @brief Automatically adjust a coordinate location for wrapping.
+         *
+         * @param[in] coord the coordinates of the specified location.
+         *
+         * @return the adjusted coordinate wrapped if appropriate.
+         */
+        [[nodiscard]] HexCoord coord_wrap(const HexCoord& coord) const;
+
+        /**
+         * @brief Get the number of cells of per-cell storage
+         */
+        [[nodiscard]] std::size_t cell_capacity() const;
+
+        /**
+         * @brief Get a view of the contents of a cell by its offset
+         *
+         * @param[in] index the offset of the cell.
+         *
+         * @return a span of the `AgentID`s in the cell.
+         */
+        [[nodiscard]] virtual std::span<const AgentID> get_cell_view(std::size_t index) const = 0;
+
+        /**
+         * @brief Get the offset of a cell in row-major offset layout
+         *
+         * @param[in] coord the coordinates of a valid location.
+         *
+         * @return the offset of the cell
+         */
+        [[nodiscard]] inline std::size_t coord_index(const HexCoord& coord) const {
+            return static_cast<std::size_t>(coord.r()) * _maximum_x + static_cast<std::size_t>(column(coord));
+        }
+
+        /**
+         * @brief Get the coordinates of a cell from its offset
+         *
+         * @param[in] index the offset of the cell.
+         *
+         * @return the coordinates of the cell
+         *
+         * @see `coord_index()`
+         */
+        [[nodiscard]] inline HexCoord index_coord(std::size_t index) const {
+            auto row = static_cast<int>(index / _maximum_x);
+            auto col = static_cast<int>(index % _maximum_x);
+            return {col - (row - (row & 1)) / 2, row};
+        }
+
+        /**
+         * @brief Get the offset column of a coordinate
+         */
+        [[nodiscard]] static inline int column(const HexCoord& coord) {
+            return coord.q() + (coord.r() - (coord.r() & 1)) / 2;
+        }
+
+    private:
+        unsigned int _maximum_x, _maximum_y;
+        bool _wrap_x, _wrap_y;
+
+        // Six neighbor offsets per cell, in the order of `HexCoord::directions`
+        std::vector<std::uint32_t> _neighbors;
+    };
+
+    template<typename Visitor>
+    bool HexGrid::for_each_neighbor(
+            const HexCoord& coord,
+            const bool include_center,
+            Visitor&& visitor
+    ) const {
+        auto index = coord_index(coord);
+
+        if (include_center && !stencil::visit(visitor, coord))
+            return false;
+        for (auto i = index * 6; i < index * 6 + 6; i++)
+            if (_neighbors[i] != no_neighbor && !stencil::visit(visitor, index_coord(_neighbors[i])))
+                return false;
+        return true;
+    }
+
+    template<typename Visitor>
+    bool HexGrid::for_each_neighbor(
+            const HexCoord& coord,
+            const bool include_center,
+            const unsigned int radius,
+            Visitor&& visitor
+    ) const {
+        if (radius == 1)
+            return for_each_neighbor(coord, include_center, visitor);
+
+        const auto reach = static_cast<int>(radius);
+        const auto maximum_x = static_cast<int>(_maximum_x);
+        const auto maximum_y = static_cast<int>(_maximum_y);
+        const auto col = column(coord);
+
+        // A hex within the radius is no more than the radius away in offset
+        // columns and rows, so interior cells need neither wrapping nor
+        // validity checks
+        const auto interior = col >= reach && col < maximum_x - reach &&
+                              coord.r() >= reach && coord.r() < maximum_y - reach;
+
+        for (auto dq = -reach; dq <= reach; dq++) {
+            for (auto dr = std::max(-reach, -dq - reach); dr <= std::min(reach, -dq + reach); dr++) {
+                if (!include_center && dq == 0 && dr == 0)
+                    continue;
+
+                HexCoord neighbor(coord.q() + dq, coord.r() + dr);
+                if (!interior) {
+                    neighbor = coord_wrap(neighbor);
+                    if (!is_location_valid(neighbor))
+                        continue;
+                }
+                if (!stencil::visit(visitor, neighbor))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    template<typename Visitor>
+    bool HexGrid::for_each_agent_in_neighborhood(
+            const HexCoord& coord,
+            const bool include_center,
+            const unsigned int radius,
+            Visitor&& visitor
+    ) const {
+        auto visit_cell = [this, &visitor](const std::size_t index) {
+            for (auto agent_id : get_cell_view(index))
+                if (!stencil::visit(visitor, agent_id))
+                    return false;
+            return true;
+        };
+
+        if (radius != 1)
+            return for_each_neighbor(coord, include_center, radius, [this, &visit_cell](const HexCoord& cell) {
+                return visit_cell(coord_index(cell));
+            });
+
+        // Neighbor table entries are cell offsets already
+        auto index = coord_index(coord);
+        if (include_center && !visit_cell(index))
+            return false;
+        for (auto i = index * 6; i < index * 6 + 6; i++)
+            if (_neighbors[i] != no_neighbor && !visit_cell(_neighbors[i]))
+                return false;
+        return true;
+    }
+
+    template<typename Filter, typename Visitor>
+    bool HexGrid::for_each_agent_in_neighborhood(
+            const HexCoord& coord,
+            const bool include_center,
+            const unsigned int radius,
+            Filter&& filter,
+            Visitor&& visitor
+    ) const {
+        return for_each_agent_in_neighborhood(coord, include_center, radius,
+                                              [&filter, &visitor](const AgentID agent_id) {
+                                                  return !filter(agent_id) || stencil::visit(visitor, agent_id);
+                                              });
+    }
+
+}  // namespace kami
+
+//! @cond SuppressHashMethod
+namespace std {
+    template<>
+    struct hash<kami::HexCoord> {
+        size_t operator()(const kami::HexCoord& key) const {
+            return ((hash<int>()(key.q()) ^ (hash<int>()(key.r()) << 1)) >> 1);
+        }
+    };
+}  // namespace std
+//! @endcond
+
+#endif  // KAMI_HEXGRID_H
@@ -0,0 +1,249 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef KAMI_ISLAND_H
+//! @cond SuppressGuard
+#define KAMI_ISLAND_H
+//! @endcond
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <kami/agent.h>
+#include <kami/executor.h>
+#include <kami/kami.h>
+#include <kami/model.h>
+
+namespace kami {
+
+    /**
+     * @brief An `Agent` leaving one `Island` for another
+     *
+     * @see `Island::emigrate()`
+     */
+    struct LIBKAMI_EXPORT Migrant {
+        /**
+         * @brief The `AgentID` of the migrating agent
+         */
+        AgentID agent_id;
+
+        /**
+         * @brief The index of the destination `Island` in its `Archipelago`
+         */
+        std::size_t destination;
+    };
+
+    /**
+     * @brief A `Model` that exchanges agents with other models
+     *
+     * @details An island is a complete model, with its own `Population`,
+     * `Domain`, and `Scheduler`, that is run alongside other islands by an
+     * `Archipelago`.  Islands are stepped concurrently and only interact
+     * through migration, so an island must not touch the state of any
+     * other island while stepping.
+     *
+     * Subclasses choose which agents leave, and where they go, in
+     * `emigrate()`, take departing agents out of their `Domain` in
+     * `depart()`, and place arriving agents in their `Domain` in
+     * `immigrate()`.  Moving agents between populations is handled by
+     * the `Archipelago`.
+     *
+     * @see `Archipelago`
+     */
+    class LIBKAMI_EXPORT Island
+            : public Model {
+    public:
+        /**
+         * @brief Select the agents leaving this island
+         *
+         * @details This method is called by the `Archipelago` at each
+         * migration.  It only chooses the migrants and must not change
+         * the island's `Domain` or `Population`, since the migration may
+         * still be rejected; departing agents are taken out of the
+         * `Domain` later, in `depart()`.  The default implementation
+         * sends no agents.
+         *
+         * @param[in] island_count the number of islands in the
+         * `Archipelago`
+         *
+         * @returns the departing agents and their destinations
+         */
+        virtual std::unique_ptr<std::vector<Migrant>> emigrate(std::size_t island_count);
+
+        /**
+         * @brief Release an agent leaving this island
+         *
+         * @details This method is called by the `Archipelago` for each
+         * departing agent, once every migrant in the archipelago has been
+         * accepted and before the agent is removed from the island's
+         * `Population`.  It should remove the agent from the island's
+         * `Domain`, if any.  The default implementation does nothing.
+         *
+         * @param[in] agent the departing agent
+         *
+         * @returns the `AgentID` of the departing agent
+         */
+        virtual AgentID depart(const std::shared_ptr<Agent>& agent);
+
+        /**
+         * @brief Receive an agent arriving on this island
+         *
+         * @details This method is called by the `Archipelago` for each
+         * arriving agent, after the agent has been added to the island's
+         * `Population`.  It should place the agent in the island's
+         * `Domain`, if any.  The default implementation does nothing.
+         *
+         * @param[in] agent the arriving agent
+         *
+         * @returns the `AgentID` of the arriving agent
+         */
+        virtual AgentID immigrate(const std::shared_ptr<Agent>& agent);
+    };
+
+    /**
+     * @brief A set of loosely coupled models run concurrently
+     *
+     * @details An archipelago runs many `Island` models side by side on
+     * a single `Executor`, with each island stepped concurrently with the
+     * others.  At a configurable interval, agents migrate between the
+     * islands.  Migration takes place in four phases: each island,
+     * concurrently, selects its emigrants, which are checked without
+     * changing any island; each island, concurrently, then releases its
+     * emigrants from its `Domain` and `Population` into its own outbound
+     * buffer; the buffers are exchanged in a single pass, in island
+     * order; and finally each island, concurrently, takes in its
+     * arrivals.  No lock or agent map is shared
+     * between islands, and the outcome does not depend on the number of
+     * threads.
+     *
+     * @see `Island`
+     */
+    class LIBKAMI_EXPORT Archipelago
+            : public std::enable_shared_from_this<Archipelago> {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * @param[in] executor the `Executor` shared by all islands; if
+         * not given, one is created with the default number of threads
+         */
+        explicit Archipelago(std::shared_ptr<Executor> executor = nullptr);
+
+        /**
+         * @brief Add an `Island` to the archipelago
+         *
+         * @details The island is given the archipelago's `Executor`, so
+         * that parallel work within an island shares the same threads.
+         *
+         * @param[in] island the `Island` to add
+         *
+         * @returns the index of the island
+         */
+        std::size_t add_island(std::shared_ptr<Island> island);
+
+        /**
+         * @brief Get an `Island` by index
+         *
+         * @param[in] index the index of the island
+         *
+         * @returns a shared pointer to the `Island`
+         */
+        [[nodiscard]] std::shared_ptr<Island> get_island(std::size_t index) const;
+
+        /**
+         * @brief Get the number of islands
+         */
+        [[nodiscard]] std::size_t get_island_count() const;
+
+        /**
+         * @brief Get the `Executor` shared by all islands
+         *
+         * @returns a shared pointer to the `Executor`
+         */
+        [[nodiscard]] std::shared_ptr<Executor> get_executor() const;
+
+        /**
+         * @brief Get the number of steps between migrations
+         *
+         * @returns the migration interval, in steps, where zero means
+         * agents never migrate
+         */
+        [[nodiscard]] unsigned int get_migration_interval() const;
+
+        /**
+         * @brief Set the number of steps between migrations
+         *
+         * @param[in] interval the migration interval, in steps, where
+         * zero means agents never migrate
+         *
+         * @returns the migration interval
+         */
+        unsigned int set_migration_interval(unsigned int interval);
+
+        /**
+         * @brief Execute a single time step of every island
+         *
+         * @details The islands are stepped concurrently.  If a migration
+         * is due after this step, it follows once every island has
+         * completed its step.
+         *
+         * @returns a shared pointer to the archipelago
+         */
+        std::shared_ptr<Archipelago> step();
+
+        /**
+         * @brief Migrate agents between the islands
+         *
+         * @details This is called by `step()` at the migration interval,
+         * but may also be called directly.  Every migrant is checked
+         * before any island releases an agent, so a rejected
+         * migration leaves every `Domain` and `Population` unchanged.
+         *
+         * @returns the number of agents that migrated
+         *
+         * @throws error::OptionInvalid if a destination is not an island,
+         * or an agent is sent twice
+         * @throws error::AgentNotFound if an agent is not in its island's
+         * `Population`
+         */
+        std::size_t migrate();
+
+        /**
+         * @brief Get the number of steps executed
+         */
+        [[nodiscard]] unsigned int get_step_id() const;
+
+    private:
+        std::shared_ptr<Executor> _executor;
+        std::vector<std::shared_ptr<Island>> _islands;
+        unsigned int _migration_interval = 0;
+        unsigned int _step_count = 0;
+    };
+
+}  // namespace kami
+
+#endif  // KAMI_ISLAND_H
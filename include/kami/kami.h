@@ -41,8 +41,14 @@ namespace kami {
 
     class AgentID;
 
+    class Archipelago;
+
     class Domain;
 
+    class Executor;
+
+    class Island;
+
     class Model;
 
     class Population;
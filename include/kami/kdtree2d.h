@@ -0,0 +1,352 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef KAMI_KDTREE2D_H
+//! @cond SuppressGuard
+#define KAMI_KDTREE2D_H
+//! @endcond
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <kami/agent.h>
+#include <kami/continuous2d.h>
+#include <kami/executor.h>
+#include <kami/kami.h>
+#include <kami/stencil.h>
+
+namespace kami {
+
+    /**
+     * @brief A k-d tree over agent positions in two dimensions
+     *
+     * @details The tree is a static index, built in bulk from a set of
+     * positions and rebuilt when they change, typically once per step.
+     * Unlike the uniform bins of `ContinuousSpace2D`, its cells adapt to
+     * the positions, so queries stay fast when agents crowd together.
+     *
+     * The tree splits the widest side of each node at the median, down to
+     * leaves of at most `leaf_size` agents.  Since every node is split at
+     * the middle of its range of agents, the shape of the tree depends only
+     * on the number of agents, and nodes are stored in an implicit
+     * complete binary tree.  The agents themselves, with copies of their
+     * positions, are stored in tree order.  Building divides the lower
+     * levels of the tree among the threads of an `Executor`.
+     *
+     * A tree built from a `ContinuousSpace2D` honors its wrapping, so
+     * distances and queries take the shorter way around.
+     */
+    class LIBKAMI_EXPORT KDTree2D {
+    public:
+        /**
+         * @brief The largest number of agents in a leaf
+         */
+        static constexpr std::size_t leaf_size = 8;
+
+        /**
+         * @brief Constructs an empty tree
+         */
+        KDTree2D() = default;
+
+        /**
+         * @brief Build the tree over the agents in a space
+         *
+         * @param[in] space the space to index.
+         * @param[in] executor the `Executor` to use, or `nullptr` to build
+         * on the calling thread only.
+         */
+        void build(
+                const ContinuousSpace2D& space,
+                Executor* executor = nullptr
+        );
+
+        /**
+         * @brief Build the tree over a set of positions
+         *
+         * @details The positions are unbounded and do not wrap.
+         *
+         * @param[in] agent_ids the `AgentID` of each agent.
+         * @param[in] x the `x` coordinate of each agent.
+         * @param[in] y the `y` coordinate of each agent.
+         * @param[in] executor the `Executor` to use, or `nullptr` to build
+         * on the calling thread only.
+         */
+        void build(
+                std::span<const AgentID> agent_ids,
+                std::span<const double> x,
+                std::span<const double> y,
+                Executor* executor = nullptr
+        );
+
+        /**
+         * @brief Get the number of agents in the tree
+         */
+        [[nodiscard]] std::size_t size() const;
+
+        /**
+         * @brief Get the agents in the tree, in tree order
+         *
+         * @details Agents near each other in the tree are near each other
+         * in space.  Batched queries are answered in this order.
+         */
+        [[nodiscard]] std::span<const AgentID> get_agent_ids() const;
+
+        /**
+         * @brief Get the agents within a radius of the specified location
+         *
+         * @param[in] coord the coordinates of the center.
+         * @param[in] radius the radius of the query.
+         *
+         * @return the `AgentID`s of the agents at most `radius` from the
+         * center, in tree order.
+         */
+        [[nodiscard]] std::unique_ptr<std::vector<AgentID>> get_agents_in_radius(
+                const ContinuousCoord2D& coord,
+                double radius
+        ) const;
+
+        /**
+         * @brief Visit each agent within a radius of the specified location
+         *
+         * @details Nothing is allocated.  Agents are visited in tree order.
+         *
+         * @param[in] coord the coordinates of the center.
+         * @param[in] radius the radius of the query.
+         * @param[in] visitor a callable taking an `AgentID`.  If it returns
+         * `bool`, returning false ends the visit.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         */
+        template<typename Visitor>
+        bool for_each_agent_in_radius(
+                const ContinuousCoord2D& coord,
+                double radius,
+                Visitor&& visitor
+        ) const;
+
+        /**
+         * @brief Get the nearest agents to the specified location
+         *
+         * @param[in] coord the coordinates of the query.
+         * @param[in] k the number of agents to find.
+         *
+         * @return the `AgentID`s of the `k` nearest agents, or of all of
+         * them if there are fewer, nearest first.
+         */
+        [[nodiscard]] std::unique_ptr<std::vector<AgentID>> get_nearest(
+                const ContinuousCoord2D& coord,
+                std::size_t k
+        ) const;
+
+        /**
+         * @brief Find the nearest agents to the specified location
+         *
+         * @details Results are written to the buffers given, nearest first,
+         * and nothing is allocated.
+         *
+         * @param[in] coord the coordinates of the query.
+         * @param[in] k the number of agents to find.
+         * @param[out] agent_ids a buffer of at least `k` elements for the
+         * `AgentID`s found.
+         * @param[out] distances a buffer of at least `k` elements for the
+         * distances to the agents found.
+         * @param[in] exclude an agent to leave out, such as the one making
+         * the query, or `AgentID::null()`.
+         *
+         * @return the number of agents found, which is `k` unless the tree
+         * holds fewer.
+         */
+        std::size_t nearest(
+                const ContinuousCoord2D& coord,
+                std::size_t k,
+                std::span<AgentID> agent_ids,
+                std::span<double> distances,
+                AgentID exclude = AgentID::null()
+        ) const;
+
+        /**
+         * @brief Find the nearest other agents to every agent in the tree
+         *
+         * @details Queries are made for the agents in the order of
+         * `get_agent_ids()`, and row `i` of each buffer, elements
+         * `[i * k, (i + 1) * k)`, holds the results for the `i`-th agent,
+         * nearest first.  Rows with fewer than `k` results are padded with
+         * `AgentID::null()` and infinite distances.  Since neighboring
+         * queries visit neighboring parts of the tree, this is faster than
+         * querying agents in an arbitrary order, and the queries are
+         * divided among the threads of the `Executor`.
+         *
+         * @param[in] k the number of agents to find for each agent.
+         * @param[out] agent_ids a buffer of at least `size() * k` elements.
+         * @param[out] distances a buffer of at least `size() * k` elements.
+         * @param[in] executor the `Executor` to use, or `nullptr` to query
+         * on the calling thread only.
+         */
+        void nearest_all(
+                std::size_t k,
+                std::span<AgentID> agent_ids,
+                std::span<double> distances,
+                Executor* executor = nullptr
+        ) const;
+
+    private:
+        struct Box {
+            double min_x, min_y, max_x, max_y;
+        };
+
+        struct Frame {
+            std::size_t node, begin, end;
+        };
+
+        static constexpr unsigned int max_depth = 63;
+
+        // The agents and their positions, in tree order
+        std::vector<AgentID> _agent_ids;
+        std::vector<double> _x, _y;
+
+        // The bounding box of each node of the implicit tree
+        std::vector<Box> _boxes;
+        unsigned int _depth = 0;
+
+        double _width = 0.0, _height = 0.0;
+        bool _wrap_x = false, _wrap_y = false;
+
+        void build_tree(
+                std::span<const AgentID> agent_ids,
+                std::span<const double> x,
+                std::span<const double> y,
+                Executor* executor
+        );
+
+        void build_node(
+                std::vector<std::uint32_t>& order,
+                std::span<const double> x,
+                std::span<const double> y,
+                std::size_t node,
+                std::size_t begin,
+                std::size_t end,
+                unsigned int depth,
+                unsigned int stop_depth,
+                std::vector<Frame>* subtrees
+        );
+
+        [[nodiscard]] static inline double displacement(
+                double delta,
+                double length,
+                bool wrap
+        ) {
+            if (wrap) {
+                if (delta > 0.5 * length)
+                    delta -= length;
+                else if (delta < -0.5 * length)
+                    delta += length;
+            }
+            return delta;
+        }
+
+        [[nodiscard]] static inline double axis_gap(
+                double value,
+                double min,
+                double max,
+                double length,
+                bool wrap
+        ) {
+            if (value >= min && value <= max)
+                return 0.0;
+
+            // Around the wrap, the gap is to the far side of the box
+            auto gap = value < min ? min - value : value - max;
+            if (wrap)
+                gap = std::min(gap, value < min ? value + length - max : min + length - value);
+            return gap;
+        }
+
+        [[nodiscard]] inline double box_distance_squared(
+                const Box& box,
+                double x,
+                double y
+        ) const {
+            auto dx = axis_gap(x, box.min_x, box.max_x, _width, _wrap_x);
+            auto dy = axis_gap(y, box.min_y, box.max_y, _height, _wrap_y);
+            return dx * dx + dy * dy;
+        }
+
+        [[nodiscard]] inline double distance_squared(
+                std::size_t i,
+                double x,
+                double y
+        ) const {
+            auto dx = displacement(_x[i] - x, _width, _wrap_x);
+            auto dy = displacement(_y[i] - y, _height, _wrap_y);
+            return dx * dx + dy * dy;
+        }
+    };
+
+    template<typename Visitor>
+    bool KDTree2D::for_each_agent_in_radius(
+            const ContinuousCoord2D& coord,
+            const double radius,
+            Visitor&& visitor
+    ) const {
+        if (_agent_ids.empty() || !(radius >= 0.0))
+            return true;
+
+        const auto x = coord.x();
+        const auto y = coord.y();
+        const auto radius_squared = radius * radius;
+        std::array<Frame, max_depth + 1> stack;
+        std::size_t top = 0;
+
+        stack[top++] = {0, 0, _agent_ids.size()};
+        while (top > 0) {
+            auto [node, begin, end] = stack[--top];
+            if (box_distance_squared(_boxes[node], x, y) > radius_squared)
+                continue;
+
+            if (2 * node + 1 >= _boxes.size()) {
+                for (auto i = begin; i < end; i++)
+                    if (distance_squared(i, x, y) <= radius_squared && !stencil::visit(visitor, _agent_ids[i]))
+                        return false;
+                continue;
+            }
+
+            // Push the right child first so the left is visited first
+            auto middle = begin + (end - begin) / 2;
+            stack[top++] = {2 * node + 2, middle, end};
+            stack[top++] = {2 * node + 1, begin, middle};
+        }
+        return true;
+    }
+
+}  // namespace kami
+
+#endif  // KAMI_KDTREE2D_H
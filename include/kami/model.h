@@ -32,6 +32,7 @@
 #include <memory>
 
 #include <kami/domain.h>
+#include <kami/executor.h>
 #include <kami/kami.h>
 #include <kami/population.h>
 #include <kami/scheduler.h>
@@ -98,6 +99,27 @@ namespace kami {
          */
         std::shared_ptr<Scheduler> set_scheduler(std::shared_ptr<Scheduler> scheduler);
 
+        /**
+         * @brief Get the `Executor` associated with this model
+         *
+         * @details Every parallel feature of Kami runs on the model's
+         * `Executor`.  If no `Executor` has been set, one is created
+         * with the default number of threads on first use.
+         *
+         * @returns a shared pointer to the `Executor`
+         */
+        std::shared_ptr<Executor> get_executor();
+
+        /**
+         * @brief Add an `Executor` to this model
+         *
+         * @details This method will associate an `Executor` with the
+         * model.  Several models may share one `Executor`.
+         *
+         * @returns a shared pointer to the `Executor`
+         */
+        std::shared_ptr<Executor> set_executor(std::shared_ptr<Executor> executor);
+
         /**
          * @brief Execute a single time step of the model
          *
@@ -124,6 +146,11 @@ namespace kami {
         */
         std::shared_ptr<Scheduler> _sched = nullptr;
 
+        /**
+        * @brief Reference copy of the `Executor`
+        */
+        std::shared_ptr<Executor> _executor = nullptr;
+
     };
 
 }  // namespace kami
@@ -29,11 +29,20 @@
 #define KAMI_MULTIGRID2D_H
 //! @endcond
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <span>
+#include <vector>
+
 #include <kami/agent.h>
+#include <kami/agentindex.h>
 #include <kami/domain.h>
 #include <kami/grid.h>
 #include <kami/grid2d.h>
 #include <kami/kami.h>
+#include <kami/smallvector.h>
 
 namespace kami {
 
@@ -41,6 +50,11 @@ namespace kami {
      * @brief A two-dimensional grid where each cell may contain multiple agents
      *
      * @details The grid is linear and may wrap around in either dimension.
+     * The contents of each cell are stored contiguously, in a per-cell
+     * `SmallVector` that holds the first few agents inline, so that most
+     * cells never allocate.  Each agent's slot within its cell is
+     * tracked, so removing an agent swaps the last agent of the cell
+     * into its place rather than scanning the cell.
      *
      * @see `Grid2D`
      * @see `SoloGrid2D`
@@ -68,15 +82,99 @@ namespace kami {
         /**
          * @brief Place agent on the grid at the specified location.
          *
+         * @details As in `SoloGrid2D`, an agent may only be placed once;
+         * use `move_agent()` to change its location.
+         *
          * @param[in] agent_id the `AgentID` of the agent to add.
          * @param[in] coord the coordinates of the agent.
          *
          * @returns the `AgentID` of the agent added
+         *
+         * @throws error::OptionInvalid if the agent is already on the grid.
          */
         AgentID add_agent(
                 AgentID agent_id,
                 const GridCoord2D& coord
         ) override;
+
+        using Grid2D::delete_agent;
+
+        /**
+         * @brief Remove agent from the grid at the specified location
+         *
+         * @param[in] agent_id the `AgentID` of the agent to remove.
+         * @param[in] coord the coordinates of the agent.
+         *
+         * @returns the `AgentID` of the agent removed
+         */
+        AgentID delete_agent(
+                AgentID agent_id,
+                const GridCoord2D& coord
+        ) override;
+
+        /**
+         * @brief Move an agent to the specified location.
+         *
+         * @details If the destination is invalid, an exception is thrown
+         * and the agent remains where it was.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to move.
+         * @param[in] coord the coordinates of the destination.
+         *
+         * @returns the `AgentID` of the agent moved
+         */
+        AgentID move_agent(
+                AgentID agent_id,
+                const GridCoord2D& coord
+        ) override;
+
+        /**
+         * @brief Inquire if the specified location is empty.
+         *
+         * @param[in] coord the coordinates of the query.
+         *
+         * @return true if the location has no `Agent`s occupying it, false
+         * otherwise.
+         */
+        [[nodiscard]] bool is_location_empty(const GridCoord2D& coord) const override;
+
+        /**
+         * @brief Get the contents of the specified location.
+         *
+         * @param[in] coord the coordinates of the query.
+         *
+         * @return a pointer to a `set` of the `AgentID`s at the location.
+         */
+        [[nodiscard]] std::shared_ptr<std::set<AgentID>>
+        get_location_contents(const GridCoord2D& coord) const override;
+
+        /**
+         * @brief Get a view of the contents of the specified location.
+         *
+         * @param[in] coord the coordinates of a valid location.
+         *
+         * @return a span of the `AgentID`s at the location.
+         */
+        [[nodiscard]] std::span<const AgentID> get_location_view(const GridCoord2D& coord) const override;
+
+    protected:
+        /**
+         * @brief The `AgentID`s at each cell, in row-major order
+         *
+         * @see `Grid2D::coord_index()`
+         */
+        std::vector<SmallVector<AgentID, 2>> _agent_cells;
+
+        /**
+         * @brief The position of each agent within its cell
+         */
+        AgentIndex<std::uint32_t> _agent_slots;
+
+    private:
+        void remove_from_cell(
+                AgentID agent_id,
+                std::size_t cell_index
+        );
     };
 
 }  // namespace kami
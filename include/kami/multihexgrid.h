@@ -0,0 +1,167 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef KAMI_MULTIHEXGRID_H
+//! @cond SuppressGuard
+#define KAMI_MULTIHEXGRID_H
+//! @endcond
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <span>
+#include <vector>
+
+#include <kami/agent.h>
+#include <kami/agentindex.h>
+#include <kami/domain.h>
+#include <kami/grid.h>
+#include <kami/hexgrid.h>
+#include <kami/kami.h>
+#include <kami/smallvector.h>
+
+namespace kami {
+
+    /**
+     * @brief A hexagonal grid where each cell may contain multiple agents
+     *
+     * @details The grid may wrap around in either dimension.  The contents of
+     * each cell are stored contiguously, in a per-cell `SmallVector` kept in
+     * offset order, and each agent's slot within its cell is tracked so that
+     * removal is a swap rather than a scan.
+     *
+     * @see `HexGrid`
+     * @see `SoloHexGrid`
+     */
+    class LIBKAMI_EXPORT MultiHexGrid
+            : public HexGrid {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * @param[in] maximum_x the number of columns in the grid
+         * @param[in] maximum_y the number of rows in the grid
+         * @param[in] wrap_x should the grid wrap around on itself across
+         * columns
+         * @param[in] wrap_y should the grid wrap around on itself across rows
+         */
+        MultiHexGrid(
+                unsigned int maximum_x,
+                unsigned int maximum_y,
+                bool wrap_x,
+                bool wrap_y
+        );
+
+        /**
+         * @brief Place agent on the grid at the specified location.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to add.
+         * @param[in] coord the coordinates of the agent.
+         *
+         * @returns the `AgentID` of the agent added
+         */
+        AgentID add_agent(
+                AgentID agent_id,
+                const HexCoord& coord
+        ) override;
+
+        using HexGrid::delete_agent;
+
+        /**
+         * @brief Remove agent from the grid at the specified location
+         *
+         * @param[in] agent_id the `AgentID` of the agent to remove.
+         * @param[in] coord the coordinates of the agent.
+         *
+         * @returns the `AgentID` of the agent removed
+         */
+        AgentID delete_agent(
+                AgentID agent_id,
+                const HexCoord& coord
+        ) override;
+
+        /**
+         * @brief Move an agent to the specified location.
+         *
+         * @details If the destination is invalid, an exception is thrown
+         * and the agent remains where it was.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to move.
+         * @param[in] coord the coordinates of the destination.
+         *
+         * @returns the `AgentID` of the agent moved
+         */
+        AgentID move_agent(
+                AgentID agent_id,
+                const HexCoord& coord
+        ) override;
+
+        /**
+         * @brief Inquire if the specified location is empty.
+         *
+         * @param[in] coord the coordinates of the query.
+         *
+         * @return true if the location has no `Agent`s occupying it, false
+         * otherwise.
+         */
+        [[nodiscard]] bool is_location_empty(const HexCoord& coord) const override;
+
+        /**
+         * @brief Get the contents of the specified location.
+         *
+         * @param[in] coord the coordinates of the query.
+         *
+         * @return a pointer to a `set` of the `AgentID`s at the location.
+         */
+        [[nodiscard]] std::shared_ptr<std::set<AgentID>>
+        get_location_contents(const HexCoord& coord) const override;
+
+    protected:
+        [[nodiscard]] std::span<const AgentID> get_cell_view(std::size_t index) const override;
+
+        /**
+         * @brief The `AgentID`s at each cell, in offset order
+         *
+         * @see `HexGrid::coord_index()`
+         */
+        std::vector<SmallVector<AgentID, 2>> _agent_cells;
+
+        /**
+         * @brief The position of each agent within its cell
+         */
+        AgentIndex<std::uint32_t> _agent_slots;
+
+    private:
+        void remove_from_cell(
+                AgentID agent_id,
+                std::size_t cell_index
+        );
+    };
+
+}  // namespace kami
+
+#endif  // KAMI_MULTIHEXGRID_H
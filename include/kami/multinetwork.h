@@ -0,0 +1,159 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef KAMI_MULTINETWORK_H
+//! @cond SuppressGuard
+#define KAMI_MULTINETWORK_H
+//! @endcond
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <span>
+#include <vector>
+
+#include <kami/agent.h>
+#include <kami/agentindex.h>
+#include <kami/kami.h>
+#include <kami/network.h>
+#include <kami/smallvector.h>
+
+namespace kami {
+
+    /**
+     * @brief A network domain where each node may contain multiple agents
+     *
+     * @details The contents of each node are stored contiguously, in a
+     * per-node `SmallVector`, and each agent's slot within its node is
+     * tracked so that removal is a swap rather than a scan.
+     *
+     * @see `NetworkDomain`
+     * @see `SoloNetwork`
+     */
+    class LIBKAMI_EXPORT MultiNetwork
+            : public NetworkDomain {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * @param[in] graph the graph of the network.
+         */
+        explicit MultiNetwork(std::shared_ptr<const NetworkGraph> graph);
+
+        /**
+         * @brief Place agent on the network at the specified node.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to add.
+         * @param[in] coord the coordinates of the agent.
+         *
+         * @returns the `AgentID` of the agent added
+         */
+        AgentID add_agent(
+                AgentID agent_id,
+                const NodeCoord& coord
+        ) override;
+
+        using NetworkDomain::delete_agent;
+
+        /**
+         * @brief Remove agent from the network at the specified node
+         *
+         * @param[in] agent_id the `AgentID` of the agent to remove.
+         * @param[in] coord the coordinates of the agent.
+         *
+         * @returns the `AgentID` of the agent removed
+         */
+        AgentID delete_agent(
+                AgentID agent_id,
+                const NodeCoord& coord
+        ) override;
+
+        /**
+         * @brief Move an agent to the specified node.
+         *
+         * @details If the destination is invalid, an exception is thrown
+         * and the agent remains where it was.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to move.
+         * @param[in] coord the coordinates of the destination.
+         *
+         * @returns the `AgentID` of the agent moved
+         */
+        AgentID move_agent(
+                AgentID agent_id,
+                const NodeCoord& coord
+        ) override;
+
+        /**
+         * @brief Inquire if the specified node is empty.
+         *
+         * @param[in] coord the coordinates of the query.
+         *
+         * @return true if the node has no `Agent`s occupying it, false
+         * otherwise.
+         */
+        [[nodiscard]] bool is_location_empty(const NodeCoord& coord) const override;
+
+        /**
+         * @brief Get the contents of the specified node.
+         *
+         * @param[in] coord the coordinates of the query.
+         *
+         * @return a pointer to a `set` of the `AgentID`s at the node.
+         */
+        [[nodiscard]] std::shared_ptr<std::set<AgentID>>
+        get_location_contents(const NodeCoord& coord) const override;
+
+        /**
+         * @brief Get a view of the contents of the specified node.
+         *
+         * @param[in] coord the coordinates of a valid node.
+         *
+         * @return a span of the `AgentID`s at the node.
+         */
+        [[nodiscard]] std::span<const AgentID> get_location_view(const NodeCoord& coord) const override;
+
+    protected:
+        /**
+         * @brief The `AgentID`s at each node
+         */
+        std::vector<SmallVector<AgentID, 2>> _agent_nodes;
+
+        /**
+         * @brief The position of each agent within its node
+         */
+        AgentIndex<std::uint32_t> _agent_slots;
+
+    private:
+        void remove_from_node(
+                AgentID agent_id,
+                unsigned int node
+        );
+    };
+
+}  // namespace kami
+
+#endif  // KAMI_MULTINETWORK_H
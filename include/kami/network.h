@@ -0,0 +1,582 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef KAMI_NETWORK_H
+//! @cond SuppressGuard
+#define KAMI_NETWORK_H
+//! @endcond
+
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <set>
+#include <span>
+#include <string>
+#include <unordered_set>
+
+#include <kami/agent.h>
+#include <kami/agentindex.h>
+#include <kami/domain.h>
+#include <kami/error.h>
+#include <kami/kami.h>
+#include <kami/stencil.h>
+
+namespace kami {
+
+    /**
+     * @brief Coordinates of a node in a network
+     *
+     * @details Nodes are numbered from zero up to the node count of the
+     * underlying `NetworkGraph`.
+     */
+    class LIBKAMI_EXPORT NodeCoord
+            : public Coord {
+    public:
+        /**
+         * @brief Constructor for node coordinates
+         */
+        explicit NodeCoord(unsigned int node);
+
+        /**
+         * @brief Get the number of the node.
+         */
+        [[nodiscard]] unsigned int node() const;
+
+        /**
+         * @brief Convert the coordinate to a human-readable string.
+         *
+         * @return a human-readable form of the `Coord` as `std::string`.
+         */
+        [[nodiscard]] std::string to_string() const override;
+
+        /**
+         * @brief Test if two coordinates are equal
+         */
+        friend bool operator==(
+                const NodeCoord&,
+                const NodeCoord&
+        );
+
+        /**
+         * @brief Test if two coordinates are not equal
+         */
+        friend bool operator!=(
+                const NodeCoord&,
+                const NodeCoord&
+        );
+
+        /**
+         * @brief Output a given coordinate to the specified stream
+         */
+        friend std::ostream& operator<<(
+                std::ostream&,
+                const NodeCoord&
+        );
+
+    private:
+        unsigned int _node;
+    };
+
+    /**
+     * @brief The adjacency of a network
+     *
+     * @details A graph has a fixed number of nodes.  The neighbors of each
+     * node are available as a contiguous span, so that walking them does not
+     * allocate.  In a directed graph, the neighbors of a node are those its
+     * edges lead to.  Graphs are simple: duplicate edges are merged and
+     * self-loops are dropped.
+     *
+     * @see `CSRGraph`
+     * @see `NetworkDomain`
+     */
+    class LIBKAMI_EXPORT NetworkGraph {
+    public:
+        virtual ~NetworkGraph() = default;
+
+        /**
+         * @brief Get the number of nodes in the graph.
+         */
+        [[nodiscard]] virtual unsigned int get_node_count() const = 0;
+
+        /**
+         * @brief Get the number of edges in the graph.
+         *
+         * @details An undirected edge is counted once.
+         */
+        [[nodiscard]] virtual std::size_t get_edge_count() const = 0;
+
+        /**
+         * @brief Inquire whether the edges of the graph are directed.
+         */
+        [[nodiscard]] virtual bool is_directed() const = 0;
+
+        /**
+         * @brief Get the neighbors of a node
+         *
+         * @details The span is into the graph's own storage and is only
+         * valid until the graph is next modified.
+         *
+         * @param[in] node a node in the graph.
+         *
+         * @return a span of the neighboring nodes.
+         */
+        [[nodiscard]] virtual std::span<const unsigned int> get_neighbors(unsigned int node) const = 0;
+
+        /**
+         * @brief Inquire if there is an edge between two nodes
+         *
+         * @param[in] from a node in the graph.
+         * @param[in] to a node in the graph.
+         *
+         * @return true if an edge leads from `from` to `to`, false otherwise.
+         */
+        [[nodiscard]] virtual bool has_edge(
+                unsigned int from,
+                unsigned int to
+        ) const = 0;
+
+        /**
+         * @brief Get the number of neighbors of a node.
+         *
+         * @param[in] node a node in the graph.
+         */
+        [[nodiscard]] std::size_t get_degree(unsigned int node) const;
+    };
+
+    /**
+     * @brief A network domain where each node may contain agents
+     *
+     * @details The network is defined by a `NetworkGraph`, which the domain
+     * shares and does not copy.  The graph may be changed while the domain
+     * is in use, but not its number of nodes.  Queries mirror those of the
+     * grid domains, with the neighborhood of a node being its neighbors in
+     * the graph.
+     *
+     * @see `MultiNetwork`
+     * @see `SoloNetwork`
+     */
+    class LIBKAMI_EXPORT NetworkDomain
+            : public Domain {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * @param[in] graph the graph of the network.
+         */
+        explicit NetworkDomain(std::shared_ptr<const NetworkGraph> graph);
+
+        /**
+         * @brief Place agent on the network at the specified node.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to add.
+         * @param[in] coord the coordinates of the agent.
+         *
+         * @returns the `AgentID` of the agent placed
+         */
+        virtual AgentID add_agent(
+                AgentID agent_id,
+                const NodeCoord& coord
+        ) = 0;
+
+        /**
+         * @brief Remove agent from the network.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to remove.
+         *
+         * @returns the `AgentID` of the agent removed
+         */
+        AgentID delete_agent(AgentID agent_id);
+
+        /**
+         * @brief Remove agent from the network at the specified node
+         *
+         * @param[in] agent_id the `AgentID` of the agent to remove.
+         * @param[in] coord the coordinates of the agent.
+         *
+         * @returns the `AgentID` of the agent removed
+         */
+        virtual AgentID delete_agent(
+                AgentID agent_id,
+                const NodeCoord& coord
+        ) = 0;
+
+        /**
+         * @brief Move an agent to the specified node.
+         *
+         * @details Agents may move to any node, not only to neighbors.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to move.
+         * @param[in] coord the coordinates of the destination.
+         *
+         * @returns the `AgentID` of the agent moved
+         */
+        virtual AgentID move_agent(
+                AgentID agent_id,
+                const NodeCoord& coord
+        ) = 0;
+
+        /**
+         * @brief Inquire if the specified node is empty.
+         *
+         * @param[in] coord the coordinates of the query.
+         *
+         * @return true if the node has no `Agent`s occupying it, false
+         * otherwise.
+         */
+        [[nodiscard]] virtual bool is_location_empty(const NodeCoord& coord) const = 0;
+
+        /**
+         * @brief Inquire if the specified node is in the network.
+         *
+         * @param[in] coord the coordinates of the query.
+         *
+         * @return true if the node is in the network, false otherwise.
+         */
+        [[nodiscard]] bool is_location_valid(const NodeCoord& coord) const;
+
+        /**
+         * @brief Get the location of the specified agent.
+         *
+         * @param[in] agent_id the `AgentID` of the agent in question.
+         *
+         * @return the location of the specified `Agent`
+         */
+        [[nodiscard]] NodeCoord get_location_by_agent(const AgentID& agent_id) const;
+
+        /**
+         * @brief Get the contents of the specified node.
+         *
+         * @param[in] coord the coordinates of the query.
+         *
+         * @return a pointer to a `set` of `AgentID`s.
+         */
+        [[nodiscard]] virtual std::shared_ptr<std::set<AgentID>>
+        get_location_contents(const NodeCoord& coord) const = 0;
+
+        /**
+         * @brief Get a view of the contents of the specified node.
+         *
+         * @details The view is into the domain's own storage and is only
+         * valid until the domain is next modified.  The order of the agents
+         * within the view is unspecified.
+         *
+         * @param[in] coord the coordinates of a valid node.
+         *
+         * @return a span of the `AgentID`s at the node.
+         */
+        [[nodiscard]] virtual std::span<const AgentID> get_location_view(const NodeCoord& coord) const = 0;
+
+        /**
+         * @brief Get the graph of the network.
+         */
+        [[nodiscard]] std::shared_ptr<const NetworkGraph> get_graph() const;
+
+        /**
+         * @brief Replace the graph of the network
+         *
+         * @details Agents stay on their nodes.  This allows a model to
+         * query a frozen snapshot of a `DynamicGraph` for part of a step
+         * and change the edges for the rest.
+         *
+         * @param[in] graph the new graph, with the same number of nodes.
+         *
+         * @throws error::OptionInvalid if the number of nodes differs.
+         */
+        void set_graph(std::shared_ptr<const NetworkGraph> graph);
+
+        /**
+         * @brief Return the neighborhood of the specified Agent
+         *
+         * @param[in] agent_id the `AgentID` of the agent in question.
+         * @param[in] include_center should the node occupied by the agent be
+         * in the list.
+         *
+         * @return a set of `NodeCoord` that includes all of the neighboring
+         * nodes.
+         */
+        [[nodiscard]] std::shared_ptr<std::unordered_set<NodeCoord>>
+        get_neighborhood(
+                AgentID agent_id,
+                bool include_center
+        ) const;
+
+        /**
+         * @brief Return the neighborhood of the specified node
+         *
+         * @param[in] coord the coordinates of the specified node.
+         * @param[in] include_center should the node itself be in the list.
+         *
+         * @return a set of `NodeCoord` that includes all of the neighboring
+         * nodes.
+         */
+        [[nodiscard]] std::shared_ptr<std::unordered_set<NodeCoord>>
+        get_neighborhood(
+                const NodeCoord& coord,
+                bool include_center
+        ) const;
+
+        /**
+         * @brief Visit each neighbor of the specified node
+         *
+         * @details Neighbors are visited in the order the graph stores
+         * them, and nothing is allocated.
+         *
+         * @param[in] coord the coordinates of a valid node.
+         * @param[in] include_center should the node itself be visited, first.
+         * @param[in] visitor a callable taking a `const NodeCoord&`.  If it
+         * returns `bool`, returning false ends the visit.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         */
+        template<typename Visitor>
+        bool for_each_neighbor(
+                const NodeCoord& coord,
+                bool include_center,
+                Visitor&& visitor
+        ) const;
+
+        /**
+         * @brief Visit each agent in the neighborhood of the specified node
+         *
+         * @details Node storage is scanned directly, and no containers are
+         * built.  Neither the domain nor the graph may be modified during
+         * the visit.
+         *
+         * @param[in] coord the coordinates of a valid node.
+         * @param[in] include_center should agents at the node itself be
+         * visited.
+         * @param[in] visitor a callable taking an `AgentID`.  If it returns
+         * `bool`, returning false ends the visit.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         */
+        template<typename Visitor>
+        bool for_each_agent_in_neighborhood(
+                const NodeCoord& coord,
+                bool include_center,
+                Visitor&& visitor
+        ) const;
+
+        /**
+         * @brief Visit each matching agent in the neighborhood of the specified
+         * node
+         *
+         * @param[in] coord the coordinates of a valid node.
+         * @param[in] include_center should agents at the node itself be
+         * visited.
+         * @param[in] filter a predicate taking an `AgentID`; only agents for
+         * which it returns true are visited.
+         * @param[in] visitor a callable taking an `AgentID`.  If it returns
+         * `bool`, returning false ends the visit.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         */
+        template<typename Filter, typename Visitor>
+        bool for_each_agent_in_neighborhood(
+                const NodeCoord& coord,
+                bool include_center,
+                Filter&& filter,
+                Visitor&& visitor
+        ) const;
+
+        /**
+         * @brief Choose a random node in the neighborhood of the specified
+         * node
+         *
+         * @details Each node of the neighborhood is equally likely.  This
+         * is a single draw, and nothing is allocated.
+         *
+         * @param[in] coord the coordinates of a valid node.
+         * @param[in] include_center may the node itself be chosen.
+         * @param[in] rng a uniform random bit generator.
+         *
+         * @return the chosen node, or nothing if the neighborhood is empty.
+         */
+        template<typename URBG>
+        std::optional<NodeCoord> random_neighbor_cell(
+                const NodeCoord& coord,
+                bool include_center,
+                URBG& rng
+        ) const;
+
+        /**
+         * @brief Choose a random agent at the specified node
+         *
+         * @details This is a single draw from the node's storage.
+         *
+         * @param[in] coord the coordinates of the specified node.
+         * @param[in] rng a uniform random bit generator.
+         *
+         * @return the `AgentID` of the chosen agent, or nothing if the
+         * node is empty.
+         */
+        template<typename URBG>
+        std::optional<AgentID> random_agent_at(
+                const NodeCoord& coord,
+                URBG& rng
+        ) const;
+
+        /**
+         * @brief Choose a random agent at the specified node, other than
+         * the one given
+         *
+         * @param[in] coord the coordinates of the specified node.
+         * @param[in] agent_id the `AgentID` of the agent to pass over.
+         * @param[in] rng a uniform random bit generator.
+         *
+         * @return the `AgentID` of the chosen agent, or nothing if there
+         * are no other agents at the node.
+         */
+        template<typename URBG>
+        std::optional<AgentID> random_other_agent_at(
+                const NodeCoord& coord,
+                AgentID agent_id,
+                URBG& rng
+        ) const;
+
+    protected:
+        /**
+         * @brief The graph of the network
+         */
+        std::shared_ptr<const NetworkGraph> _graph;
+
+        /**
+         * @brief The node of each agent, keyed by `AgentID`
+         */
+        AgentIndex<unsigned int> _agent_index;
+    };
+
+    template<typename Visitor>
+    bool NetworkDomain::for_each_neighbor(
+            const NodeCoord& coord,
+            const bool include_center,
+            Visitor&& visitor
+    ) const {
+        if (include_center && !stencil::visit(visitor, coord))
+            return false;
+        for (auto neighbor : _graph->get_neighbors(coord.node()))
+            if (!stencil::visit(visitor, NodeCoord(neighbor)))
+                return false;
+        return true;
+    }
+
+    template<typename Visitor>
+    bool NetworkDomain::for_each_agent_in_neighborhood(
+            const NodeCoord& coord,
+            const bool include_center,
+            Visitor&& visitor
+    ) const {
+        return for_each_neighbor(coord, include_center, [this, &visitor](const NodeCoord& node) {
+            for (auto agent_id : get_location_view(node))
+                if (!stencil::visit(visitor, agent_id))
+                    return false;
+            return true;
+        });
+    }
+
+    template<typename Filter, typename Visitor>
+    bool NetworkDomain::for_each_agent_in_neighborhood(
+            const NodeCoord& coord,
+            const bool include_center,
+            Filter&& filter,
+            Visitor&& visitor
+    ) const {
+        return for_each_agent_in_neighborhood(coord, include_center, [&filter, &visitor](const AgentID agent_id) {
+            return !filter(agent_id) || stencil::visit(visitor, agent_id);
+        });
+    }
+
+    template<typename URBG>
+    std::optional<NodeCoord> NetworkDomain::random_neighbor_cell(
+            const NodeCoord& coord,
+            const bool include_center,
+            URBG& rng
+    ) const {
+        if (!is_location_valid(coord))
+            throw error::LocationInvalid("Coordinates " + coord.to_string() + " are invalid");
+
+        auto neighbors = _graph->get_neighbors(coord.node());
+        auto count = neighbors.size() + (include_center ? 1 : 0);
+        if (count == 0)
+            return std::nullopt;
+
+        auto index = std::uniform_int_distribution<std::size_t>(0, count - 1)(rng);
+        if (index == neighbors.size())
+            return coord;
+        return NodeCoord(neighbors[index]);
+    }
+
+    template<typename URBG>
+    std::optional<AgentID> NetworkDomain::random_agent_at(
+            const NodeCoord& coord,
+            URBG& rng
+    ) const {
+        if (!is_location_valid(coord))
+            throw error::LocationInvalid("Coordinates " + coord.to_string() + " are invalid");
+
+        auto agent_ids = get_location_view(coord);
+        if (agent_ids.empty())
+            return std::nullopt;
+        return agent_ids[std::uniform_int_distribution<std::size_t>(0, agent_ids.size() - 1)(rng)];
+    }
+
+    template<typename URBG>
+    std::optional<AgentID> NetworkDomain::random_other_agent_at(
+            const NodeCoord& coord,
+            const AgentID agent_id,
+            URBG& rng
+    ) const {
+        if (!is_location_valid(coord))
+            throw error::LocationInvalid("Coordinates " + coord.to_string() + " are invalid");
+
+        auto agent_ids = get_location_view(coord);
+        if (agent_ids.empty() || (agent_ids.size() == 1 && agent_ids[0] == agent_id))
+            return std::nullopt;
+
+        std::uniform_int_distribution<std::size_t> dist(0, agent_ids.size() - 1);
+        while (true) {
+            auto other_agent_id = agent_ids[dist(rng)];
+            if (other_agent_id != agent_id)
+                return other_agent_id;
+        }
+    }
+
+}  // namespace kami
+
+//! @cond SuppressHashMethod
+namespace std {
+    template<>
+    struct hash<kami::NodeCoord> {
+        size_t operator()(const kami::NodeCoord& key) const {
+            return hash<unsigned int>()(key.node());
+        }
+    };
+}  // namespace std
+//! @endcond
+
+#endif  // KAMI_NETWORK_H
@@ -0,0 +1,155 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef KAMI_ORDERED_H
+//! @cond SuppressGuard
+#define KAMI_ORDERED_H
+//! @endcond
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <kami/agent.h>
+#include <kami/kami.h>
+#include <kami/model.h>
+#include <kami/scheduler.h>
+#include <kami/sequential.h>
+
+namespace kami {
+
+    /**
+     * @brief Will execute all agent steps in order of a key.
+     *
+     * @details An ordered scheduler will take a key, such as wealth,
+     * arrival time, or bid, from each agent assigned to the scheduler
+     * and call their `step()` function in ascending, or descending,
+     * order of that key.  Agents with equal keys are executed in
+     * `AgentID` order, so the order is reproducible from run to run.
+     *
+     * The keys are taken, in parallel on the model's `Executor`, into a
+     * flat array at the start of each step and sorted there by a
+     * parallel radix sort.  The key function must therefore be safe to
+     * call concurrently, which is the case for any function that only
+     * reads the agent given to it.
+     *
+     * @see `radix_sort()`
+     */
+    class LIBKAMI_EXPORT OrderedScheduler
+            : public SequentialScheduler {
+    public:
+        /**
+         * @brief A function returning the key of an `Agent`
+         */
+        typedef std::function<double(const std::shared_ptr<Agent>&)> Key;
+
+        /**
+         * @brief Constructor.
+         *
+         * @param[in] key a function returning the key of an agent
+         * @param[in] descending should agents with larger keys be
+         * executed first
+         */
+        explicit OrderedScheduler(
+                Key key,
+                bool descending = false
+        );
+
+        /**
+         * @brief Execute a single time step.
+         *
+         * @details This method will sort the list of Agents provided
+         * by key then execute the `Agent::step()` method for every Agent
+         * listed.
+         *
+         * @param model a reference copy of the model
+         * @param agent_list list of agents to execute the step
+         *
+         * @returns returns vector of agents successfully stepped
+         */
+        std::unique_ptr<std::vector<AgentID>>
+        step(
+                std::shared_ptr<Model> model,
+                std::unique_ptr<std::vector<AgentID>> agent_list
+        ) override;
+
+        /**
+         * @brief Execute a single time step for a `ReporterModel`
+         *
+         * @details This method will sort the list of Agents provided
+         * by key then execute the `Agent::step()` method for every Agent
+         * listed.
+         *
+         * @param model a reference copy of the `ReporterModel`
+         * @param agent_list list of agents to execute the step
+         *
+         * @returns returns vector of agents successfully stepped
+         */
+        std::unique_ptr<std::vector<AgentID>>
+        step(
+                std::shared_ptr<ReporterModel> model,
+                std::unique_ptr<std::vector<AgentID>> agent_list
+        ) override;
+
+        /**
+         * @brief Sort a list of agents by key
+         *
+         * @param model a reference copy of the model
+         * @param agent_list list of agents to sort
+         *
+         * @returns the agents, in the order they would be executed
+         */
+        std::unique_ptr<std::vector<AgentID>>
+        sort(
+                const std::shared_ptr<Model>& model,
+                std::unique_ptr<std::vector<AgentID>> agent_list
+        ) const;
+
+        /**
+         * @brief Inquire if agents with larger keys are executed first
+         *
+         * @return true if the order is descending, and false otherwise
+         */
+        [[nodiscard]] bool get_descending() const;
+
+        /**
+         * @brief Set the direction of the order
+         *
+         * @param[in] descending should agents with larger keys be
+         * executed first
+         *
+         * @return true if the order is descending, and false otherwise
+         */
+        bool set_descending(bool descending);
+
+    private:
+        Key _key;
+        bool _descending;
+    };
+
+}  // namespace kami
+
+#endif  // KAMI_ORDERED_H
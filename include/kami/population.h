@@ -76,6 +76,19 @@ namespace kami {
          */
         [[nodiscard]] std::unique_ptr<std::vector<AgentID>> get_agent_list() const;
 
+        /**
+         * @brief Get the revision of the Population.
+         *
+         * @details The revision is incremented every time an `Agent` is
+         * added to or deleted from the `Population`, so derived data, such
+         * as a cached agent ordering, can be reused for as long as the
+         * revision is unchanged.  Subclasses that manipulate `_agent_map`
+         * directly should increment `_revision` as well.
+         *
+         * @returns the current revision
+         */
+        [[nodiscard]] unsigned long long get_revision() const;
+
     protected:
         /**
          * @brief A mapping of `AgentID` to `Agent` pointers
@@ -86,6 +99,11 @@ namespace kami {
          * wish to manipulate this mapping directly.
          */
         std::map<kami::AgentID, std::shared_ptr<Agent>> _agent_map;
+
+        /**
+         * @brief The number of changes made to `_agent_map`
+         */
+        unsigned long long _revision = 0;
     };
 }  // namespace kami
 
@@ -33,12 +33,18 @@
 
 #include <kami/grid1d.h>
 #include <kami/grid2d.h>
+#include <kami/grid3d.h>
+#include <kami/hexgrid.h>
+#include <kami/network.h>
 
 namespace kami {
 
     typedef std::variant<
             GridCoord1D,
-            GridCoord2D
+            GridCoord2D,
+            GridCoord3D,
+            HexCoord,
+            NodeCoord
     > Position;
 
 }
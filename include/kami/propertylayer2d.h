@@ -0,0 +1,590 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef KAMI_PROPERTYLAYER2D_H
+//! @cond SuppressGuard
+#define KAMI_PROPERTYLAYER2D_H
+//! @endcond
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <kami/error.h>
+#include <kami/executor.h>
+#include <kami/grid.h>
+#include <kami/grid2d.h>
+#include <kami/stencil.h>
+
+namespace kami {
+
+    /**
+     * @brief A scalar field over the cells of a two-dimensional grid
+     *
+     * @details A property layer holds one value per cell, such as the sugar
+     * in a Sugarscape model or the pheromone in an ant model, beside the
+     * agents placed on a grid.  Values are stored contiguously in row-major
+     * order, the same order as `Grid2D` uses for its own per-cell storage,
+     * and coordinates wrap by the same rules as the grid's.  Reading or
+     * writing a value by coordinate takes constant time.
+     *
+     * The kernels that update the whole layer are plain loops over the
+     * contiguous values, which the compiler vectorizes, and will divide
+     * their work among the threads of an `Executor` when given one.
+     *
+     * @tparam T the arithmetic type of the values
+     */
+    template<typename T>
+    class PropertyLayer2D {
+        static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+                      "PropertyLayer2D values must be arithmetic and not bool");
+
+    public:
+        /**
+         * @brief Constructor
+         *
+         * @param[in] maximum_x the length of the layer in the first dimension
+         * @param[in] maximum_y the length of the layer in the second dimension
+         * @param[in] wrap_x should the layer wrap around on itself in the
+         * first dimension
+         * @param[in] wrap_y should the layer wrap around on itself in the
+         * second dimension
+         * @param[in] value the initial value of every cell
+         *
+         * @throws error::OptionInvalid if either dimension is zero.
+         */
+        PropertyLayer2D(
+                unsigned int maximum_x,
+                unsigned int maximum_y,
+                bool wrap_x = false,
+                bool wrap_y = false,
+                T value = T{}
+        );
+
+        /**
+         * @brief Constructor for a layer matching a grid
+         *
+         * @param[in] grid the grid whose dimensions and wrapping to share
+         * @param[in] value the initial value of every cell
+         */
+        explicit PropertyLayer2D(
+                const Grid2D& grid,
+                T value = T{}
+        );
+
+        /**
+         * @brief Inquire if the specified location is valid.
+         *
+         * @param[in] coord the coordinates of the query, which are wrapped
+         * first where the layer wraps.
+         *
+         * @return true if the location is on the layer, false otherwise.
+         */
+        [[nodiscard]] bool is_location_valid(const GridCoord2D& coord) const;
+
+        /**
+         * @brief Get the value at a location
+         *
+         * @param[in] coord the coordinates of the location.
+         *
+         * @return the value
+         *
+         * @throws error::LocationInvalid if the location is not valid.
+         */
+        [[nodiscard]] T get(const GridCoord2D& coord) const;
+
+        /**
+         * @brief Set the value at a location
+         *
+         * @param[in] coord the coordinates of the location.
+         * @param[in] value the new value.
+         *
+         * @throws error::LocationInvalid if the location is not valid.
+         */
+        void set(
+                const GridCoord2D& coord,
+                T value
+        );
+
+        /**
+         * @brief Get a reference to the value at a location
+         *
+         * @details The reference remains valid until the layer is assigned
+         * to or swapped, as by `StencilEngine2D::step()`.
+         *
+         * @param[in] coord the coordinates of the location.
+         *
+         * @return a reference to the value
+         *
+         * @throws error::LocationInvalid if the location is not valid.
+         */
+        [[nodiscard]] T& at(const GridCoord2D& coord);
+
+        /**
+         * @brief Get the values of the layer
+         *
+         * @return the values, in row-major order
+         */
+        [[nodiscard]] std::span<T> get_values();
+
+        /**
+         * @brief Get the values of the layer
+         *
+         * @return the values, in row-major order
+         */
+        [[nodiscard]] std::span<const T> get_values() const;
+
+        /**
+         * @brief Set every value to a constant
+         *
+         * @param[in] value the new value.
+         * @param[in] executor the `Executor` to use, or `nullptr` to run on
+         * the calling thread only.
+         */
+        void fill(
+                T value,
+                Executor* executor = nullptr
+        );
+
+        /**
+         * @brief Multiply every value by a constant
+         *
+         * @param[in] factor the multiplier.
+         * @param[in] executor the `Executor` to use, or `nullptr` to run on
+         * the calling thread only.
+         */
+        void scale(
+                T factor,
+                Executor* executor = nullptr
+        );
+
+        /**
+         * @brief Add a constant to every value
+         *
+         * @param[in] value the addend.
+         * @param[in] executor the `Executor` to use, or `nullptr` to run on
+         * the calling thread only.
+         */
+        void add(
+                T value,
+                Executor* executor = nullptr
+        );
+
+        /**
+         * @brief Add a multiple of another layer, cell by cell
+         *
+         * @param[in] other the layer to add, which may be this one.
+         * @param[in] factor the multiplier for the other layer.
+         * @param[in] executor the `Executor` to use, or `nullptr` to run on
+         * the calling thread only.
+         *
+         * @throws error::OptionInvalid if the layers differ in size.
+         */
+        void add(
+                const PropertyLayer2D& other,
+                T factor = T{1},
+                Executor* executor = nullptr
+        );
+
+        /**
+         * @brief Remove a fraction of every value
+         *
+         * @details For integral values, what remains is rounded toward zero.
+         *
+         * @param[in] rate the fraction to remove, within `[0, 1]`.
+         * @param[in] executor the `Executor` to use, or `nullptr` to run on
+         * the calling thread only.
+         *
+         * @throws error::OptionInvalid if the rate is out of range.
+         */
+        void evaporate(
+                double rate,
+                Executor* executor = nullptr
+        );
+
+        /**
+         * @brief Replace every value with a function of itself
+         *
+         * @param[in] function a callable taking and returning a `T`.  With
+         * an `Executor`, it is called concurrently.
+         * @param[in] executor the `Executor` to use, or `nullptr` to run on
+         * the calling thread only.
+         */
+        template<typename Function>
+        void apply(
+                Function&& function,
+                Executor* executor = nullptr
+        );
+
+        /**
+         * @brief Sum each cell's neighborhood into another layer
+         *
+         * @details Each cell of the result is the sum of the values of
+         * this layer over the cell's neighborhood, found by the same rules
+         * as `Grid2D::get_neighborhood()`.  The sum is accumulated one
+         * stencil offset at a time over whole rows, so that the inner loop
+         * reads and writes contiguous values.
+         *
+         * @param[out] result the layer to hold the sums, of the same size as
+         * this one and not this one.
+         * @param[in] neighborhood_type the neighborhood type.
+         * @param[in] radius the radius of the neighborhood.
+         * @param[in] include_center should the center-point be counted.
+         * @param[in] executor the `Executor` to use, or `nullptr` to run on
+         * the calling thread only.
+         *
+         * @throws error::OptionInvalid if the result is this layer or
+         * differs in size.
+         */
+        void neighborhood_sum(
+                PropertyLayer2D& result,
+                GridNeighborhoodType neighborhood_type,
+                unsigned int radius = 1,
+                bool include_center = true,
+                Executor* executor = nullptr
+        ) const;
+
+        /**
+         * @brief Get the sum of every value
+         */
+        [[nodiscard]] T sum() const;
+
+        /**
+         * @brief Get the size of the layer in the `x` dimension.
+         */
+        [[nodiscard]] unsigned int get_maximum_x() const;
+
+        /**
+         * @brief Get the size of the layer in the `y` dimension.
+         */
+        [[nodiscard]] unsigned int get_maximum_y() const;
+
+        /**
+         * @brief Inquire whether the layer wraps in the `x` dimension.
+         */
+        [[nodiscard]] bool get_wrap_x() const;
+
+        /**
+         * @brief Inquire whether the layer wraps in the `y` dimension.
+         */
+        [[nodiscard]] bool get_wrap_y() const;
+
+    private:
+        static constexpr std::size_t grain = 1u << 14;
+
+        unsigned int _maximum_x, _maximum_y;
+        bool _wrap_x, _wrap_y;
+        std::vector<T> _values;
+
+        [[nodiscard]] std::size_t index_of(const GridCoord2D& coord) const;
+
+        void check_size(const PropertyLayer2D& other) const;
+
+        template<typename Body>
+        static void for_each_chunk(
+                Executor* executor,
+                std::size_t count,
+                std::size_t chunk_size,
+                Body&& body
+        );
+    };
+
+    template<typename T>
+    PropertyLayer2D<T>::PropertyLayer2D(
+            const unsigned int maximum_x,
+            const unsigned int maximum_y,
+            const bool wrap_x,
+            const bool wrap_y,
+            const T value
+    )
+            :_maximum_x(maximum_x), _maximum_y(maximum_y), _wrap_x(wrap_x), _wrap_y(wrap_y) {
+        if (maximum_x == 0 || maximum_y == 0)
+            throw error::OptionInvalid(fmt::format("Layer dimensions {} by {} are invalid", maximum_x, maximum_y));
+        _values.assign(static_cast<std::size_t>(maximum_x) * maximum_y, value);
+    }
+
+    template<typename T>
+    PropertyLayer2D<T>::PropertyLayer2D(
+            const Grid2D& grid,
+            const T value
+    )
+            :PropertyLayer2D(grid.get_maximum_x(), grid.get_maximum_y(), grid.get_wrap_x(), grid.get_wrap_y(),
+                             value) {
+    }
+
+    template<typename T>
+    bool PropertyLayer2D<T>::is_location_valid(const GridCoord2D& coord) const {
+        auto x = coord.x();
+        auto y = coord.y();
+
+        return (_wrap_x || (x >= 0 && x < static_cast<int>(_maximum_x))) &&
+               (_wrap_y || (y >= 0 && y < static_cast<int>(_maximum_y)));
+    }
+
+    template<typename T>
+    T PropertyLayer2D<T>::get(const GridCoord2D& coord) const {
+        return _values[index_of(coord)];
+    }
+
+    template<typename T>
+    void PropertyLayer2D<T>::set(
+            const GridCoord2D& coord,
+            const T value
+    ) {
+        _values[index_of(coord)] = value;
+    }
+
+    template<typename T>
+    T& PropertyLayer2D<T>::at(const GridCoord2D& coord) {
+        return _values[index_of(coord)];
+    }
+
+    template<typename T>
+    std::span<T> PropertyLayer2D<T>::get_values() {
+        return _values;
+    }
+
+    template<typename T>
+    std::span<const T> PropertyLayer2D<T>::get_values() const {
+        return _values;
+    }
+
+    template<typename T>
+    void PropertyLayer2D<T>::fill(
+            const T value,
+            Executor* executor
+    ) {
+        auto* values = _values.data();
+
+        for_each_chunk(executor, _values.size(), grain, [values, value](std::size_t begin, std::size_t end) {
+            std::fill(values + begin, values + end, value);
+        });
+    }
+
+    template<typename T>
+    void PropertyLayer2D<T>::scale(
+            const T factor,
+            Executor* executor
+    ) {
+        auto* values = _values.data();
+
+        for_each_chunk(executor, _values.size(), grain, [values, factor](std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; i++)
+                values[i] *= factor;
+        });
+    }
+
+    template<typename T>
+    void PropertyLayer2D<T>::add(
+            const T value,
+            Executor* executor
+    ) {
+        auto* values = _values.data();
+
+        for_each_chunk(executor, _values.size(), grain, [values, value](std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; i++)
+                values[i] += value;
+        });
+    }
+
+    template<typename T>
+    void PropertyLayer2D<T>::add(
+            const PropertyLayer2D& other,
+            const T factor,
+            Executor* executor
+    ) {
+        check_size(other);
+        auto* values = _values.data();
+        const auto* addends = other._values.data();
+
+        for_each_chunk(executor, _values.size(), grain, [=](std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; i++)
+                values[i] += factor * addends[i];
+        });
+    }
+
+    template<typename T>
+    void PropertyLayer2D<T>::evaporate(
+            const double rate,
+            Executor* executor
+    ) {
+        if (!(rate >= 0.0 && rate <= 1.0))
+            throw error::OptionInvalid(fmt::format("Evaporation rate {} is invalid", rate));
+
+        if constexpr (std::is_floating_point_v<T>) {
+            scale(static_cast<T>(1.0 - rate), executor);
+        } else {
+            auto* values = _values.data();
+            const auto remain = 1.0 - rate;
+
+            for_each_chunk(executor, _values.size(), grain, [values, remain](std::size_t begin, std::size_t end) {
+                for (auto i = begin; i < end; i++)
+                    values[i] = static_cast<T>(static_cast<double>(values[i]) * remain);
+            });
+        }
+    }
+
+    template<typename T>
+    template<typename Function>
+    void PropertyLayer2D<T>::apply(
+            Function&& function,
+            Executor* executor
+    ) {
+        auto* values = _values.data();
+
+        for_each_chunk(executor, _values.size(), grain, [values, &function](std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; i++)
+                values[i] = function(values[i]);
+        });
+    }
+
+    template<typename T>
+    void PropertyLayer2D<T>::neighborhood_sum(
+            PropertyLayer2D& result,
+            const GridNeighborhoodType neighborhood_type,
+            const unsigned int radius,
+            const bool include_center,
+            Executor* executor
+    ) const {
+        if (&result == this)
+            throw error::OptionInvalid("Neighborhood sums cannot be taken in place");
+        check_size(result);
+
+        const auto& offsets = stencil::get_2d(neighborhood_type, radius);
+        const auto maximum_x = static_cast<int>(_maximum_x);
+        const auto maximum_y = static_cast<int>(_maximum_y);
+        const auto* values = _values.data();
+        auto* sums = result._values.data();
+        const auto rows_per_chunk = std::max<std::size_t>(1, grain / _maximum_x);
+
+        for_each_chunk(executor, _maximum_y, rows_per_chunk, [&](std::size_t begin, std::size_t end) {
+            for (auto y = static_cast<int>(begin); y < static_cast<int>(end); y++) {
+                auto* sum_row = sums + static_cast<std::size_t>(y) * _maximum_x;
+                std::fill(sum_row, sum_row + maximum_x, T{});
+
+                for (const auto& offset : offsets) {
+                    if (!include_center && offset.dx == 0 && offset.dy == 0)
+                        continue;
+
+                    auto source_y = y + offset.dy;
+                    if (source_y < 0 || source_y >= maximum_y) {
+                        if (!_wrap_y)
+                            continue;
+                        source_y = stencil::wrap(source_y, maximum_y);
+                    }
+                    const auto* row = values + static_cast<std::size_t>(source_y) * _maximum_x;
+                    const auto dx = offset.dx;
+
+                    // The cells whose source needs no wrapping form one run
+                    auto first = std::clamp(-dx, 0, maximum_x);
+                    auto last = std::clamp(maximum_x - dx, first, maximum_x);
+                    for (auto x = first; x < last; x++)
+                        sum_row[x] += row[x + dx];
+
+                    if (_wrap_x) {
+                        for (auto x = 0; x < first; x++)
+                            sum_row[x] += row[stencil::wrap(x + dx, maximum_x)];
+                        for (auto x = last; x < maximum_x; x++)
+                            sum_row[x] += row[stencil::wrap(x + dx, maximum_x)];
+                    }
+                }
+            }
+        });
+    }
+
+    template<typename T>
+    T PropertyLayer2D<T>::sum() const {
+        T total{};
+
+        for (auto value : _values)
+            total += value;
+        return total;
+    }
+
+    template<typename T>
+    unsigned int PropertyLayer2D<T>::get_maximum_x() const {
+        return _maximum_x;
+    }
+
+    template<typename T>
+    unsigned int PropertyLayer2D<T>::get_maximum_y() const {
+        return _maximum_y;
+    }
+
+    template<typename T>
+    bool PropertyLayer2D<T>::get_wrap_x() const {
+        return _wrap_x;
+    }
+
+    template<typename T>
+    bool PropertyLayer2D<T>::get_wrap_y() const {
+        return _wrap_y;
+    }
+
+    template<typename T>
+    std::size_t PropertyLayer2D<T>::index_of(const GridCoord2D& coord) const {
+        auto x = coord.x();
+        auto y = coord.y();
+
+        if (_wrap_x)
+            x = stencil::wrap(x, static_cast<int>(_maximum_x));
+        if (_wrap_y)
+            y = stencil::wrap(y, static_cast<int>(_maximum_y));
+        if (x < 0 || x >= static_cast<int>(_maximum_x) || y < 0 || y >= static_cast<int>(_maximum_y))
+            throw error::LocationInvalid(fmt::format("Coordinates {} are invalid", coord.to_string()));
+        return static_cast<std::size_t>(y) * _maximum_x + static_cast<std::size_t>(x);
+    }
+
+    template<typename T>
+    void PropertyLayer2D<T>::check_size(const PropertyLayer2D& other) const {
+        if (other._maximum_x != _maximum_x || other._maximum_y != _maximum_y)
+            throw error::OptionInvalid(
+                    fmt::format("Layer of {} by {} does not match layer of {} by {}", other._maximum_x,
+                                other._maximum_y, _maximum_x, _maximum_y));
+    }
+
+    template<typename T>
+    template<typename Body>
+    void PropertyLayer2D<T>::for_each_chunk(
+            Executor* executor,
+            const std::size_t count,
+            const std::size_t chunk_size,
+            Body&& body
+    ) {
+        if (executor == nullptr || count <= chunk_size)
+            body(std::size_t{0}, count);
+        else
+            executor->parallel_for(0, count, chunk_size, body);
+    }
+
+}  // namespace kami
+
+#endif  // KAMI_PROPERTYLAYER2D_H
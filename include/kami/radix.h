@@ -0,0 +1,88 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef KAMI_RADIX_H
+//! @cond SuppressGuard
+#define KAMI_RADIX_H
+//! @endcond
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <kami/executor.h>
+#include <kami/kami.h>
+
+namespace kami {
+
+    /**
+     * @brief Convert a `double` to an unsigned key with the same ordering
+     *
+     * @details The key of a smaller value is smaller than the key of a
+     * larger value, so `double` values may be sorted by `radix_sort()`.
+     * Negative and positive zero share a key.  NaN values, whatever
+     * their sign or payload, share a key that sorts after all other
+     * values.
+     *
+     * @param[in] value the value to convert
+     *
+     * @returns the key
+     */
+    LIBKAMI_EXPORT std::uint64_t radix_key(double value);
+
+    /**
+     * @brief Convert a signed integer to an unsigned key with the same ordering
+     *
+     * @param[in] value the value to convert
+     *
+     * @returns the key
+     */
+    LIBKAMI_EXPORT std::uint64_t radix_key(std::int64_t value);
+
+    /**
+     * @brief Sort values by key using a parallel LSD radix sort
+     *
+     * @details The `keys` are sorted in ascending order and the `values`
+     * are permuted along with them.  The sort is stable, so values with
+     * equal keys retain their relative order.  Each of the eight byte-wide
+     * passes is divided among the threads of the `Executor`, and passes
+     * over bytes that every key shares are skipped.
+     *
+     * @param[in,out] keys the keys to sort
+     * @param[in,out] values the values to permute, which must be the same
+     * size as `keys`
+     * @param[in] executor the `Executor` to use, or `nullptr` to sort on
+     * the calling thread only
+     */
+    LIBKAMI_EXPORT void radix_sort(
+            std::vector<std::uint64_t>& keys,
+            std::vector<std::size_t>& values,
+            Executor* executor = nullptr
+    );
+
+}  // namespace kami
+
+#endif  // KAMI_RADIX_H
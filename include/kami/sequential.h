@@ -30,6 +30,7 @@
 //! @endcond
 
 #include <memory>
+#include <typeindex>
 #include <vector>
 
 #include <kami/agent.h>
@@ -46,6 +47,15 @@ namespace kami {
      * to the scheduler and call their `step()` function in a sequential order.
      * That order is preserved between calls to `step()` but may be modified by
      * `addAgent()` or `deleteAgent()`.
+     *
+     * Where the model does not depend on the order of execution, the
+     * scheduler may be asked to group the agents by their dynamic type,
+     * executing all agents of one class before moving on to the next.
+     * Consecutive calls to the same `step()` implementation are kinder to
+     * the branch predictor and instruction cache than calls alternating
+     * between classes.  The grouping is stable, and is cached between
+     * steps, along with the `Agent`s themselves, until the `Population`
+     * changes.
      */
     class LIBKAMI_EXPORT SequentialScheduler
             : public Scheduler {
@@ -115,6 +125,69 @@ namespace kami {
                 std::shared_ptr<ReporterModel> model,
                 std::unique_ptr<std::vector<AgentID>> agent_list
         ) override;
+
+        /**
+         * @brief Inquire if agents are grouped by type
+         *
+         * @return true if agents are grouped by type, and false otherwise
+         */
+        [[nodiscard]] bool get_group_by_type() const;
+
+        /**
+         * @brief Set whether agents are grouped by type
+         *
+         * @details When enabled, each call to `step()` that takes its
+         * agents from the `Population` executes them grouped by dynamic
+         * type.  Classes are ordered by their first appearance in the
+         * `Population`, and agents of the same class retain their order.
+         * Agent lists given explicitly to `step()` are executed as given.
+         *
+         * @param[in] group_by_type should agents be grouped by type
+         *
+         * @return true if agents are grouped by type, and false otherwise
+         */
+        bool set_group_by_type(bool group_by_type);
+
+    protected:
+        /**
+         * @brief Get the agent list of a `Population`, grouped by type
+         *
+         * @details The grouping is cached and only recomputed when the
+         * revision of the `Population` changes.
+         *
+         * @param population the `Population` to list
+         *
+         * @returns the grouped agent list
+         */
+        std::unique_ptr<std::vector<AgentID>> get_grouped_agent_list(const std::shared_ptr<Population>& population);
+
+        /**
+         * @brief Get the cached `Agent`s for a grouped agent list
+         *
+         * @details The `Agent`s are only available if `agent_list` is
+         * the grouped agent list most recently produced for `population`
+         * and the `Population` has not changed since.  Executing them
+         * directly avoids looking up each `Agent` in the `Population`.
+         * The cache holds a reference to each `Agent`, so one that is
+         * deleted from the `Population` during a step outlives its step.
+         *
+         * @param population the `Population` the agents belong to
+         * @param agent_list list of agents to execute the step
+         *
+         * @returns the `Agent`s in the order of `agent_list`, or
+         * `nullptr` if they are not available
+         */
+        [[nodiscard]] const std::vector<std::shared_ptr<Agent>>* get_grouped_agents(
+                const std::shared_ptr<Population>& population,
+                const std::vector<AgentID>& agent_list
+        ) const;
+
+    private:
+        bool _group_by_type = false;
+        std::weak_ptr<Population> _grouped_population;
+        unsigned long long _grouped_revision = 0;
+        std::vector<AgentID> _grouped_agent_list;
+        std::vector<std::shared_ptr<Agent>> _grouped_agents;
     };
 
 }  // namespace kami
@@ -0,0 +1,242 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef KAMI_SMALLVECTOR_H
+//! @cond SuppressGuard
+#define KAMI_SMALLVECTOR_H
+//! @endcond
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace kami {
+
+    /**
+     * @brief A vector that keeps its first few elements inline
+     *
+     * @details Up to `N` elements are stored within the object itself, and
+     * only larger contents are moved to the heap.  This suits per-cell
+     * storage, where most cells hold few elements and a separate
+     * allocation for each would dominate the cost.  When on the heap, the
+     * pointer shares space with the inline storage, so the object is no
+     * larger than the inline elements plus two counters.
+     *
+     * Elements must be trivially copyable, and are moved with
+     * `std::memcpy`.
+     *
+     * @tparam T the element type
+     * @tparam N the number of elements stored inline
+     */
+    template<typename T, std::size_t N>
+    class SmallVector {
+        static_assert(std::is_trivially_copyable_v<T>, "SmallVector elements must be trivially copyable");
+        static_assert(N > 0, "SmallVector must have inline capacity");
+
+    public:
+        /**
+         * @brief Constructs an empty vector
+         */
+        SmallVector() noexcept = default;
+
+        /**
+         * @brief Copy constructor
+         */
+        SmallVector(const SmallVector& other) {
+            reserve(other._size);
+            std::memcpy(data(), other.data(), other._size * sizeof(T));
+            _size = other._size;
+        }
+
+        /**
+         * @brief Move constructor
+         */
+        SmallVector(SmallVector&& other) noexcept {
+            take(other);
+        }
+
+        /**
+         * @brief Copy assignment
+         */
+        SmallVector& operator=(const SmallVector& other) {
+            if (this != &other) {
+                clear();
+                reserve(other._size);
+                std::memcpy(data(), other.data(), other._size * sizeof(T));
+                _size = other._size;
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Move assignment
+         */
+        SmallVector& operator=(SmallVector&& other) noexcept {
+            if (this != &other) {
+                release();
+                take(other);
+            }
+            return *this;
+        }
+
+        ~SmallVector() {
+            release();
+        }
+
+        /**
+         * @brief Get a pointer to the first element
+         */
+        [[nodiscard]] T* data() noexcept {
+            return is_inline() ? reinterpret_cast<T*>(_storage._inline) : _storage._heap;
+        }
+
+        /**
+         * @brief Get a pointer to the first element
+         */
+        [[nodiscard]] const T* data() const noexcept {
+            return is_inline() ? reinterpret_cast<const T*>(_storage._inline) : _storage._heap;
+        }
+
+        [[nodiscard]] T* begin() noexcept {
+            return data();
+        }
+
+        [[nodiscard]] T* end() noexcept {
+            return data() + _size;
+        }
+
+        [[nodiscard]] const T* begin() const noexcept {
+            return data();
+        }
+
+        [[nodiscard]] const T* end() const noexcept {
+            return data() + _size;
+        }
+
+        [[nodiscard]] T& operator[](std::size_t index) noexcept {
+            return data()[index];
+        }
+
+        [[nodiscard]] const T& operator[](std::size_t index) const noexcept {
+            return data()[index];
+        }
+
+        [[nodiscard]] T& back() noexcept {
+            return data()[_size - 1];
+        }
+
+        /**
+         * @brief Get the number of elements
+         */
+        [[nodiscard]] std::size_t size() const noexcept {
+            return _size;
+        }
+
+        /**
+         * @brief Inquire if the vector has no elements
+         */
+        [[nodiscard]] bool empty() const noexcept {
+            return _size == 0;
+        }
+
+        /**
+         * @brief Get the number of elements that fit without reallocation
+         */
+        [[nodiscard]] std::size_t capacity() const noexcept {
+            return _capacity;
+        }
+
+        /**
+         * @brief Ensure room for at least `capacity` elements
+         */
+        void reserve(std::size_t capacity) {
+            if (capacity <= _capacity)
+                return;
+
+            auto heap = std::allocator<T>().allocate(capacity);
+            std::memcpy(heap, data(), _size * sizeof(T));
+            release();
+            _storage._heap = heap;
+            _capacity = static_cast<std::uint32_t>(capacity);
+        }
+
+        /**
+         * @brief Append an element, doubling the capacity if full
+         */
+        void push_back(const T& value) {
+            if (_size == _capacity)
+                reserve(2 * static_cast<std::size_t>(_capacity));
+            std::memcpy(data() + _size, &value, sizeof(T));
+            _size++;
+        }
+
+        /**
+         * @brief Remove the last element
+         */
+        void pop_back() noexcept {
+            _size--;
+        }
+
+        /**
+         * @brief Remove all elements, keeping the capacity
+         */
+        void clear() noexcept {
+            _size = 0;
+        }
+
+    private:
+        union Storage {
+            T* _heap;
+            alignas(T) unsigned char _inline[N * sizeof(T)];
+        } _storage{};
+
+        std::uint32_t _size = 0;
+        std::uint32_t _capacity = N;
+
+        [[nodiscard]] bool is_inline() const noexcept {
+            return _capacity == N;
+        }
+
+        void release() noexcept {
+            if (!is_inline())
+                std::allocator<T>().deallocate(_storage._heap, _capacity);
+            _capacity = N;
+        }
+
+        void take(SmallVector& other) noexcept {
+            std::memcpy(&_storage, &other._storage, sizeof(Storage));
+            _size = other._size;
+            _capacity = other._capacity;
+            other._size = 0;
+            other._capacity = N;
+        }
+    };
+
+}  // namespace kami
+
+#endif  // KAMI_SMALLVECTOR_H
@@ -29,17 +29,38 @@
 #define KAMI_SOLOGRID2D_H
 //! @endcond
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <random>
+#include <set>
+#include <span>
+#include <vector>
+
 #include <kami/KAMI_EXPORT.h>
 #include <kami/agent.h>
+#include <kami/executor.h>
+#include <kami/grid.h>
 #include <kami/grid2d.h>
 #include <kami/kami.h>
 
 namespace kami {
 
     /**
-     * @brief A two-dimensional grid where each cell may contain multiple agents
+     * @brief A two-dimensional grid where each cell may contain one agent
      *
      * @details The grid is linear and may wrap around in either dimension.
+     * Occupancy is stored densely, as one `AgentID` per cell with
+     * `AgentID::null()` marking an empty cell, so occupancy checks and
+     * moves take constant time and do not allocate.  The storage is
+     * allocated once, when the grid is constructed.
+     *
+     * The grid also keeps the set of empty cells, as a dense array with
+     * the position of each cell in it, updated as agents are added, moved
+     * and removed.  Choosing an empty cell at random therefore takes
+     * constant time however full the grid is, where drawing cells until
+     * one is empty slows without bound as the grid fills.
      *
      * @see `Grid2D`
      * @see `MultiGrid2D`
@@ -54,13 +75,16 @@ namespace kami {
          * @param[in] maximum_y the length of the grid in the second dimension
          * @param[in] wrap_x should the grid wrap around on itself in the first dimension
          * @param[in] wrap_y should the grid wrap around on itself in the second dimension
+         *
+         * @throws error::OptionInvalid if the grid has more than
+         * `UINT32_MAX` cells.
          */
         SoloGrid2D(
                 unsigned int maximum_x,
                 unsigned int maximum_y,
                 bool wrap_x,
                 bool wrap_y
-        );;
+        );
 
         /**
          * @details Place agent on the grid at the specified location.
@@ -76,8 +100,209 @@ namespace kami {
                 const GridCoord2D& coord
         ) override;
 
+        using Grid2D::delete_agent;
+
+        /**
+         * @brief Remove agent from the grid at the specified location
+         *
+         * @param[in] agent_id the `AgentID` of the agent to remove.
+         * @param[in] coord the coordinates of the agent.
+         *
+         * @returns the `AgentID` of the agent removed
+         */
+        AgentID delete_agent(
+                AgentID agent_id,
+                const GridCoord2D& coord
+        ) override;
+
+        /**
+         * @brief Move an agent to the specified location.
+         *
+         * @details The move is made in place.  If the destination is
+         * invalid or occupied, an exception is thrown and the agent
+         * remains where it was.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to move.
+         * @param[in] coord the coordinates of the destination.
+         *
+         * @returns the `AgentID` of the agent moved
+         */
+        AgentID move_agent(
+                AgentID agent_id,
+                const GridCoord2D& coord
+        ) override;
+
+        /**
+         * @brief Move many agents at once.
+         *
+         * @details Competing claims on a cell go to the earliest in the
+         * batch.
+         *
+         * @param[in] moves the moves to make.
+         *
+         * @returns the `AgentID`s of the agents moved, in the order given
+         *
+         * @see `move_agents(const std::vector<GridMove2D>&, GridConflictPolicy, std::uint64_t, Executor*)`
+         */
+        std::unique_ptr<std::vector<AgentID>> move_agents(const std::vector<GridMove2D>& moves) override;
+
+        /**
+         * @brief Move many agents at once, settling competing claims.
+         *
+         * @details This is the commit phase of a parallel movement step:
+         * agents decide where to go independently, and the batch is then
+         * applied in one pass.  A move may only claim a cell that is empty
+         * at the start of the batch, so the result does not depend on the
+         * order of the moves.  Where several moves claim one cell, the
+         * policy picks the winner.  Refused moves leave their agents where
+         * they were.  A move to an agent's own cell always succeeds.
+         *
+         * Claims are grouped by cell with a parallel radix sort, and the
+         * winning moves are then applied concurrently.  Every move is
+         * checked before any is made, so if an agent is not on the grid,
+         * appears twice, or has an invalid destination, an exception is
+         * thrown and the grid is unchanged.
+         *
+         * @param[in] moves the moves to make.
+         * @param[in] policy how competing claims are settled.
+         * @param[in] seed the seed for `GridConflictPolicy::Random`.
+         * @param[in] executor the `Executor` to run on, or `nullptr` to
+         * run on the calling thread only.
+         *
+         * @returns the `AgentID`s of the agents moved, in the order given
+         */
+        std::unique_ptr<std::vector<AgentID>> move_agents(
+                const std::vector<GridMove2D>& moves,
+                GridConflictPolicy policy,
+                std::uint64_t seed = 0,
+                Executor* executor = nullptr
+        );
+
+        /**
+         * @brief Inquire if the specified location is empty.
+         *
+         * @param[in] coord the coordinates of the query.
+         *
+         * @return true if the location has no `Agent` occupying it, false
+         * otherwise.
+         */
+        [[nodiscard]] bool is_location_empty(const GridCoord2D& coord) const override;
+
+        /**
+         * @brief Get the contents of the specified location.
+         *
+         * @param[in] coord the coordinates of the query.
+         *
+         * @return a pointer to a `set` holding the `AgentID` of the agent
+         * at the location, if any.
+         */
+        [[nodiscard]] std::shared_ptr<std::set<AgentID>>
+        get_location_contents(const GridCoord2D& coord) const override;
+
+        /**
+         * @brief Get a view of the contents of the specified location.
+         *
+         * @param[in] coord the coordinates of a valid location.
+         *
+         * @return a span holding the `AgentID` of the agent at the
+         * location, if any.
+         */
+        [[nodiscard]] std::span<const AgentID> get_location_view(const GridCoord2D& coord) const override;
+
+        /**
+         * @brief Get the number of empty cells on the grid.
+         */
+        [[nodiscard]] std::size_t get_empty_cell_count() const;
+
+        /**
+         * @brief Choose an empty cell uniformly at random
+         *
+         * @details This is a single draw from the set of empty cells.
+         *
+         * @param[in] rng a uniform random bit generator.
+         *
+         * @return the coordinates of the chosen cell, or nothing if the grid
+         * is full.
+         */
+        template<typename URBG>
+        std::optional<GridCoord2D> random_empty_cell(URBG& rng) const;
+
+        /**
+         * @brief Place agents on distinct empty cells chosen at random
+         *
+         * @details Each agent takes one draw from the cells still empty,
+         * so every placement of the agents on distinct empty cells is
+         * equally likely.  Every agent is checked before any is placed,
+         * so if an exception is thrown the grid is unchanged.
+         *
+         * @param[in] agent_ids the `AgentID`s of the agents to add.
+         * @param[in] rng a uniform random bit generator.
+         *
+         * @returns the coordinates of each agent, in the order given
+         *
+         * @throws error::OptionInvalid if an agent is already on the grid
+         * or appears twice.
+         * @throws error::LocationUnavailable if there are fewer empty cells
+         * than agents.
+         */
+        template<typename URBG>
+        std::unique_ptr<std::vector<GridCoord2D>> add_agents_randomly(
+                std::span<const AgentID> agent_ids,
+                URBG& rng
+        );
+
+    protected:
+        /**
+         * @brief The `AgentID` at each cell, in row-major order
+         *
+         * @see `Grid2D::coord_index()`
+         */
+        std::vector<AgentID> _agent_cells;
+
+    private:
+        // The empty cells, in no particular order, and the position of each
+        // empty cell in that array
+        std::vector<std::uint32_t> _empty_cells;
+        std::vector<std::uint32_t> _empty_positions;
+
+        static std::uint64_t mix_key(
+                std::uint64_t seed,
+                std::uint64_t value
+        );
+
+        void claim_cell(std::size_t cell);
+
+        void release_cell(std::size_t cell);
+
+        void check_new_agents(std::span<const AgentID> agent_ids) const;
     };
 
+    template<typename URBG>
+    std::optional<GridCoord2D> SoloGrid2D::random_empty_cell(URBG& rng) const {
+        if (_empty_cells.empty())
+            return std::nullopt;
+        return index_coord(_empty_cells[std::uniform_int_distribution<std::size_t>(0, _empty_cells.size() - 1)(rng)]);
+    }
+
+    template<typename URBG>
+    std::unique_ptr<std::vector<GridCoord2D>> SoloGrid2D::add_agents_randomly(
+            std::span<const AgentID> agent_ids,
+            URBG& rng
+    ) {
+        check_new_agents(agent_ids);
+
+        auto coords = std::make_unique<std::vector<GridCoord2D>>();
+        coords->reserve(agent_ids.size());
+        for (auto agent_id : agent_ids) {
+            auto cell = _empty_cells[std::uniform_int_distribution<std::size_t>(0, _empty_cells.size() - 1)(rng)];
+            _agent_index.insert(agent_id, cell);
+            _agent_cells[cell] = agent_id;
+            claim_cell(cell);
+            coords->push_back(index_coord(cell));
+        }
+        return std::move(coords);
+    }
+
 }  // namespace kami
 
 #endif  // KAMI_SOLOGRID2D_H
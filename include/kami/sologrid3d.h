@@ -0,0 +1,165 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef KAMI_SOLOGRID3D_H
+//! @cond SuppressGuard
+#define KAMI_SOLOGRID3D_H
+//! @endcond
+
+#include <memory>
+#include <set>
+#include <span>
+#include <vector>
+
+#include <kami/KAMI_EXPORT.h>
+#include <kami/agent.h>
+#include <kami/grid.h>
+#include <kami/grid3d.h>
+#include <kami/kami.h>
+
+namespace kami {
+
+    /**
+     * @brief A three-dimensional grid where each cell may contain one agent
+     *
+     * @details The grid may wrap around in any dimension.  Occupancy is
+     * stored densely, as one `AgentID` per cell in brick order with
+     * `AgentID::null()` marking an empty cell, so occupancy checks and
+     * moves take constant time and do not allocate.
+     *
+     * @see `Grid3D`
+     * @see `MultiGrid3D`
+     */
+    class LIBKAMI_EXPORT SoloGrid3D
+            : public Grid3D {
+    public:
+        /**
+         * @details Constructor
+         *
+         * @param[in] maximum_x the length of the grid in the first dimension
+         * @param[in] maximum_y the length of the grid in the second dimension
+         * @param[in] maximum_z the length of the grid in the third dimension
+         * @param[in] wrap_x should the grid wrap around on itself in the first dimension
+         * @param[in] wrap_y should the grid wrap around on itself in the second dimension
+         * @param[in] wrap_z should the grid wrap around on itself in the third dimension
+         */
+        SoloGrid3D(
+                unsigned int maximum_x,
+                unsigned int maximum_y,
+                unsigned int maximum_z,
+                bool wrap_x,
+                bool wrap_y,
+                bool wrap_z
+        );
+
+        /**
+         * @details Place agent on the grid at the specified location.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to add.
+         * @param[in] coord the coordinates of the agent.
+         *
+         * @returns the `AgentID` of the agent placed
+         */
+        AgentID add_agent(
+                AgentID agent_id,
+                const GridCoord3D& coord
+        ) override;
+
+        using Grid3D::delete_agent;
+
+        /**
+         * @brief Remove agent from the grid at the specified location
+         *
+         * @param[in] agent_id the `AgentID` of the agent to remove.
+         * @param[in] coord the coordinates of the agent.
+         *
+         * @returns the `AgentID` of the agent removed
+         */
+        AgentID delete_agent(
+                AgentID agent_id,
+                const GridCoord3D& coord
+        ) override;
+
+        /**
+         * @brief Move an agent to the specified location.
+         *
+         * @details The move is made in place.  If the destination is
+         * invalid or occupied, an exception is thrown and the agent
+         * remains where it was.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to move.
+         * @param[in] coord the coordinates of the destination.
+         *
+         * @returns the `AgentID` of the agent moved
+         */
+        AgentID move_agent(
+                AgentID agent_id,
+                const GridCoord3D& coord
+        ) override;
+
+        /**
+         * @brief Inquire if the specified location is empty.
+         *
+         * @param[in] coord the coordinates of the query.
+         *
+         * @return true if the location has no `Agent` occupying it, false
+         * otherwise.
+         */
+        [[nodiscard]] bool is_location_empty(const GridCoord3D& coord) const override;
+
+        /**
+         * @brief Get the contents of the specified location.
+         *
+         * @param[in] coord the coordinates of the query.
+         *
+         * @return a pointer to a `set` holding the `AgentID` of the agent
+         * at the location, if any.
+         */
+        [[nodiscard]] std::shared_ptr<std::set<AgentID>>
+        get_location_contents(const GridCoord3D& coord) const override;
+
+        /**
+         * @brief Get a view of the contents of the specified location.
+         *
+         * @param[in] coord the coordinates of a valid location.
+         *
+         * @return a span holding the `AgentID` of the agent at the
+         * location, if any.
+         */
+        [[nodiscard]] std::span<const AgentID> get_location_view(const GridCoord3D& coord) const override;
+
+    protected:
+        /**
+         * @brief The `AgentID` at each cell, in brick order
+         *
+         * @see `Grid3D::coord_index()`
+         */
+        std::vector<AgentID> _agent_cells;
+    };
+
+}  // namespace kami
+
+#endif  // KAMI_SOLOGRID3D_H
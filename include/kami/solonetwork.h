@@ -0,0 +1,149 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef KAMI_SOLONETWORK_H
+//! @cond SuppressGuard
+#define KAMI_SOLONETWORK_H
+//! @endcond
+
+#include <memory>
+#include <set>
+#include <span>
+#include <vector>
+
+#include <kami/KAMI_EXPORT.h>
+#include <kami/agent.h>
+#include <kami/kami.h>
+#include <kami/network.h>
+
+namespace kami {
+
+    /**
+     * @brief A network domain where each node may contain one agent
+     *
+     * @details Occupancy is stored densely, as one `AgentID` per node with
+     * `AgentID::null()` marking an empty node, so occupancy checks and
+     * moves take constant time and do not allocate.
+     *
+     * @see `MultiNetwork`
+     * @see `NetworkDomain`
+     */
+    class LIBKAMI_EXPORT SoloNetwork
+            : public NetworkDomain {
+    public:
+        /**
+         * @details Constructor
+         *
+         * @param[in] graph the graph of the network.
+         */
+        explicit SoloNetwork(std::shared_ptr<const NetworkGraph> graph);
+
+        /**
+         * @details Place agent on the network at the specified node.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to add.
+         * @param[in] coord the coordinates of the agent.
+         *
+         * @returns the `AgentID` of the agent placed
+         */
+        AgentID add_agent(
+                AgentID agent_id,
+                const NodeCoord& coord
+        ) override;
+
+        using NetworkDomain::delete_agent;
+
+        /**
+         * @brief Remove agent from the network at the specified node
+         *
+         * @param[in] agent_id the `AgentID` of the agent to remove.
+         * @param[in] coord the coordinates of the agent.
+         *
+         * @returns the `AgentID` of the agent removed
+         */
+        AgentID delete_agent(
+                AgentID agent_id,
+                const NodeCoord& coord
+        ) override;
+
+        /**
+         * @brief Move an agent to the specified node.
+         *
+         * @details The move is made in place.  If the destination is
+         * invalid or occupied, an exception is thrown and the agent
+         * remains where it was.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to move.
+         * @param[in] coord the coordinates of the destination.
+         *
+         * @returns the `AgentID` of the agent moved
+         */
+        AgentID move_agent(
+                AgentID agent_id,
+                const NodeCoord& coord
+        ) override;
+
+        /**
+         * @brief Inquire if the specified node is empty.
+         *
+         * @param[in] coord the coordinates of the query.
+         *
+         * @return true if the node has no `Agent` occupying it, false
+         * otherwise.
+         */
+        [[nodiscard]] bool is_location_empty(const NodeCoord& coord) const override;
+
+        /**
+         * @brief Get the contents of the specified node.
+         *
+         * @param[in] coord the coordinates of the query.
+         *
+         * @return a pointer to a `set` holding the `AgentID` of the agent
+         * at the node, if any.
+         */
+        [[nodiscard]] std::shared_ptr<std::set<AgentID>>
+        get_location_contents(const NodeCoord& coord) const override;
+
+        /**
+         * @brief Get a view of the contents of the specified node.
+         *
+         * @param[in] coord the coordinates of a valid node.
+         *
+         * @return a span holding the `AgentID` of the agent at the node, if
+         * any.
+         */
+        [[nodiscard]] std::span<const AgentID> get_location_view(const NodeCoord& coord) const override;
+
+    protected:
+        /**
+         * @brief The `AgentID` at each node
+         */
+        std::vector<AgentID> _agent_nodes;
+    };
+
+}  // namespace kami
+
+#endif  // KAMI_SOLONETWORK_H
@@ -0,0 +1,437 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef KAMI_SPARSEMULTIGRID2D_H
+//! @cond SuppressGuard
+#define KAMI_SPARSEMULTIGRID2D_H
+//! @endcond
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <set>
+#include <span>
+#include <vector>
+
+#include <kami/agent.h>
+#include <kami/agentindex.h>
+#include <kami/domain.h>
+#include <kami/grid.h>
+#include <kami/grid2d.h>
+#include <kami/kami.h>
+#include <kami/smallvector.h>
+#include <kami/stencil.h>
+
+namespace kami {
+
+    /**
+     * @brief A two-dimensional grid for very large, mostly empty worlds,
+     * where each cell may contain multiple agents
+     *
+     * @details The grid is linear and may wrap around in either dimension.
+     * Unlike `MultiGrid2D`, which allocates every cell up front, the grid
+     * is divided into square tiles of `tile_length` cells on a side, and
+     * only tiles holding at least one agent are allocated.  Tiles are
+     * found through a hashed tile directory, created when the first agent
+     * arrives, and freed when the last agent leaves, so memory follows
+     * the population rather than the area of the grid.  A grid of a
+     * million cells on a side costs nothing until agents are placed on it.
+     *
+     * Within a tile, the contents of each cell are stored as in
+     * `MultiGrid2D`.  Neighborhood queries look up each tile once, rather
+     * than once per cell, and a neighborhood that lies inside an absent
+     * tile is skipped without visiting its cells.
+     *
+     * @see `Grid2D`
+     * @see `MultiGrid2D`
+     */
+    class LIBKAMI_EXPORT SparseMultiGrid2D
+            : public Grid2D {
+    public:
+        /**
+         * @brief The base-two logarithm of the length of a tile
+         */
+        static constexpr unsigned int tile_shift = 6;
+
+        /**
+         * @brief The number of cells on each side of a tile
+         */
+        static constexpr unsigned int tile_length = 1u << tile_shift;
+
+        /**
+         * @brief Constructor
+         *
+         * @param[in] maximum_x the length of the grid in the first dimension
+         * @param[in] maximum_y the length of the grid in the second dimension
+         * @param[in] wrap_x should the grid wrap around on itself in the first
+         * dimension
+         * @param[in] wrap_y should the grid wrap around on itself in the second
+         * dimension
+         */
+        SparseMultiGrid2D(
+                unsigned int maximum_x,
+                unsigned int maximum_y,
+                bool wrap_x,
+                bool wrap_y
+        );
+
+        /**
+         * @brief Place agent on the grid at the specified location.
+         *
+         * @details As in `SoloGrid2D`, an agent may only be placed once;
+         * use `move_agent()` to change its location.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to add.
+         * @param[in] coord the coordinates of the agent.
+         *
+         * @returns the `AgentID` of the agent added
+         *
+         * @throws error::OptionInvalid if the agent is already on the grid.
+         */
+        AgentID add_agent(
+                AgentID agent_id,
+                const GridCoord2D& coord
+        ) override;
+
+        using Grid2D::delete_agent;
+
+        /**
+         * @brief Remove agent from the grid at the specified location
+         *
+         * @details If the agent was the last on its tile, the tile is freed.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to remove.
+         * @param[in] coord the coordinates of the agent.
+         *
+         * @returns the `AgentID` of the agent removed
+         */
+        AgentID delete_agent(
+                AgentID agent_id,
+                const GridCoord2D& coord
+        ) override;
+
+        /**
+         * @brief Move an agent to the specified location.
+         *
+         * @details If the destination is invalid, an exception is thrown
+         * and the agent remains where it was.
+         *
+         * @param[in] agent_id the `AgentID` of the agent to move.
+         * @param[in] coord the coordinates of the destination.
+         *
+         * @returns the `AgentID` of the agent moved
+         */
+        AgentID move_agent(
+                AgentID agent_id,
+                const GridCoord2D& coord
+        ) override;
+
+        /**
+         * @brief Inquire if the specified location is empty.
+         *
+         * @param[in] coord the coordinates of the query.
+         *
+         * @return true if the location has no `Agent`s occupying it, false
+         * otherwise.
+         */
+        [[nodiscard]] bool is_location_empty(const GridCoord2D& coord) const override;
+
+        /**
+         * @brief Get the contents of the specified location.
+         *
+         * @param[in] coord the coordinates of the query.
+         *
+         * @return a pointer to a `set` of the `AgentID`s at the location.
+         */
+        [[nodiscard]] std::shared_ptr<std::set<AgentID>>
+        get_location_contents(const GridCoord2D& coord) const override;
+
+        /**
+         * @brief Get a view of the contents of the specified location.
+         *
+         * @param[in] coord the coordinates of a valid location.
+         *
+         * @return a span of the `AgentID`s at the location.
+         */
+        [[nodiscard]] std::span<const AgentID> get_location_view(const GridCoord2D& coord) const override;
+
+        /**
+         * @brief Get the number of tiles currently allocated
+         *
+         * @details This is the number of tiles holding at least one agent.
+         */
+        [[nodiscard]] std::size_t get_tile_count() const;
+
+        /**
+         * @brief Visit each allocated tile
+         *
+         * @details The visitor is called with the coordinates of the
+         * lower corner of the tile.  It may return `void`, or `bool`, where
+         * `false` ends the visit early.  Tiles are visited in no
+         * particular order.
+         *
+         * @param[in] visitor the visitor.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         */
+        template<typename Visitor>
+        bool for_each_tile(Visitor&& visitor) const;
+
+        /**
+         * @brief Visit each occupied cell of the grid
+         *
+         * @details The visitor is called with the coordinates of the cell
+         * and a span of the `AgentID`s in it.  It may return `void`, or
+         * `bool`, where `false` ends the visit early.  Only allocated tiles
+         * are scanned, so the cost follows the population rather than the
+         * area of the grid.
+         *
+         * @param[in] visitor the visitor.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         */
+        template<typename Visitor>
+        bool for_each_occupied_cell(Visitor&& visitor) const;
+
+        /**
+         * @brief Visit each agent in the neighborhood of a location
+         *
+         * @details This hides the `Grid2D` version, which looks up each
+         * cell separately, with one that looks up each tile once.  The
+         * results are the same.
+         *
+         * @param[in] coord the coordinates of the center.
+         * @param[in] include_center should the center-point be visited.
+         * @param[in] neighborhood_type the neighborhood type.
+         * @param[in] radius the radius of the neighborhood.
+         * @param[in] visitor the visitor.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         *
+         * @see `Grid2D::for_each_agent_in_neighborhood()`
+         */
+        template<typename Visitor>
+        bool for_each_agent_in_neighborhood(
+                const GridCoord2D& coord,
+                bool include_center,
+                GridNeighborhoodType neighborhood_type,
+                unsigned int radius,
+                Visitor&& visitor
+        ) const;
+
+        /**
+         * @brief Visit each agent in the neighborhood of a location that
+         * passes a filter
+         *
+         * @param[in] coord the coordinates of the center.
+         * @param[in] include_center should the center-point be visited.
+         * @param[in] neighborhood_type the neighborhood type.
+         * @param[in] radius the radius of the neighborhood.
+         * @param[in] filter the filter, called with each `AgentID`.
+         * @param[in] visitor the visitor.
+         *
+         * @return false if the visit was ended early, true otherwise.
+         *
+         * @see `Grid2D::for_each_agent_in_neighborhood()`
+         */
+        template<typename Filter, typename Visitor>
+        bool for_each_agent_in_neighborhood(
+                const GridCoord2D& coord,
+                bool include_center,
+                GridNeighborhoodType neighborhood_type,
+                unsigned int radius,
+                Filter&& filter,
+                Visitor&& visitor
+        ) const;
+
+    private:
+        static constexpr unsigned int tile_mask = tile_length - 1;
+        static constexpr std::size_t tile_cells = static_cast<std::size_t>(tile_length) * tile_length;
+        static constexpr std::uint64_t empty_key = std::numeric_limits<std::uint64_t>::max();
+
+        struct Tile {
+            std::uint64_t key = empty_key;
+            std::size_t position = 0;
+            std::size_t agent_count = 0;
+            std::array<SmallVector<AgentID, 2>, tile_cells> cells;
+        };
+
+        [[nodiscard]] inline std::uint64_t tile_key(const GridCoord2D& coord) const {
+            return (static_cast<std::uint64_t>(coord.y()) >> tile_shift) * _tiles_x +
+                   (static_cast<std::uint64_t>(coord.x()) >> tile_shift);
+        }
+
+        [[nodiscard]] static inline std::size_t tile_offset(const GridCoord2D& coord) {
+            return (static_cast<std::size_t>(coord.y()) & tile_mask) * tile_length +
+                   (static_cast<std::size_t>(coord.x()) & tile_mask);
+        }
+
+        [[nodiscard]] inline GridCoord2D tile_origin(const Tile& tile) const {
+            return {static_cast<int>((tile.key % _tiles_x) << tile_shift),
+                    static_cast<int>((tile.key / _tiles_x) << tile_shift)};
+        }
+
+        [[nodiscard]] Tile* find_tile(std::uint64_t key) const;
+
+        Tile& claim_tile(std::uint64_t key);
+
+        void release_tile(Tile& tile);
+
+        void insert_directory(Tile* tile);
+
+        void erase_directory(std::uint64_t key);
+
+        [[nodiscard]] std::size_t directory_slot(std::uint64_t key) const;
+
+        void add_to_tile(
+                AgentID agent_id,
+                const GridCoord2D& coord
+        );
+
+        void remove_from_tile(
+                AgentID agent_id,
+                const GridCoord2D& coord
+        );
+
+        std::uint64_t _tiles_x;
+
+        // Allocated tiles, densely packed, with each tile's position
+        // recorded in the tile so it can be swapped out when freed
+        std::vector<std::unique_ptr<Tile>> _tiles;
+
+        // The tile directory, an open-addressed hash table from tile key
+        // to tile with linear probing
+        std::vector<Tile*> _directory;
+        std::size_t _directory_shift;
+
+        // A freed tile, kept to absorb agents crossing back and forth
+        // over the edge of a tile
+        std::unique_ptr<Tile> _spare_tile;
+
+        AgentIndex<std::uint32_t> _agent_slots;
+    };
+
+    template<typename Visitor>
+    bool SparseMultiGrid2D::for_each_tile(Visitor&& visitor) const {
+        for (const auto& tile : _tiles)
+            if (!stencil::visit(visitor, tile_origin(*tile)))
+                return false;
+        return true;
+    }
+
+    template<typename Visitor>
+    bool SparseMultiGrid2D::for_each_occupied_cell(Visitor&& visitor) const {
+        for (const auto& tile : _tiles) {
+            const auto origin = tile_origin(*tile);
+            for (std::size_t offset = 0; offset < tile_cells; offset++) {
+                const auto& cell = tile->cells[offset];
+                if (cell.empty())
+                    continue;
+                const GridCoord2D coord(origin.x() + static_cast<int>(offset & tile_mask),
+                                        origin.y() + static_cast<int>(offset >> tile_shift));
+                if (!stencil::visit(visitor, coord, std::span<const AgentID>(cell.data(), cell.size())))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    template<typename Visitor>
+    bool SparseMultiGrid2D::for_each_agent_in_neighborhood(
+            const GridCoord2D& coord,
+            const bool include_center,
+            const GridNeighborhoodType neighborhood_type,
+            const unsigned int radius,
+            Visitor&& visitor
+    ) const {
+        const auto r = static_cast<int>(radius);
+        const auto local_x = static_cast<int>(static_cast<unsigned int>(coord.x()) & tile_mask);
+        const auto local_y = static_cast<int>(static_cast<unsigned int>(coord.y()) & tile_mask);
+
+        // A neighborhood inside a single tile is read straight from the
+        // tile, and one inside an absent tile holds no agents
+        if (is_interior(coord, r) &&
+            local_x >= r && local_x + r < static_cast<int>(tile_length) &&
+            local_y >= r && local_y + r < static_cast<int>(tile_length)) {
+            const Tile* tile = find_tile(tile_key(coord));
+            if (tile == nullptr)
+                return true;
+
+            const auto center = static_cast<std::ptrdiff_t>(tile_offset(coord));
+            return stencil::with_2d(neighborhood_type, radius, [&](const auto& offsets) {
+                for (const auto& offset : offsets) {
+                    if (!include_center && offset.dx == 0 && offset.dy == 0)
+                        continue;
+                    const auto& cell = tile->cells[center + offset.dy * static_cast<std::ptrdiff_t>(tile_length) +
+                                                   offset.dx];
+                    for (auto agent_id : cell)
+                        if (!stencil::visit(visitor, agent_id))
+                            return false;
+                }
+                return true;
+            });
+        }
+
+        // Cells are visited in scan order, so consecutive cells mostly
+        // share a tile, and the last tile found is remembered
+        auto cached_key = empty_key;
+        const Tile* cached_tile = nullptr;
+        return for_each_neighbor(coord, include_center, neighborhood_type, radius,
+                                 [&](const GridCoord2D& cell) {
+                                     const auto key = tile_key(cell);
+                                     if (key != cached_key) {
+                                         cached_key = key;
+                                         cached_tile = find_tile(key);
+                                     }
+                                     if (cached_tile == nullptr)
+                                         return true;
+                                     for (auto agent_id : cached_tile->cells[tile_offset(cell)])
+                                         if (!stencil::visit(visitor, agent_id))
+                                             return false;
+                                     return true;
+                                 });
+    }
+
+    template<typename Filter, typename Visitor>
+    bool SparseMultiGrid2D::for_each_agent_in_neighborhood(
+            const GridCoord2D& coord,
+            const bool include_center,
+            const GridNeighborhoodType neighborhood_type,
+            const unsigned int radius,
+            Filter&& filter,
+            Visitor&& visitor
+    ) const {
+        return for_each_agent_in_neighborhood(coord, include_center, neighborhood_type, radius,
+                                              [&filter, &visitor](const AgentID agent_id) {
+                                                  return !filter(agent_id) || stencil::visit(visitor, agent_id);
+                                              });
+    }
+
+}  // namespace kami
+
+#endif  // KAMI_SPARSEMULTIGRID2D_H
@@ -0,0 +1,515 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef KAMI_STENCIL_H
+//! @cond SuppressGuard
+#define KAMI_STENCIL_H
+//! @endcond
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <kami/error.h>
+#include <kami/grid.h>
+#include <kami/kami.h>
+
+namespace kami {
+
+    /**
+     * @brief An offset from a cell of a one-dimensional grid
+     */
+    struct GridOffset1D {
+        /**
+         * @brief The offset in the `x` dimension
+         */
+        int dx;
+    };
+
+    /**
+     * @brief An offset from a cell of a two-dimensional grid
+     */
+    struct GridOffset2D {
+        /**
+         * @brief The offset in the `x` dimension
+         */
+        int dx;
+
+        /**
+         * @brief The offset in the `y` dimension
+         */
+        int dy;
+    };
+
+    /**
+     * @brief An offset from a cell of a three-dimensional grid
+     */
+    struct GridOffset3D {
+        /**
+         * @brief The offset in the `x` dimension
+         */
+        int dx;
+
+        /**
+         * @brief The offset in the `y` dimension
+         */
+        int dy;
+
+        /**
+         * @brief The offset in the `z` dimension
+         */
+        int dz;
+    };
+
+    /**
+     * @brief Neighborhood stencils
+     *
+     * @details A stencil is the list of offsets from a cell to each cell
+     * in its neighborhood, including the cell itself.  The offsets are
+     * given in row-major scan order, by increasing `z`, then `y`, and then
+     * `x`, so that visiting a neighborhood walks memory forward in grids
+     * stored row by row.
+     *
+     * Stencils of small radius are generated at compile time.  Those of
+     * larger radius are generated on first use and cached.
+     */
+    namespace stencil {
+
+        /**
+         * @brief The largest radius with stencils generated at compile time
+         */
+        inline constexpr unsigned int max_static_radius = 4;
+
+        /**
+         * @brief Inquire if a three-dimensional offset lies within a
+         * neighborhood
+         *
+         * @param[in] neighborhood_type the neighborhood type.
+         * @param[in] radius the radius of the neighborhood.
+         * @param[in] dx the offset in the `x` dimension.
+         * @param[in] dy the offset in the `y` dimension.
+         * @param[in] dz the offset in the `z` dimension.
+         *
+         * @return true if the offset is within the neighborhood
+         */
+        [[nodiscard]] constexpr bool contains(
+                GridNeighborhoodType neighborhood_type,
+                int radius,
+                int dx,
+                int dy,
+                int dz
+        ) {
+            if (dx < -radius || dx > radius || dy < -radius || dy > radius || dz < -radius || dz > radius)
+                return false;
+
+            auto steps = (dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy) + (dz < 0 ? -dz : dz);
+            switch (neighborhood_type) {
+                case GridNeighborhoodType::Moore:
+                    return true;
+                case GridNeighborhoodType::VonNeumann:
+                    return steps <= radius;
+                case GridNeighborhoodType::Euclidean:
+                    return dx * dx + dy * dy + dz * dz <= radius * radius;
+                case GridNeighborhoodType::Edge:
+                    return steps <= 2 * radius;
+                default:
+                    return false;
+            }
+        }
+
+        /**
+         * @brief Inquire if an offset lies within a neighborhood
+         *
+         * @param[in] neighborhood_type the neighborhood type.
+         * @param[in] radius the radius of the neighborhood.
+         * @param[in] dx the offset in the `x` dimension.
+         * @param[in] dy the offset in the `y` dimension.
+         *
+         * @return true if the offset is within the neighborhood
+         */
+        [[nodiscard]] constexpr bool contains(
+                GridNeighborhoodType neighborhood_type,
+                int radius,
+                int dx,
+                int dy
+        ) {
+            return contains(neighborhood_type, radius, dx, dy, 0);
+        }
+
+        /**
+         * @brief Count the offsets in a two-dimensional stencil
+         */
+        [[nodiscard]] constexpr std::size_t size_2d(
+                GridNeighborhoodType neighborhood_type,
+                int radius
+        ) {
+            std::size_t size = 0;
+
+            for (auto dy = -radius; dy <= radius; dy++)
+                for (auto dx = -radius; dx <= radius; dx++)
+                    if (contains(neighborhood_type, radius, dx, dy))
+                        size++;
+            return size;
+        }
+
+        /**
+         * @brief Count the offsets in a three-dimensional stencil
+         */
+        [[nodiscard]] constexpr std::size_t size_3d(
+                GridNeighborhoodType neighborhood_type,
+                int radius
+        ) {
+            std::size_t size = 0;
+
+            for (auto dz = -radius; dz <= radius; dz++)
+                for (auto dy = -radius; dy <= radius; dy++)
+                    for (auto dx = -radius; dx <= radius; dx++)
+                        if (contains(neighborhood_type, radius, dx, dy, dz))
+                            size++;
+            return size;
+        }
+
+        /**
+         * @brief Generate a three-dimensional stencil at compile time
+         *
+         * @tparam T the neighborhood type
+         * @tparam R the radius
+         */
+        template<GridNeighborhoodType T, int R>
+        [[nodiscard]] constexpr auto make_3d() {
+            std::array<GridOffset3D, size_3d(T, R)> offsets{};
+            std::size_t index = 0;
+
+            for (auto dz = -R; dz <= R; dz++)
+                for (auto dy = -R; dy <= R; dy++)
+                    for (auto dx = -R; dx <= R; dx++)
+                        if (contains(T, R, dx, dy, dz))
+                            offsets[index++] = {dx, dy, dz};
+            return offsets;
+        }
+
+        /**
+         * @brief Generate a two-dimensional stencil at compile time
+         *
+         * @tparam T the neighborhood type
+         * @tparam R the radius
+         */
+        template<GridNeighborhoodType T, int R>
+        [[nodiscard]] constexpr auto make_2d() {
+            std::array<GridOffset2D, size_2d(T, R)> offsets{};
+            std::size_t index = 0;
+
+            for (auto dy = -R; dy <= R; dy++)
+                for (auto dx = -R; dx <= R; dx++)
+                    if (contains(T, R, dx, dy))
+                        offsets[index++] = {dx, dy};
+            return offsets;
+        }
+
+        /**
+         * @brief Generate a one-dimensional stencil at compile time
+         *
+         * @tparam R the radius
+         */
+        template<int R>
+        [[nodiscard]] constexpr auto make_1d() {
+            std::array<GridOffset1D, 2 * R + 1> offsets{};
+
+            for (auto dx = -R; dx <= R; dx++)
+                offsets[dx + R] = {dx};
+            return offsets;
+        }
+
+        /**
+         * @brief A two-dimensional stencil generated at compile time
+         */
+        template<GridNeighborhoodType T, int R>
+        inline constexpr auto stencil_2d = make_2d<T, R>();
+
+        /**
+         * @brief A three-dimensional stencil generated at compile time
+         */
+        template<GridNeighborhoodType T, int R>
+        inline constexpr auto stencil_3d = make_3d<T, R>();
+
+        /**
+         * @brief A one-dimensional stencil generated at compile time
+         */
+        template<int R>
+        inline constexpr auto stencil_1d = make_1d<R>();
+
+        /**
+         * @brief The radius-one neighborhood on a one-dimensional grid
+         */
+        inline constexpr auto neighbors_1d = stencil_1d<1>;
+
+        /**
+         * @brief The radius-one Moore neighborhood on a two-dimensional grid
+         */
+        inline constexpr auto moore_2d = stencil_2d<GridNeighborhoodType::Moore, 1>;
+
+        /**
+         * @brief The radius-one von Neumann neighborhood on a two-dimensional
+         * grid
+         */
+        inline constexpr auto vonneumann_2d = stencil_2d<GridNeighborhoodType::VonNeumann, 1>;
+
+        /**
+         * @brief Get a one-dimensional stencil of any radius
+         *
+         * @details The stencil is generated on first use and cached for
+         * the life of the program.  This is safe to call concurrently.
+         *
+         * @param[in] radius the radius of the neighborhood.
+         *
+         * @return a reference to the cached stencil
+         */
+        LIBKAMI_EXPORT const std::vector<GridOffset1D>& get_1d(unsigned int radius);
+
+        /**
+         * @brief Get a two-dimensional stencil of any radius
+         *
+         * @details The stencil is generated on first use and cached for
+         * the life of the program.  This is safe to call concurrently.
+         *
+         * @param[in] neighborhood_type the neighborhood type.
+         * @param[in] radius the radius of the neighborhood.
+         *
+         * @return a reference to the cached stencil
+         */
+        LIBKAMI_EXPORT const std::vector<GridOffset2D>& get_2d(
+                GridNeighborhoodType neighborhood_type,
+                unsigned int radius
+        );
+
+        /**
+         * @brief Get a three-dimensional stencil of any radius
+         *
+         * @details The stencil is generated on first use and cached for
+         * the life of the program.  This is safe to call concurrently.
+         *
+         * @param[in] neighborhood_type the neighborhood type.
+         * @param[in] radius the radius of the neighborhood.
+         *
+         * @return a reference to the cached stencil
+         */
+        LIBKAMI_EXPORT const std::vector<GridOffset3D>& get_3d(
+                GridNeighborhoodType neighborhood_type,
+                unsigned int radius
+        );
+
+        /**
+         * @brief Call a function with a two-dimensional stencil
+         *
+         * @details The function is called with a stencil fixed at compile
+         * time when one exists for the radius, and with a cached stencil
+         * otherwise, so that callers can be written once for both.
+         *
+         * @param[in] neighborhood_type the neighborhood type.
+         * @param[in] radius the radius of the neighborhood.
+         * @param[in] fn a generic callable taking the stencil.
+         *
+         * @returns the result of `fn`
+         */
+        template<typename Fn>
+        decltype(auto) with_2d(
+                GridNeighborhoodType neighborhood_type,
+                unsigned int radius,
+                Fn&& fn
+        );
+
+        /**
+         * @brief Call a function with a one-dimensional stencil
+         *
+         * @param[in] radius the radius of the neighborhood.
+         * @param[in] fn a generic callable taking the stencil.
+         *
+         * @returns the result of `fn`
+         *
+         * @see `with_2d()`
+         */
+        template<typename Fn>
+        decltype(auto) with_1d(
+                unsigned int radius,
+                Fn&& fn
+        ) {
+            static_assert(max_static_radius == 4);
+
+            switch (radius) {
+                case 0:
+                    return fn(stencil_1d<0>);
+                case 1:
+                    return fn(stencil_1d<1>);
+                case 2:
+                    return fn(stencil_1d<2>);
+                case 3:
+                    return fn(stencil_1d<3>);
+                case 4:
+                    return fn(stencil_1d<4>);
+                default:
+                    return fn(get_1d(radius));
+            }
+        }
+
+        //! @cond SuppressDetail
+        template<GridNeighborhoodType T, typename Fn>
+        decltype(auto) with_2d(
+                unsigned int radius,
+                Fn& fn
+        ) {
+            static_assert(max_static_radius == 4);
+
+            switch (radius) {
+                case 0:
+                    return fn(stencil_2d<T, 0>);
+                case 1:
+                    return fn(stencil_2d<T, 1>);
+                case 2:
+                    return fn(stencil_2d<T, 2>);
+                case 3:
+                    return fn(stencil_2d<T, 3>);
+                case 4:
+                    return fn(stencil_2d<T, 4>);
+                default:
+                    return fn(get_2d(T, radius));
+            }
+        }
+        //! @endcond
+
+        template<typename Fn>
+        decltype(auto) with_2d(
+                GridNeighborhoodType neighborhood_type,
+                unsigned int radius,
+                Fn&& fn
+        ) {
+            switch (neighborhood_type) {
+                case GridNeighborhoodType::VonNeumann:
+                    return with_2d<GridNeighborhoodType::VonNeumann>(radius, fn);
+                case GridNeighborhoodType::Moore:
+                case GridNeighborhoodType::Edge:
+                    return with_2d<GridNeighborhoodType::Moore>(radius, fn);
+                case GridNeighborhoodType::Euclidean:
+                    return with_2d<GridNeighborhoodType::Euclidean>(radius, fn);
+                default:
+                    throw error::OptionInvalid(
+                            "Invalid neighborhood type " +
+                            std::to_string(static_cast<unsigned int>(neighborhood_type)) + " given");
+            }
+        }
+
+        //! @cond SuppressDetail
+        template<GridNeighborhoodType T, typename Fn>
+        decltype(auto) with_3d(
+                unsigned int radius,
+                Fn& fn
+        ) {
+            if (radius == 1)
+                return fn(stencil_3d<T, 1>);
+            return fn(get_3d(T, radius));
+        }
+        //! @endcond
+
+        /**
+         * @brief Call a function with a three-dimensional stencil
+         *
+         * @details Three-dimensional stencils grow quickly with radius, so
+         * only those of radius one are fixed at compile time; others are
+         * cached.
+         *
+         * @param[in] neighborhood_type the neighborhood type.
+         * @param[in] radius the radius of the neighborhood.
+         * @param[in] fn a generic callable taking the stencil.
+         *
+         * @returns the result of `fn`
+         *
+         * @see `with_2d()`
+         */
+        template<typename Fn>
+        decltype(auto) with_3d(
+                GridNeighborhoodType neighborhood_type,
+                unsigned int radius,
+                Fn&& fn
+        ) {
+            switch (neighborhood_type) {
+                case GridNeighborhoodType::VonNeumann:
+                    return with_3d<GridNeighborhoodType::VonNeumann>(radius, fn);
+                case GridNeighborhoodType::Moore:
+                    return with_3d<GridNeighborhoodType::Moore>(radius, fn);
+                case GridNeighborhoodType::Euclidean:
+                    return with_3d<GridNeighborhoodType::Euclidean>(radius, fn);
+                case GridNeighborhoodType::Edge:
+                    return with_3d<GridNeighborhoodType::Edge>(radius, fn);
+                default:
+                    throw error::OptionInvalid(
+                            "Invalid neighborhood type " +
+                            std::to_string(static_cast<unsigned int>(neighborhood_type)) + " given");
+            }
+        }
+
+        /**
+         * @brief Wrap an index onto a dimension of the given length
+         *
+         * @details Indices already within the dimension are returned
+         * without division.
+         */
+        [[nodiscard]] constexpr int wrap(
+                int index,
+                int length
+        ) {
+            if (index >= 0 && index < length)
+                return index;
+            return ((index % length) + length) % length;
+        }
+
+        /**
+         * @brief Call a visitor and report whether to continue
+         *
+         * @details Visitors may return `void`, to visit every element, or
+         * `bool`, where `false` ends the visit early.
+         *
+         * @returns false if the visitor asked to stop, true otherwise
+         */
+        template<typename Visitor, typename... Args>
+        constexpr bool visit(
+                Visitor& visitor,
+                Args&& ... args
+        ) {
+            if constexpr (std::is_same_v<std::invoke_result_t<Visitor&, Args...>, bool>)
+                return visitor(std::forward<Args>(args)...);
+            else {
+                visitor(std::forward<Args>(args)...);
+                return true;
+            }
+        }
+
+    }  // namespace stencil
+
+}  // namespace kami
+
+#endif  // KAMI_STENCIL_H
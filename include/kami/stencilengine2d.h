@@ -0,0 +1,451 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef KAMI_STENCILENGINE2D_H
+//! @cond SuppressGuard
+#define KAMI_STENCILENGINE2D_H
+//! @endcond
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <kami/error.h>
+#include <kami/executor.h>
+#include <kami/propertylayer2d.h>
+#include <kami/stencil.h>
+
+namespace kami {
+
+    /**
+     * @brief A square weighted stencil for a `StencilEngine2D`
+     *
+     * @details The kernel is either 3 by 3 or 5 by 5, for a radius of 1 or
+     * 2.  Weights are given in row-major order, by increasing `y` and then
+     * `x`, so that the weight for offset `(dx, dy)` is at
+     * `(dy + radius) * width + (dx + radius)`.
+     *
+     * @tparam T the arithmetic type of the weights
+     */
+    template<typename T>
+    class StencilKernel2D {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * @param[in] weights the 9 or 25 weights, in row-major order.
+         *
+         * @throws error::OptionInvalid if there are neither 9 nor 25
+         * weights.
+         */
+        explicit StencilKernel2D(std::span<const T> weights);
+
+        /**
+         * @brief Constructor
+         *
+         * @param[in] weights the 9 or 25 weights, in row-major order.
+         *
+         * @throws error::OptionInvalid if there are neither 9 nor 25
+         * weights.
+         */
+        StencilKernel2D(std::initializer_list<T> weights);
+
+        /**
+         * @brief Make a kernel that diffuses a share of each cell to its
+         * neighbors
+         *
+         * @details Each cell keeps `1 - rate` of its value and shares
+         * `rate` equally among its eight Moore neighbors, as in the
+         * `diffuse` primitive of NetLogo.  A cell on a bounded edge keeps
+         * the shares of the neighbors it lacks, so the total is conserved
+         * whether or not the grid wraps.
+         *
+         * @param[in] rate the share diffused, within `[0, 1]`.
+         *
+         * @return the 3 by 3 kernel
+         *
+         * @throws error::OptionInvalid if the rate is out of range.
+         */
+        [[nodiscard]] static StencilKernel2D diffusion(double rate);
+
+        /**
+         * @brief Get the radius of the kernel, either 1 or 2.
+         */
+        [[nodiscard]] int get_radius() const;
+
+        /**
+         * @brief Get the weight for an offset
+         *
+         * @return the weight, or zero if the offset is outside the kernel
+         */
+        [[nodiscard]] T get_weight(
+                int dx,
+                int dy
+        ) const;
+
+        /**
+         * @brief Get the weights, in row-major order
+         */
+        [[nodiscard]] std::span<const T> get_weights() const;
+
+    private:
+        int _radius;
+        std::array<T, 25> _weights{};
+    };
+
+    /**
+     * @brief Apply weighted stencils across whole property layers
+     *
+     * @details The engine is meant for fields such as pheromone or heat,
+     * updated in full each step.  It reads one layer and writes another,
+     * so a cell's update never sees its neighbors' new values, and
+     * `step()` keeps its own second buffer, swapping it with the layer
+     * after each pass.
+     *
+     * Each pass is divided into tiles a few hundred cells wide and a few
+     * dozen rows high.  Within a tile, the rows of input for successive
+     * rows of output stay in cache, so each value is read from memory
+     * about once per pass and the pass is limited by memory bandwidth.
+     * The inner loop over a row of a tile has the kernel unrolled at
+     * compile time and no wrapping or bounds checks, which leaves it free
+     * to be vectorized.  Only the cells within the kernel's radius of a
+     * grid edge take the slower path, which wraps by the layer's rules
+     * or, where the layer does not wrap, gives the weight of cells beyond
+     * the edge to the center cell.  A cell thus keeps what it cannot pass
+     * over a bounded edge, and a symmetric kernel whose weights sum to one
+     * conserves the total on any grid.  Tiles are divided among the
+     * threads of an `Executor` when given one.
+     *
+     * @tparam T the arithmetic type of the values
+     */
+    template<typename T>
+    class StencilEngine2D {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * @param[in] tile_x the width of each tile, in cells.
+         * @param[in] tile_y the height of each tile, in cells.
+         *
+         * @throws error::OptionInvalid if either tile dimension is zero.
+         */
+        explicit StencilEngine2D(
+                unsigned int tile_x = 512,
+                unsigned int tile_y = 32
+        );
+
+        /**
+         * @brief Apply a kernel to a layer once, writing to another
+         *
+         * @param[in] source the layer to read.
+         * @param[out] result the layer to write, of the same size as the
+         * source and not the source.
+         * @param[in] kernel the kernel to apply.
+         * @param[in] executor the `Executor` to use, or `nullptr` to run on
+         * the calling thread only.
+         *
+         * @throws error::OptionInvalid if the result is the source or
+         * differs in size.
+         */
+        void apply(
+                const PropertyLayer2D<T>& source,
+                PropertyLayer2D<T>& result,
+                const StencilKernel2D<T>& kernel,
+                Executor* executor = nullptr
+        ) const;
+
+        /**
+         * @brief Apply a kernel to a layer in place, a number of times
+         *
+         * @details The values are swapped between the layer and the
+         * engine's buffer after each pass, so references into the layer's
+         * values do not survive the call.
+         *
+         * @param[in,out] layer the layer to update.
+         * @param[in] kernel the kernel to apply.
+         * @param[in] steps the number of passes.
+         * @param[in] executor the `Executor` to use, or `nullptr` to run on
+         * the calling thread only.
+         */
+        void step(
+                PropertyLayer2D<T>& layer,
+                const StencilKernel2D<T>& kernel,
+                unsigned int steps = 1,
+                Executor* executor = nullptr
+        );
+
+        /**
+         * @brief Get the width of each tile, in cells.
+         */
+        [[nodiscard]] unsigned int get_tile_x() const;
+
+        /**
+         * @brief Get the height of each tile, in cells.
+         */
+        [[nodiscard]] unsigned int get_tile_y() const;
+
+    private:
+        unsigned int _tile_x, _tile_y;
+        std::optional<PropertyLayer2D<T>> _buffer;
+
+        template<int R>
+        static void apply_tile(
+                const T* source,
+                T* result,
+                int maximum_x,
+                int maximum_y,
+                bool wrap_x,
+                bool wrap_y,
+                const T* weights,
+                int x_begin,
+                int x_end,
+                int y_begin,
+                int y_end
+        );
+    };
+
+    template<typename T>
+    StencilKernel2D<T>::StencilKernel2D(std::span<const T> weights) {
+        if (weights.size() == 9)
+            _radius = 1;
+        else if (weights.size() == 25)
+            _radius = 2;
+        else
+            throw error::OptionInvalid(fmt::format("Kernel of {} weights is not 3 by 3 or 5 by 5", weights.size()));
+        std::copy(weights.begin(), weights.end(), _weights.begin());
+    }
+
+    template<typename T>
+    StencilKernel2D<T>::StencilKernel2D(std::initializer_list<T> weights)
+            :StencilKernel2D(std::span<const T>(weights.begin(), weights.size())) {
+    }
+
+    template<typename T>
+    StencilKernel2D<T> StencilKernel2D<T>::diffusion(const double rate) {
+        static_assert(std::is_floating_point_v<T>, "Diffusion kernels must have floating-point weights");
+        if (!(rate >= 0.0 && rate <= 1.0))
+            throw error::OptionInvalid(fmt::format("Diffusion rate {} is invalid", rate));
+
+        auto share = static_cast<T>(rate / 8.0);
+        return {share, share, share, share, static_cast<T>(1.0 - rate), share, share, share, share};
+    }
+
+    template<typename T>
+    int StencilKernel2D<T>::get_radius() const {
+        return _radius;
+    }
+
+    template<typename T>
+    T StencilKernel2D<T>::get_weight(
+            const int dx,
+            const int dy
+    ) const {
+        if (dx < -_radius || dx > _radius || dy < -_radius || dy > _radius)
+            return T{};
+        return _weights[static_cast<std::size_t>((dy + _radius) * (2 * _radius + 1) + dx + _radius)];
+    }
+
+    template<typename T>
+    std::span<const T> StencilKernel2D<T>::get_weights() const {
+        auto width = static_cast<std::size_t>(2 * _radius + 1);
+        return {_weights.data(), width * width};
+    }
+
+    template<typename T>
+    StencilEngine2D<T>::StencilEngine2D(
+            const unsigned int tile_x,
+            const unsigned int tile_y
+    )
+            :_tile_x(tile_x), _tile_y(tile_y) {
+        if (tile_x == 0 || tile_y == 0)
+            throw error::OptionInvalid(fmt::format("Tile dimensions {} by {} are invalid", tile_x, tile_y));
+    }
+
+    template<typename T>
+    void StencilEngine2D<T>::apply(
+            const PropertyLayer2D<T>& source,
+            PropertyLayer2D<T>& result,
+            const StencilKernel2D<T>& kernel,
+            Executor* executor
+    ) const {
+        if (&result == &source)
+            throw error::OptionInvalid("Stencils cannot be applied in place");
+        if (result.get_maximum_x() != source.get_maximum_x() || result.get_maximum_y() != source.get_maximum_y())
+            throw error::OptionInvalid(
+                    fmt::format("Layer of {} by {} does not match layer of {} by {}", result.get_maximum_x(),
+                                result.get_maximum_y(), source.get_maximum_x(), source.get_maximum_y()));
+
+        const auto maximum_x = static_cast<int>(source.get_maximum_x());
+        const auto maximum_y = static_cast<int>(source.get_maximum_y());
+        const auto wrap_x = source.get_wrap_x();
+        const auto wrap_y = source.get_wrap_y();
+        const auto* values = source.get_values().data();
+        auto* results = result.get_values().data();
+        const auto* weights = kernel.get_weights().data();
+        const auto radius = kernel.get_radius();
+
+        const auto tile_x = static_cast<int>(std::min(_tile_x, source.get_maximum_x()));
+        const auto tile_y = static_cast<int>(std::min(_tile_y, source.get_maximum_y()));
+        const auto tiles_x = static_cast<std::size_t>((maximum_x + tile_x - 1) / tile_x);
+        const auto tiles_y = static_cast<std::size_t>((maximum_y + tile_y - 1) / tile_y);
+
+        auto body = [&](std::size_t begin, std::size_t end) {
+            for (auto tile = begin; tile < end; tile++) {
+                auto x_begin = static_cast<int>(tile % tiles_x) * tile_x;
+                auto y_begin = static_cast<int>(tile / tiles_x) * tile_y;
+                auto x_end = std::min(x_begin + tile_x, maximum_x);
+                auto y_end = std::min(y_begin + tile_y, maximum_y);
+
+                if (radius == 1)
+                    apply_tile<1>(values, results, maximum_x, maximum_y, wrap_x, wrap_y, weights,
+                                  x_begin, x_end, y_begin, y_end);
+                else
+                    apply_tile<2>(values, results, maximum_x, maximum_y, wrap_x, wrap_y, weights,
+                                  x_begin, x_end, y_begin, y_end);
+            }
+        };
+
+        if (executor == nullptr)
+            body(0, tiles_x * tiles_y);
+        else
+            executor->parallel_for(0, tiles_x * tiles_y, 1, body);
+    }
+
+    template<typename T>
+    void StencilEngine2D<T>::step(
+            PropertyLayer2D<T>& layer,
+            const StencilKernel2D<T>& kernel,
+            const unsigned int steps,
+            Executor* executor
+    ) {
+        if (!_buffer || _buffer->get_maximum_x() != layer.get_maximum_x() ||
+            _buffer->get_maximum_y() != layer.get_maximum_y() || _buffer->get_wrap_x() != layer.get_wrap_x() ||
+            _buffer->get_wrap_y() != layer.get_wrap_y())
+            _buffer.emplace(layer.get_maximum_x(), layer.get_maximum_y(), layer.get_wrap_x(), layer.get_wrap_y());
+
+        for (unsigned int i = 0; i < steps; i++) {
+            apply(layer, *_buffer, kernel, executor);
+            std::swap(layer, *_buffer);
+        }
+    }
+
+    template<typename T>
+    unsigned int StencilEngine2D<T>::get_tile_x() const {
+        return _tile_x;
+    }
+
+    template<typename T>
+    unsigned int StencilEngine2D<T>::get_tile_y() const {
+        return _tile_y;
+    }
+
+    template<typename T>
+    template<int R>
+    void StencilEngine2D<T>::apply_tile(
+            const T* source,
+            T* result,
+            const int maximum_x,
+            const int maximum_y,
+            const bool wrap_x,
+            const bool wrap_y,
+            const T* weights,
+            const int x_begin,
+            const int x_end,
+            const int y_begin,
+            const int y_end
+    ) {
+        constexpr int width = 2 * R + 1;
+        std::array<T, width * width> w;
+        std::copy(weights, weights + width * width, w.begin());
+
+        // Columns within the radius of a side need wrapping or checks
+        const auto interior_begin = std::max(x_begin, R);
+        const auto interior_end = std::max(interior_begin, std::min(x_end, maximum_x - R));
+
+        std::array<const T*, width> rows;
+        std::array<T, width * width> row_weights;
+        for (auto y = y_begin; y < y_end; y++) {
+            // The weight of rows beyond a bounded edge goes to the center,
+            // and those rows read the center row under a zero weight
+            const auto* center = source + static_cast<std::size_t>(y) * maximum_x;
+            row_weights = w;
+            for (auto dy = -R; dy <= R; dy++) {
+                auto source_y = y + dy;
+                if (source_y >= 0 && source_y < maximum_y)
+                    rows[dy + R] = source + static_cast<std::size_t>(source_y) * maximum_x;
+                else if (wrap_y)
+                    rows[dy + R] = source + static_cast<std::size_t>(stencil::wrap(source_y, maximum_y)) * maximum_x;
+                else {
+                    rows[dy + R] = center;
+                    for (auto j = 0; j < width; j++) {
+                        row_weights[R * width + R] += row_weights[(dy + R) * width + j];
+                        row_weights[(dy + R) * width + j] = T{};
+                    }
+                }
+            }
+            auto* out = result + static_cast<std::size_t>(y) * maximum_x;
+
+            for (auto x = interior_begin; x < interior_end; x++) {
+                T total{};
+                for (auto i = 0; i < width; i++)
+                    for (auto j = 0; j < width; j++)
+                        total += row_weights[i * width + j] * rows[i][x + j - R];
+                out[x] = total;
+            }
+
+            auto edge = [&](int x) {
+                T total{};
+                for (auto i = 0; i < width; i++)
+                    for (auto j = 0; j < width; j++) {
+                        auto source_x = x + j - R;
+                        if (source_x < 0 || source_x >= maximum_x) {
+                            if (!wrap_x) {
+                                total += row_weights[i * width + j] * center[x];
+                                continue;
+                            }
+                            source_x = stencil::wrap(source_x, maximum_x);
+                        }
+                        total += row_weights[i * width + j] * rows[i][source_x];
+                    }
+                out[x] = total;
+            };
+            for (auto x = x_begin; x < std::min(interior_begin, x_end); x++)
+                edge(x);
+            for (auto x = interior_end; x < x_end; x++)
+                edge(x);
+        }
+    }
+
+}  // namespace kami
+
+#endif  // KAMI_STENCILENGINE2D_H
@@ -34,6 +34,14 @@ namespace kami {
             :_id(_id_next++) {
     }
 
+    AgentID::AgentID(long long id)
+            :_id(id) {
+    }
+
+    AgentID AgentID::null() {
+        return AgentID(0);
+    }
+
     std::string AgentID::to_string() const {
         return std::to_string(_id);
     }
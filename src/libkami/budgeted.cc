@@ -0,0 +1,169 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <kami/agent.h>
+#include <kami/budgeted.h>
+#include <kami/error.h>
+#include <kami/population.h>
+#include <kami/reporter.h>
+
+namespace kami {
+
+    BudgetedScheduler::BudgetedScheduler(std::chrono::nanoseconds budget)
+            :_budget(budget) {
+    }
+
+    BudgetedScheduler::BudgetedScheduler(
+            std::chrono::nanoseconds budget,
+            Priority priority
+    )
+            :_budget(budget), _priority(std::move(priority)) {
+    }
+
+    std::unique_ptr<std::vector<AgentID>> BudgetedScheduler::step(std::shared_ptr<Model> model) {
+        // Carried-over agents do not need a fresh copy of the agent list
+        auto agent_list = _pending.empty()
+                          ? model->get_population()->get_agent_list()
+                          : std::make_unique<std::vector<AgentID>>();
+        return std::move(this->step(model, std::move(agent_list)));
+    }
+
+    std::unique_ptr<std::vector<AgentID>> BudgetedScheduler::step(std::shared_ptr<ReporterModel> model) {
+        return std::move(this->step(std::static_pointer_cast<Model>(model)));
+    }
+
+    std::unique_ptr<std::vector<AgentID>>
+    BudgetedScheduler::step(
+            std::shared_ptr<Model> model,
+            std::unique_ptr<std::vector<AgentID>> agent_list
+    ) {
+        auto start = std::chrono::steady_clock::now();
+        auto return_agent_list = std::make_unique<std::vector<AgentID>>();
+        auto population = model->get_population();
+
+        Scheduler::_step_counter++;
+        if (_pending.empty())
+            start_round(population, *agent_list);
+
+        while (!_pending.empty()) {
+            if (!return_agent_list->empty() && std::chrono::steady_clock::now() - start >= _budget)
+                break;
+
+            auto [agent_id, round_start] = _pending.front();
+            _pending.pop_front();
+
+            std::shared_ptr<Agent> agent;
+            try {
+                agent = population->get_agent_by_id(agent_id);
+            } catch (error::AgentNotFound&) {
+                continue;
+            }
+
+            agent->step(model);
+            return_agent_list->push_back(agent_id);
+
+            auto wait = static_cast<unsigned int>(Scheduler::_step_counter) - round_start;
+            _max_wait = std::max(_max_wait, wait);
+            _total_wait += wait;
+            _total_executed++;
+        }
+
+        _deferred_count = _pending.size();
+        _total_deferred += _deferred_count;
+        _last_duration = std::chrono::steady_clock::now() - start;
+
+        return std::move(return_agent_list);
+    }
+
+    std::unique_ptr<std::vector<AgentID>>
+    BudgetedScheduler::step(
+            std::shared_ptr<ReporterModel> model,
+            std::unique_ptr<std::vector<AgentID>> agent_list
+    ) {
+        return std::move(this->step(std::static_pointer_cast<Model>(model), std::move(agent_list)));
+    }
+
+    void BudgetedScheduler::start_round(
+            const std::shared_ptr<Population>& population,
+            const std::vector<AgentID>& agent_list
+    ) {
+        auto round_start = static_cast<unsigned int>(Scheduler::_step_counter);
+
+        if (_priority == nullptr) {
+            for (auto& agent_id : agent_list)
+                _pending.emplace_back(agent_id, round_start);
+            return;
+        }
+
+        std::vector<std::pair<double, AgentID>> ranked;
+        ranked.reserve(agent_list.size());
+        for (auto& agent_id : agent_list)
+            ranked.emplace_back(_priority(population->get_agent_by_id(agent_id)), agent_id);
+
+        std::stable_sort(ranked.begin(), ranked.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.first > rhs.first;
+        });
+        for (auto& [priority, agent_id] : ranked)
+            _pending.emplace_back(agent_id, round_start);
+    }
+
+    std::chrono::nanoseconds BudgetedScheduler::set_budget(std::chrono::nanoseconds budget) {
+        _budget = budget;
+        return _budget;
+    }
+
+    std::chrono::nanoseconds BudgetedScheduler::get_budget() const {
+        return _budget;
+    }
+
+    std::size_t BudgetedScheduler::get_deferred_count() const {
+        return _deferred_count;
+    }
+
+    unsigned long long BudgetedScheduler::get_total_deferred() const {
+        return _total_deferred;
+    }
+
+    unsigned int BudgetedScheduler::get_max_wait() const {
+        return _max_wait;
+    }
+
+    double BudgetedScheduler::get_mean_wait() const {
+        if (_total_executed == 0)
+            return 0.0;
+        return static_cast<double>(_total_wait) / static_cast<double>(_total_executed);
+    }
+
+    std::chrono::nanoseconds BudgetedScheduler::get_last_duration() const {
+        return _last_duration;
+    }
+
+}  // namespace kami
@@ -0,0 +1,337 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <kami/agent.h>
+#include <kami/continuous2d.h>
+#include <kami/error.h>
+#include <kami/executor.h>
+
+namespace kami {
+
+    namespace {
+
+        constexpr std::size_t rebuild_grain = 1u << 14;
+
+    }  // namespace
+
+    ContinuousCoord2D::ContinuousCoord2D(
+            double x_coord,
+            double y_coord
+    )
+            :_x_coord(x_coord), _y_coord(y_coord) {
+    }
+
+    double ContinuousCoord2D::x() const {
+        return _x_coord;
+    }
+
+    double ContinuousCoord2D::y() const {
+        return _y_coord;
+    }
+
+    std::string ContinuousCoord2D::to_string() const {
+        return fmt::format("({}, {})", _x_coord, _y_coord);
+    }
+
+    double ContinuousCoord2D::distance(const ContinuousCoord2D& p) const {
+        return std::hypot(_x_coord - p._x_coord, _y_coord - p._y_coord);
+    }
+
+    bool operator==(
+            const ContinuousCoord2D& lhs,
+            const ContinuousCoord2D& rhs
+    ) {
+        return (lhs._x_coord == rhs._x_coord && lhs._y_coord == rhs._y_coord);
+    }
+
+    bool operator!=(
+            const ContinuousCoord2D& lhs,
+            const ContinuousCoord2D& rhs
+    ) {
+        return !(lhs == rhs);
+    }
+
+    std::ostream& operator<<(
+            std::ostream& lhs,
+            const ContinuousCoord2D& rhs
+    ) {
+        return lhs << rhs.to_string();
+    }
+
+    ContinuousSpace2D::ContinuousSpace2D(
+            double width,
+            double height,
+            double bin_size,
+            bool wrap_x,
+            bool wrap_y
+    )
+            :_width(width), _height(height), _wrap_x(wrap_x), _wrap_y(wrap_y) {
+        if (!(width > 0.0) || !(height > 0.0))
+            throw error::OptionInvalid(fmt::format("Space dimensions {} by {} are invalid", width, height));
+        if (!(bin_size > 0.0))
+            throw error::OptionInvalid(fmt::format("Bin size {} is invalid", bin_size));
+
+        _bins_x = std::max<std::size_t>(1, static_cast<std::size_t>(std::floor(width / bin_size)));
+        _bins_y = std::max<std::size_t>(1, static_cast<std::size_t>(std::floor(height / bin_size)));
+        _inverse_bin_width = static_cast<double>(_bins_x) / width;
+        _inverse_bin_height = static_cast<double>(_bins_y) / height;
+        _bin_start.assign(_bins_x * _bins_y + 1, 0);
+    }
+
+    AgentID ContinuousSpace2D::add_agent(
+            const AgentID agent_id,
+            const ContinuousCoord2D& coord
+    ) {
+        auto [x, y] = wrap_location(coord);
+
+        if (!_agent_slots.insert(agent_id, static_cast<std::uint32_t>(_agent_ids.size())))
+            throw error::OptionInvalid(fmt::format("Agent {} already in space", agent_id.to_string()));
+        _agent_ids.push_back(agent_id);
+        _agent_x.push_back(x);
+        _agent_y.push_back(y);
+        _index_stale = true;
+        return agent_id;
+    }
+
+    AgentID ContinuousSpace2D::delete_agent(const AgentID agent_id) {
+        auto slot_ptr = _agent_slots.find(agent_id);
+        if (slot_ptr == nullptr)
+            throw error::AgentNotFound(fmt::format("Agent {} not found in space", agent_id.to_string()));
+
+        // Swap the last agent into the vacated slot
+        auto slot = *slot_ptr;
+        auto last = _agent_ids.size() - 1;
+        if (slot != last) {
+            _agent_ids[slot] = _agent_ids[last];
+            _agent_x[slot] = _agent_x[last];
+            _agent_y[slot] = _agent_y[last];
+            *_agent_slots.find(_agent_ids[slot]) = slot;
+        }
+        _agent_ids.pop_back();
+        _agent_x.pop_back();
+        _agent_y.pop_back();
+        _agent_slots.erase(agent_id);
+        _index_stale = true;
+        return agent_id;
+    }
+
+    AgentID ContinuousSpace2D::move_agent(
+            const AgentID agent_id,
+            const ContinuousCoord2D& coord
+    ) {
+        auto slot = _agent_slots.find(agent_id);
+        if (slot == nullptr)
+            throw error::AgentNotFound(fmt::format("Agent {} not found in space", agent_id.to_string()));
+
+        auto [x, y] = wrap_location(coord);
+        _agent_x[*slot] = x;
+        _agent_y[*slot] = y;
+        _index_stale = true;
+        return agent_id;
+    }
+
+    bool ContinuousSpace2D::is_location_valid(const ContinuousCoord2D& coord) const {
+        return coord.x() >= 0.0 && coord.x() < _width && coord.y() >= 0.0 && coord.y() < _height;
+    }
+
+    ContinuousCoord2D ContinuousSpace2D::get_location_by_agent(const AgentID& agent_id) const {
+        auto slot = _agent_slots.find(agent_id);
+        if (slot == nullptr)
+            throw error::AgentNotFound(fmt::format("Agent {} not found in space", agent_id.to_string()));
+        return {_agent_x[*slot], _agent_y[*slot]};
+    }
+
+    double ContinuousSpace2D::distance(
+            const ContinuousCoord2D& p,
+            const ContinuousCoord2D& q
+    ) const {
+        return std::hypot(displacement(q.x() - p.x(), _width, _wrap_x),
+                          displacement(q.y() - p.y(), _height, _wrap_y));
+    }
+
+    std::unique_ptr<std::vector<AgentID>> ContinuousSpace2D::get_agents_in_radius(
+            const ContinuousCoord2D& coord,
+            const double radius
+    ) const {
+        auto agent_ids = std::make_unique<std::vector<AgentID>>();
+
+        for_each_agent_in_radius(coord, radius, [&agent_ids](const AgentID agent_id) {
+            agent_ids->push_back(agent_id);
+        });
+        return std::move(agent_ids);
+    }
+
+    void ContinuousSpace2D::rebuild_index(Executor* executor) const {
+        if (!_index_stale.load(std::memory_order_acquire))
+            return;
+
+        std::lock_guard<std::mutex> lock(_index_mutex);
+        if (!_index_stale.load(std::memory_order_relaxed))
+            return;
+
+        const auto count = _agent_ids.size();
+        const auto bin_count = _bins_x * _bins_y;
+
+        // Each chunk keeps its own histogram, so cap the chunks to keep
+        // the histograms small beside the agents themselves
+        std::size_t chunk_count = 1;
+        if (executor != nullptr)
+            chunk_count = std::clamp<std::size_t>(std::min(count / rebuild_grain, 4 * count / (bin_count + 1)),
+                                                  1, executor->get_concurrency());
+        auto chunk_size = (count + chunk_count - 1) / chunk_count;
+
+        auto for_each_chunk = [&](auto&& body) {
+            if (chunk_count == 1)
+                body(0, 0, count);
+            else
+                executor->parallel_for(0, chunk_count, 1, [&](std::size_t begin, std::size_t end) {
+                    for (auto chunk = begin; chunk < end; chunk++)
+                        body(chunk, chunk * chunk_size, std::min(count, (chunk + 1) * chunk_size));
+                });
+        };
+
+        std::vector<std::vector<std::uint32_t>> histograms(chunk_count, std::vector<std::uint32_t>(bin_count, 0));
+        _agent_bins.resize(count);
+        for_each_chunk([&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            auto& histogram = histograms[chunk];
+            for (auto i = begin; i < end; i++) {
+                auto bin = bin_of(_agent_x[i], _agent_y[i]);
+                _agent_bins[i] = static_cast<std::uint32_t>(bin);
+                histogram[bin]++;
+            }
+        });
+
+        // Turn the counts into starting offsets, bin-major and chunk-minor,
+        // which keeps agents within a bin in slot order
+        std::uint32_t offset = 0;
+        for (std::size_t bin = 0; bin < bin_count; bin++) {
+            _bin_start[bin] = offset;
+            for (auto& histogram : histograms) {
+                auto bin_size = histogram[bin];
+                histogram[bin] = offset;
+                offset += bin_size;
+            }
+        }
+        _bin_start[bin_count] = offset;
+
+        _sorted_ids.resize(count, AgentID::null());
+        _sorted_x.resize(count);
+        _sorted_y.resize(count);
+        for_each_chunk([&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            auto& histogram = histograms[chunk];
+            for (auto i = begin; i < end; i++) {
+                auto position = histogram[_agent_bins[i]]++;
+                _sorted_ids[position] = _agent_ids[i];
+                _sorted_x[position] = _agent_x[i];
+                _sorted_y[position] = _agent_y[i];
+            }
+        });
+
+        _index_stale.store(false, std::memory_order_release);
+    }
+
+    std::size_t ContinuousSpace2D::get_agent_count() const {
+        return _agent_ids.size();
+    }
+
+    double ContinuousSpace2D::get_width() const {
+        return _width;
+    }
+
+    double ContinuousSpace2D::get_height() const {
+        return _height;
+    }
+
+    bool ContinuousSpace2D::get_wrap_x() const {
+        return _wrap_x;
+    }
+
+    bool ContinuousSpace2D::get_wrap_y() const {
+        return _wrap_y;
+    }
+
+    std::size_t ContinuousSpace2D::get_bin_count_x() const {
+        return _bins_x;
+    }
+
+    std::size_t ContinuousSpace2D::get_bin_count_y() const {
+        return _bins_y;
+    }
+
+    std::pair<double, double> ContinuousSpace2D::wrap_location(const ContinuousCoord2D& coord) const {
+        auto x = coord.x();
+        auto y = coord.y();
+
+        if (_wrap_x && std::isfinite(x) && (x < 0.0 || x >= _width)) {
+            x -= _width * std::floor(x / _width);
+            if (x >= _width)
+                x = 0.0;
+        }
+        if (_wrap_y && std::isfinite(y) && (y < 0.0 || y >= _height)) {
+            y -= _height * std::floor(y / _height);
+            if (y >= _height)
+                y = 0.0;
+        }
+        if (!(x >= 0.0 && x < _width && y >= 0.0 && y < _height))
+            throw error::LocationInvalid(fmt::format("Coordinates {} are invalid", coord.to_string()));
+        return {x, y};
+    }
+
+    std::pair<int, int> ContinuousSpace2D::bin_range(
+            const double center,
+            const double radius,
+            const std::size_t bins,
+            const double inverse_bin_size,
+            const bool wrap
+    ) {
+        auto last_bin = static_cast<int>(bins) - 1;
+        // Wide enough for any range that does not span the whole space
+        auto limit = 2.0 * static_cast<double>(bins) + 1.0;
+        auto first = static_cast<int>(std::clamp(std::floor((center - radius) * inverse_bin_size), -limit, limit));
+        auto last = static_cast<int>(std::clamp(std::floor((center + radius) * inverse_bin_size), -limit, limit));
+
+        if (!wrap)
+            return {std::max(first, 0), std::min(last, last_bin)};
+
+        // Visit each bin at most once, even for a query wider than the space
+        if (last - first >= last_bin)
+            return {0, last_bin};
+        return {first, last};
+    }
+
+}  // namespace kami
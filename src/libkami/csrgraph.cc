@@ -0,0 +1,182 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <kami/csrgraph.h>
+#include <kami/error.h>
+#include <kami/network.h>
+
+namespace kami {
+
+    CSRGraph::CSRGraph(
+            unsigned int node_count,
+            std::span<const std::pair<unsigned int, unsigned int>> edges,
+            bool directed
+    )
+            :_node_count(node_count), _directed(directed), _offsets(static_cast<std::size_t>(node_count) + 1, 0) {
+        for (auto& [from, to] : edges) {
+            if (from >= node_count || to >= node_count)
+                throw error::OptionInvalid(
+                        fmt::format("Edge ({}, {}) names a node outside a graph of {} nodes", from, to, node_count));
+            if (from == to)
+                continue;
+            _offsets[from + 1]++;
+            if (!directed)
+                _offsets[to + 1]++;
+        }
+        for (std::size_t node = 0; node < node_count; node++)
+            _offsets[node + 1] += _offsets[node];
+
+        // Scatter each edge into its row, then sort and merge duplicates
+        // within each row while compacting the rows down
+        _targets.resize(_offsets.back());
+        std::vector<std::size_t> next(_offsets.begin(), _offsets.end() - 1);
+        for (auto& [from, to] : edges) {
+            if (from == to)
+                continue;
+            _targets[next[from]++] = to;
+            if (!directed)
+                _targets[next[to]++] = from;
+        }
+
+        std::size_t end = 0;
+        for (std::size_t node = 0; node < node_count; node++) {
+            auto row_begin = _targets.begin() + static_cast<std::ptrdiff_t>(_offsets[node]);
+            auto row_end = _targets.begin() + static_cast<std::ptrdiff_t>(_offsets[node + 1]);
+            std::sort(row_begin, row_end);
+            row_end = std::unique(row_begin, row_end);
+
+            _offsets[node] = end;
+            for (auto target = row_begin; target != row_end; ++target)
+                _targets[end++] = *target;
+        }
+        _offsets[node_count] = end;
+        _targets.resize(end);
+        _targets.shrink_to_fit();
+    }
+
+    std::shared_ptr<CSRGraph> CSRGraph::load_edge_list(
+            const std::string& path,
+            bool directed,
+            unsigned int node_count
+    ) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            throw error::ResourceNotAvailable(fmt::format("Cannot open edge list {}", path));
+        const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (file.bad())
+            throw error::ResourceNotAvailable(fmt::format("Cannot read edge list {}", path));
+
+        std::vector<std::pair<unsigned int, unsigned int>> edges;
+        unsigned int largest = 0;
+        std::size_t line_number = 0;
+        auto position = text.data();
+        const auto text_end = text.data() + text.size();
+
+        auto skip_blanks = [&position, text_end]() {
+            while (position < text_end && (*position == ' ' || *position == '\t' || *position == '\r'))
+                position++;
+        };
+
+        while (position < text_end) {
+            auto line_end = std::find(position, text_end, '\n');
+            line_number++;
+
+            skip_blanks();
+            if (position < line_end && *position != '#' && *position != '%') {
+                unsigned int node[2];
+                for (auto& n : node) {
+                    skip_blanks();
+                    auto [parsed_end, ec] = std::from_chars(position, line_end, n);
+                    if (ec != std::errc())
+                        throw error::OptionInvalid(
+                                fmt::format("Cannot parse line {} of edge list {}", line_number, path));
+                    position = parsed_end;
+                }
+
+                // Only a comment may follow, so that a file with extra
+                // columns is not silently read as a different graph
+                skip_blanks();
+                if (position < line_end && *position != '#' && *position != '%')
+                    throw error::OptionInvalid(
+                            fmt::format("Unexpected text after the edge on line {} of edge list {}", line_number,
+                                        path));
+                largest = std::max({largest, node[0], node[1]});
+                edges.emplace_back(node[0], node[1]);
+            }
+            position = line_end + (line_end < text_end ? 1 : 0);
+        }
+
+        if (node_count == 0 && !edges.empty())
+            node_count = largest + 1;
+        return std::make_shared<CSRGraph>(node_count, edges, directed);
+    }
+
+    unsigned int CSRGraph::get_node_count() const {
+        return _node_count;
+    }
+
+    std::size_t CSRGraph::get_edge_count() const {
+        return _directed ? _targets.size() : _targets.size() / 2;
+    }
+
+    bool CSRGraph::is_directed() const {
+        return _directed;
+    }
+
+    std::span<const unsigned int> CSRGraph::get_neighbors(const unsigned int node) const {
+        return {_targets.data() + _offsets[node], _offsets[node + 1] - _offsets[node]};
+    }
+
+    bool CSRGraph::has_edge(
+            const unsigned int from,
+            const unsigned int to
+    ) const {
+        auto neighbors = get_neighbors(from);
+        return std::binary_search(neighbors.begin(), neighbors.end(), to);
+    }
+
+    std::span<const std::size_t> CSRGraph::get_offsets() const {
+        return _offsets;
+    }
+
+    std::span<const unsigned int> CSRGraph::get_targets() const {
+        return _targets;
+    }
+
+}  // namespace kami
@@ -0,0 +1,272 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <kami/csrgraph.h>
+#include <kami/dynamicgraph.h>
+#include <kami/error.h>
+#include <kami/network.h>
+
+namespace kami {
+
+    DynamicGraph::DynamicGraph(
+            unsigned int node_count,
+            bool directed
+    )
+            :_node_count(node_count), _directed(directed), _rows(node_count, Row{0, 0, 0}) {
+    }
+
+    DynamicGraph::DynamicGraph(const NetworkGraph& graph)
+            :DynamicGraph(graph.get_node_count(), graph.is_directed()) {
+        // Size each row to fit, so that copying moves no rows
+        std::size_t total = 0;
+        for (unsigned int node = 0; node < _node_count; node++) {
+            auto degree = static_cast<std::uint32_t>(graph.get_degree(node));
+            _rows[node] = Row{total, 0, degree};
+            total += degree;
+        }
+        _pool.resize(total);
+
+        std::size_t capacity = 16;
+        while (capacity < 2 * total)
+            capacity *= 2;
+        rehash_edges(capacity);
+
+        for (unsigned int node = 0; node < _node_count; node++)
+            for (auto neighbor : graph.get_neighbors(node))
+                push_neighbor(node, neighbor);
+    }
+
+    bool DynamicGraph::add_edge(
+            const unsigned int from,
+            const unsigned int to
+    ) {
+        if (from >= _node_count || to >= _node_count)
+            throw error::OptionInvalid(
+                    fmt::format("Edge ({}, {}) names a node outside a graph of {} nodes", from, to, _node_count));
+        if (from == to || find_edge(edge_key(from, to)) != npos)
+            return false;
+
+        push_neighbor(from, to);
+        if (!_directed)
+            push_neighbor(to, from);
+        return true;
+    }
+
+    bool DynamicGraph::delete_edge(
+            const unsigned int from,
+            const unsigned int to
+    ) {
+        if (from >= _node_count || to >= _node_count || find_edge(edge_key(from, to)) == npos)
+            return false;
+
+        remove_neighbor(from, to);
+        if (!_directed)
+            remove_neighbor(to, from);
+        return true;
+    }
+
+    unsigned int DynamicGraph::get_node_count() const {
+        return _node_count;
+    }
+
+    std::size_t DynamicGraph::get_edge_count() const {
+        return _directed ? _edge_entries : _edge_entries / 2;
+    }
+
+    bool DynamicGraph::is_directed() const {
+        return _directed;
+    }
+
+    std::span<const unsigned int> DynamicGraph::get_neighbors(const unsigned int node) const {
+        auto& row = _rows[node];
+        return {_pool.data() + row.begin, row.size};
+    }
+
+    bool DynamicGraph::has_edge(
+            const unsigned int from,
+            const unsigned int to
+    ) const {
+        return find_edge(edge_key(from, to)) != npos;
+    }
+
+    std::shared_ptr<CSRGraph> DynamicGraph::freeze() const {
+        std::vector<std::pair<unsigned int, unsigned int>> edges;
+        edges.reserve(get_edge_count());
+
+        // Undirected edges are stored both ways but need only be given once
+        for (unsigned int node = 0; node < _node_count; node++)
+            for (auto neighbor : get_neighbors(node))
+                if (_directed || node < neighbor)
+                    edges.emplace_back(node, neighbor);
+        return std::make_shared<CSRGraph>(_node_count, edges, _directed);
+    }
+
+    void DynamicGraph::compact() {
+        std::vector<unsigned int> pool(_pool.size() - _abandoned);
+        std::size_t end = 0;
+
+        for (auto& row : _rows) {
+            std::copy_n(_pool.begin() + static_cast<std::ptrdiff_t>(row.begin), row.size,
+                        pool.begin() + static_cast<std::ptrdiff_t>(end));
+            row.begin = end;
+            end += row.capacity;
+        }
+        _pool = std::move(pool);
+        _abandoned = 0;
+    }
+
+    std::uint64_t DynamicGraph::edge_key(
+            const unsigned int from,
+            const unsigned int to
+    ) {
+        return (static_cast<std::uint64_t>(from) << 32) | to;
+    }
+
+    std::size_t DynamicGraph::home_slot(const std::uint64_t key) const {
+        // Fibonacci hashing, as in `AgentIndex`
+        return static_cast<std::size_t>((key * 0x9e3779b97f4a7c15ULL) >> _edge_shift);
+    }
+
+    std::size_t DynamicGraph::find_edge(const std::uint64_t key) const {
+        if (_edge_entries == 0)
+            return npos;
+
+        for (auto index = home_slot(key); _edge_keys[index] != no_edge; index = (index + 1) & _edge_mask)
+            if (_edge_keys[index] == key)
+                return index;
+        return npos;
+    }
+
+    void DynamicGraph::insert_edge(
+            const std::uint64_t key,
+            const std::uint32_t slot
+    ) {
+        if (2 * (_edge_entries + 1) > _edge_keys.size())
+            rehash_edges(_edge_keys.empty() ? 16 : 2 * _edge_keys.size());
+
+        auto index = home_slot(key);
+        while (_edge_keys[index] != no_edge)
+            index = (index + 1) & _edge_mask;
+        _edge_keys[index] = key;
+        _edge_slots[index] = slot;
+        _edge_entries++;
+    }
+
+    void DynamicGraph::erase_edge(std::size_t index) {
+        // Shift back any later entries that probed past this one
+        auto next = (index + 1) & _edge_mask;
+        while (_edge_keys[next] != no_edge) {
+            auto home = home_slot(_edge_keys[next]);
+            if (((next - home) & _edge_mask) >= ((next - index) & _edge_mask)) {
+                _edge_keys[index] = _edge_keys[next];
+                _edge_slots[index] = _edge_slots[next];
+                index = next;
+            }
+            next = (next + 1) & _edge_mask;
+        }
+
+        _edge_keys[index] = no_edge;
+        _edge_entries--;
+    }
+
+    void DynamicGraph::rehash_edges(std::size_t capacity) {
+        auto keys = std::move(_edge_keys);
+        auto slots = std::move(_edge_slots);
+
+        _edge_keys.assign(capacity, no_edge);
+        _edge_slots.assign(capacity, 0);
+        _edge_mask = capacity - 1;
+        _edge_shift = 64;
+        for (auto c = capacity; c > 1; c >>= 1)
+            _edge_shift--;
+
+        for (std::size_t i = 0; i < keys.size(); i++) {
+            if (keys[i] == no_edge)
+                continue;
+
+            auto index = home_slot(keys[i]);
+            while (_edge_keys[index] != no_edge)
+                index = (index + 1) & _edge_mask;
+            _edge_keys[index] = keys[i];
+            _edge_slots[index] = slots[i];
+        }
+    }
+
+    void DynamicGraph::push_neighbor(
+            const unsigned int from,
+            const unsigned int to
+    ) {
+        auto& row = _rows[from];
+
+        // Move a full row to the end of the pool with room to grow
+        if (row.size == row.capacity) {
+            auto capacity = std::max<std::uint32_t>(4, 2 * row.capacity);
+            auto begin = _pool.size();
+
+            _pool.resize(begin + capacity);
+            std::copy_n(_pool.begin() + static_cast<std::ptrdiff_t>(row.begin), row.size,
+                        _pool.begin() + static_cast<std::ptrdiff_t>(begin));
+            _abandoned += row.capacity;
+            row.begin = begin;
+            row.capacity = capacity;
+        }
+
+        _pool[row.begin + row.size] = to;
+        insert_edge(edge_key(from, to), row.size);
+        row.size++;
+
+        if (2 * _abandoned > _pool.size())
+            compact();
+    }
+
+    void DynamicGraph::remove_neighbor(
+            const unsigned int from,
+            const unsigned int to
+    ) {
+        auto& row = _rows[from];
+        auto index = find_edge(edge_key(from, to));
+        auto slot = _edge_slots[index];
+        erase_edge(index);
+
+        // Move the last neighbor of the row into the vacated slot
+        row.size--;
+        if (slot != row.size) {
+            auto last = _pool[row.begin + row.size];
+            _pool[row.begin + slot] = last;
+            _edge_slots[find_edge(edge_key(from, last))] = slot;
+        }
+    }
+
+}  // namespace kami
@@ -0,0 +1,289 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <kami/error.h>
+#include <kami/executor.h>
+
+namespace kami {
+
+    namespace {
+        // The executor and queue the current thread works for, if any
+        thread_local const Executor* current_executor = nullptr;
+        thread_local int current_worker = -1;
+    }
+
+    struct Executor::Group {
+        explicit Group(std::size_t count)
+                :pending(count) {
+        }
+
+        void fail(std::exception_ptr exception_ptr) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!exception)
+                exception = std::move(exception_ptr);
+            failed = true;
+        }
+
+        std::atomic<std::size_t> pending;
+        std::atomic<bool> failed{false};
+        std::mutex mutex;
+        std::exception_ptr exception = nullptr;
+    };
+
+    Executor::Executor(unsigned int thread_count) {
+        // One queue per worker, plus one for work submitted from outside
+        for (unsigned int i = 0; i <= thread_count; i++)
+            _queues.push_back(std::make_unique<Queue>());
+        for (unsigned int i = 0; i < thread_count; i++)
+            _threads.emplace_back(&Executor::work, this, static_cast<int>(i));
+    }
+
+    Executor::~Executor() {
+        {
+            std::lock_guard<std::mutex> lock(_sleep_mutex);
+            _stop = true;
+        }
+        _sleep.notify_all();
+        for (auto& thread : _threads)
+            thread.join();
+    }
+
+    unsigned int Executor::get_thread_count() const {
+        return static_cast<unsigned int>(_threads.size());
+    }
+
+    unsigned int Executor::get_concurrency() const {
+        return get_thread_count() + 1;
+    }
+
+    unsigned int Executor::default_thread_count() {
+        auto hardware_threads = std::thread::hardware_concurrency();
+        return hardware_threads > 1 ? hardware_threads - 1 : 0;
+    }
+
+    void Executor::parallel_for(
+            std::size_t begin,
+            std::size_t end,
+            std::size_t grain,
+            const std::function<void(std::size_t, std::size_t)>& body
+    ) {
+        if (end <= begin)
+            return;
+
+        auto count = end - begin;
+        if (grain == 0)
+            grain = std::max<std::size_t>(1, count / (4 * get_concurrency()));
+        if (count <= grain) {
+            body(begin, end);
+            return;
+        }
+
+        Group group((count + grain - 1) / grain);
+        for (auto chunk_begin = begin; chunk_begin < end; chunk_begin += std::min(grain, end - chunk_begin)) {
+            auto chunk_end = chunk_begin + std::min(grain, end - chunk_begin);
+            submit({[&body, &group, chunk_begin, chunk_end]() {
+                if (!group.failed)
+                    body(chunk_begin, chunk_end);
+            }, &group});
+        }
+        wait(group);
+    }
+
+    void Executor::run(const TaskGraph& graph) {
+        auto node_count = graph._nodes.size();
+        if (node_count == 0)
+            return;
+
+        // Reject cycles up front, otherwise the run would never finish
+        std::vector<std::size_t> in_degree(node_count);
+        std::vector<std::size_t> ready;
+        for (std::size_t i = 0; i < node_count; i++)
+            if ((in_degree[i] = graph._nodes[i].predecessor_count) == 0)
+                ready.push_back(i);
+        auto roots = ready;
+        for (std::size_t visited = 0; visited < node_count; visited++) {
+            if (ready.empty())
+                throw error::OptionInvalid("Task graph contains a cycle");
+            auto i = ready.back();
+            ready.pop_back();
+            for (auto successor : graph._nodes[i].successors)
+                if (--in_degree[successor] == 0)
+                    ready.push_back(successor);
+        }
+
+        struct Run {
+            const TaskGraph& graph;
+            Executor& executor;
+            Group group;
+            std::unique_ptr<std::atomic<std::size_t>[]> remaining;
+
+            void launch(std::size_t i) {
+                executor.submit({[this, i]() { complete(i); }, &group});
+            }
+
+            void complete(std::size_t i) {
+                auto& node = graph._nodes[i];
+                if (!group.failed) {
+                    try {
+                        node.fn();
+                    } catch (...) {
+                        group.fail(std::current_exception());
+                    }
+                }
+                for (auto successor : node.successors)
+                    if (remaining[successor].fetch_sub(1) == 1)
+                        launch(successor);
+            }
+        } run{graph, *this, Group(node_count), std::make_unique<std::atomic<std::size_t>[]>(node_count)};
+
+        for (std::size_t i = 0; i < node_count; i++)
+            run.remaining[i] = graph._nodes[i].predecessor_count;
+        for (auto root : roots)
+            run.launch(root);
+        wait(run.group);
+    }
+
+    void Executor::submit(Task task) {
+        auto self = (current_executor == this) ? current_worker : -1;
+        auto& queue = (self >= 0) ? *_queues[self] : *_queues.back();
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+        _queued++;
+        {
+            std::lock_guard<std::mutex> lock(_sleep_mutex);
+        }
+        _sleep.notify_one();
+    }
+
+    bool Executor::try_execute(int self) {
+        auto queue_count = static_cast<int>(_queues.size());
+        Task task;
+        auto found = false;
+
+        // Our own work first, newest first, while it is still in cache
+        if (self >= 0) {
+            std::lock_guard<std::mutex> lock(_queues[self]->mutex);
+            if (!_queues[self]->tasks.empty()) {
+                task = std::move(_queues[self]->tasks.back());
+                _queues[self]->tasks.pop_back();
+                found = true;
+            }
+        }
+
+        // Then outside submissions and everybody else's oldest work
+        auto start = (self >= 0) ? self + 1 : queue_count - 1;
+        for (int i = 0; !found && i < queue_count; i++) {
+            auto victim = (start + i) % queue_count;
+            if (victim == self)
+                continue;
+            std::lock_guard<std::mutex> lock(_queues[victim]->mutex);
+            if (!_queues[victim]->tasks.empty()) {
+                task = std::move(_queues[victim]->tasks.front());
+                _queues[victim]->tasks.pop_front();
+                found = true;
+            }
+        }
+
+        if (!found)
+            return false;
+        _queued--;
+        execute(task);
+        return true;
+    }
+
+    void Executor::wait(Group& group) {
+        auto self = (current_executor == this) ? current_worker : -1;
+
+        while (group.pending.load() > 0)
+            if (!try_execute(self))
+                std::this_thread::yield();
+
+        if (group.exception)
+            std::rethrow_exception(group.exception);
+    }
+
+    void Executor::work(int self) {
+        current_executor = this;
+        current_worker = self;
+
+        while (true) {
+            if (try_execute(self))
+                continue;
+
+            std::unique_lock<std::mutex> lock(_sleep_mutex);
+            _sleep.wait(lock, [this]() { return _stop || _queued.load() > 0; });
+            if (_stop && _queued.load() == 0)
+                return;
+        }
+    }
+
+    void Executor::execute(Task& task) {
+        auto group = task.group;
+        try {
+            task.fn();
+        } catch (...) {
+            group->fail(std::current_exception());
+        }
+        group->pending--;
+    }
+
+    std::size_t TaskGraph::add_task(std::function<void()> task) {
+        _nodes.push_back({std::move(task), {}, 0});
+        return _nodes.size() - 1;
+    }
+
+    void TaskGraph::add_dependency(
+            std::size_t before,
+            std::size_t after
+    ) {
+        if (before >= _nodes.size() || after >= _nodes.size())
+            throw error::OptionInvalid("Task index out of range");
+
+        _nodes[before].successors.push_back(after);
+        _nodes[after].predecessor_count++;
+    }
+
+    std::size_t TaskGraph::size() const {
+        return _nodes.size();
+    }
+
+    void TaskGraph::clear() {
+        _nodes.clear();
+    }
+
+}  // namespace kami
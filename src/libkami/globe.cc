@@ -0,0 +1,557 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <numbers>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <kami/agent.h>
+#include <kami/error.h>
+#include <kami/executor.h>
+#include <kami/globe.h>
+
+namespace kami {
+
+    namespace {
+
+        constexpr std::size_t rebuild_grain = 1u << 14;
+        constexpr double degrees = std::numbers::pi / 180.0;
+        constexpr double half_pi = std::numbers::pi / 2.0;
+
+        // Place the bits of a 16-bit value in the even bit positions
+        constexpr std::uint32_t spread_bits(std::uint32_t v) {
+            v = (v | (v << 8)) & 0x00ff00ffu;
+            v = (v | (v << 4)) & 0x0f0f0f0fu;
+            v = (v | (v << 2)) & 0x33333333u;
+            v = (v | (v << 1)) & 0x55555555u;
+            return v;
+        }
+
+        // The inverse of spread_bits, ignoring the odd bit positions
+        constexpr std::uint32_t compress_bits(std::uint32_t v) {
+            v &= 0x55555555u;
+            v = (v | (v >> 1)) & 0x33333333u;
+            v = (v | (v >> 2)) & 0x0f0f0f0fu;
+            v = (v | (v >> 4)) & 0x00ff00ffu;
+            v = (v | (v >> 8)) & 0x0000ffffu;
+            return v;
+        }
+
+        // The ring and longitude offset of the southernmost corner of each
+        // base cell, in units of the side of the cell
+        constexpr std::array<int, 12> face_ring{2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4};
+        constexpr std::array<int, 12> face_phi{1, 3, 5, 7, 0, 2, 4, 6, 1, 3, 5, 7};
+
+        void check_level(const unsigned int level) {
+            if (level > Globe::maximum_level)
+                throw error::OptionInvalid(fmt::format("Cell level {} is invalid", level));
+        }
+
+        // The arctangent of t for |t| <= 0.66, as a rational function
+        // without branches (Cephes, accurate to about one ulp)
+        inline double small_arctangent(const double t) {
+            const double z = t * t;
+            const double p = (((-8.750608600031904122785e-1 * z - 1.615753718733365076637e1) * z -
+                               7.500855792314704667340e1) * z - 1.228866684490136173410e2) * z -
+                             6.485021904942025371773e1;
+            const double q = ((((z + 2.485846490142306297962e1) * z + 1.650270098316988542046e2) * z +
+                               4.328810604912902668951e2) * z + 4.853903996359136964868e2) * z +
+                             1.945506571482613964425e2;
+            return t * z * p / q + t;
+        }
+
+        // The angles between a unit vector and each of a run of unit
+        // vectors.  For unit vectors p and q, with chord c = |p - q| and
+        // s = |p + q|, c^2 + s^2 = 4 and the angle is 2 atan(c / s).  Two
+        // half-angle steps bring the argument into [0, tan(pi / 8)], where
+        // no range reduction is needed, so the loop has no branches and
+        // vectorizes without a vector arctangent.
+        void angle_kernel(
+                const double origin_x,
+                const double origin_y,
+                const double origin_z,
+                const double scale,
+                const double* xs,
+                const double* ys,
+                const double* zs,
+                double* angles,
+                const std::size_t count
+        ) {
+            for (std::size_t i = 0; i < count; i++) {
+                const double dx = xs[i] - origin_x, dy = ys[i] - origin_y, dz = zs[i] - origin_z;
+                const double sx = xs[i] + origin_x, sy = ys[i] + origin_y, sz = zs[i] + origin_z;
+                const double chord = std::sqrt(dx * dx + dy * dy + dz * dz);
+                const double span = std::sqrt(sx * sx + sy * sy + sz * sz);
+                const double quarter = chord / (span + 2.0);
+                const double eighth = quarter / (1.0 + std::sqrt(1.0 + quarter * quarter));
+                angles[i] = 8.0 * scale * small_arctangent(eighth);
+            }
+        }
+
+    }  // namespace
+
+    GlobeCoord::GlobeCoord(
+            double latitude,
+            double longitude
+    )
+            :_latitude(latitude), _longitude(longitude) {
+    }
+
+    double GlobeCoord::latitude() const {
+        return _latitude;
+    }
+
+    double GlobeCoord::longitude() const {
+        return _longitude;
+    }
+
+    std::string GlobeCoord::to_string() const {
+        return fmt::format("({}, {})", _latitude, _longitude);
+    }
+
+    double GlobeCoord::distance(const GlobeCoord& p) const {
+        auto sin_latitude = std::sin((p._latitude - _latitude) * degrees / 2.0);
+        auto sin_longitude = std::sin((p._longitude - _longitude) * degrees / 2.0);
+        auto h = sin_latitude * sin_latitude +
+                 std::cos(_latitude * degrees) * std::cos(p._latitude * degrees) * sin_longitude * sin_longitude;
+        return 2.0 * std::asin(std::sqrt(std::clamp(h, 0.0, 1.0)));
+    }
+
+    bool operator==(
+            const GlobeCoord& lhs,
+            const GlobeCoord& rhs
+    ) {
+        return (lhs._latitude == rhs._latitude && lhs._longitude == rhs._longitude);
+    }
+
+    bool operator!=(
+            const GlobeCoord& lhs,
+            const GlobeCoord& rhs
+    ) {
+        return !(lhs == rhs);
+    }
+
+    std::ostream& operator<<(
+            std::ostream& lhs,
+            const GlobeCoord& rhs
+    ) {
+        return lhs << rhs.to_string();
+    }
+
+    Globe::Globe(
+            double radius,
+            unsigned int level
+    )
+            :_radius(radius), _level(level) {
+        if (!(radius > 0.0) || !std::isfinite(radius))
+            throw error::OptionInvalid(fmt::format("Globe radius {} is invalid", radius));
+        check_level(level);
+
+        for (unsigned int i = 0; i <= level; i++)
+            _cell_radii[i] = get_cell_radius(i);
+        _cell_start.assign(get_cell_count() + 1, 0);
+    }
+
+    AgentID Globe::add_agent(
+            const AgentID agent_id,
+            const GlobeCoord& coord
+    ) {
+        auto location = normalize(coord);
+
+        auto slot = _agent_ids.size();
+        if (!_agent_slots.insert(agent_id, static_cast<std::uint32_t>(slot)))
+            throw error::OptionInvalid(fmt::format("Agent {} already on globe", agent_id.to_string()));
+        _agent_ids.push_back(agent_id);
+        _agent_latitudes.emplace_back();
+        _agent_longitudes.emplace_back();
+        _agent_x.emplace_back();
+        _agent_y.emplace_back();
+        _agent_z.emplace_back();
+        _agent_cells.emplace_back();
+        place(slot, location);
+        return agent_id;
+    }
+
+    AgentID Globe::delete_agent(const AgentID agent_id) {
+        auto slot_ptr = _agent_slots.find(agent_id);
+        if (slot_ptr == nullptr)
+            throw error::AgentNotFound(fmt::format("Agent {} not found on globe", agent_id.to_string()));
+
+        // Swap the last agent into the vacated slot
+        auto slot = *slot_ptr;
+        auto last = _agent_ids.size() - 1;
+        if (slot != last) {
+            _agent_ids[slot] = _agent_ids[last];
+            _agent_latitudes[slot] = _agent_latitudes[last];
+            _agent_longitudes[slot] = _agent_longitudes[last];
+            _agent_x[slot] = _agent_x[last];
+            _agent_y[slot] = _agent_y[last];
+            _agent_z[slot] = _agent_z[last];
+            _agent_cells[slot] = _agent_cells[last];
+            *_agent_slots.find(_agent_ids[slot]) = slot;
+        }
+        _agent_ids.pop_back();
+        _agent_latitudes.pop_back();
+        _agent_longitudes.pop_back();
+        _agent_x.pop_back();
+        _agent_y.pop_back();
+        _agent_z.pop_back();
+        _agent_cells.pop_back();
+        _agent_slots.erase(agent_id);
+        _index_stale = true;
+        return agent_id;
+    }
+
+    AgentID Globe::move_agent(
+            const AgentID agent_id,
+            const GlobeCoord& coord
+    ) {
+        auto slot = _agent_slots.find(agent_id);
+        if (slot == nullptr)
+            throw error::AgentNotFound(fmt::format("Agent {} not found on globe", agent_id.to_string()));
+
+        place(*slot, normalize(coord));
+        return agent_id;
+    }
+
+    bool Globe::is_location_valid(const GlobeCoord& coord) const {
+        return coord.latitude() >= -90.0 && coord.latitude() <= 90.0 && std::isfinite(coord.longitude());
+    }
+
+    GlobeCoord Globe::get_location_by_agent(const AgentID& agent_id) const {
+        auto slot = _agent_slots.find(agent_id);
+        if (slot == nullptr)
+            throw error::AgentNotFound(fmt::format("Agent {} not found on globe", agent_id.to_string()));
+        return {_agent_latitudes[*slot], _agent_longitudes[*slot]};
+    }
+
+    double Globe::distance(
+            const GlobeCoord& p,
+            const GlobeCoord& q
+    ) const {
+        return _radius * p.distance(q);
+    }
+
+    void Globe::get_distances(
+            const GlobeCoord& coord,
+            std::span<const AgentID> agent_ids,
+            std::span<double> distances
+    ) const {
+        if (distances.size() < agent_ids.size())
+            throw error::OptionInvalid(
+                    fmt::format("Output holds {} distances, not {}", distances.size(), agent_ids.size()));
+
+        // Gather the agents' unit vectors into flat arrays first, so the
+        // distances are found in one pass over contiguous memory
+        const auto count = agent_ids.size();
+        std::vector<double> xs(count), ys(count), zs(count);
+        for (std::size_t i = 0; i < count; i++) {
+            auto slot = _agent_slots.find(agent_ids[i]);
+            if (slot == nullptr)
+                throw error::AgentNotFound(fmt::format("Agent {} not found on globe", agent_ids[i].to_string()));
+
+            xs[i] = _agent_x[*slot];
+            ys[i] = _agent_y[*slot];
+            zs[i] = _agent_z[*slot];
+        }
+
+        const auto origin = to_vector(coord.latitude(), coord.longitude());
+        angle_kernel(origin.x, origin.y, origin.z, _radius, xs.data(), ys.data(), zs.data(), distances.data(), count);
+    }
+
+    std::unique_ptr<std::vector<AgentID>> Globe::get_agents_in_radius(
+            const GlobeCoord& coord,
+            const double radius
+    ) const {
+        auto agent_ids = std::make_unique<std::vector<AgentID>>();
+
+        for_each_agent_in_radius(coord, radius, [&agent_ids](const AgentID agent_id) {
+            agent_ids->push_back(agent_id);
+        });
+        return std::move(agent_ids);
+    }
+
+    void Globe::rebuild_index(Executor* executor) const {
+        if (!_index_stale.load(std::memory_order_acquire))
+            return;
+
+        std::lock_guard<std::mutex> lock(_index_mutex);
+        if (!_index_stale.load(std::memory_order_relaxed))
+            return;
+
+        const auto count = _agent_ids.size();
+        const auto cell_count = get_cell_count();
+
+        // Each chunk keeps its own histogram, so cap the chunks to keep
+        // the histograms small beside the agents themselves
+        std::size_t chunk_count = 1;
+        if (executor != nullptr)
+            chunk_count = std::clamp<std::size_t>(std::min(count / rebuild_grain, 4 * count / (cell_count + 1)),
+                                                  1, executor->get_concurrency());
+        auto chunk_size = (count + chunk_count - 1) / chunk_count;
+
+        auto for_each_chunk = [&](auto&& body) {
+            if (chunk_count == 1)
+                body(0, 0, count);
+            else
+                executor->parallel_for(0, chunk_count, 1, [&](std::size_t begin, std::size_t end) {
+                    for (auto chunk = begin; chunk < end; chunk++)
+                        body(chunk, chunk * chunk_size, std::min(count, (chunk + 1) * chunk_size));
+                });
+        };
+
+        std::vector<std::vector<std::uint32_t>> histograms(chunk_count, std::vector<std::uint32_t>(cell_count, 0));
+        for_each_chunk([&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            auto& histogram = histograms[chunk];
+            for (auto i = begin; i < end; i++)
+                histogram[_agent_cells[i]]++;
+        });
+
+        // Turn the counts into starting offsets, cell-major and
+        // chunk-minor, which keeps agents within a cell in slot order
+        std::uint32_t offset = 0;
+        for (std::size_t cell = 0; cell < cell_count; cell++) {
+            _cell_start[cell] = offset;
+            for (auto& histogram : histograms) {
+                auto cell_size = histogram[cell];
+                histogram[cell] = offset;
+                offset += cell_size;
+            }
+        }
+        _cell_start[cell_count] = offset;
+
+        _sorted_ids.resize(count, AgentID::null());
+        _sorted_x.resize(count);
+        _sorted_y.resize(count);
+        _sorted_z.resize(count);
+        for_each_chunk([&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            auto& histogram = histograms[chunk];
+            for (auto i = begin; i < end; i++) {
+                auto position = histogram[_agent_cells[i]]++;
+                _sorted_ids[position] = _agent_ids[i];
+                _sorted_x[position] = _agent_x[i];
+                _sorted_y[position] = _agent_y[i];
+                _sorted_z[position] = _agent_z[i];
+            }
+        });
+
+        _index_stale.store(false, std::memory_order_release);
+    }
+
+    std::size_t Globe::get_agent_count() const {
+        return _agent_ids.size();
+    }
+
+    double Globe::get_radius() const {
+        return _radius;
+    }
+
+    unsigned int Globe::get_level() const {
+        return _level;
+    }
+
+    std::size_t Globe::get_cell_count() const {
+        return std::size_t{12} << (2 * _level);
+    }
+
+    std::uint32_t Globe::get_cell(
+            const GlobeCoord& coord,
+            const unsigned int level
+    ) {
+        check_level(level);
+        return vector_cell(to_vector(coord.latitude(), coord.longitude()), level);
+    }
+
+    GlobeCoord Globe::get_cell_center(
+            const std::uint32_t cell,
+            const unsigned int level
+    ) {
+        check_level(level);
+        if (cell >= (std::uint32_t{12} << (2 * level)))
+            throw error::OptionInvalid(fmt::format("Cell {} at level {} is invalid", cell, level));
+
+        auto v = cell_vector(cell, level);
+        return {std::asin(std::clamp(v.z, -1.0, 1.0)) / degrees, std::atan2(v.y, v.x) / degrees};
+    }
+
+    double Globe::get_cell_radius(const unsigned int level) {
+        check_level(level);
+
+        // The widest cells are those in the polar caps next to the
+        // equatorial band, measured from center to pole-side corner
+        auto side = static_cast<double>(1u << level);
+        auto t = 1.0 - 1.0 / side;
+        auto phi = std::numbers::pi / (4.0 * side);
+        auto z = 1.0 - t * t / 3.0;
+        auto r_a = std::sqrt(1.0 - 4.0 / 9.0);
+        auto r_b = std::sqrt(1.0 - z * z);
+        auto dot = r_a * r_b * std::cos(phi) + 2.0 / 3.0 * z;
+
+        // Pad for rounding, so that no agent is ever passed over
+        return std::acos(std::clamp(dot, -1.0, 1.0)) * (1.0 + 1e-9) + 1e-12;
+    }
+
+    Globe::Vector Globe::to_vector(
+            const double latitude,
+            const double longitude
+    ) {
+        auto cos_latitude = std::cos(latitude * degrees);
+        return {cos_latitude * std::cos(longitude * degrees),
+                cos_latitude * std::sin(longitude * degrees),
+                std::sin(latitude * degrees)};
+    }
+
+    std::uint32_t Globe::vector_cell(
+            const Vector& v,
+            const unsigned int level
+    ) {
+        const auto side = 1u << level;
+        const auto side_d = static_cast<double>(side);
+        const auto z = std::clamp(v.z, -1.0, 1.0);
+        const auto za = std::abs(z);
+
+        // The longitude in quarter turns, in [0, 4)
+        auto tt = std::atan2(v.y, v.x) / half_pi;
+        if (tt < 0.0)
+            tt += 4.0;
+        if (tt >= 4.0)
+            tt = 0.0;
+
+        unsigned int face, ix, iy;
+        if (za <= 2.0 / 3.0) {
+            // The equatorial band, where cell edges are straight lines in
+            // longitude and the sine of latitude
+            auto t1 = side_d * (0.5 + tt);
+            auto t2 = side_d * z * 0.75;
+            auto jp = static_cast<unsigned int>(t1 - t2);
+            auto jm = static_cast<unsigned int>(t1 + t2);
+            auto ifp = jp >> level;
+            auto ifm = jm >> level;
+            if (ifp == ifm)
+                face = ifp | 4u;
+            else if (ifp < ifm)
+                face = ifp;
+            else
+                face = ifm + 8u;
+            ix = jm & (side - 1);
+            iy = side - (jp & (side - 1)) - 1;
+        } else {
+            // The polar caps
+            auto ntt = std::min(3u, static_cast<unsigned int>(tt));
+            auto tp = tt - ntt;
+            auto tmp = side_d * std::sqrt(3.0 * (1.0 - za));
+            auto jp = std::min(static_cast<unsigned int>(tp * tmp), side - 1);
+            auto jm = std::min(static_cast<unsigned int>((1.0 - tp) * tmp), side - 1);
+            if (z >= 0.0) {
+                face = ntt;
+                ix = side - jm - 1;
+                iy = side - jp - 1;
+            } else {
+                face = ntt + 8u;
+                ix = jp;
+                iy = jm;
+            }
+        }
+        return (face << (2 * level)) + spread_bits(ix) + (spread_bits(iy) << 1);
+    }
+
+    Globe::Vector Globe::cell_vector(
+            const std::uint32_t cell,
+            const unsigned int level
+    ) {
+        const int side = 1 << level;
+        const auto side_d = static_cast<double>(side);
+        const auto face = static_cast<int>(cell >> (2 * level));
+        const auto within = cell & ((1u << (2 * level)) - 1);
+        const auto ix = static_cast<int>(compress_bits(within));
+        const auto iy = static_cast<int>(compress_bits(within >> 1));
+
+        // The ring counts down from the north pole, from 1 to 4 * side - 1
+        auto ring = face_ring[face] * side - ix - iy - 1;
+        int ring_size;
+        int shift = 0;
+        double z;
+        if (ring < side) {
+            ring_size = ring;
+            z = 1.0 - ring_size * ring_size / (3.0 * side_d * side_d);
+        } else if (ring > 3 * side) {
+            ring_size = 4 * side - ring;
+            z = ring_size * ring_size / (3.0 * side_d * side_d) - 1.0;
+        } else {
+            ring_size = side;
+            z = (2 * side - ring) * 2.0 / (3.0 * side_d);
+            shift = (ring - side) & 1;
+        }
+
+        auto jp = (face_phi[face] * ring_size + ix - iy + 1 + shift) / 2;
+        if (jp > 4 * ring_size)
+            jp -= 4 * ring_size;
+        if (jp < 1)
+            jp += 4 * ring_size;
+
+        auto phi = (jp - (shift + 1) * 0.5) * (half_pi / ring_size);
+        auto r = std::sqrt(std::max(0.0, (1.0 - z) * (1.0 + z)));
+        return {r * std::cos(phi), r * std::sin(phi), z};
+    }
+
+    GlobeCoord Globe::normalize(const GlobeCoord& coord) const {
+        if (!is_location_valid(coord))
+            throw error::LocationInvalid(fmt::format("Coordinates {} are invalid", coord.to_string()));
+
+        auto longitude = coord.longitude();
+        if (longitude < -180.0 || longitude >= 180.0) {
+            longitude -= 360.0 * std::floor((longitude + 180.0) / 360.0);
+            if (longitude >= 180.0)
+                longitude = -180.0;
+        }
+        return {coord.latitude(), longitude};
+    }
+
+    void Globe::place(
+            const std::size_t slot,
+            const GlobeCoord& coord
+    ) {
+        auto v = to_vector(coord.latitude(), coord.longitude());
+        _agent_latitudes[slot] = coord.latitude();
+        _agent_longitudes[slot] = coord.longitude();
+        _agent_x[slot] = v.x;
+        _agent_y[slot] = v.y;
+        _agent_z[slot] = v.z;
+        _agent_cells[slot] = vector_cell(v, _level);
+        _index_stale = true;
+    }
+
+}  // namespace kami
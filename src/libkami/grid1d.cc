@@ -114,7 +114,6 @@ namespace kami {
         _wrap_x = wrap_x;
 
         _agent_grid = std::make_unique<std::unordered_multimap<GridCoord1D, AgentID>>();
-        _agent_index = std::make_unique<std::map<AgentID, GridCoord1D>>();
     }
 
     AgentID Grid1D::delete_agent(AgentID agent_id) {
@@ -128,7 +127,7 @@ namespace kami {
         for (auto test_agent_id = _agent_grid->find(coord); test_agent_id != _agent_grid->end(); test_agent_id++)
             if (test_agent_id->second == agent_id) {
                 _agent_grid->erase(test_agent_id);
-                _agent_index->erase(agent_id);
+                _agent_index.erase(agent_id);
                 return agent_id;
             }
 
@@ -169,16 +168,9 @@ namespace kami {
     ) const {
         auto neighborhood = std::make_shared<std::unordered_set<GridCoord1D>>();
 
-        // We assume our starting position is valid
-        if (include_center)
-            neighborhood->insert(coord);
-
-        for (auto& direction : directions) {
-            auto new_location = coord_wrap(coord + direction);
-
-            if (is_location_valid(new_location))
-                neighborhood->insert(new_location);
-        }
+        for_each_neighbor(coord, include_center, [&neighborhood](const GridCoord1D& neighbor) {
+            neighborhood->insert(neighbor);
+        });
 
         return std::move(neighborhood);
     }
@@ -209,10 +201,10 @@ namespace kami {
     }
 
     GridCoord1D Grid1D::get_location_by_agent(const AgentID& agent_id) const {
-        auto coord = _agent_index->find(agent_id);
-        if (coord == _agent_index->end())
+        auto x = _agent_index.find(agent_id);
+        if (x == nullptr)
             throw error::AgentNotFound(fmt::format("Agent {} not found on grid", agent_id.to_string()));
-        return coord->second;
+        return GridCoord1D(*x);
     }
 
     GridCoord1D Grid1D::coord_wrap(const GridCoord1D& coord) const {
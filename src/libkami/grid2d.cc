@@ -23,9 +23,16 @@
  * SOFTWARE.
  */
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
 #include <map>
 #include <memory>
+#include <span>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -35,9 +42,96 @@
 #include <kami/domain.h>
 #include <kami/error.h>
 #include <kami/grid2d.h>
+#include <kami/stencil.h>
 
 namespace kami {
 
+    namespace {
+
+        // The length given to the distance kernel for a dimension that does
+        // not wrap, long enough that the way around is never shorter
+        constexpr int unwrapped = std::numeric_limits<int>::max();
+
+        double combine_distance(
+                const int dx,
+                const int dy,
+                const GridDistanceType distance_type
+        ) {
+            switch (distance_type) {
+                case GridDistanceType::Chebyshev:
+                    return static_cast<double>(std::max(dx, dy));
+                case GridDistanceType::Manhattan:
+                    return static_cast<double>(dx) + static_cast<double>(dy);
+                case GridDistanceType::Euclidean:
+                    return std::sqrt(static_cast<double>(dx) * dx + static_cast<double>(dy) * dy);
+                default:
+                    throw error::OptionInvalid("Unknown distance type given");
+            }
+        }
+
+        // Measure from one point to many, taking the shorter way around in
+        // each dimension.  The metric is fixed at compile time, so the loop
+        // has no branches.
+        template<GridDistanceType T>
+        void distance_kernel(
+                const int origin_x,
+                const int origin_y,
+                const int* x,
+                const int* y,
+                double* distances,
+                const std::size_t count,
+                const int length_x,
+                const int length_y
+        ) {
+            for (std::size_t i = 0; i < count; i++) {
+                auto dx = std::abs(x[i] - origin_x);
+                auto dy = std::abs(y[i] - origin_y);
+                dx = std::min(dx, length_x - dx);
+                dy = std::min(dy, length_y - dy);
+
+                if constexpr (T == GridDistanceType::Chebyshev)
+                    distances[i] = static_cast<double>(std::max(dx, dy));
+                else if constexpr (T == GridDistanceType::Manhattan)
+                    distances[i] = static_cast<double>(dx) + static_cast<double>(dy);
+                else
+                    distances[i] = std::sqrt(static_cast<double>(dx) * dx + static_cast<double>(dy) * dy);
+            }
+        }
+
+        void batch_distance(
+                const GridCoord2D& origin,
+                const std::span<const int> x,
+                const std::span<const int> y,
+                const std::span<double> distances,
+                const GridDistanceType distance_type,
+                const int length_x,
+                const int length_y
+        ) {
+            if (y.size() != x.size() || distances.size() < x.size())
+                throw error::OptionInvalid(
+                        fmt::format("Batch of {} by {} coordinates into {} distances is invalid", x.size(),
+                                    y.size(), distances.size()));
+
+            switch (distance_type) {
+                case GridDistanceType::Chebyshev:
+                    distance_kernel<GridDistanceType::Chebyshev>(origin.x(), origin.y(), x.data(), y.data(),
+                                                                 distances.data(), x.size(), length_x, length_y);
+                    break;
+                case GridDistanceType::Manhattan:
+                    distance_kernel<GridDistanceType::Manhattan>(origin.x(), origin.y(), x.data(), y.data(),
+                                                                 distances.data(), x.size(), length_x, length_y);
+                    break;
+                case GridDistanceType::Euclidean:
+                    distance_kernel<GridDistanceType::Euclidean>(origin.x(), origin.y(), x.data(), y.data(),
+                                                                 distances.data(), x.size(), length_x, length_y);
+                    break;
+                default:
+                    throw error::OptionInvalid("Unknown distance type given");
+            }
+        }
+
+    }  // namespace
+
     int GridCoord2D::x() const {
         return _x_coord;
     }
@@ -59,16 +153,23 @@ namespace kami {
             std::shared_ptr<GridCoord2D>& p,
             GridDistanceType distance_type
     ) const {
-        switch (distance_type) {
-            case GridDistanceType::Chebyshev:
-                return distance_chebyshev(p);
-            case GridDistanceType::Manhattan:
-                return distance_manhattan(p);
-            case GridDistanceType::Euclidean:
-                return distance_euclidean(p);
-            default:
-                throw error::OptionInvalid("Unknown distance type given");
-        }
+        return distance(*p, distance_type);
+    }
+
+    double GridCoord2D::distance(
+            const GridCoord2D& p,
+            GridDistanceType distance_type
+    ) const {
+        return combine_distance(std::abs(_x_coord - p._x_coord), std::abs(_y_coord - p._y_coord), distance_type);
+    }
+
+    void GridCoord2D::distance(
+            std::span<const int> x,
+            std::span<const int> y,
+            std::span<double> distances,
+            GridDistanceType distance_type
+    ) const {
+        batch_distance(*this, x, y, distances, distance_type, unwrapped, unwrapped);
     }
 
     bool operator==(
@@ -99,18 +200,6 @@ namespace kami {
             :_x_coord(x_coord), _y_coord(y_coord) {
     }
 
-    double GridCoord2D::distance_chebyshev(std::shared_ptr<GridCoord2D>& p) const {
-        return static_cast<double>(fmax(abs(_x_coord - p->_x_coord), abs(_x_coord - p->_x_coord)));
-    }
-
-    double GridCoord2D::distance_euclidean(std::shared_ptr<GridCoord2D>& p) const {
-        return sqrt(pow(_x_coord - p->_x_coord, 2) + pow(_x_coord - p->_x_coord, 2));
-    }
-
-    double GridCoord2D::distance_manhattan(std::shared_ptr<GridCoord2D>& p) const {
-        return static_cast<double>(abs(_x_coord - p->_x_coord) + abs(_x_coord - p->_x_coord));
-    }
-
     GridCoord2D operator+(
             const GridCoord2D& lhs,
             const GridCoord2D& rhs
@@ -149,29 +238,12 @@ namespace kami {
         _maximum_y = maximum_y;
         _wrap_x = wrap_x;
         _wrap_y = wrap_y;
-
-        _agent_grid = std::make_unique<std::unordered_multimap<GridCoord2D, AgentID>>();
-        _agent_index = std::make_unique<std::map<AgentID, GridCoord2D>>();
     }
 
     AgentID Grid2D::delete_agent(const AgentID agent_id) {
         return delete_agent(agent_id, get_location_by_agent(agent_id));
     }
 
-    AgentID Grid2D::delete_agent(
-            const AgentID agent_id,
-            const GridCoord2D& coord
-    ) {
-        for (auto test_agent_id = _agent_grid->find(coord); test_agent_id != _agent_grid->end(); test_agent_id++)
-            if (test_agent_id->second == agent_id) {
-                _agent_grid->erase(test_agent_id);
-                _agent_index->erase(agent_id);
-                return agent_id;
-            }
-
-        throw error::AgentNotFound("Agent not found on grid");
-    }
-
     bool Grid2D::is_location_valid(const GridCoord2D& coord) const {
         auto x = coord.x();
         auto y = coord.y();
@@ -180,11 +252,6 @@ namespace kami {
                 y >= 0 && y < static_cast<int>(_maximum_y));
     }
 
-    bool Grid2D::is_location_empty(const GridCoord2D& coord) const {
-        auto grid_location = _agent_grid->equal_range(coord);
-        return grid_location.first == grid_location.second;
-    }
-
     AgentID Grid2D::move_agent(
             const AgentID agent_id,
             const GridCoord2D& coord
@@ -192,6 +259,25 @@ namespace kami {
         return add_agent(delete_agent(agent_id, get_location_by_agent(agent_id)), coord);
     }
 
+    std::unique_ptr<std::vector<AgentID>> Grid2D::move_agents(const std::vector<GridMove2D>& moves) {
+        auto moved = std::make_unique<std::vector<AgentID>>();
+        std::unordered_set<AgentID> seen;
+
+        for (auto& move : moves) {
+            if (!_agent_index.contains(move.agent_id))
+                throw error::AgentNotFound(fmt::format("Agent {} not found on grid", move.agent_id.to_string()));
+            if (!is_location_valid(move.coord))
+                throw error::LocationInvalid(fmt::format("Coordinates {} are invalid", move.coord.to_string()));
+            if (!seen.insert(move.agent_id).second)
+                throw error::OptionInvalid(fmt::format("Agent {} moved twice in batch", move.agent_id.to_string()));
+        }
+
+        moved->reserve(moves.size());
+        for (auto& move : moves)
+            moved->push_back(move_agent(move.agent_id, move.coord));
+        return std::move(moved);
+    }
+
     std::shared_ptr<std::unordered_set<GridCoord2D>>
     Grid2D::get_neighborhood(
             const AgentID agent_id,
@@ -208,50 +294,14 @@ namespace kami {
             const GridNeighborhoodType neighborhood_type
     ) const {
         auto neighborhood = std::make_unique<std::unordered_set<GridCoord2D>>();
-        std::vector<GridCoord2D> directions;
-
-        switch (neighborhood_type) {
-            case GridNeighborhoodType::VonNeumann:
-                directions = directions_vonneumann;
-                break;
-            case GridNeighborhoodType::Moore:
-                directions = directions_moore;
-                break;
-            default:
-                throw error::OptionInvalid(
-                        fmt::format("Invalid neighborhood type {} given", (unsigned int) neighborhood_type));
-        }
-
-        if (include_center and is_location_valid(coord))
-            neighborhood->insert(coord);
-
-        for (auto& direction : directions) {
-            auto new_location = coord_wrap(coord + direction);
 
-            if (is_location_valid(new_location))
-                neighborhood->insert(new_location);
-        }
+        for_each_neighbor(coord, include_center, neighborhood_type, [&neighborhood](const GridCoord2D& neighbor) {
+            neighborhood->insert(neighbor);
+        });
 
         return std::move(neighborhood);
     }
 
-    std::shared_ptr<std::set<AgentID>> Grid2D::get_location_contents(const GridCoord2D& coord) const {
-        auto agent_ids = std::make_shared<std::set<AgentID>>();
-
-        if (!is_location_valid(coord))
-            throw error::LocationUnavailable(fmt::format("Coordinates {} are invalid", coord.to_string()));
-        if (is_location_empty(coord))
-            return agent_ids;
-
-        auto agent_range = _agent_grid->equal_range(coord);
-        if (agent_range.first == agent_range.second)
-            return agent_ids;
-
-        for (auto i = agent_range.first; i != agent_range.second; i++)
-            agent_ids->insert(i->second);
-        return agent_ids;
-    }
-
     bool Grid2D::get_wrap_x() const {
         return _wrap_x;
     }
@@ -260,6 +310,39 @@ namespace kami {
         return _wrap_y;
     }
 
+    double Grid2D::distance(
+            const GridCoord2D& p,
+            const GridCoord2D& q,
+            const GridDistanceType distance_type
+    ) const {
+        auto maximum_x = static_cast<int>(_maximum_x);
+        auto maximum_y = static_cast<int>(_maximum_y);
+        auto dx = std::abs(q.x() - p.x());
+        auto dy = std::abs(q.y() - p.y());
+
+        if (_wrap_x) {
+            dx = stencil::wrap(dx, maximum_x);
+            dx = std::min(dx, maximum_x - dx);
+        }
+        if (_wrap_y) {
+            dy = stencil::wrap(dy, maximum_y);
+            dy = std::min(dy, maximum_y - dy);
+        }
+        return combine_distance(dx, dy, distance_type);
+    }
+
+    void Grid2D::get_distances(
+            const GridCoord2D& origin,
+            std::span<const int> x,
+            std::span<const int> y,
+            std::span<double> distances,
+            const GridDistanceType distance_type
+    ) const {
+        batch_distance(origin, x, y, distances, distance_type,
+                       _wrap_x ? static_cast<int>(_maximum_x) : unwrapped,
+                       _wrap_y ? static_cast<int>(_maximum_y) : unwrapped);
+    }
+
     unsigned int Grid2D::get_maximum_x() const {
         return _maximum_x;
     }
@@ -269,10 +352,10 @@ namespace kami {
     }
 
     GridCoord2D Grid2D::get_location_by_agent(const AgentID& agent_id) const {
-        auto coord = _agent_index->find(agent_id);
-        if (coord == _agent_index->end())
+        auto cell = _agent_index.find(agent_id);
+        if (cell == nullptr)
             throw error::AgentNotFound(fmt::format("Agent {} not found on grid", agent_id.to_string()));
-        return coord->second;
+        return index_coord(*cell);
     }
 
     GridCoord2D Grid2D::coord_wrap(const GridCoord2D& coord) const {
@@ -281,7 +364,7 @@ namespace kami {
 
         if (_wrap_x)
             x = (x + static_cast<int>(_maximum_x)) % static_cast<int>(_maximum_x);
-        if (_wrap_x)
+        if (_wrap_y)
             y = (y + static_cast<int>(_maximum_y)) % static_cast<int>(_maximum_y);
         return {x, y};
     }
@@ -0,0 +1,240 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <unordered_set>
+
+#include <fmt/format.h>
+
+#include <kami/agent.h>
+#include <kami/error.h>
+#include <kami/grid3d.h>
+#include <kami/stencil.h>
+
+namespace kami {
+
+    GridCoord3D::GridCoord3D(
+            int x_coord,
+            int y_coord,
+            int z_coord
+    )
+            :_x_coord(x_coord), _y_coord(y_coord), _z_coord(z_coord) {
+    }
+
+    int GridCoord3D::x() const {
+        return _x_coord;
+    }
+
+    int GridCoord3D::y() const {
+        return _y_coord;
+    }
+
+    int GridCoord3D::z() const {
+        return _z_coord;
+    }
+
+    std::string GridCoord3D::to_string() const {
+        return std::string("(" + std::to_string(_x_coord) + ", " + std::to_string(_y_coord) + ", " +
+                           std::to_string(_z_coord) + ")");
+    }
+
+    double GridCoord3D::distance(std::shared_ptr<Coord>& p) const {
+        auto p3d = std::static_pointer_cast<GridCoord3D>(p);
+        return distance(p3d);
+    }
+
+    double GridCoord3D::distance(
+            std::shared_ptr<GridCoord3D>& p,
+            GridDistanceType distance_type
+    ) const {
+        auto dx = std::abs(_x_coord - p->_x_coord);
+        auto dy = std::abs(_y_coord - p->_y_coord);
+        auto dz = std::abs(_z_coord - p->_z_coord);
+
+        switch (distance_type) {
+            case GridDistanceType::Chebyshev:
+                return static_cast<double>(std::max({dx, dy, dz}));
+            case GridDistanceType::Manhattan:
+                return static_cast<double>(dx + dy + dz);
+            case GridDistanceType::Euclidean:
+                return std::sqrt(static_cast<double>(dx * dx + dy * dy + dz * dz));
+            default:
+                throw error::OptionInvalid("Unknown distance type given");
+        }
+    }
+
+    bool operator==(
+            const GridCoord3D& lhs,
+            const GridCoord3D& rhs
+    ) {
+        return (lhs._x_coord == rhs._x_coord && lhs._y_coord == rhs._y_coord && lhs._z_coord == rhs._z_coord);
+    }
+
+    bool operator!=(
+            const GridCoord3D& lhs,
+            const GridCoord3D& rhs
+    ) {
+        return !(lhs == rhs);
+    }
+
+    std::ostream& operator<<(
+            std::ostream& lhs,
+            const GridCoord3D& rhs
+    ) {
+        return lhs << rhs.to_string();
+    }
+
+    GridCoord3D operator+(
+            const GridCoord3D& lhs,
+            const GridCoord3D& rhs
+    ) {
+        return {lhs._x_coord + rhs._x_coord, lhs._y_coord + rhs._y_coord, lhs._z_coord + rhs._z_coord};
+    }
+
+    GridCoord3D operator-(
+            const GridCoord3D& lhs,
+            const GridCoord3D& rhs
+    ) {
+        return {lhs._x_coord - rhs._x_coord, lhs._y_coord - rhs._y_coord, lhs._z_coord - rhs._z_coord};
+    }
+
+    GridCoord3D operator*(
+            const GridCoord3D& lhs,
+            const double rhs
+    ) {
+        return {static_cast<int>(lhs._x_coord * rhs), static_cast<int>(lhs._y_coord * rhs),
+                static_cast<int>(lhs._z_coord * rhs)};
+    }
+
+    GridCoord3D operator*(
+            const double lhs,
+            const GridCoord3D& rhs
+    ) {
+        return rhs * lhs;
+    }
+
+    Grid3D::Grid3D(
+            unsigned int maximum_x,
+            unsigned int maximum_y,
+            unsigned int maximum_z,
+            bool wrap_x,
+            bool wrap_y,
+            bool wrap_z
+    )
+            :_maximum_x(maximum_x), _maximum_y(maximum_y), _maximum_z(maximum_z),
+             _wrap_x(wrap_x), _wrap_y(wrap_y), _wrap_z(wrap_z),
+             _bricks_x((maximum_x + brick_size - 1) / brick_size),
+             _bricks_y((maximum_y + brick_size - 1) / brick_size),
+             _bricks_z((maximum_z + brick_size - 1) / brick_size) {
+    }
+
+    AgentID Grid3D::delete_agent(const AgentID agent_id) {
+        return delete_agent(agent_id, get_location_by_agent(agent_id));
+    }
+
+    bool Grid3D::is_location_valid(const GridCoord3D& coord) const {
+        return (coord.x() >= 0 && coord.x() < static_cast<int>(_maximum_x) &&
+                coord.y() >= 0 && coord.y() < static_cast<int>(_maximum_y) &&
+                coord.z() >= 0 && coord.z() < static_cast<int>(_maximum_z));
+    }
+
+    GridCoord3D Grid3D::get_location_by_agent(const AgentID& agent_id) const {
+        auto cell = _agent_index.find(agent_id);
+        if (cell == nullptr)
+            throw error::AgentNotFound(fmt::format("Agent {} not found on grid", agent_id.to_string()));
+        return index_coord(*cell);
+    }
+
+    bool Grid3D::get_wrap_x() const {
+        return _wrap_x;
+    }
+
+    bool Grid3D::get_wrap_y() const {
+        return _wrap_y;
+    }
+
+    bool Grid3D::get_wrap_z() const {
+        return _wrap_z;
+    }
+
+    unsigned int Grid3D::get_maximum_x() const {
+        return _maximum_x;
+    }
+
+    unsigned int Grid3D::get_maximum_y() const {
+        return _maximum_y;
+    }
+
+    unsigned int Grid3D::get_maximum_z() const {
+        return _maximum_z;
+    }
+
+    std::shared_ptr<std::unordered_set<GridCoord3D>>
+    Grid3D::get_neighborhood(
+            const AgentID agent_id,
+            const bool include_center,
+            const GridNeighborhoodType neighborhood_type
+    ) const {
+        return std::move(get_neighborhood(get_location_by_agent(agent_id), include_center, neighborhood_type));
+    }
+
+    std::shared_ptr<std::unordered_set<GridCoord3D>>
+    Grid3D::get_neighborhood(
+            const GridCoord3D& coord,
+            const bool include_center,
+            const GridNeighborhoodType neighborhood_type
+    ) const {
+        auto neighborhood = std::make_unique<std::unordered_set<GridCoord3D>>();
+
+        for_each_neighbor(coord, include_center, neighborhood_type, [&neighborhood](const GridCoord3D& neighbor) {
+            neighborhood->insert(neighbor);
+        });
+
+        return std::move(neighborhood);
+    }
+
+    GridCoord3D Grid3D::coord_wrap(const GridCoord3D& coord) const {
+        auto x = coord.x();
+        auto y = coord.y();
+        auto z = coord.z();
+
+        if (_wrap_x)
+            x = stencil::wrap(x, static_cast<int>(_maximum_x));
+        if (_wrap_y)
+            y = stencil::wrap(y, static_cast<int>(_maximum_y));
+        if (_wrap_z)
+            z = stencil::wrap(z, static_cast<int>(_maximum_z));
+        return {x, y, z};
+    }
+
+    std::size_t Grid3D::cell_capacity() const {
+        return _bricks_x * _bricks_y * _bricks_z * brick_size * brick_size * brick_size;
+    }
+
+}  // namespace kami
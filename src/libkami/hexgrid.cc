@@ -0,0 +1,237 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_set>
+
+#include <fmt/format.h>
+
+#include <kami/agent.h>
+#include <kami/error.h>
+#include <kami/hexgrid.h>
+#include <kami/stencil.h>
+
+namespace kami {
+
+    const std::array<HexCoord, 6> HexCoord::directions = {
+            HexCoord(1, 0), HexCoord(1, -1), HexCoord(0, -1),
+            HexCoord(-1, 0), HexCoord(-1, 1), HexCoord(0, 1)
+    };
+
+    HexCoord::HexCoord(
+            int q_coord,
+            int r_coord
+    )
+            :_q_coord(q_coord), _r_coord(r_coord) {
+    }
+
+    int HexCoord::q() const {
+        return _q_coord;
+    }
+
+    int HexCoord::r() const {
+        return _r_coord;
+    }
+
+    int HexCoord::s() const {
+        return -_q_coord - _r_coord;
+    }
+
+    std::string HexCoord::to_string() const {
+        return std::string("(" + std::to_string(_q_coord) + ", " + std::to_string(_r_coord) + ")");
+    }
+
+    double HexCoord::distance(std::shared_ptr<Coord>& p) const {
+        auto phex = std::static_pointer_cast<HexCoord>(p);
+        return static_cast<double>(distance(*phex));
+    }
+
+    int HexCoord::distance(const HexCoord& p) const {
+        auto dq = _q_coord - p._q_coord;
+        auto dr = _r_coord - p._r_coord;
+        return (std::abs(dq) + std::abs(dr) + std::abs(dq + dr)) / 2;
+    }
+
+    bool operator==(
+            const HexCoord& lhs,
+            const HexCoord& rhs
+    ) {
+        return (lhs._q_coord == rhs._q_coord && lhs._r_coord == rhs._r_coord);
+    }
+
+    bool operator!=(
+            const HexCoord& lhs,
+            const HexCoord& rhs
+    ) {
+        return !(lhs == rhs);
+    }
+
+    std::ostream& operator<<(
+            std::ostream& lhs,
+            const HexCoord& rhs
+    ) {
+        return lhs << rhs.to_string();
+    }
+
+    HexCoord operator+(
+            const HexCoord& lhs,
+            const HexCoord& rhs
+    ) {
+        return {lhs._q_coord + rhs._q_coord, lhs._r_coord + rhs._r_coord};
+    }
+
+    HexCoord operator-(
+            const HexCoord& lhs,
+            const HexCoord& rhs
+    ) {
+        return {lhs._q_coord - rhs._q_coord, lhs._r_coord - rhs._r_coord};
+    }
+
+    HexGrid::HexGrid(
+            unsigned int maximum_x,
+            unsigned int maximum_y,
+            bool wrap_x,
+            bool wrap_y
+    )
+            :_maximum_x(maximum_x), _maximum_y(maximum_y), _wrap_x(wrap_x), _wrap_y(wrap_y) {
+        if (wrap_y && maximum_y % 2 != 0)
+            throw error::OptionInvalid("Hex grids wrapping across rows must have an even number of rows");
+        if (cell_capacity() >= no_neighbor)
+            throw error::OptionInvalid(fmt::format("Hex grid of {} by {} is too large", maximum_x, maximum_y));
+
+        _neighbors.resize(cell_capacity() * 6, no_neighbor);
+        for (std::size_t index = 0; index < cell_capacity(); index++) {
+            auto coord = index_coord(index);
+            for (std::size_t i = 0; i < HexCoord::directions.size(); i++) {
+                auto neighbor = coord_wrap(coord + HexCoord::directions[i]);
+                if (is_location_valid(neighbor))
+                    _neighbors[index * 6 + i] = static_cast<std::uint32_t>(coord_index(neighbor));
+            }
+        }
+    }
+
+    AgentID HexGrid::delete_agent(const AgentID agent_id) {
+        return delete_agent(agent_id, get_location_by_agent(agent_id));
+    }
+
+    bool HexGrid::is_location_valid(const HexCoord& coord) const {
+        auto col = column(coord);
+        return (col >= 0 && col < static_cast<int>(_maximum_x) &&
+                coord.r() >= 0 && coord.r() < static_cast<int>(_maximum_y));
+    }
+
+    HexCoord HexGrid::get_location_by_agent(const AgentID& agent_id) const {
+        auto cell = _agent_index.find(agent_id);
+        if (cell == nullptr)
+            throw error::AgentNotFound(fmt::format("Agent {} not found on grid", agent_id.to_string()));
+        return index_coord(*cell);
+    }
+
+    std::span<const AgentID> HexGrid::get_location_view(const HexCoord& coord) const {
+        return get_cell_view(coord_index(coord));
+    }
+
+    bool HexGrid::get_wrap_x() const {
+        return _wrap_x;
+    }
+
+    bool HexGrid::get_wrap_y() const {
+        return _wrap_y;
+    }
+
+    unsigned int HexGrid::get_maximum_x() const {
+        return _maximum_x;
+    }
+
+    unsigned int HexGrid::get_maximum_y() const {
+        return _maximum_y;
+    }
+
+    int HexGrid::distance(
+            const HexCoord& p,
+            const HexCoord& q
+    ) const {
+        const auto maximum_x = static_cast<int>(_maximum_x);
+        const auto maximum_y = static_cast<int>(_maximum_y);
+        auto shortest = std::numeric_limits<int>::max();
+
+        // Try each copy of the second point in the neighboring tiles of the
+        // torus.  Shifting down by an even number of rows leaves the columns
+        // alone but moves `q` back by half as many.
+        for (auto tile_y = _wrap_y ? -1 : 0; tile_y <= (_wrap_y ? 1 : 0); tile_y++)
+            for (auto tile_x = _wrap_x ? -1 : 0; tile_x <= (_wrap_x ? 1 : 0); tile_x++) {
+                HexCoord copy(q.q() + tile_x * maximum_x - tile_y * maximum_y / 2, q.r() + tile_y * maximum_y);
+                shortest = std::min(shortest, p.distance(copy));
+            }
+        return shortest;
+    }
+
+    std::shared_ptr<std::unordered_set<HexCoord>>
+    HexGrid::get_neighborhood(
+            const AgentID agent_id,
+            const bool include_center
+    ) const {
+        return std::move(get_neighborhood(get_location_by_agent(agent_id), include_center));
+    }
+
+    std::shared_ptr<std::unordered_set<HexCoord>>
+    HexGrid::get_neighborhood(
+            const HexCoord& coord,
+            const bool include_center
+    ) const {
+        auto neighborhood = std::make_unique<std::unordered_set<HexCoord>>();
+
+        if (!is_location_valid(coord))
+            throw error::LocationInvalid(fmt::format("Coordinates {} are invalid", coord.to_string()));
+        for_each_neighbor(coord, include_center, [&neighborhood](const HexCoord& neighbor) {
+            neighborhood->insert(neighbor);
+        });
+
+        return std::move(neighborhood);
+    }
+
+    HexCoord HexGrid::coord_wrap(const HexCoord& coord) const {
+        auto col = column(coord);
+        auto row = coord.r();
+
+        if (_wrap_x)
+            col = stencil::wrap(col, static_cast<int>(_maximum_x));
+        if (_wrap_y)
+            row = stencil::wrap(row, static_cast<int>(_maximum_y));
+        return {col - (row - (row & 1)) / 2, row};
+    }
+
+    std::size_t HexGrid::cell_capacity() const {
+        return static_cast<std::size_t>(_maximum_x) * _maximum_y;
+    }
+
+}  // namespace kami
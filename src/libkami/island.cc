@@ -0,0 +1,173 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cstddef>
+#include <memory>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <kami/agent.h>
+#include <kami/error.h>
+#include <kami/executor.h>
+#include <kami/island.h>
+#include <kami/population.h>
+
+namespace kami {
+
+    std::unique_ptr<std::vector<Migrant>> Island::emigrate(std::size_t) {
+        return std::make_unique<std::vector<Migrant>>();
+    }
+
+    AgentID Island::depart(const std::shared_ptr<Agent>& agent) {
+        return agent->get_agent_id();
+    }
+
+    AgentID Island::immigrate(const std::shared_ptr<Agent>& agent) {
+        return agent->get_agent_id();
+    }
+
+    Archipelago::Archipelago(std::shared_ptr<Executor> executor)
+            :_executor(std::move(executor)) {
+        if (_executor == nullptr)
+            _executor = std::make_shared<Executor>();
+    }
+
+    std::size_t Archipelago::add_island(std::shared_ptr<Island> island) {
+        if (island == nullptr)
+            throw error::ResourceNotAvailable("No island given");
+
+        island->set_executor(_executor);
+        _islands.push_back(std::move(island));
+        return _islands.size() - 1;
+    }
+
+    std::shared_ptr<Island> Archipelago::get_island(std::size_t index) const {
+        if (index >= _islands.size())
+            throw error::ResourceNotAvailable(fmt::format("Island {} not found in archipelago", index));
+        return _islands[index];
+    }
+
+    std::size_t Archipelago::get_island_count() const {
+        return _islands.size();
+    }
+
+    std::shared_ptr<Executor> Archipelago::get_executor() const {
+        return _executor;
+    }
+
+    unsigned int Archipelago::get_migration_interval() const {
+        return _migration_interval;
+    }
+
+    unsigned int Archipelago::set_migration_interval(unsigned int interval) {
+        _migration_interval = interval;
+        return _migration_interval;
+    }
+
+    std::shared_ptr<Archipelago> Archipelago::step() {
+        _step_count++;
+
+        _executor->parallel_for(0, _islands.size(), 1, [this](std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; i++)
+                _islands[i]->step();
+        });
+
+        if (_migration_interval > 0 && _step_count % _migration_interval == 0)
+            migrate();
+
+        return shared_from_this();
+    }
+
+    std::size_t Archipelago::migrate() {
+        auto island_count = _islands.size();
+        std::vector<std::unique_ptr<std::vector<Migrant>>> departures(island_count);
+        std::vector<std::vector<std::pair<std::size_t, std::shared_ptr<Agent>>>> outbound(island_count);
+        std::vector<std::vector<std::shared_ptr<Agent>>> inbound(island_count);
+
+        // Every migrant is checked before any leaves, so that a rejected
+        // migration leaves every domain and population as it was
+        _executor->parallel_for(0, island_count, 1, [&](std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; i++) {
+                departures[i] = _islands[i]->emigrate(island_count);
+                auto population = _islands[i]->get_population();
+                std::unordered_set<AgentID> seen;
+
+                for (auto& migrant : *departures[i]) {
+                    if (migrant.destination >= island_count)
+                        throw error::OptionInvalid(
+                                fmt::format("Agent {} cannot migrate to island {}", migrant.agent_id.to_string(),
+                                            migrant.destination));
+                    if (!seen.insert(migrant.agent_id).second)
+                        throw error::OptionInvalid(
+                                fmt::format("Agent {} cannot migrate twice", migrant.agent_id.to_string()));
+                    static_cast<void>(population->get_agent_by_id(migrant.agent_id));
+                }
+            }
+        });
+
+        // Each island fills only its own outbound buffer
+        _executor->parallel_for(0, island_count, 1, [&](std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; i++) {
+                auto population = _islands[i]->get_population();
+
+                outbound[i].reserve(departures[i]->size());
+                for (auto& migrant : *departures[i]) {
+                    _islands[i]->depart(population->get_agent_by_id(migrant.agent_id));
+                    outbound[i].emplace_back(migrant.destination, population->delete_agent(migrant.agent_id));
+                }
+            }
+        });
+
+        // Exchange in island order, so arrivals are in the same order
+        // however many threads are used
+        std::size_t migrant_count = 0;
+        for (auto& buffer : outbound)
+            for (auto& [destination, agent] : buffer) {
+                inbound[destination].push_back(std::move(agent));
+                migrant_count++;
+            }
+
+        _executor->parallel_for(0, island_count, 1, [&](std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; i++) {
+                auto population = _islands[i]->get_population();
+
+                for (auto& agent : inbound[i]) {
+                    population->add_agent(agent);
+                    _islands[i]->immigrate(agent);
+                }
+            }
+        });
+
+        return migrant_count;
+    }
+
+    unsigned int Archipelago::get_step_id() const {
+        return _step_count;
+    }
+
+}  // namespace kami
@@ -0,0 +1,292 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <kami/agent.h>
+#include <kami/continuous2d.h>
+#include <kami/error.h>
+#include <kami/executor.h>
+#include <kami/kdtree2d.h>
+
+namespace kami {
+
+    void KDTree2D::build(
+            const ContinuousSpace2D& space,
+            Executor* executor
+    ) {
+        _width = space._width;
+        _height = space._height;
+        _wrap_x = space._wrap_x;
+        _wrap_y = space._wrap_y;
+        build_tree(space._agent_ids, space._agent_x, space._agent_y, executor);
+    }
+
+    void KDTree2D::build(
+            std::span<const AgentID> agent_ids,
+            std::span<const double> x,
+            std::span<const double> y,
+            Executor* executor
+    ) {
+        if (x.size() != agent_ids.size() || y.size() != agent_ids.size())
+            throw error::OptionInvalid("Agents and coordinates must be the same size");
+
+        _width = _height = 0.0;
+        _wrap_x = _wrap_y = false;
+        build_tree(agent_ids, x, y, executor);
+    }
+
+    std::size_t KDTree2D::size() const {
+        return _agent_ids.size();
+    }
+
+    std::span<const AgentID> KDTree2D::get_agent_ids() const {
+        return _agent_ids;
+    }
+
+    std::unique_ptr<std::vector<AgentID>> KDTree2D::get_agents_in_radius(
+            const ContinuousCoord2D& coord,
+            const double radius
+    ) const {
+        auto agent_ids = std::make_unique<std::vector<AgentID>>();
+
+        for_each_agent_in_radius(coord, radius, [&agent_ids](const AgentID agent_id) {
+            agent_ids->push_back(agent_id);
+        });
+        return std::move(agent_ids);
+    }
+
+    std::unique_ptr<std::vector<AgentID>> KDTree2D::get_nearest(
+            const ContinuousCoord2D& coord,
+            const std::size_t k
+    ) const {
+        auto agent_ids = std::make_unique<std::vector<AgentID>>(k, AgentID::null());
+        std::vector<double> distances(k);
+
+        agent_ids->resize(nearest(coord, k, *agent_ids, distances));
+        return std::move(agent_ids);
+    }
+
+    std::size_t KDTree2D::nearest(
+            const ContinuousCoord2D& coord,
+            const std::size_t k,
+            std::span<AgentID> agent_ids,
+            std::span<double> distances,
+            const AgentID exclude
+    ) const {
+        if (agent_ids.size() < k || distances.size() < k)
+            throw error::OptionInvalid(fmt::format("Buffers too small for {} results", k));
+        if (k == 0 || _agent_ids.empty())
+            return 0;
+
+        const auto x = coord.x();
+        const auto y = coord.y();
+        std::array<Frame, max_depth + 1> stack;
+        std::size_t top = 0;
+        std::size_t found = 0;
+
+        // The results are kept sorted by squared distance, so the worst
+        // is last; k is small enough that insertion beats a heap
+        auto worst = [&]() {
+            return found < k ? std::numeric_limits<double>::infinity() : distances[k - 1];
+        };
+
+        stack[top++] = {0, 0, _agent_ids.size()};
+        while (top > 0) {
+            auto [node, begin, end] = stack[--top];
+            if (box_distance_squared(_boxes[node], x, y) >= worst())
+                continue;
+
+            if (2 * node + 1 >= _boxes.size()) {
+                for (auto i = begin; i < end; i++) {
+                    auto distance = distance_squared(i, x, y);
+                    if (distance >= worst() || _agent_ids[i] == exclude)
+                        continue;
+
+                    auto slot = std::min(found, k - 1);
+                    while (slot > 0 && distances[slot - 1] > distance) {
+                        distances[slot] = distances[slot - 1];
+                        agent_ids[slot] = agent_ids[slot - 1];
+                        slot--;
+                    }
+                    distances[slot] = distance;
+                    agent_ids[slot] = _agent_ids[i];
+                    found = std::min(found + 1, k);
+                }
+                continue;
+            }
+
+            // Visit the nearer child first, to tighten the bound sooner
+            auto middle = begin + (end - begin) / 2;
+            Frame left = {2 * node + 1, begin, middle};
+            Frame right = {2 * node + 2, middle, end};
+            if (box_distance_squared(_boxes[left.node], x, y) <= box_distance_squared(_boxes[right.node], x, y))
+                std::swap(left, right);
+            stack[top++] = left;
+            stack[top++] = right;
+        }
+
+        for (std::size_t i = 0; i < found; i++)
+            distances[i] = std::sqrt(distances[i]);
+        return found;
+    }
+
+    void KDTree2D::nearest_all(
+            const std::size_t k,
+            std::span<AgentID> agent_ids,
+            std::span<double> distances,
+            Executor* executor
+    ) const {
+        const auto count = _agent_ids.size();
+        if (agent_ids.size() < count * k || distances.size() < count * k)
+            throw error::OptionInvalid(fmt::format("Buffers too small for {} results", count * k));
+        if (k == 0)
+            return;
+
+        auto body = [&](std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; i++) {
+                auto row_ids = agent_ids.subspan(i * k, k);
+                auto row_distances = distances.subspan(i * k, k);
+                auto found = nearest(ContinuousCoord2D(_x[i], _y[i]), k, row_ids, row_distances, _agent_ids[i]);
+
+                std::fill(row_ids.begin() + static_cast<std::ptrdiff_t>(found), row_ids.end(), AgentID::null());
+                std::fill(row_distances.begin() + static_cast<std::ptrdiff_t>(found), row_distances.end(),
+                          std::numeric_limits<double>::infinity());
+            }
+        };
+
+        if (executor == nullptr)
+            body(0, count);
+        else
+            executor->parallel_for(0, count, 0, body);
+    }
+
+    void KDTree2D::build_tree(
+            std::span<const AgentID> agent_ids,
+            std::span<const double> x,
+            std::span<const double> y,
+            Executor* executor
+    ) {
+        const auto count = agent_ids.size();
+        if (count > std::numeric_limits<std::uint32_t>::max())
+            throw error::OptionInvalid(fmt::format("Too many agents ({}) for a tree", count));
+
+        // Every leaf is at the same depth, holding at most leaf_size agents
+        _depth = 0;
+        while (_depth < max_depth && ((count - 1) >> _depth) + 1 > leaf_size && count > 0)
+            _depth++;
+        _boxes.assign((std::size_t(2) << _depth) - 1, Box{});
+
+        std::vector<std::uint32_t> order(count);
+        std::iota(order.begin(), order.end(), 0);
+
+        // Build the upper levels here, then the subtrees below them in
+        // parallel, since subtrees share no nodes or agents
+        std::vector<Frame> subtrees;
+        unsigned int split_depth = 0;
+        if (executor != nullptr && count > 4096)
+            while (split_depth < _depth && (1u << split_depth) < 4 * executor->get_concurrency())
+                split_depth++;
+
+        build_node(order, x, y, 0, 0, count, 0, split_depth, &subtrees);
+
+        auto build_subtrees = [&](std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; i++)
+                build_node(order, x, y, subtrees[i].node, subtrees[i].begin, subtrees[i].end, split_depth,
+                           _depth, nullptr);
+        };
+        if (executor == nullptr || subtrees.size() == 1)
+            build_subtrees(0, subtrees.size());
+        else
+            executor->parallel_for(0, subtrees.size(), 1, build_subtrees);
+
+        _agent_ids.resize(count, AgentID::null());
+        _x.resize(count);
+        _y.resize(count);
+        auto gather = [&](std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; i++) {
+                _agent_ids[i] = agent_ids[order[i]];
+                _x[i] = x[order[i]];
+                _y[i] = y[order[i]];
+            }
+        };
+        if (executor == nullptr)
+            gather(0, count);
+        else
+            executor->parallel_for(0, count, 0, gather);
+    }
+
+    void KDTree2D::build_node(
+            std::vector<std::uint32_t>& order,
+            std::span<const double> x,
+            std::span<const double> y,
+            const std::size_t node,
+            const std::size_t begin,
+            const std::size_t end,
+            const unsigned int depth,
+            const unsigned int stop_depth,
+            std::vector<Frame>* subtrees
+    ) {
+        if (subtrees != nullptr && depth == stop_depth) {
+            subtrees->push_back({node, begin, end});
+            return;
+        }
+
+        auto& box = _boxes[node];
+        box = {std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(),
+               -std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()};
+        for (auto i = begin; i < end; i++) {
+            box.min_x = std::min(box.min_x, x[order[i]]);
+            box.max_x = std::max(box.max_x, x[order[i]]);
+            box.min_y = std::min(box.min_y, y[order[i]]);
+            box.max_y = std::max(box.max_y, y[order[i]]);
+        }
+        if (depth == _depth)
+            return;
+
+        auto middle = begin + (end - begin) / 2;
+        auto& axis = box.max_x - box.min_x >= box.max_y - box.min_y ? x : y;
+        std::nth_element(order.begin() + static_cast<std::ptrdiff_t>(begin),
+                         order.begin() + static_cast<std::ptrdiff_t>(middle),
+                         order.begin() + static_cast<std::ptrdiff_t>(end),
+                         [&axis](std::uint32_t lhs, std::uint32_t rhs) {
+                             return axis[lhs] < axis[rhs];
+                         });
+        build_node(order, x, y, 2 * node + 1, begin, middle, depth + 1, stop_depth, subtrees);
+        build_node(order, x, y, 2 * node + 2, middle, end, depth + 1, stop_depth, subtrees);
+    }
+
+}  // namespace kami
@@ -27,6 +27,7 @@
 #include <utility>
 
 #include <kami/error.h>
+#include <kami/executor.h>
 #include <kami/model.h>
 #include <kami/scheduler.h>
 
@@ -65,6 +66,17 @@ namespace kami {
         return _sched;
     }
 
+    std::shared_ptr<Executor> Model::get_executor() {
+        if (_executor == nullptr)
+            _executor = std::make_shared<Executor>();
+        return _executor;
+    }
+
+    std::shared_ptr<Executor> Model::set_executor(std::shared_ptr<Executor> executor) {
+        _executor = std::move(executor);
+        return _executor;
+    }
+
     std::shared_ptr<Model> Model::step() {
         _sched->step(shared_from_this());
         return shared_from_this();
@@ -47,7 +47,7 @@ namespace kami {
         if (!is_location_valid(coord))
             throw error::LocationInvalid(fmt::format("Coordinates {} are invalid", coord.to_string()));
 
-        _agent_index->insert(std::pair<AgentID, GridCoord1D>(agent_id, coord));
+        _agent_index.insert(agent_id, coord.x());
         _agent_grid->insert(std::pair<GridCoord1D, AgentID>(coord, agent_id));
         return agent_id;
     }
@@ -23,6 +23,13 @@
  * SOFTWARE.
  */
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <span>
+#include <utility>
+
 #include <fmt/format.h>
 
 #include <kami/agent.h>
@@ -39,7 +46,8 @@ namespace kami {
             bool wrap_x,
             bool wrap_y
     )
-            :Grid2D(maximum_x, maximum_y, wrap_x, wrap_y) {
+            :Grid2D(maximum_x, maximum_y, wrap_x, wrap_y),
+             _agent_cells(static_cast<std::size_t>(maximum_x) * maximum_y) {
     }
 
     AgentID MultiGrid2D::add_agent(
@@ -49,9 +57,82 @@ namespace kami {
         if (!is_location_valid(coord))
             throw error::LocationInvalid(fmt::format("Coordinates {} are invalid", coord.to_string()));
 
-        _agent_index->insert(std::pair<AgentID, GridCoord2D>(agent_id, coord));
-        _agent_grid->insert(std::pair<GridCoord2D, AgentID>(coord, agent_id));
+        auto cell_index = coord_index(coord);
+        auto& cell = _agent_cells[cell_index];
+
+        if (!_agent_index.insert(agent_id, cell_index))
+            throw error::OptionInvalid(fmt::format("Agent {} already on grid", agent_id.to_string()));
+        _agent_slots.insert(agent_id, static_cast<std::uint32_t>(cell.size()));
+        cell.push_back(agent_id);
+        return agent_id;
+    }
+
+    AgentID MultiGrid2D::delete_agent(
+            const AgentID agent_id,
+            const GridCoord2D& coord
+    ) {
+        auto agent_cell = _agent_index.find(agent_id);
+        if (agent_cell == nullptr || !is_location_valid(coord) || *agent_cell != coord_index(coord))
+            throw error::AgentNotFound("Agent not found on grid");
+
+        remove_from_cell(agent_id, *agent_cell);
+        _agent_slots.erase(agent_id);
+        _agent_index.erase(agent_id);
         return agent_id;
     }
 
+    AgentID MultiGrid2D::move_agent(
+            const AgentID agent_id,
+            const GridCoord2D& coord
+    ) {
+        auto agent_cell = _agent_index.find(agent_id);
+        if (agent_cell == nullptr)
+            throw error::AgentNotFound(fmt::format("Agent {} not found on grid", agent_id.to_string()));
+        if (!is_location_valid(coord))
+            throw error::LocationInvalid(fmt::format("Coordinates {} are invalid", coord.to_string()));
+
+        auto cell_index = coord_index(coord);
+        auto& cell = _agent_cells[cell_index];
+
+        remove_from_cell(agent_id, *agent_cell);
+        *_agent_slots.find(agent_id) = static_cast<std::uint32_t>(cell.size());
+        cell.push_back(agent_id);
+        *agent_cell = cell_index;
+        return agent_id;
+    }
+
+    bool MultiGrid2D::is_location_empty(const GridCoord2D& coord) const {
+        if (!is_location_valid(coord))
+            return true;
+        return _agent_cells[coord_index(coord)].empty();
+    }
+
+    std::shared_ptr<std::set<AgentID>> MultiGrid2D::get_location_contents(const GridCoord2D& coord) const {
+        if (!is_location_valid(coord))
+            throw error::LocationUnavailable(fmt::format("Coordinates {} are invalid", coord.to_string()));
+
+        auto& cell = _agent_cells[coord_index(coord)];
+        return std::make_shared<std::set<AgentID>>(cell.begin(), cell.end());
+    }
+
+    std::span<const AgentID> MultiGrid2D::get_location_view(const GridCoord2D& coord) const {
+        auto& cell = _agent_cells[coord_index(coord)];
+        return {cell.data(), cell.size()};
+    }
+
+    void MultiGrid2D::remove_from_cell(
+            const AgentID agent_id,
+            const std::size_t cell_index
+    ) {
+        auto& cell = _agent_cells[cell_index];
+        auto slot = *_agent_slots.find(agent_id);
+
+        // Swap the last agent of the cell into the vacated slot
+        if (slot + 1 != cell.size()) {
+            cell[slot] = cell.back();
+            *_agent_slots.find(cell[slot]) = slot;
+        }
+        cell.pop_back();
+    }
+
 }  // namespace kami
@@ -0,0 +1,138 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <span>
+
+#include <fmt/format.h>
+
+#include <kami/agent.h>
+#include <kami/error.h>
+#include <kami/grid3d.h>
+#include <kami/multigrid3d.h>
+
+namespace kami {
+
+    MultiGrid3D::MultiGrid3D(
+            unsigned int maximum_x,
+            unsigned int maximum_y,
+            unsigned int maximum_z,
+            bool wrap_x,
+            bool wrap_y,
+            bool wrap_z
+    )
+            :Grid3D(maximum_x, maximum_y, maximum_z, wrap_x, wrap_y, wrap_z),
+             _agent_cells(cell_capacity()) {
+    }
+
+    AgentID MultiGrid3D::add_agent(
+            const AgentID agent_id,
+            const GridCoord3D& coord
+    ) {
+        if (!is_location_valid(coord))
+            throw error::LocationInvalid(fmt::format("Coordinates {} are invalid", coord.to_string()));
+
+        auto cell_index = coord_index(coord);
+        auto& cell = _agent_cells[cell_index];
+
+        if (!_agent_index.insert(agent_id, cell_index))
+            throw error::OptionInvalid(fmt::format("Agent {} already on grid", agent_id.to_string()));
+        _agent_slots.insert(agent_id, static_cast<std::uint32_t>(cell.size()));
+        cell.push_back(agent_id);
+        return agent_id;
+    }
+
+    AgentID MultiGrid3D::delete_agent(
+            const AgentID agent_id,
+            const GridCoord3D& coord
+    ) {
+        auto agent_cell = _agent_index.find(agent_id);
+        if (agent_cell == nullptr || !is_location_valid(coord) || *agent_cell != coord_index(coord))
+            throw error::AgentNotFound("Agent not found on grid");
+
+        remove_from_cell(agent_id, *agent_cell);
+        _agent_slots.erase(agent_id);
+        _agent_index.erase(agent_id);
+        return agent_id;
+    }
+
+    AgentID MultiGrid3D::move_agent(
+            const AgentID agent_id,
+            const GridCoord3D& coord
+    ) {
+        auto agent_cell = _agent_index.find(agent_id);
+        if (agent_cell == nullptr)
+            throw error::AgentNotFound(fmt::format("Agent {} not found on grid", agent_id.to_string()));
+        if (!is_location_valid(coord))
+            throw error::LocationInvalid(fmt::format("Coordinates {} are invalid", coord.to_string()));
+
+        auto cell_index = coord_index(coord);
+        auto& cell = _agent_cells[cell_index];
+
+        remove_from_cell(agent_id, *agent_cell);
+        *_agent_slots.find(agent_id) = static_cast<std::uint32_t>(cell.size());
+        cell.push_back(agent_id);
+        *agent_cell = cell_index;
+        return agent_id;
+    }
+
+    bool MultiGrid3D::is_location_empty(const GridCoord3D& coord) const {
+        if (!is_location_valid(coord))
+            return true;
+        return _agent_cells[coord_index(coord)].empty();
+    }
+
+    std::shared_ptr<std::set<AgentID>> MultiGrid3D::get_location_contents(const GridCoord3D& coord) const {
+        if (!is_location_valid(coord))
+            throw error::LocationUnavailable(fmt::format("Coordinates {} are invalid", coord.to_string()));
+
+        auto& cell = _agent_cells[coord_index(coord)];
+        return std::make_shared<std::set<AgentID>>(cell.begin(), cell.end());
+    }
+
+    std::span<const AgentID> MultiGrid3D::get_location_view(const GridCoord3D& coord) const {
+        auto& cell = _agent_cells[coord_index(coord)];
+        return {cell.data(), cell.size()};
+    }
+
+    void MultiGrid3D::remove_from_cell(
+            const AgentID agent_id,
+            const std::size_t cell_index
+    ) {
+        auto& cell = _agent_cells[cell_index];
+        auto slot = *_agent_slots.find(agent_id);
+
+        // Swap the last agent of the cell into the vacated slot
+        if (slot + 1 != cell.size()) {
+            cell[slot] = cell.back();
+            *_agent_slots.find(cell[slot]) = slot;
+        }
+        cell.pop_back();
+    }
+
+}  // namespace kami
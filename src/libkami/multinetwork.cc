@@ -0,0 +1,129 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <span>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <kami/agent.h>
+#include <kami/error.h>
+#include <kami/multinetwork.h>
+#include <kami/network.h>
+
+namespace kami {
+
+    MultiNetwork::MultiNetwork(std::shared_ptr<const NetworkGraph> graph)
+            :NetworkDomain(std::move(graph)),
+             _agent_nodes(_graph->get_node_count()) {
+    }
+
+    AgentID MultiNetwork::add_agent(
+            const AgentID agent_id,
+            const NodeCoord& coord
+    ) {
+        if (!is_location_valid(coord))
+            throw error::LocationInvalid(fmt::format("Coordinates {} are invalid", coord.to_string()));
+
+        auto& agents = _agent_nodes[coord.node()];
+
+        if (!_agent_index.insert(agent_id, coord.node()))
+            throw error::OptionInvalid(fmt::format("Agent {} is already on the network", agent_id.to_string()));
+        _agent_slots.insert(agent_id, static_cast<std::uint32_t>(agents.size()));
+        agents.push_back(agent_id);
+        return agent_id;
+    }
+
+    AgentID MultiNetwork::delete_agent(
+            const AgentID agent_id,
+            const NodeCoord& coord
+    ) {
+        auto agent_node = _agent_index.find(agent_id);
+        if (agent_node == nullptr || *agent_node != coord.node())
+            throw error::AgentNotFound("Agent not found on network");
+
+        remove_from_node(agent_id, *agent_node);
+        _agent_slots.erase(agent_id);
+        _agent_index.erase(agent_id);
+        return agent_id;
+    }
+
+    AgentID MultiNetwork::move_agent(
+            const AgentID agent_id,
+            const NodeCoord& coord
+    ) {
+        auto agent_node = _agent_index.find(agent_id);
+        if (agent_node == nullptr)
+            throw error::AgentNotFound(fmt::format("Agent {} not found on network", agent_id.to_string()));
+        if (!is_location_valid(coord))
+            throw error::LocationInvalid(fmt::format("Coordinates {} are invalid", coord.to_string()));
+
+        auto& agents = _agent_nodes[coord.node()];
+
+        remove_from_node(agent_id, *agent_node);
+        *_agent_slots.find(agent_id) = static_cast<std::uint32_t>(agents.size());
+        agents.push_back(agent_id);
+        *agent_node = coord.node();
+        return agent_id;
+    }
+
+    bool MultiNetwork::is_location_empty(const NodeCoord& coord) const {
+        if (!is_location_valid(coord))
+            return true;
+        return _agent_nodes[coord.node()].empty();
+    }
+
+    std::shared_ptr<std::set<AgentID>> MultiNetwork::get_location_contents(const NodeCoord& coord) const {
+        if (!is_location_valid(coord))
+            throw error::LocationUnavailable(fmt::format("Coordinates {} are invalid", coord.to_string()));
+
+        auto& agents = _agent_nodes[coord.node()];
+        return std::make_shared<std::set<AgentID>>(agents.begin(), agents.end());
+    }
+
+    std::span<const AgentID> MultiNetwork::get_location_view(const NodeCoord& coord) const {
+        auto& agents = _agent_nodes[coord.node()];
+        return {agents.data(), agents.size()};
+    }
+
+    void MultiNetwork::remove_from_node(
+            const AgentID agent_id,
+            const unsigned int node
+    ) {
+        auto& agents = _agent_nodes[node];
+        auto slot = *_agent_slots.find(agent_id);
+
+        // Swap the last agent of the node into the vacated slot
+        if (slot + 1 != agents.size()) {
+            agents[slot] = agents.back();
+            *_agent_slots.find(agents[slot]) = slot;
+        }
+        agents.pop_back();
+    }
+
+}  // namespace kami
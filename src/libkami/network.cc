@@ -0,0 +1,132 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <kami/agent.h>
+#include <kami/error.h>
+#include <kami/network.h>
+
+namespace kami {
+
+    NodeCoord::NodeCoord(unsigned int node)
+            :_node(node) {
+    }
+
+    unsigned int NodeCoord::node() const {
+        return _node;
+    }
+
+    std::string NodeCoord::to_string() const {
+        return std::string("(" + std::to_string(_node) + ")");
+    }
+
+    bool operator==(
+            const NodeCoord& lhs,
+            const NodeCoord& rhs
+    ) {
+        return lhs._node == rhs._node;
+    }
+
+    bool operator!=(
+            const NodeCoord& lhs,
+            const NodeCoord& rhs
+    ) {
+        return !(lhs == rhs);
+    }
+
+    std::ostream& operator<<(
+            std::ostream& lhs,
+            const NodeCoord& rhs
+    ) {
+        return lhs << rhs.to_string();
+    }
+
+    std::size_t NetworkGraph::get_degree(const unsigned int node) const {
+        return get_neighbors(node).size();
+    }
+
+    NetworkDomain::NetworkDomain(std::shared_ptr<const NetworkGraph> graph)
+            :_graph(std::move(graph)) {
+        if (!_graph)
+            throw error::OptionInvalid("Network domains require a graph");
+    }
+
+    AgentID NetworkDomain::delete_agent(const AgentID agent_id) {
+        return delete_agent(agent_id, get_location_by_agent(agent_id));
+    }
+
+    bool NetworkDomain::is_location_valid(const NodeCoord& coord) const {
+        return coord.node() < _graph->get_node_count();
+    }
+
+    NodeCoord NetworkDomain::get_location_by_agent(const AgentID& agent_id) const {
+        auto node = _agent_index.find(agent_id);
+        if (node == nullptr)
+            throw error::AgentNotFound(fmt::format("Agent {} not found on network", agent_id.to_string()));
+        return NodeCoord(*node);
+    }
+
+    std::shared_ptr<const NetworkGraph> NetworkDomain::get_graph() const {
+        return _graph;
+    }
+
+    void NetworkDomain::set_graph(std::shared_ptr<const NetworkGraph> graph) {
+        if (!graph || graph->get_node_count() != _graph->get_node_count())
+            throw error::OptionInvalid("A replacement graph must have the same nodes");
+        _graph = std::move(graph);
+    }
+
+    std::shared_ptr<std::unordered_set<NodeCoord>>
+    NetworkDomain::get_neighborhood(
+            const AgentID agent_id,
+            const bool include_center
+    ) const {
+        return std::move(get_neighborhood(get_location_by_agent(agent_id), include_center));
+    }
+
+    std::shared_ptr<std::unordered_set<NodeCoord>>
+    NetworkDomain::get_neighborhood(
+            const NodeCoord& coord,
+            const bool include_center
+    ) const {
+        auto neighborhood = std::make_unique<std::unordered_set<NodeCoord>>();
+
+        if (!is_location_valid(coord))
+            throw error::LocationInvalid(fmt::format("Coordinates {} are invalid", coord.to_string()));
+        for_each_neighbor(coord, include_center, [&neighborhood](const NodeCoord& neighbor) {
+            neighborhood->insert(neighbor);
+        });
+
+        return std::move(neighborhood);
+    }
+
+}  // namespace kami
@@ -0,0 +1,111 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <kami/agent.h>
+#include <kami/error.h>
+#include <kami/executor.h>
+#include <kami/ordered.h>
+#include <kami/population.h>
+#include <kami/radix.h>
+#include <kami/reporter.h>
+#include <kami/sequential.h>
+
+namespace kami {
+
+    OrderedScheduler::OrderedScheduler(
+            Key key,
+            bool descending
+    )
+            :_key(std::move(key)), _descending(descending) {
+        if (_key == nullptr)
+            throw error::OptionInvalid("No key function given");
+    }
+
+    std::unique_ptr<std::vector<AgentID>>
+    OrderedScheduler::step(
+            std::shared_ptr<Model> model,
+            std::unique_ptr<std::vector<AgentID>> agent_list
+    ) {
+        auto sorted_agent_list = this->sort(model, std::move(agent_list));
+        return std::move(this->SequentialScheduler::step(model, std::move(sorted_agent_list)));
+    }
+
+    std::unique_ptr<std::vector<AgentID>>
+    OrderedScheduler::step(
+            std::shared_ptr<ReporterModel> model,
+            std::unique_ptr<std::vector<AgentID>> agent_list
+    ) {
+        auto sorted_agent_list = this->sort(model, std::move(agent_list));
+        return std::move(this->SequentialScheduler::step(model, std::move(sorted_agent_list)));
+    }
+
+    std::unique_ptr<std::vector<AgentID>>
+    OrderedScheduler::sort(
+            const std::shared_ptr<Model>& model,
+            std::unique_ptr<std::vector<AgentID>> agent_list
+    ) const {
+        auto population = model->get_population();
+        auto executor = model->get_executor();
+        auto count = agent_list->size();
+
+        // Ties keep their incoming order, so that order must be by AgentID
+        if (!std::is_sorted(agent_list->begin(), agent_list->end()))
+            std::sort(agent_list->begin(), agent_list->end());
+
+        std::vector<std::uint64_t> keys(count);
+        std::vector<std::size_t> index(count);
+        executor->parallel_for(0, count, 0, [&](std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; i++) {
+                auto key = radix_key(_key(population->get_agent_by_id((*agent_list)[i])));
+                keys[i] = _descending ? ~key : key;
+                index[i] = i;
+            }
+        });
+
+        radix_sort(keys, index, executor.get());
+
+        auto sorted_agent_list = std::make_unique<std::vector<AgentID>>();
+        sorted_agent_list->reserve(count);
+        for (auto i : index)
+            sorted_agent_list->push_back((*agent_list)[i]);
+        return std::move(sorted_agent_list);
+    }
+
+    bool OrderedScheduler::get_descending() const {
+        return _descending;
+    }
+
+    bool OrderedScheduler::set_descending(bool descending) {
+        _descending = descending;
+        return _descending;
+    }
+
+}  // namespace kami
@@ -35,7 +35,8 @@ namespace kami {
 
     AgentID Population::add_agent(const std::shared_ptr<Agent>& agent) noexcept {
         auto agent_id = agent->get_agent_id();
-        _agent_map.insert(std::pair<AgentID, std::shared_ptr<Agent>>(agent_id, agent));
+        if (_agent_map.insert(std::pair<AgentID, std::shared_ptr<Agent>>(agent_id, agent)).second)
+            _revision++;
         return agent->get_agent_id();
     }
 
@@ -47,6 +48,7 @@ namespace kami {
 
         auto agent = agent_it->second;
         _agent_map.erase(agent_it);
+        _revision++;
         return std::move(agent);
     }
 
@@ -70,4 +72,8 @@ namespace kami {
         return std::move(agent_ids);
     }
 
+    unsigned long long Population::get_revision() const {
+        return _revision;
+    }
+
 }  // namespace kami
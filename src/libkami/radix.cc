@@ -0,0 +1,142 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <kami/error.h>
+#include <kami/executor.h>
+#include <kami/radix.h>
+
+namespace kami {
+
+    namespace {
+        constexpr unsigned int radix_bits = 8;
+        constexpr std::size_t radix_size = 1u << radix_bits;
+        constexpr unsigned int radix_passes = 64 / radix_bits;
+
+        // Below this size, splitting the work costs more than it saves
+        constexpr std::size_t radix_grain = 1u << 14;
+
+        inline std::size_t digit(
+                std::uint64_t key,
+                unsigned int pass
+        ) {
+            return static_cast<std::size_t>((key >> (pass * radix_bits)) & (radix_size - 1));
+        }
+    }
+
+    std::uint64_t radix_key(double value) {
+        // NaNs of either sign share the largest key
+        if (std::isnan(value))
+            return ~0ull;
+        if (value == 0.0)
+            value = 0.0;
+
+        auto bits = std::bit_cast<std::uint64_t>(value);
+        return (bits & 0x8000000000000000ull) ? ~bits : (bits | 0x8000000000000000ull);
+    }
+
+    std::uint64_t radix_key(std::int64_t value) {
+        return static_cast<std::uint64_t>(value) ^ 0x8000000000000000ull;
+    }
+
+    void radix_sort(
+            std::vector<std::uint64_t>& keys,
+            std::vector<std::size_t>& values,
+            Executor* executor
+    ) {
+        if (keys.size() != values.size())
+            throw error::OptionInvalid("Keys and values must be the same size");
+
+        auto count = keys.size();
+        if (count < 2)
+            return;
+
+        std::size_t chunk_count = 1;
+        if (executor != nullptr)
+            chunk_count = std::clamp<std::size_t>(count / radix_grain, 1, executor->get_concurrency());
+        auto chunk_size = (count + chunk_count - 1) / chunk_count;
+
+        auto for_each_chunk = [&](auto&& body) {
+            if (chunk_count == 1)
+                body(0, 0, count);
+            else
+                executor->parallel_for(0, chunk_count, 1, [&](std::size_t begin, std::size_t end) {
+                    for (auto chunk = begin; chunk < end; chunk++)
+                        body(chunk, chunk * chunk_size, std::min(count, (chunk + 1) * chunk_size));
+                });
+        };
+
+        std::vector<std::uint64_t> key_buffer(count);
+        std::vector<std::size_t> value_buffer(count);
+        std::vector<std::array<std::size_t, radix_size>> histograms(chunk_count);
+
+        for (unsigned int pass = 0; pass < radix_passes; pass++) {
+            for_each_chunk([&](std::size_t chunk, std::size_t begin, std::size_t end) {
+                auto& histogram = histograms[chunk];
+                histogram.fill(0);
+                for (auto i = begin; i < end; i++)
+                    histogram[digit(keys[i], pass)]++;
+            });
+
+            // Skip the pass if every key has the same digit
+            auto first_digit = digit(keys[0], pass);
+            std::size_t first_digit_count = 0;
+            for (auto& histogram : histograms)
+                first_digit_count += histogram[first_digit];
+            if (first_digit_count == count)
+                continue;
+
+            // Turn the counts into starting offsets, digit-major and
+            // chunk-minor, which keeps the scatter stable
+            std::size_t offset = 0;
+            for (std::size_t d = 0; d < radix_size; d++)
+                for (auto& histogram : histograms) {
+                    auto digit_count = histogram[d];
+                    histogram[d] = offset;
+                    offset += digit_count;
+                }
+
+            for_each_chunk([&](std::size_t chunk, std::size_t begin, std::size_t end) {
+                auto& histogram = histograms[chunk];
+                for (auto i = begin; i < end; i++) {
+                    auto position = histogram[digit(keys[i], pass)]++;
+                    key_buffer[position] = keys[i];
+                    value_buffer[position] = values[i];
+                }
+            });
+
+            keys.swap(key_buffer);
+            values.swap(value_buffer);
+        }
+    }
+
+}  // namespace kami
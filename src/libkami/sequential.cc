@@ -24,9 +24,13 @@
  */
 
 #include <memory>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <kami/agent.h>
+#include <kami/population.h>
 #include <kami/reporter.h>
 #include <kami/sequential.h>
 
@@ -34,11 +38,15 @@ namespace kami {
 
     std::unique_ptr<std::vector<AgentID>> SequentialScheduler::step(std::shared_ptr<Model> model) {
         auto population = model->get_population();
+        if (_group_by_type)
+            return std::move(this->step(model, get_grouped_agent_list(population)));
         return std::move(this->step(model, population->get_agent_list()));
     }
 
     std::unique_ptr<std::vector<AgentID>> SequentialScheduler::step(std::shared_ptr<ReporterModel> model) {
         auto population = model->get_population();
+        if (_group_by_type)
+            return std::move(this->step(model, get_grouped_agent_list(population)));
         return std::move(this->step(model, population->get_agent_list()));
     }
 
@@ -51,7 +59,21 @@ namespace kami {
         auto population = model->get_population();
 
         Scheduler::_step_counter++;
-        for (auto& agent_id : *agent_list) {
+        std::size_t i = 0;
+        if (auto agents = get_grouped_agents(population, *agent_list)) {
+            // An agent may add or delete others during its step, so the
+            // cached pointers are only used while the revision holds
+            const auto revision = population->get_revision();
+            for (; i < agents->size() && population->get_revision() == revision; i++) {
+                auto agent = (*agents)[i];
+
+                agent->step(model);
+                return_agent_list->push_back((*agent_list)[i]);
+            }
+        }
+
+        for (; i < agent_list->size(); i++) {
+            auto& agent_id = (*agent_list)[i];
             auto agent = population->get_agent_by_id(agent_id);
 
             agent->step(model);
@@ -70,7 +92,21 @@ namespace kami {
         auto population = model->get_population();
 
         Scheduler::_step_counter++;
-        for (auto& agent_id : *agent_list) {
+        std::size_t i = 0;
+        if (auto agents = get_grouped_agents(population, *agent_list)) {
+            // An agent may add or delete others during its step, so the
+            // cached pointers are only used while the revision holds
+            const auto revision = population->get_revision();
+            for (; i < agents->size() && population->get_revision() == revision; i++) {
+                auto agent = (*agents)[i];
+
+                agent->step(model);
+                return_agent_list->push_back((*agent_list)[i]);
+            }
+        }
+
+        for (; i < agent_list->size(); i++) {
+            auto& agent_id = (*agent_list)[i];
             auto agent = population->get_agent_by_id(agent_id);
 
             agent->step(model);
@@ -80,4 +116,58 @@ namespace kami {
         return std::move(return_agent_list);
     }
 
+    bool SequentialScheduler::get_group_by_type() const {
+        return _group_by_type;
+    }
+
+    bool SequentialScheduler::set_group_by_type(bool group_by_type) {
+        _group_by_type = group_by_type;
+        return _group_by_type;
+    }
+
+    std::unique_ptr<std::vector<AgentID>>
+    SequentialScheduler::get_grouped_agent_list(const std::shared_ptr<Population>& population) {
+        if (_grouped_population.lock() != population || _grouped_revision != population->get_revision()) {
+            auto agent_list = population->get_agent_list();
+            std::unordered_map<std::type_index, std::size_t> group_index;
+            std::vector<std::vector<std::pair<AgentID, std::shared_ptr<Agent>>>> groups;
+
+            for (auto& agent_id : *agent_list) {
+                auto agent = population->get_agent_by_id(agent_id);
+                auto [group, inserted] = group_index.try_emplace(std::type_index(typeid(*agent)), groups.size());
+                if (inserted)
+                    groups.emplace_back();
+                groups[group->second].emplace_back(agent_id, std::move(agent));
+            }
+
+            _grouped_agent_list.clear();
+            _grouped_agent_list.reserve(agent_list->size());
+            _grouped_agents.clear();
+            _grouped_agents.reserve(agent_list->size());
+            for (auto& group : groups)
+                for (auto& [agent_id, agent] : group) {
+                    _grouped_agent_list.push_back(agent_id);
+                    _grouped_agents.push_back(std::move(agent));
+                }
+
+            _grouped_population = population;
+            _grouped_revision = population->get_revision();
+        }
+
+        return std::make_unique<std::vector<AgentID>>(_grouped_agent_list);
+    }
+
+    const std::vector<std::shared_ptr<Agent>>*
+    SequentialScheduler::get_grouped_agents(
+            const std::shared_ptr<Population>& population,
+            const std::vector<AgentID>& agent_list
+    ) const {
+        // The cached pointers are only good while the population they
+        // came from is unchanged, and only for the list they were made for
+        if (!_group_by_type || _grouped_population.lock() != population ||
+            _grouped_revision != population->get_revision() || agent_list != _grouped_agent_list)
+            return nullptr;
+        return &_grouped_agents;
+    }
+
 }  // namespace kami
@@ -47,7 +47,7 @@ namespace kami {
         if (!is_location_empty(coord))
             throw error::LocationUnavailable(fmt::format("Coordinates {} already occupied", coord.to_string()));
 
-        _agent_index->insert(std::pair<AgentID, GridCoord1D>(agent_id, coord));
+        _agent_index.insert(agent_id, coord.x());
         _agent_grid->insert(std::pair<GridCoord1D, AgentID>(coord, agent_id));
         return agent_id;
     }
@@ -23,12 +23,24 @@
  * SOFTWARE.
  */
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <set>
+#include <span>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
 
 #include <kami/agent.h>
 #include <kami/error.h>
+#include <kami/executor.h>
+#include <kami/radix.h>
 #include <kami/sologrid2d.h>
 
 namespace kami {
@@ -39,7 +51,18 @@ namespace kami {
             bool wrap_x,
             bool wrap_y
     )
-            :Grid2D(maximum_x, maximum_y, wrap_x, wrap_y) {
+            :Grid2D(maximum_x, maximum_y, wrap_x, wrap_y),
+             _agent_cells(static_cast<std::size_t>(maximum_x) * maximum_y, AgentID::null()) {
+        auto cell_count = _agent_cells.size();
+        if (cell_count > std::numeric_limits<std::uint32_t>::max())
+            throw error::OptionInvalid(fmt::format("Grid of {} by {} is too large", maximum_x, maximum_y));
+
+        _empty_cells.resize(cell_count);
+        _empty_positions.resize(cell_count);
+        for (std::size_t cell = 0; cell < cell_count; cell++) {
+            _empty_cells[cell] = static_cast<std::uint32_t>(cell);
+            _empty_positions[cell] = static_cast<std::uint32_t>(cell);
+        }
     }
 
     AgentID SoloGrid2D::add_agent(
@@ -50,10 +73,213 @@ namespace kami {
             throw error::LocationInvalid(fmt::format("Coordinates {} are invalid", coord.to_string()));
         if (!is_location_empty(coord))
             throw error::LocationUnavailable(fmt::format("Coordinates {} already occupied", coord.to_string()));
+        if (!_agent_index.insert(agent_id, coord_index(coord)))
+            throw error::OptionInvalid(fmt::format("Agent {} already on grid", agent_id.to_string()));
+
+        _agent_cells[coord_index(coord)] = agent_id;
+        claim_cell(coord_index(coord));
+        return agent_id;
+    }
+
+    AgentID SoloGrid2D::delete_agent(
+            const AgentID agent_id,
+            const GridCoord2D& coord
+    ) {
+        if (!is_location_valid(coord) || _agent_cells[coord_index(coord)] != agent_id)
+            throw error::AgentNotFound("Agent not found on grid");
 
-        _agent_index->insert(std::pair<AgentID, GridCoord2D>(agent_id, coord));
-        _agent_grid->insert(std::pair<GridCoord2D, AgentID>(coord, agent_id));
+        _agent_cells[coord_index(coord)] = AgentID::null();
+        _agent_index.erase(agent_id);
+        release_cell(coord_index(coord));
         return agent_id;
     }
 
+    AgentID SoloGrid2D::move_agent(
+            const AgentID agent_id,
+            const GridCoord2D& coord
+    ) {
+        auto agent_cell = _agent_index.find(agent_id);
+        if (agent_cell == nullptr)
+            throw error::AgentNotFound(fmt::format("Agent {} not found on grid", agent_id.to_string()));
+        if (!is_location_valid(coord))
+            throw error::LocationInvalid(fmt::format("Coordinates {} are invalid", coord.to_string()));
+
+        auto cell = coord_index(coord);
+        if (*agent_cell == cell)
+            return agent_id;
+        if (_agent_cells[cell] != AgentID::null())
+            throw error::LocationUnavailable(fmt::format("Coordinates {} already occupied", coord.to_string()));
+
+        _agent_cells[*agent_cell] = AgentID::null();
+        _agent_cells[cell] = agent_id;
+        claim_cell(cell);
+        release_cell(*agent_cell);
+        *agent_cell = cell;
+        return agent_id;
+    }
+
+    std::unique_ptr<std::vector<AgentID>> SoloGrid2D::move_agents(const std::vector<GridMove2D>& moves) {
+        return move_agents(moves, GridConflictPolicy::First);
+    }
+
+    std::unique_ptr<std::vector<AgentID>> SoloGrid2D::move_agents(
+            const std::vector<GridMove2D>& moves,
+            const GridConflictPolicy policy,
+            const std::uint64_t seed,
+            Executor* executor
+    ) {
+        auto move_count = moves.size();
+        auto for_range = [executor](std::size_t count, const std::function<void(std::size_t, std::size_t)>& body) {
+            if (executor == nullptr)
+                body(0, count);
+            else
+                executor->parallel_for(0, count, 0, body);
+        };
+
+        // The index is not resized during the batch, so these stay valid
+        std::vector<std::size_t*> locations;
+        std::unordered_set<AgentID> seen;
+
+        locations.reserve(move_count);
+        for (auto& move : moves) {
+            auto agent_cell = _agent_index.find(move.agent_id);
+            if (agent_cell == nullptr)
+                throw error::AgentNotFound(fmt::format("Agent {} not found on grid", move.agent_id.to_string()));
+            if (!is_location_valid(move.coord))
+                throw error::LocationInvalid(fmt::format("Coordinates {} are invalid", move.coord.to_string()));
+            if (!seen.insert(move.agent_id).second)
+                throw error::OptionInvalid(fmt::format("Agent {} moved twice in batch", move.agent_id.to_string()));
+            locations.push_back(agent_cell);
+        }
+
+        // Only cells empty at the start of the batch may be claimed
+        std::vector<char> granted(move_count, 0);
+        std::vector<std::size_t> claims;
+        for (std::size_t i = 0; i < move_count; i++) {
+            if (*locations[i] == coord_index(moves[i].coord))
+                granted[i] = 1;
+            else if (_agent_cells[coord_index(moves[i].coord)] == AgentID::null())
+                claims.push_back(i);
+        }
+
+        // Order the claims by policy, then group them by cell.  Both sorts
+        // are stable, so ties keep their order in the batch.
+        std::vector<std::uint64_t> keys(claims.size());
+        if (policy == GridConflictPolicy::Random || policy == GridConflictPolicy::Priority) {
+            for_range(claims.size(), [&](std::size_t begin, std::size_t end) {
+                for (auto j = begin; j < end; j++) {
+                    auto& move = moves[claims[j]];
+                    keys[j] = policy == GridConflictPolicy::Random
+                              ? mix_key(seed, std::hash<AgentID>()(move.agent_id))
+                              : ~radix_key(move.priority);
+                }
+            });
+            radix_sort(keys, claims, executor);
+        }
+
+        for_range(claims.size(), [&](std::size_t begin, std::size_t end) {
+            for (auto j = begin; j < end; j++)
+                keys[j] = coord_index(moves[claims[j]].coord);
+        });
+        radix_sort(keys, claims, executor);
+
+        for (std::size_t j = 0; j < claims.size(); j++)
+            if (j == 0 || keys[j] != keys[j - 1])
+                granted[claims[j]] = 1;
+
+        // Winners leave distinct occupied cells for distinct empty ones, so
+        // no two of them touch the same cell or index entry
+        std::vector<std::size_t> vacated(move_count);
+        for_range(move_count, [&](std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; i++) {
+                auto cell = coord_index(moves[i].coord);
+                vacated[i] = *locations[i];
+                if (!granted[i] || *locations[i] == cell)
+                    continue;
+                _agent_cells[*locations[i]] = AgentID::null();
+                _agent_cells[cell] = moves[i].agent_id;
+                *locations[i] = cell;
+            }
+        });
+
+        // The set of empty cells is shared, so it is updated afterward, in
+        // batch order
+        auto moved = std::make_unique<std::vector<AgentID>>();
+        for (std::size_t i = 0; i < move_count; i++) {
+            if (!granted[i])
+                continue;
+            if (vacated[i] != *locations[i]) {
+                claim_cell(*locations[i]);
+                release_cell(vacated[i]);
+            }
+            moved->push_back(moves[i].agent_id);
+        }
+        return std::move(moved);
+    }
+
+    std::uint64_t SoloGrid2D::mix_key(
+            std::uint64_t seed,
+            std::uint64_t value
+    ) {
+        // SplitMix64 finalizer
+        auto key = seed ^ (value + 0x9e3779b97f4a7c15ULL);
+        key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+        return key ^ (key >> 31);
+    }
+
+    bool SoloGrid2D::is_location_empty(const GridCoord2D& coord) const {
+        if (!is_location_valid(coord))
+            return true;
+        return _agent_cells[coord_index(coord)] == AgentID::null();
+    }
+
+    std::shared_ptr<std::set<AgentID>> SoloGrid2D::get_location_contents(const GridCoord2D& coord) const {
+        auto agent_ids = std::make_shared<std::set<AgentID>>();
+
+        if (!is_location_valid(coord))
+            throw error::LocationUnavailable(fmt::format("Coordinates {} are invalid", coord.to_string()));
+        if (!is_location_empty(coord))
+            agent_ids->insert(_agent_cells[coord_index(coord)]);
+        return agent_ids;
+    }
+
+    std::span<const AgentID> SoloGrid2D::get_location_view(const GridCoord2D& coord) const {
+        auto& agent_id = _agent_cells[coord_index(coord)];
+        return {&agent_id, agent_id == AgentID::null() ? 0u : 1u};
+    }
+
+    std::size_t SoloGrid2D::get_empty_cell_count() const {
+        return _empty_cells.size();
+    }
+
+    void SoloGrid2D::claim_cell(const std::size_t cell) {
+        // Swap the last empty cell into the claimed one's position
+        auto position = _empty_positions[cell];
+        auto last = _empty_cells.back();
+        _empty_cells[position] = last;
+        _empty_positions[last] = position;
+        _empty_cells.pop_back();
+    }
+
+    void SoloGrid2D::release_cell(const std::size_t cell) {
+        _empty_positions[cell] = static_cast<std::uint32_t>(_empty_cells.size());
+        _empty_cells.push_back(static_cast<std::uint32_t>(cell));
+    }
+
+    void SoloGrid2D::check_new_agents(std::span<const AgentID> agent_ids) const {
+        std::unordered_set<AgentID> seen;
+
+        for (auto agent_id : agent_ids) {
+            if (_agent_index.contains(agent_id))
+                throw error::OptionInvalid(fmt::format("Agent {} already on grid", agent_id.to_string()));
+            if (!seen.insert(agent_id).second)
+                throw error::OptionInvalid(fmt::format("Agent {} added twice in batch", agent_id.to_string()));
+        }
+        if (agent_ids.size() > _empty_cells.size())
+            throw error::LocationUnavailable(
+                    fmt::format("{} agents cannot be placed on {} empty cells", agent_ids.size(),
+                                _empty_cells.size()));
+    }
+
 }  // namespace kami
@@ -0,0 +1,122 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <memory>
+#include <set>
+#include <span>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <kami/agent.h>
+#include <kami/error.h>
+#include <kami/grid3d.h>
+#include <kami/sologrid3d.h>
+
+namespace kami {
+
+    SoloGrid3D::SoloGrid3D(
+            unsigned int maximum_x,
+            unsigned int maximum_y,
+            unsigned int maximum_z,
+            bool wrap_x,
+            bool wrap_y,
+            bool wrap_z
+    )
+            :Grid3D(maximum_x, maximum_y, maximum_z, wrap_x, wrap_y, wrap_z),
+             _agent_cells(cell_capacity(), AgentID::null()) {
+    }
+
+    AgentID SoloGrid3D::add_agent(
+            const AgentID agent_id,
+            const GridCoord3D& coord
+    ) {
+        if (!is_location_valid(coord))
+            throw error::LocationInvalid(fmt::format("Coordinates {} are invalid", coord.to_string()));
+        if (!is_location_empty(coord))
+            throw error::LocationUnavailable(fmt::format("Coordinates {} already occupied", coord.to_string()));
+        if (!_agent_index.insert(agent_id, coord_index(coord)))
+            throw error::OptionInvalid(fmt::format("Agent {} already on grid", agent_id.to_string()));
+
+        _agent_cells[coord_index(coord)] = agent_id;
+        return agent_id;
+    }
+
+    AgentID SoloGrid3D::delete_agent(
+            const AgentID agent_id,
+            const GridCoord3D& coord
+    ) {
+        if (!is_location_valid(coord) || _agent_cells[coord_index(coord)] != agent_id)
+            throw error::AgentNotFound("Agent not found on grid");
+
+        _agent_cells[coord_index(coord)] = AgentID::null();
+        _agent_index.erase(agent_id);
+        return agent_id;
+    }
+
+    AgentID SoloGrid3D::move_agent(
+            const AgentID agent_id,
+            const GridCoord3D& coord
+    ) {
+        auto agent_cell = _agent_index.find(agent_id);
+        if (agent_cell == nullptr)
+            throw error::AgentNotFound(fmt::format("Agent {} not found on grid", agent_id.to_string()));
+        if (!is_location_valid(coord))
+            throw error::LocationInvalid(fmt::format("Coordinates {} are invalid", coord.to_string()));
+
+        auto cell = coord_index(coord);
+        if (*agent_cell == cell)
+            return agent_id;
+        if (_agent_cells[cell] != AgentID::null())
+            throw error::LocationUnavailable(fmt::format("Coordinates {} already occupied", coord.to_string()));
+
+        _agent_cells[*agent_cell] = AgentID::null();
+        _agent_cells[cell] = agent_id;
+        *agent_cell = cell;
+        return agent_id;
+    }
+
+    bool SoloGrid3D::is_location_empty(const GridCoord3D& coord) const {
+        if (!is_location_valid(coord))
+            return true;
+        return _agent_cells[coord_index(coord)] == AgentID::null();
+    }
+
+    std::shared_ptr<std::set<AgentID>> SoloGrid3D::get_location_contents(const GridCoord3D& coord) const {
+        auto agent_ids = std::make_shared<std::set<AgentID>>();
+
+        if (!is_location_valid(coord))
+            throw error::LocationUnavailable(fmt::format("Coordinates {} are invalid", coord.to_string()));
+        if (!is_location_empty(coord))
+            agent_ids->insert(_agent_cells[coord_index(coord)]);
+        return agent_ids;
+    }
+
+    std::span<const AgentID> SoloGrid3D::get_location_view(const GridCoord3D& coord) const {
+        auto& agent_id = _agent_cells[coord_index(coord)];
+        return {&agent_id, agent_id == AgentID::null() ? 0u : 1u};
+    }
+
+}  // namespace kami
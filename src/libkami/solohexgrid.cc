@@ -0,0 +1,121 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cstddef>
+#include <memory>
+#include <set>
+#include <span>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <kami/agent.h>
+#include <kami/error.h>
+#include <kami/hexgrid.h>
+#include <kami/solohexgrid.h>
+
+namespace kami {
+
+    SoloHexGrid::SoloHexGrid(
+            unsigned int maximum_x,
+            unsigned int maximum_y,
+            bool wrap_x,
+            bool wrap_y
+    )
+            :HexGrid(maximum_x, maximum_y, wrap_x, wrap_y),
+             _agent_cells(cell_capacity(), AgentID::null()) {
+    }
+
+    AgentID SoloHexGrid::add_agent(
+            const AgentID agent_id,
+            const HexCoord& coord
+    ) {
+        if (!is_location_valid(coord))
+            throw error::LocationInvalid(fmt::format("Coordinates {} are invalid", coord.to_string()));
+        if (!is_location_empty(coord))
+            throw error::LocationUnavailable(fmt::format("Coordinates {} already occupied", coord.to_string()));
+        if (!_agent_index.insert(agent_id, coord_index(coord)))
+            throw error::OptionInvalid(fmt::format("Agent {} already on grid", agent_id.to_string()));
+
+        _agent_cells[coord_index(coord)] = agent_id;
+        return agent_id;
+    }
+
+    AgentID SoloHexGrid::delete_agent(
+            const AgentID agent_id,
+            const HexCoord& coord
+    ) {
+        if (!is_location_valid(coord) || _agent_cells[coord_index(coord)] != agent_id)
+            throw error::AgentNotFound("Agent not found on grid");
+
+        _agent_cells[coord_index(coord)] = AgentID::null();
+        _agent_index.erase(agent_id);
+        return agent_id;
+    }
+
+    AgentID SoloHexGrid::move_agent(
+            const AgentID agent_id,
+            const HexCoord& coord
+    ) {
+        auto agent_cell = _agent_index.find(agent_id);
+        if (agent_cell == nullptr)
+            throw error::AgentNotFound(fmt::format("Agent {} not found on grid", agent_id.to_string()));
+        if (!is_location_valid(coord))
+            throw error::LocationInvalid(fmt::format("Coordinates {} are invalid", coord.to_string()));
+
+        auto cell = coord_index(coord);
+        if (*agent_cell == cell)
+            return agent_id;
+        if (_agent_cells[cell] != AgentID::null())
+            throw error::LocationUnavailable(fmt::format("Coordinates {} already occupied", coord.to_string()));
+
+        _agent_cells[*agent_cell] = AgentID::null();
+        _agent_cells[cell] = agent_id;
+        *agent_cell = cell;
+        return agent_id;
+    }
+
+    bool SoloHexGrid::is_location_empty(const HexCoord& coord) const {
+        if (!is_location_valid(coord))
+            return true;
+        return _agent_cells[coord_index(coord)] == AgentID::null();
+    }
+
+    std::shared_ptr<std::set<AgentID>> SoloHexGrid::get_location_contents(const HexCoord& coord) const {
+        auto agent_ids = std::make_shared<std::set<AgentID>>();
+
+        if (!is_location_valid(coord))
+            throw error::LocationUnavailable(fmt::format("Coordinates {} are invalid", coord.to_string()));
+        if (!is_location_empty(coord))
+            agent_ids->insert(_agent_cells[coord_index(coord)]);
+        return agent_ids;
+    }
+
+    std::span<const AgentID> SoloHexGrid::get_cell_view(const std::size_t index) const {
+        auto& agent_id = _agent_cells[index];
+        return {&agent_id, agent_id == AgentID::null() ? 0u : 1u};
+    }
+
+}  // namespace kami
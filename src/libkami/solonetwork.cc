@@ -0,0 +1,116 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <memory>
+#include <set>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <kami/agent.h>
+#include <kami/error.h>
+#include <kami/network.h>
+#include <kami/solonetwork.h>
+
+namespace kami {
+
+    SoloNetwork::SoloNetwork(std::shared_ptr<const NetworkGraph> graph)
+            :NetworkDomain(std::move(graph)),
+             _agent_nodes(_graph->get_node_count(), AgentID::null()) {
+    }
+
+    AgentID SoloNetwork::add_agent(
+            const AgentID agent_id,
+            const NodeCoord& coord
+    ) {
+        if (!is_location_valid(coord))
+            throw error::LocationInvalid(fmt::format("Coordinates {} are invalid", coord.to_string()));
+        if (!is_location_empty(coord))
+            throw error::LocationUnavailable(fmt::format("Coordinates {} already occupied", coord.to_string()));
+        if (!_agent_index.insert(agent_id, coord.node()))
+            throw error::OptionInvalid(fmt::format("Agent {} is already on the network", agent_id.to_string()));
+
+        _agent_nodes[coord.node()] = agent_id;
+        return agent_id;
+    }
+
+    AgentID SoloNetwork::delete_agent(
+            const AgentID agent_id,
+            const NodeCoord& coord
+    ) {
+        if (!is_location_valid(coord) || _agent_nodes[coord.node()] != agent_id)
+            throw error::AgentNotFound("Agent not found on network");
+
+        _agent_nodes[coord.node()] = AgentID::null();
+        _agent_index.erase(agent_id);
+        return agent_id;
+    }
+
+    AgentID SoloNetwork::move_agent(
+            const AgentID agent_id,
+            const NodeCoord& coord
+    ) {
+        auto agent_node = _agent_index.find(agent_id);
+        if (agent_node == nullptr)
+            throw error::AgentNotFound(fmt::format("Agent {} not found on network", agent_id.to_string()));
+        if (!is_location_valid(coord))
+            throw error::LocationInvalid(fmt::format("Coordinates {} are invalid", coord.to_string()));
+
+        auto node = coord.node();
+        if (*agent_node == node)
+            return agent_id;
+        if (_agent_nodes[node] != AgentID::null())
+            throw error::LocationUnavailable(fmt::format("Coordinates {} already occupied", coord.to_string()));
+
+        _agent_nodes[*agent_node] = AgentID::null();
+        _agent_nodes[node] = agent_id;
+        *agent_node = node;
+        return agent_id;
+    }
+
+    bool SoloNetwork::is_location_empty(const NodeCoord& coord) const {
+        if (!is_location_valid(coord))
+            return true;
+        return _agent_nodes[coord.node()] == AgentID::null();
+    }
+
+    std::shared_ptr<std::set<AgentID>> SoloNetwork::get_location_contents(const NodeCoord& coord) const {
+        auto agent_ids = std::make_shared<std::set<AgentID>>();
+
+        if (!is_location_valid(coord))
+            throw error::LocationUnavailable(fmt::format("Coordinates {} are invalid", coord.to_string()));
+        if (!is_location_empty(coord))
+            agent_ids->insert(_agent_nodes[coord.node()]);
+        return agent_ids;
+    }
+
+    std::span<const AgentID> SoloNetwork::get_location_view(const NodeCoord& coord) const {
+        auto& agent_id = _agent_nodes[coord.node()];
+        return {&agent_id, agent_id == AgentID::null() ? 0u : 1u};
+    }
+
+}  // namespace kami
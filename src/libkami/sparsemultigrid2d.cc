@@ -0,0 +1,250 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <kami/agent.h>
+#include <kami/domain.h>
+#include <kami/error.h>
+#include <kami/grid2d.h>
+#include <kami/sparsemultigrid2d.h>
+
+namespace kami {
+
+    namespace {
+
+        constexpr std::size_t initial_directory_shift = 60;  // 16 slots
+
+    }  // namespace
+
+    SparseMultiGrid2D::SparseMultiGrid2D(
+            unsigned int maximum_x,
+            unsigned int maximum_y,
+            bool wrap_x,
+            bool wrap_y
+    )
+            :Grid2D(maximum_x, maximum_y, wrap_x, wrap_y),
+             _tiles_x((static_cast<std::uint64_t>(maximum_x) + tile_mask) >> tile_shift),
+             _directory(std::size_t(1) << (64 - initial_directory_shift), nullptr),
+             _directory_shift(initial_directory_shift) {
+    }
+
+    AgentID SparseMultiGrid2D::add_agent(
+            const AgentID agent_id,
+            const GridCoord2D& coord
+    ) {
+        if (!is_location_valid(coord))
+            throw error::LocationInvalid(fmt::format("Coordinates {} are invalid", coord.to_string()));
+
+        if (!_agent_index.insert(agent_id, coord_index(coord)))
+            throw error::OptionInvalid(fmt::format("Agent {} already on grid", agent_id.to_string()));
+        _agent_slots.insert(agent_id, 0);
+        add_to_tile(agent_id, coord);
+        return agent_id;
+    }
+
+    AgentID SparseMultiGrid2D::delete_agent(
+            const AgentID agent_id,
+            const GridCoord2D& coord
+    ) {
+        auto agent_cell = _agent_index.find(agent_id);
+        if (agent_cell == nullptr || !is_location_valid(coord) || *agent_cell != coord_index(coord))
+            throw error::AgentNotFound("Agent not found on grid");
+
+        remove_from_tile(agent_id, coord);
+        _agent_slots.erase(agent_id);
+        _agent_index.erase(agent_id);
+        return agent_id;
+    }
+
+    AgentID SparseMultiGrid2D::move_agent(
+            const AgentID agent_id,
+            const GridCoord2D& coord
+    ) {
+        auto agent_cell = _agent_index.find(agent_id);
+        if (agent_cell == nullptr)
+            throw error::AgentNotFound(fmt::format("Agent {} not found on grid", agent_id.to_string()));
+        if (!is_location_valid(coord))
+            throw error::LocationInvalid(fmt::format("Coordinates {} are invalid", coord.to_string()));
+
+        remove_from_tile(agent_id, index_coord(*agent_cell));
+        add_to_tile(agent_id, coord);
+        *agent_cell = coord_index(coord);
+        return agent_id;
+    }
+
+    bool SparseMultiGrid2D::is_location_empty(const GridCoord2D& coord) const {
+        if (!is_location_valid(coord))
+            return true;
+
+        auto tile = find_tile(tile_key(coord));
+        return tile == nullptr || tile->cells[tile_offset(coord)].empty();
+    }
+
+    std::shared_ptr<std::set<AgentID>> SparseMultiGrid2D::get_location_contents(const GridCoord2D& coord) const {
+        if (!is_location_valid(coord))
+            throw error::LocationUnavailable(fmt::format("Coordinates {} are invalid", coord.to_string()));
+
+        auto contents = std::make_shared<std::set<AgentID>>();
+        auto tile = find_tile(tile_key(coord));
+        if (tile != nullptr) {
+            auto& cell = tile->cells[tile_offset(coord)];
+            contents->insert(cell.begin(), cell.end());
+        }
+        return contents;
+    }
+
+    std::span<const AgentID> SparseMultiGrid2D::get_location_view(const GridCoord2D& coord) const {
+        auto tile = find_tile(tile_key(coord));
+        if (tile == nullptr)
+            return {};
+
+        auto& cell = tile->cells[tile_offset(coord)];
+        return {cell.data(), cell.size()};
+    }
+
+    std::size_t SparseMultiGrid2D::get_tile_count() const {
+        return _tiles.size();
+    }
+
+    std::size_t SparseMultiGrid2D::directory_slot(const std::uint64_t key) const {
+        // Fibonacci hashing spreads neighbouring tile keys across the table
+        return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> _directory_shift);
+    }
+
+    SparseMultiGrid2D::Tile* SparseMultiGrid2D::find_tile(const std::uint64_t key) const {
+        const auto mask = _directory.size() - 1;
+        for (auto slot = directory_slot(key);; slot = (slot + 1) & mask) {
+            auto tile = _directory[slot];
+            if (tile == nullptr || tile->key == key)
+                return tile;
+        }
+    }
+
+    SparseMultiGrid2D::Tile& SparseMultiGrid2D::claim_tile(const std::uint64_t key) {
+        auto found = find_tile(key);
+        if (found != nullptr)
+            return *found;
+
+        // Keep the directory at most half full, so probes stay short
+        if ((_tiles.size() + 1) * 2 > _directory.size()) {
+            _directory.assign(_directory.size() * 2, nullptr);
+            _directory_shift--;
+            for (auto& tile : _tiles)
+                insert_directory(tile.get());
+        }
+
+        auto tile = _spare_tile ? std::move(_spare_tile) : std::make_unique<Tile>();
+        tile->key = key;
+        tile->position = _tiles.size();
+        tile->agent_count = 0;
+        insert_directory(tile.get());
+        _tiles.push_back(std::move(tile));
+        return *_tiles.back();
+    }
+
+    void SparseMultiGrid2D::release_tile(Tile& tile) {
+        erase_directory(tile.key);
+
+        // Swap the last tile into the vacated position
+        const auto position = tile.position;
+        auto released = std::move(_tiles[position]);
+        if (position + 1 != _tiles.size()) {
+            _tiles[position] = std::move(_tiles.back());
+            _tiles[position]->position = position;
+        }
+        _tiles.pop_back();
+
+        released->key = empty_key;
+        if (!_spare_tile)
+            _spare_tile = std::move(released);
+    }
+
+    void SparseMultiGrid2D::insert_directory(Tile* tile) {
+        const auto mask = _directory.size() - 1;
+        auto slot = directory_slot(tile->key);
+        while (_directory[slot] != nullptr)
+            slot = (slot + 1) & mask;
+        _directory[slot] = tile;
+    }
+
+    void SparseMultiGrid2D::erase_directory(const std::uint64_t key) {
+        const auto mask = _directory.size() - 1;
+        auto slot = directory_slot(key);
+        while (_directory[slot]->key != key)
+            slot = (slot + 1) & mask;
+
+        // Shift later entries of the probe sequence back over the hole,
+        // so that lookups never need tombstones
+        for (auto next = (slot + 1) & mask; _directory[next] != nullptr; next = (next + 1) & mask) {
+            const auto home = directory_slot(_directory[next]->key);
+            if (((next - home) & mask) >= ((next - slot) & mask)) {
+                _directory[slot] = _directory[next];
+                slot = next;
+            }
+        }
+        _directory[slot] = nullptr;
+    }
+
+    void SparseMultiGrid2D::add_to_tile(
+            const AgentID agent_id,
+            const GridCoord2D& coord
+    ) {
+        auto& tile = claim_tile(tile_key(coord));
+        auto& cell = tile.cells[tile_offset(coord)];
+
+        *_agent_slots.find(agent_id) = static_cast<std::uint32_t>(cell.size());
+        cell.push_back(agent_id);
+        tile.agent_count++;
+    }
+
+    void SparseMultiGrid2D::remove_from_tile(
+            const AgentID agent_id,
+            const GridCoord2D& coord
+    ) {
+        auto tile = find_tile(tile_key(coord));
+        auto& cell = tile->cells[tile_offset(coord)];
+        auto slot = *_agent_slots.find(agent_id);
+
+        // Swap the last agent of the cell into the vacated slot
+        if (slot + 1 != cell.size()) {
+            cell[slot] = cell.back();
+            *_agent_slots.find(cell[slot]) = slot;
+        }
+        cell.pop_back();
+
+        if (--tile->agent_count == 0)
+            release_tile(*tile);
+    }
+
+}  // namespace kami
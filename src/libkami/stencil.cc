@@ -0,0 +1,122 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+#include <kami/grid.h>
+#include <kami/stencil.h>
+
+namespace kami::stencil {
+
+    namespace {
+
+        // A cache of generated stencils.  Entries are never removed, and
+        // the stencils are held by pointer, so a reference stays valid
+        // once returned.  Lookups share the lock, so concurrent queries
+        // only serialize while a new stencil is generated.
+        template<typename Key, typename Offset>
+        class StencilCache {
+        public:
+            template<typename Generator>
+            const std::vector<Offset>& get(
+                    const Key& key,
+                    Generator&& generate
+            ) {
+                {
+                    std::shared_lock<std::shared_mutex> lock(_mutex);
+                    auto found = _cache.find(key);
+                    if (found != _cache.end())
+                        return *found->second;
+                }
+
+                std::unique_lock<std::shared_mutex> lock(_mutex);
+                auto& offsets = _cache[key];
+                if (offsets == nullptr) {
+                    offsets = std::make_unique<std::vector<Offset>>();
+                    generate(*offsets);
+                }
+                return *offsets;
+            }
+
+        private:
+            std::shared_mutex _mutex;
+            std::map<Key, std::unique_ptr<std::vector<Offset>>> _cache;
+        };
+
+    }  // namespace
+
+    const std::vector<GridOffset1D>& get_1d(unsigned int radius) {
+        static StencilCache<unsigned int, GridOffset1D> cache;
+
+        return cache.get(radius, [radius](std::vector<GridOffset1D>& offsets) {
+            auto r = static_cast<int>(radius);
+
+            offsets.reserve(2 * radius + 1);
+            for (auto dx = -r; dx <= r; dx++)
+                offsets.push_back({dx});
+        });
+    }
+
+    const std::vector<GridOffset2D>& get_2d(
+            GridNeighborhoodType neighborhood_type,
+            unsigned int radius
+    ) {
+        static StencilCache<std::pair<GridNeighborhoodType, unsigned int>, GridOffset2D> cache;
+
+        return cache.get({neighborhood_type, radius}, [neighborhood_type, radius](std::vector<GridOffset2D>& offsets) {
+            auto r = static_cast<int>(radius);
+
+            offsets.reserve(size_2d(neighborhood_type, r));
+            for (auto dy = -r; dy <= r; dy++)
+                for (auto dx = -r; dx <= r; dx++)
+                    if (contains(neighborhood_type, r, dx, dy))
+                        offsets.push_back({dx, dy});
+        });
+    }
+
+    const std::vector<GridOffset3D>& get_3d(
+            GridNeighborhoodType neighborhood_type,
+            unsigned int radius
+    ) {
+        static StencilCache<std::pair<GridNeighborhoodType, unsigned int>, GridOffset3D> cache;
+
+        return cache.get({neighborhood_type, radius}, [neighborhood_type, radius](std::vector<GridOffset3D>& offsets) {
+            auto r = static_cast<int>(radius);
+
+            offsets.reserve(size_3d(neighborhood_type, r));
+            for (auto dz = -r; dz <= r; dz++)
+                for (auto dy = -r; dy <= r; dy++)
+                    for (auto dx = -r; dx <= r; dx++)
+                        if (contains(neighborhood_type, r, dx, dy, dz))
+                            offsets.push_back({dx, dy, dz});
+        });
+    }
+
+}  // namespace kami::stencil
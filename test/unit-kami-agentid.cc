@@ -63,6 +63,13 @@ TEST_F(AgentIDTest, ordering) {
     EXPECT_FALSE(agent_id_bar < agent_id_foo);
 }
 
+TEST_F(AgentIDTest, null) {
+    EXPECT_EQ(AgentID::null(), AgentID::null());
+    EXPECT_NE(AgentID::null(), agent_id_foo);
+    EXPECT_NE(AgentID::null(), agent_id_bar);
+    EXPECT_TRUE(AgentID::null() < agent_id_foo);
+}
+
 int main(
         int argc,
         char** argv
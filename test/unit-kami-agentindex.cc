@@ -0,0 +1,124 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include <kami/agent.h>
+#include <kami/agentindex.h>
+
+#include <gtest/gtest.h>
+
+using namespace kami;
+using namespace std;
+
+TEST(AgentIndex, DefaultConstructor) {
+    const AgentIndex<int> agentindex_foo;
+    const AgentID agentid_foo;
+
+    EXPECT_EQ(agentindex_foo.size(), 0);
+    EXPECT_TRUE(agentindex_foo.empty());
+    EXPECT_EQ(agentindex_foo.find(agentid_foo), nullptr);
+    EXPECT_FALSE(agentindex_foo.contains(agentid_foo));
+}
+
+TEST(AgentIndex, insert) {
+    AgentIndex<int> agentindex_foo;
+    const AgentID agentid_foo, agentid_bar;
+
+    EXPECT_TRUE(agentindex_foo.insert(agentid_foo, 1));
+    EXPECT_TRUE(agentindex_foo.insert(agentid_bar, 2));
+    EXPECT_FALSE(agentindex_foo.insert(agentid_foo, 3));
+
+    EXPECT_EQ(agentindex_foo.size(), 2);
+    ASSERT_NE(agentindex_foo.find(agentid_foo), nullptr);
+    EXPECT_EQ(*agentindex_foo.find(agentid_foo), 1);
+    EXPECT_EQ(*agentindex_foo.find(agentid_bar), 2);
+}
+
+TEST(AgentIndex, find) {
+    AgentIndex<int> agentindex_foo;
+    const AgentID agentid_foo, agentid_bar;
+
+    agentindex_foo.insert(agentid_foo, 1);
+    *agentindex_foo.find(agentid_foo) = 4;
+
+    EXPECT_EQ(*agentindex_foo.find(agentid_foo), 4);
+    EXPECT_EQ(agentindex_foo.find(agentid_bar), nullptr);
+}
+
+TEST(AgentIndex, erase) {
+    AgentIndex<int> agentindex_foo;
+    const AgentID agentid_foo, agentid_bar;
+
+    agentindex_foo.insert(agentid_foo, 1);
+    agentindex_foo.insert(agentid_bar, 2);
+
+    EXPECT_TRUE(agentindex_foo.erase(agentid_foo));
+    EXPECT_FALSE(agentindex_foo.erase(agentid_foo));
+    EXPECT_EQ(agentindex_foo.size(), 1);
+    EXPECT_EQ(agentindex_foo.find(agentid_foo), nullptr);
+    EXPECT_EQ(*agentindex_foo.find(agentid_bar), 2);
+}
+
+TEST(AgentIndex, churn) {
+    AgentIndex<int> agentindex_foo;
+    map<AgentID, int> map_foo;
+    vector<AgentID> agentids;
+    mt19937 rng(8675309);
+
+    for (auto i = 0; i < 1000; i++)
+        agentids.emplace_back();
+
+    for (auto i = 0; i < 20000; i++) {
+        auto& agent_id = agentids[rng() % agentids.size()];
+        if (rng() % 3 == 0) {
+            EXPECT_EQ(agentindex_foo.erase(agent_id), map_foo.erase(agent_id) == 1);
+        } else {
+            EXPECT_EQ(agentindex_foo.insert(agent_id, i), map_foo.insert({agent_id, i}).second);
+        }
+    }
+
+    EXPECT_EQ(agentindex_foo.size(), map_foo.size());
+    for (auto& agent_id : agentids) {
+        auto value = agentindex_foo.find(agent_id);
+        auto expected = map_foo.find(agent_id);
+        if (expected == map_foo.end()) {
+            EXPECT_EQ(value, nullptr);
+        } else {
+            ASSERT_NE(value, nullptr);
+            EXPECT_EQ(*value, expected->second);
+        }
+    }
+}
+
+int main(
+        int argc,
+        char** argv
+) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,183 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <chrono>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <kami/agent.h>
+#include <kami/budgeted.h>
+#include <kami/population.h>
+
+#include <gtest/gtest.h>
+
+using namespace kami;
+using namespace std;
+
+class TestAgent
+        : public Agent {
+public:
+    explicit TestAgent(double rank)
+            :rank(rank) {
+    }
+
+    AgentID step(shared_ptr<Model> model) override {
+        return get_agent_id();
+    }
+
+    double rank;
+};
+
+class TestModel
+        : public Model {
+public:
+    shared_ptr<vector<AgentID>> retval;
+
+    shared_ptr<Model> step() override {
+        retval = _sched->step(shared_from_this());
+        return shared_from_this();
+    }
+};
+
+class BudgetedSchedulerTest
+        : public ::testing::Test {
+protected:
+    shared_ptr<TestModel> mod = nullptr;
+    shared_ptr<Population> pop_foo = nullptr;
+
+    void SetUp() override {
+        mod = make_shared<TestModel>();
+        pop_foo = make_shared<Population>();
+
+        // Domain is not required for this test
+        static_cast<void>(mod->set_population(pop_foo));
+
+        for (auto i = 0; i < 10; i++) {
+            auto agent_foo = make_shared<TestAgent>(i % 3);
+            static_cast<void>(pop_foo->add_agent(agent_foo));
+        }
+    }
+};
+
+TEST(BudgetedScheduler, DefaultConstructor) {
+    // There is really no way this can go wrong, but
+    // we add this check anyway in case of future
+    // changes.
+    EXPECT_NO_THROW(
+            const BudgetedScheduler sched_foo(chrono::milliseconds(10));
+    );
+}
+
+TEST_F(BudgetedSchedulerTest, step_unlimited) {
+    auto sched_foo = make_shared<BudgetedScheduler>(chrono::hours(1));
+    static_cast<void>(mod->set_scheduler(sched_foo));
+
+    auto tval = pop_foo->get_agent_list();
+    for (auto i = 0; i < 3; i++) {
+        mod->step();
+
+        EXPECT_EQ(*mod->retval, *tval);
+        EXPECT_EQ(sched_foo->get_deferred_count(), 0);
+    }
+    EXPECT_EQ(sched_foo->get_total_deferred(), 0);
+    EXPECT_EQ(sched_foo->get_max_wait(), 0);
+    EXPECT_DOUBLE_EQ(sched_foo->get_mean_wait(), 0.0);
+}
+
+TEST_F(BudgetedSchedulerTest, step_exhausted) {
+    // An exhausted budget still executes one agent per step
+    auto sched_foo = make_shared<BudgetedScheduler>(chrono::nanoseconds(0));
+    static_cast<void>(mod->set_scheduler(sched_foo));
+
+    auto tval = pop_foo->get_agent_list();
+    vector<AgentID> rval;
+    for (auto i = 0; i < 10; i++) {
+        mod->step();
+
+        ASSERT_EQ(mod->retval->size(), 1);
+        rval.push_back(mod->retval->front());
+        EXPECT_EQ(sched_foo->get_deferred_count(), 9 - i);
+    }
+    EXPECT_EQ(rval, *tval);
+    EXPECT_EQ(sched_foo->get_total_deferred(), 45);
+    EXPECT_EQ(sched_foo->get_max_wait(), 9);
+    EXPECT_DOUBLE_EQ(sched_foo->get_mean_wait(), 4.5);
+
+    // The next round starts over from the beginning
+    mod->step();
+    EXPECT_EQ(mod->retval->front(), tval->front());
+}
+
+TEST_F(BudgetedSchedulerTest, step_priority) {
+    auto sched_foo = make_shared<BudgetedScheduler>(
+            chrono::nanoseconds(0),
+            [](const shared_ptr<Agent>& agent) { return static_pointer_cast<TestAgent>(agent)->rank; });
+    static_cast<void>(mod->set_scheduler(sched_foo));
+
+    vector<double> ranks;
+    vector<AgentID> rval;
+    for (auto i = 0; i < 10; i++) {
+        mod->step();
+        rval.push_back(mod->retval->front());
+        ranks.push_back(static_pointer_cast<TestAgent>(pop_foo->get_agent_by_id(rval.back()))->rank);
+    }
+    EXPECT_EQ(ranks, vector<double>({2, 2, 2, 1, 1, 1, 0, 0, 0, 0}));
+
+    // Ties are executed in the order provided
+    for (size_t i = 1; i < rval.size(); i++)
+        if (ranks[i] == ranks[i - 1]) {
+            EXPECT_TRUE(rval[i - 1] < rval[i]);
+        }
+}
+
+TEST_F(BudgetedSchedulerTest, step_deleted) {
+    auto sched_foo = make_shared<BudgetedScheduler>(chrono::nanoseconds(0));
+    static_cast<void>(mod->set_scheduler(sched_foo));
+
+    auto tval = pop_foo->get_agent_list();
+    mod->step();
+    static_cast<void>(pop_foo->delete_agent(tval->at(1)));
+    mod->step();
+
+    EXPECT_EQ(mod->retval->front(), tval->at(2));
+    EXPECT_EQ(sched_foo->get_deferred_count(), 7);
+}
+
+TEST(BudgetedScheduler, set_budget) {
+    BudgetedScheduler sched_foo(chrono::milliseconds(10));
+
+    EXPECT_EQ(sched_foo.get_budget(), chrono::milliseconds(10));
+    EXPECT_EQ(sched_foo.set_budget(chrono::milliseconds(5)), chrono::milliseconds(5));
+    EXPECT_EQ(sched_foo.get_budget(), chrono::milliseconds(5));
+}
+
+int main(
+        int argc,
+        char** argv
+) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
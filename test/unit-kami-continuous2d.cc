@@ -0,0 +1,196 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <kami/agent.h>
+#include <kami/continuous2d.h>
+#include <kami/error.h>
+#include <kami/executor.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace kami;
+using namespace kami::error;
+using namespace std;
+
+TEST(ContinuousCoord2D, DefaultConstructor) {
+    const ContinuousCoord2D coord_foo(0.5, 1.5), coord_bar(3.5, 5.5);
+
+    EXPECT_DOUBLE_EQ(coord_foo.x(), 0.5);
+    EXPECT_DOUBLE_EQ(coord_foo.y(), 1.5);
+    EXPECT_EQ(coord_foo, ContinuousCoord2D(0.5, 1.5));
+    EXPECT_NE(coord_foo, coord_bar);
+    EXPECT_DOUBLE_EQ(coord_foo.distance(coord_bar), 5.0);
+    EXPECT_THAT(coord_foo.to_string(), "(0.5, 1.5)");
+}
+
+TEST(ContinuousSpace2D, DefaultConstructor) {
+    EXPECT_NO_THROW(
+            ContinuousSpace2D continuous2d_foo(10.0, 10.0, 1.0, true, true);
+    );
+    EXPECT_THROW(ContinuousSpace2D continuous2d_foo(0.0, 10.0, 1.0), OptionInvalid);
+    EXPECT_THROW(ContinuousSpace2D continuous2d_foo(10.0, 10.0, 0.0), OptionInvalid);
+
+    ContinuousSpace2D continuous2d_foo(10.0, 7.5, 2.0);
+    EXPECT_EQ(continuous2d_foo.get_bin_count_x(), 5);
+    EXPECT_EQ(continuous2d_foo.get_bin_count_y(), 3);
+}
+
+TEST(ContinuousSpace2D, add_agent) {
+    ContinuousSpace2D continuous2d_foo(10.0, 10.0, 1.0, true, false);
+    const AgentID agent_id_foo, agent_id_bar;
+
+    EXPECT_EQ(continuous2d_foo.add_agent(agent_id_foo, ContinuousCoord2D(2.5, 3.5)), agent_id_foo);
+    EXPECT_THROW(auto agent_id_baz = continuous2d_foo.add_agent(agent_id_foo, ContinuousCoord2D(1.0, 1.0)),
+                 OptionInvalid);
+    EXPECT_THROW(auto agent_id_baz = continuous2d_foo.add_agent(agent_id_bar, ContinuousCoord2D(1.0, 10.0)),
+                 LocationInvalid);
+
+    // Wrapped dimensions take any coordinate
+    EXPECT_EQ(continuous2d_foo.add_agent(agent_id_bar, ContinuousCoord2D(-1.5, 3.0)), agent_id_bar);
+    EXPECT_EQ(continuous2d_foo.get_location_by_agent(agent_id_bar), ContinuousCoord2D(8.5, 3.0));
+    EXPECT_EQ(continuous2d_foo.get_agent_count(), 2);
+}
+
+TEST(ContinuousSpace2D, delete_agent) {
+    ContinuousSpace2D continuous2d_foo(10.0, 10.0, 1.0);
+    const AgentID agent_id_foo, agent_id_bar, agent_id_baz;
+
+    static_cast<void>(continuous2d_foo.add_agent(agent_id_foo, ContinuousCoord2D(1.0, 1.0)));
+    static_cast<void>(continuous2d_foo.add_agent(agent_id_bar, ContinuousCoord2D(2.0, 2.0)));
+    static_cast<void>(continuous2d_foo.add_agent(agent_id_baz, ContinuousCoord2D(3.0, 3.0)));
+
+    EXPECT_EQ(continuous2d_foo.delete_agent(agent_id_foo), agent_id_foo);
+    EXPECT_THROW(auto agent_id_qux = continuous2d_foo.delete_agent(agent_id_foo), AgentNotFound);
+    EXPECT_THROW(auto loc = continuous2d_foo.get_location_by_agent(agent_id_foo), AgentNotFound);
+    EXPECT_EQ(continuous2d_foo.get_location_by_agent(agent_id_baz), ContinuousCoord2D(3.0, 3.0));
+    EXPECT_EQ(*continuous2d_foo.get_agents_in_radius(ContinuousCoord2D(2.0, 2.0), 5.0),
+              vector<AgentID>({agent_id_bar, agent_id_baz}));
+}
+
+TEST(ContinuousSpace2D, move_agent) {
+    ContinuousSpace2D continuous2d_foo(10.0, 10.0, 1.0);
+    const AgentID agent_id_foo;
+
+    static_cast<void>(continuous2d_foo.add_agent(agent_id_foo, ContinuousCoord2D(1.0, 1.0)));
+    EXPECT_EQ(continuous2d_foo.get_agents_in_radius(ContinuousCoord2D(1.0, 1.0), 0.5)->size(), 1);
+
+    EXPECT_EQ(continuous2d_foo.move_agent(agent_id_foo, ContinuousCoord2D(8.0, 8.0)), agent_id_foo);
+    EXPECT_TRUE(continuous2d_foo.get_agents_in_radius(ContinuousCoord2D(1.0, 1.0), 0.5)->empty());
+    EXPECT_EQ(continuous2d_foo.get_agents_in_radius(ContinuousCoord2D(8.0, 8.2), 0.5)->size(), 1);
+
+    EXPECT_THROW(auto agent_id_bar = continuous2d_foo.move_agent(agent_id_foo, ContinuousCoord2D(11.0, 1.0)),
+                 LocationInvalid);
+    EXPECT_EQ(continuous2d_foo.get_location_by_agent(agent_id_foo), ContinuousCoord2D(8.0, 8.0));
+}
+
+TEST(ContinuousSpace2D, distance) {
+    ContinuousSpace2D continuous2d_foo(10.0, 10.0, 1.0, true, false);
+
+    EXPECT_DOUBLE_EQ(continuous2d_foo.distance(ContinuousCoord2D(0.5, 0.0), ContinuousCoord2D(9.5, 0.0)), 1.0);
+    EXPECT_DOUBLE_EQ(continuous2d_foo.distance(ContinuousCoord2D(0.0, 0.5), ContinuousCoord2D(0.0, 9.5)), 9.0);
+}
+
+TEST(ContinuousSpace2D, get_agents_in_radius) {
+    for (auto wrap : {false, true}) {
+        ContinuousSpace2D continuous2d_foo(20.0, 15.0, 1.5, wrap, wrap);
+        vector<AgentID> agent_ids(2000);
+        mt19937 rng(8675309);
+        uniform_real_distribution<double> x_dist(0.0, 20.0), y_dist(0.0, 15.0);
+
+        for (auto& agent_id : agent_ids)
+            static_cast<void>(continuous2d_foo.add_agent(agent_id, ContinuousCoord2D(x_dist(rng), y_dist(rng))));
+
+        Executor executor(3);
+        continuous2d_foo.rebuild_index(&executor);
+
+        for (auto radius : {0.5, 1.5, 4.0, 30.0}) {
+            for (auto i = 0; i < 20; i++) {
+                const ContinuousCoord2D center(x_dist(rng), y_dist(rng));
+                set<AgentID> expected;
+                for (auto& agent_id : agent_ids)
+                    if (continuous2d_foo.distance(center, continuous2d_foo.get_location_by_agent(agent_id)) <= radius)
+                        expected.insert(agent_id);
+
+                auto found = continuous2d_foo.get_agents_in_radius(center, radius);
+                EXPECT_EQ(found->size(), expected.size());
+                EXPECT_EQ(set<AgentID>(found->begin(), found->end()), expected);
+            }
+        }
+    }
+}
+
+TEST(ContinuousSpace2D, rebuild_index) {
+    ContinuousSpace2D continuous2d_foo(100.0, 100.0, 2.0, true, true);
+    ContinuousSpace2D continuous2d_bar(100.0, 100.0, 2.0, true, true);
+    mt19937 rng(8675309);
+    uniform_real_distribution<double> dist(0.0, 100.0);
+
+    for (auto i = 0; i < 50000; i++) {
+        const AgentID agent_id;
+        const ContinuousCoord2D coord(dist(rng), dist(rng));
+        static_cast<void>(continuous2d_foo.add_agent(agent_id, coord));
+        static_cast<void>(continuous2d_bar.add_agent(agent_id, coord));
+    }
+
+    // A parallel rebuild orders agents the same as a serial one
+    Executor executor(3);
+    continuous2d_foo.rebuild_index(&executor);
+    for (auto i = 0; i < 50; i++) {
+        const ContinuousCoord2D center(dist(rng), dist(rng));
+        EXPECT_EQ(*continuous2d_foo.get_agents_in_radius(center, 3.0),
+                  *continuous2d_bar.get_agents_in_radius(center, 3.0));
+    }
+}
+
+TEST(ContinuousSpace2D, for_each_agent_in_radius) {
+    ContinuousSpace2D continuous2d_foo(10.0, 10.0, 1.0);
+    const AgentID agent_id_foo, agent_id_bar;
+    auto count = 0;
+
+    static_cast<void>(continuous2d_foo.add_agent(agent_id_foo, ContinuousCoord2D(5.0, 5.0)));
+    static_cast<void>(continuous2d_foo.add_agent(agent_id_bar, ContinuousCoord2D(5.5, 5.0)));
+
+    EXPECT_FALSE(continuous2d_foo.for_each_agent_in_radius(ContinuousCoord2D(5.0, 5.0), 1.0,
+                                                           [&count](const AgentID) {
+                                                               count++;
+                                                               return false;
+                                                           }));
+    EXPECT_EQ(count, 1);
+}
+
+int main(
+        int argc,
+        char** argv
+) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
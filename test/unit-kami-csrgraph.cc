@@ -0,0 +1,126 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <kami/csrgraph.h>
+#include <kami/error.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace kami;
+using namespace kami::error;
+using namespace std;
+
+TEST(CSRGraph, DefaultConstructor) {
+    const vector<pair<unsigned int, unsigned int>> edges = {{0, 1}, {1, 2}, {2, 0}, {2, 3}};
+    const CSRGraph csrgraph_foo(5, edges);
+
+    EXPECT_EQ(csrgraph_foo.get_node_count(), 5);
+    EXPECT_EQ(csrgraph_foo.get_edge_count(), 4);
+    EXPECT_FALSE(csrgraph_foo.is_directed());
+    EXPECT_THAT(csrgraph_foo.get_neighbors(2), ::testing::ElementsAre(0, 1, 3));
+    EXPECT_THAT(csrgraph_foo.get_neighbors(3), ::testing::ElementsAre(2));
+    EXPECT_TRUE(csrgraph_foo.get_neighbors(4).empty());
+    EXPECT_EQ(csrgraph_foo.get_degree(0), 2);
+    EXPECT_THAT(csrgraph_foo.get_offsets(), ::testing::ElementsAre(0, 2, 4, 7, 8, 8));
+
+    EXPECT_THROW(CSRGraph csrgraph_bar(3, edges), OptionInvalid);
+}
+
+TEST(CSRGraph, directed) {
+    const vector<pair<unsigned int, unsigned int>> edges = {{0, 1}, {1, 2}, {2, 0}, {2, 1}};
+    const CSRGraph csrgraph_foo(3, edges, true);
+
+    EXPECT_EQ(csrgraph_foo.get_edge_count(), 4);
+    EXPECT_TRUE(csrgraph_foo.is_directed());
+    EXPECT_THAT(csrgraph_foo.get_neighbors(0), ::testing::ElementsAre(1));
+    EXPECT_THAT(csrgraph_foo.get_neighbors(2), ::testing::ElementsAre(0, 1));
+    EXPECT_TRUE(csrgraph_foo.has_edge(2, 1));
+    EXPECT_FALSE(csrgraph_foo.has_edge(1, 0));
+}
+
+TEST(CSRGraph, simple) {
+    // Duplicate edges are merged, in either direction, and self-loops dropped
+    const vector<pair<unsigned int, unsigned int>> edges = {{0, 1}, {1, 0}, {0, 1}, {1, 1}, {1, 2}};
+    const CSRGraph csrgraph_foo(3, edges);
+
+    EXPECT_EQ(csrgraph_foo.get_edge_count(), 2);
+    EXPECT_THAT(csrgraph_foo.get_neighbors(0), ::testing::ElementsAre(1));
+    EXPECT_THAT(csrgraph_foo.get_neighbors(1), ::testing::ElementsAre(0, 2));
+    EXPECT_THAT(csrgraph_foo.get_targets(), ::testing::ElementsAre(1, 0, 2, 1));
+}
+
+TEST(CSRGraph, load_edge_list) {
+    auto path = (filesystem::temp_directory_path() / "unit-kami-csrgraph.txt").string();
+    {
+        ofstream file(path);
+        file << "# a comment\n"
+             << "0 1\n"
+             << "\n"
+             << "% another comment\r\n"
+             << "  1\t4 # from one to four\r\n"
+             << "4 2";
+    }
+
+    auto csrgraph_foo = CSRGraph::load_edge_list(path);
+    EXPECT_EQ(csrgraph_foo->get_node_count(), 5);
+    EXPECT_EQ(csrgraph_foo->get_edge_count(), 3);
+    EXPECT_THAT(csrgraph_foo->get_neighbors(4), ::testing::ElementsAre(1, 2));
+
+    auto csrgraph_bar = CSRGraph::load_edge_list(path, true, 8);
+    EXPECT_EQ(csrgraph_bar->get_node_count(), 8);
+    EXPECT_THAT(csrgraph_bar->get_neighbors(4), ::testing::ElementsAre(2));
+
+    {
+        ofstream file(path);
+        file << "0 1\n"
+             << "2 x\n";
+    }
+    EXPECT_THROW(auto csrgraph_baz = CSRGraph::load_edge_list(path), OptionInvalid);
+
+    // A weight column is not silently dropped
+    {
+        ofstream file(path);
+        file << "0 1 0.5\n";
+    }
+    EXPECT_THROW(auto csrgraph_baz = CSRGraph::load_edge_list(path), OptionInvalid);
+
+    filesystem::remove(path);
+    EXPECT_THROW(auto csrgraph_baz = CSRGraph::load_edge_list(path), ResourceNotAvailable);
+}
+
+int main(
+        int argc,
+        char** argv
+) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
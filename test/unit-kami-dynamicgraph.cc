@@ -0,0 +1,177 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <kami/csrgraph.h>
+#include <kami/dynamicgraph.h>
+#include <kami/error.h>
+#include <kami/multinetwork.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace kami;
+using namespace kami::error;
+using namespace std;
+
+namespace {
+
+    set<unsigned int> neighbor_set(
+            const NetworkGraph& graph,
+            unsigned int node
+    ) {
+        auto neighbors = graph.get_neighbors(node);
+        return {neighbors.begin(), neighbors.end()};
+    }
+
+}  // namespace
+
+TEST(DynamicGraph, DefaultConstructor) {
+    const DynamicGraph dynamicgraph_foo(5);
+
+    EXPECT_EQ(dynamicgraph_foo.get_node_count(), 5);
+    EXPECT_EQ(dynamicgraph_foo.get_edge_count(), 0);
+    EXPECT_FALSE(dynamicgraph_foo.is_directed());
+    EXPECT_TRUE(dynamicgraph_foo.get_neighbors(4).empty());
+}
+
+TEST(DynamicGraph, add_edge) {
+    DynamicGraph dynamicgraph_foo(5);
+
+    EXPECT_TRUE(dynamicgraph_foo.add_edge(0, 1));
+    EXPECT_TRUE(dynamicgraph_foo.add_edge(2, 1));
+    EXPECT_FALSE(dynamicgraph_foo.add_edge(1, 0));
+    EXPECT_FALSE(dynamicgraph_foo.add_edge(3, 3));
+    EXPECT_THROW(dynamicgraph_foo.add_edge(3, 5), OptionInvalid);
+
+    EXPECT_EQ(dynamicgraph_foo.get_edge_count(), 2);
+    EXPECT_EQ(neighbor_set(dynamicgraph_foo, 1), set<unsigned int>({0, 2}));
+    EXPECT_TRUE(dynamicgraph_foo.has_edge(1, 2));
+    EXPECT_FALSE(dynamicgraph_foo.has_edge(0, 2));
+}
+
+TEST(DynamicGraph, delete_edge) {
+    DynamicGraph dynamicgraph_foo(5, true);
+
+    static_cast<void>(dynamicgraph_foo.add_edge(0, 1));
+    static_cast<void>(dynamicgraph_foo.add_edge(0, 2));
+    static_cast<void>(dynamicgraph_foo.add_edge(0, 3));
+    static_cast<void>(dynamicgraph_foo.add_edge(3, 0));
+
+    EXPECT_FALSE(dynamicgraph_foo.delete_edge(1, 0));
+    EXPECT_TRUE(dynamicgraph_foo.delete_edge(0, 1));
+    EXPECT_FALSE(dynamicgraph_foo.delete_edge(0, 1));
+    EXPECT_EQ(dynamicgraph_foo.get_edge_count(), 3);
+    EXPECT_EQ(neighbor_set(dynamicgraph_foo, 0), set<unsigned int>({2, 3}));
+    EXPECT_TRUE(dynamicgraph_foo.has_edge(0, 3));
+    EXPECT_TRUE(dynamicgraph_foo.delete_edge(0, 3));
+    EXPECT_TRUE(dynamicgraph_foo.has_edge(3, 0));
+}
+
+TEST(DynamicGraph, churn) {
+    // Rewire a graph at random and check it against a reference
+    const unsigned int node_count = 200;
+    DynamicGraph dynamicgraph_foo(node_count);
+    set<pair<unsigned int, unsigned int>> reference;
+    mt19937 rng(8675309);
+    uniform_int_distribution<unsigned int> dist(0, node_count - 1);
+
+    for (auto i = 0; i < 50000; i++) {
+        auto from = dist(rng), to = dist(rng);
+        auto edge = minmax(from, to);
+        if (from == to)
+            continue;
+
+        if (i % 3 == 0) {
+            EXPECT_EQ(dynamicgraph_foo.delete_edge(from, to), reference.erase(edge) == 1);
+        } else {
+            EXPECT_EQ(dynamicgraph_foo.add_edge(from, to), reference.insert(edge).second);
+        }
+    }
+    dynamicgraph_foo.compact();
+
+    EXPECT_EQ(dynamicgraph_foo.get_edge_count(), reference.size());
+    for (unsigned int node = 0; node < node_count; node++) {
+        set<unsigned int> expected;
+        for (auto& [from, to] : reference)
+            if (from == node || to == node)
+                expected.insert(from == node ? to : from);
+        EXPECT_EQ(neighbor_set(dynamicgraph_foo, node), expected);
+        EXPECT_EQ(dynamicgraph_foo.get_degree(node), expected.size());
+    }
+}
+
+TEST(DynamicGraph, freeze) {
+    const vector<pair<unsigned int, unsigned int>> edges = {{0, 1}, {1, 2}, {2, 0}, {2, 3}};
+    const CSRGraph csrgraph_foo(5, edges);
+    DynamicGraph dynamicgraph_foo(csrgraph_foo);
+
+    EXPECT_EQ(dynamicgraph_foo.get_edge_count(), 4);
+    for (unsigned int node = 0; node < 5; node++)
+        EXPECT_EQ(neighbor_set(dynamicgraph_foo, node), neighbor_set(csrgraph_foo, node));
+
+    static_cast<void>(dynamicgraph_foo.add_edge(3, 4));
+    static_cast<void>(dynamicgraph_foo.delete_edge(0, 2));
+    auto csrgraph_bar = dynamicgraph_foo.freeze();
+
+    EXPECT_EQ(csrgraph_bar->get_edge_count(), 4);
+    EXPECT_THAT(csrgraph_bar->get_neighbors(2), ::testing::ElementsAre(1, 3));
+    EXPECT_THAT(csrgraph_bar->get_neighbors(4), ::testing::ElementsAre(3));
+
+    // The snapshot does not follow later changes
+    static_cast<void>(dynamicgraph_foo.add_edge(0, 4));
+    EXPECT_FALSE(csrgraph_bar->has_edge(0, 4));
+}
+
+TEST(DynamicGraph, set_graph) {
+    auto dynamicgraph_foo = make_shared<DynamicGraph>(4);
+    MultiNetwork multinetwork_foo(dynamicgraph_foo);
+    const AgentID agent_id_foo;
+
+    static_cast<void>(multinetwork_foo.add_agent(agent_id_foo, NodeCoord(0)));
+    static_cast<void>(dynamicgraph_foo->add_edge(0, 1));
+    EXPECT_EQ(multinetwork_foo.get_neighborhood(agent_id_foo, false)->size(), 1);
+
+    multinetwork_foo.set_graph(dynamicgraph_foo->freeze());
+    static_cast<void>(dynamicgraph_foo->add_edge(0, 2));
+    EXPECT_EQ(multinetwork_foo.get_neighborhood(agent_id_foo, false)->size(), 1);
+    EXPECT_EQ(multinetwork_foo.get_location_by_agent(agent_id_foo), NodeCoord(0));
+
+    EXPECT_THROW(multinetwork_foo.set_graph(make_shared<DynamicGraph>(5)), OptionInvalid);
+}
+
+int main(
+        int argc,
+        char** argv
+) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
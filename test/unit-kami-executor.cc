@@ -0,0 +1,176 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <kami/error.h>
+#include <kami/executor.h>
+
+#include <gtest/gtest.h>
+
+using namespace kami;
+using namespace kami::error;
+using namespace std;
+
+TEST(Executor, DefaultConstructor) {
+    // There is really no way this can go wrong, but
+    // we add this check anyway in case of future
+    // changes.
+    EXPECT_NO_THROW(
+            const Executor executor_foo
+    );
+}
+
+TEST(Executor, get_thread_count) {
+    {
+        const Executor executor_foo(3);
+        EXPECT_EQ(executor_foo.get_thread_count(), 3);
+        EXPECT_EQ(executor_foo.get_concurrency(), 4);
+    }
+    {
+        const Executor executor_foo(0);
+        EXPECT_EQ(executor_foo.get_thread_count(), 0);
+        EXPECT_EQ(executor_foo.get_concurrency(), 1);
+    }
+}
+
+TEST(Executor, parallel_for) {
+    for (auto thread_count : {0u, 1u, 4u}) {
+        Executor executor_foo(thread_count);
+        vector<int> values(10000, 0);
+
+        executor_foo.parallel_for(0, values.size(), 64, [&values](size_t begin, size_t end) {
+            for (auto i = begin; i < end; i++)
+                values[i] += static_cast<int>(i);
+        });
+
+        vector<int> expected(values.size());
+        iota(expected.begin(), expected.end(), 0);
+        EXPECT_EQ(values, expected);
+    }
+    {
+        Executor executor_foo(2);
+        atomic<int> calls = 0;
+
+        executor_foo.parallel_for(5, 5, 1, [&calls](size_t, size_t) { calls++; });
+        EXPECT_EQ(calls, 0);
+        executor_foo.parallel_for(0, 100, 0, [&calls](size_t begin, size_t end) { calls += static_cast<int>(end - begin); });
+        EXPECT_EQ(calls, 100);
+    }
+}
+
+TEST(Executor, parallel_for_nested) {
+    Executor executor_foo(2);
+    atomic<long> total = 0;
+
+    executor_foo.parallel_for(0, 16, 1, [&executor_foo, &total](size_t, size_t) {
+        executor_foo.parallel_for(0, 1000, 10, [&total](size_t begin, size_t end) {
+            total += static_cast<long>(end - begin);
+        });
+    });
+    EXPECT_EQ(total, 16000);
+}
+
+TEST(Executor, parallel_for_exception) {
+    Executor executor_foo(2);
+
+    EXPECT_THROW(
+            executor_foo.parallel_for(0, 100, 1, [](size_t begin, size_t) {
+                if (begin == 50)
+                    throw runtime_error("failed");
+            }),
+            runtime_error
+    );
+}
+
+TEST(Executor, run) {
+    Executor executor_foo(3);
+    TaskGraph graph_foo;
+    atomic<int> phase = 0;
+    vector<int> seen(4, -1);
+
+    auto first = graph_foo.add_task([&]() { seen[0] = phase++; });
+    auto left = graph_foo.add_task([&]() { seen[1] = phase++; });
+    auto right = graph_foo.add_task([&]() { seen[2] = phase++; });
+    auto last = graph_foo.add_task([&]() { seen[3] = phase++; });
+    graph_foo.add_dependency(first, left);
+    graph_foo.add_dependency(first, right);
+    graph_foo.add_dependency(left, last);
+    graph_foo.add_dependency(right, last);
+    EXPECT_EQ(graph_foo.size(), 4);
+
+    // Graphs may be run repeatedly
+    for (int i = 0; i < 3; i++) {
+        phase = 0;
+        executor_foo.run(graph_foo);
+
+        EXPECT_EQ(seen[0], 0);
+        EXPECT_GT(seen[1], seen[0]);
+        EXPECT_GT(seen[2], seen[0]);
+        EXPECT_EQ(seen[3], 3);
+    }
+
+    graph_foo.clear();
+    EXPECT_EQ(graph_foo.size(), 0);
+    EXPECT_NO_THROW(executor_foo.run(graph_foo));
+}
+
+TEST(Executor, run_cycle) {
+    Executor executor_foo(1);
+    TaskGraph graph_foo;
+
+    auto foo = graph_foo.add_task([]() {});
+    auto bar = graph_foo.add_task([]() {});
+    graph_foo.add_dependency(foo, bar);
+    graph_foo.add_dependency(bar, foo);
+
+    EXPECT_THROW(executor_foo.run(graph_foo), OptionInvalid);
+    EXPECT_THROW(graph_foo.add_dependency(foo, 7), OptionInvalid);
+}
+
+TEST(Executor, run_exception) {
+    Executor executor_foo(2);
+    TaskGraph graph_foo;
+    atomic<bool> ran_after = false;
+
+    auto foo = graph_foo.add_task([]() { throw runtime_error("failed"); });
+    auto bar = graph_foo.add_task([&ran_after]() { ran_after = true; });
+    graph_foo.add_dependency(foo, bar);
+
+    EXPECT_THROW(executor_foo.run(graph_foo), runtime_error);
+    EXPECT_FALSE(ran_after);
+}
+
+int main(
+        int argc,
+        char** argv
+) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,273 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <numbers>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <kami/agent.h>
+#include <kami/error.h>
+#include <kami/executor.h>
+#include <kami/globe.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace kami;
+using namespace kami::error;
+using namespace std;
+
+namespace {
+
+    // Uniformly distributed over the sphere
+    GlobeCoord random_coord(mt19937& rng) {
+        uniform_real_distribution<double> z_dist(-1.0, 1.0), longitude_dist(-180.0, 180.0);
+        return {asin(z_dist(rng)) * 180.0 / numbers::pi, longitude_dist(rng)};
+    }
+
+}  // namespace
+
+TEST(GlobeCoord, DefaultConstructor) {
+    const GlobeCoord coord_foo(10.5, -20.25), coord_bar(0.0, 0.0);
+
+    EXPECT_DOUBLE_EQ(coord_foo.latitude(), 10.5);
+    EXPECT_DOUBLE_EQ(coord_foo.longitude(), -20.25);
+    EXPECT_EQ(coord_foo, GlobeCoord(10.5, -20.25));
+    EXPECT_NE(coord_foo, coord_bar);
+    EXPECT_THAT(coord_foo.to_string(), "(10.5, -20.25)");
+}
+
+TEST(GlobeCoord, distance) {
+    EXPECT_DOUBLE_EQ(GlobeCoord(0.0, 0.0).distance(GlobeCoord(0.0, 90.0)), numbers::pi / 2.0);
+    EXPECT_DOUBLE_EQ(GlobeCoord(90.0, 0.0).distance(GlobeCoord(-90.0, 45.0)), numbers::pi);
+    EXPECT_NEAR(GlobeCoord(0.0, 179.0).distance(GlobeCoord(0.0, -179.0)), 2.0 * numbers::pi / 180.0, 1e-12);
+    EXPECT_NEAR(GlobeCoord(89.0, 0.0).distance(GlobeCoord(89.0, 180.0)), 2.0 * numbers::pi / 180.0, 1e-12);
+    EXPECT_DOUBLE_EQ(GlobeCoord(45.0, 30.0).distance(GlobeCoord(45.0, 30.0)), 0.0);
+}
+
+TEST(Globe, DefaultConstructor) {
+    EXPECT_NO_THROW(
+            Globe globe_foo;
+    );
+    EXPECT_THROW(Globe globe_foo(0.0), OptionInvalid);
+    EXPECT_THROW(Globe globe_foo(1.0, Globe::maximum_level + 1), OptionInvalid);
+
+    Globe globe_foo(1.0, 3);
+    EXPECT_DOUBLE_EQ(globe_foo.get_radius(), 1.0);
+    EXPECT_EQ(globe_foo.get_level(), 3);
+    EXPECT_EQ(globe_foo.get_cell_count(), 12 * 64);
+    EXPECT_DOUBLE_EQ(Globe().get_radius(), Globe::earth_radius);
+}
+
+TEST(Globe, add_agent) {
+    Globe globe_foo;
+    const AgentID agent_id_foo, agent_id_bar;
+
+    EXPECT_EQ(globe_foo.add_agent(agent_id_foo, GlobeCoord(51.5, -0.125)), agent_id_foo);
+    EXPECT_THROW(auto agent_id_baz = globe_foo.add_agent(agent_id_foo, GlobeCoord(0.0, 0.0)), OptionInvalid);
+    EXPECT_THROW(auto agent_id_baz = globe_foo.add_agent(agent_id_bar, GlobeCoord(90.5, 0.0)), LocationInvalid);
+    EXPECT_THROW(auto agent_id_baz = globe_foo.add_agent(agent_id_bar, GlobeCoord(0.0, INFINITY)), LocationInvalid);
+
+    // Longitudes wrap around
+    EXPECT_EQ(globe_foo.add_agent(agent_id_bar, GlobeCoord(-10.0, 190.0)), agent_id_bar);
+    EXPECT_EQ(globe_foo.get_location_by_agent(agent_id_bar), GlobeCoord(-10.0, -170.0));
+    EXPECT_EQ(globe_foo.get_agent_count(), 2);
+}
+
+TEST(Globe, delete_agent) {
+    Globe globe_foo;
+    const AgentID agent_id_foo, agent_id_bar, agent_id_baz;
+
+    static_cast<void>(globe_foo.add_agent(agent_id_foo, GlobeCoord(1.0, 1.0)));
+    static_cast<void>(globe_foo.add_agent(agent_id_bar, GlobeCoord(2.0, 2.0)));
+    static_cast<void>(globe_foo.add_agent(agent_id_baz, GlobeCoord(3.0, 3.0)));
+
+    EXPECT_EQ(globe_foo.delete_agent(agent_id_foo), agent_id_foo);
+    EXPECT_THROW(auto agent_id_qux = globe_foo.delete_agent(agent_id_foo), AgentNotFound);
+    EXPECT_THROW(auto loc = globe_foo.get_location_by_agent(agent_id_foo), AgentNotFound);
+    EXPECT_EQ(globe_foo.get_location_by_agent(agent_id_baz), GlobeCoord(3.0, 3.0));
+    EXPECT_EQ(*globe_foo.get_agents_in_radius(GlobeCoord(2.0, 2.0), 500.0),
+              vector<AgentID>({agent_id_bar, agent_id_baz}));
+}
+
+TEST(Globe, move_agent) {
+    Globe globe_foo;
+    const AgentID agent_id_foo;
+
+    static_cast<void>(globe_foo.add_agent(agent_id_foo, GlobeCoord(1.0, 1.0)));
+    EXPECT_EQ(globe_foo.get_agents_in_radius(GlobeCoord(1.0, 1.0), 10.0)->size(), 1);
+
+    EXPECT_EQ(globe_foo.move_agent(agent_id_foo, GlobeCoord(-60.0, 120.0)), agent_id_foo);
+    EXPECT_TRUE(globe_foo.get_agents_in_radius(GlobeCoord(1.0, 1.0), 10.0)->empty());
+    EXPECT_EQ(globe_foo.get_agents_in_radius(GlobeCoord(-60.0, 120.1), 10.0)->size(), 1);
+
+    EXPECT_THROW(auto agent_id_bar = globe_foo.move_agent(agent_id_foo, GlobeCoord(-91.0, 0.0)), LocationInvalid);
+    EXPECT_EQ(globe_foo.get_location_by_agent(agent_id_foo), GlobeCoord(-60.0, 120.0));
+}
+
+TEST(Globe, get_distances) {
+    Globe globe_foo(2.0);
+    vector<AgentID> agent_ids(500);
+    vector<double> distances(agent_ids.size());
+    mt19937 rng(8675309);
+
+    for (auto& agent_id : agent_ids)
+        static_cast<void>(globe_foo.add_agent(agent_id, random_coord(rng)));
+
+    const GlobeCoord origin(37.5, -122.25);
+    globe_foo.get_distances(origin, agent_ids, distances);
+    for (size_t i = 0; i < agent_ids.size(); i++)
+        EXPECT_NEAR(distances[i], globe_foo.distance(origin, globe_foo.get_location_by_agent(agent_ids[i])), 1e-9);
+
+    // The origin itself, its antipode, and a near neighbor
+    const AgentID agent_id_foo, agent_id_bar, agent_id_baz;
+    static_cast<void>(globe_foo.add_agent(agent_id_foo, origin));
+    static_cast<void>(globe_foo.add_agent(agent_id_bar, GlobeCoord(-37.5, 57.75)));
+    static_cast<void>(globe_foo.add_agent(agent_id_baz, GlobeCoord(37.5, -122.2499)));
+    const vector<AgentID> agent_ids_bar{agent_id_foo, agent_id_bar, agent_id_baz};
+    globe_foo.get_distances(origin, agent_ids_bar, distances);
+    EXPECT_NEAR(distances[0], 0.0, 1e-12);
+    EXPECT_NEAR(distances[1], 2.0 * numbers::pi, 1e-12);
+    EXPECT_NEAR(distances[2], globe_foo.distance(origin, GlobeCoord(37.5, -122.2499)), 1e-12);
+
+    EXPECT_THROW(globe_foo.get_distances(origin, agent_ids, span<double>(distances).first(10)), OptionInvalid);
+    const vector<AgentID> agent_ids_foo(1);
+    EXPECT_THROW(globe_foo.get_distances(origin, agent_ids_foo, distances), AgentNotFound);
+}
+
+TEST(Globe, get_cell) {
+    mt19937 rng(8675309);
+
+    // Cell centers lie in their own cells, and the numbering is nested
+    for (unsigned int level = 0; level <= 4; level++)
+        for (uint32_t cell = 0; cell < (12u << (2 * level)); cell++) {
+            auto center = Globe::get_cell_center(cell, level);
+            EXPECT_EQ(Globe::get_cell(center, level), cell);
+            if (level > 0) {
+                EXPECT_EQ(Globe::get_cell(center, level - 1), cell >> 2);
+            }
+        }
+
+    // No point is farther from its cell's center than the cell radius
+    for (unsigned int level : {0u, 1u, 3u, 6u, 10u}) {
+        auto cell_radius = Globe::get_cell_radius(level);
+        for (auto i = 0; i < 20000; i++) {
+            auto coord = random_coord(rng);
+            auto cell = Globe::get_cell(coord, level);
+            EXPECT_LE(coord.distance(Globe::get_cell_center(cell, level)), cell_radius);
+            EXPECT_EQ(Globe::get_cell(coord, 0), cell >> (2 * level));
+        }
+    }
+
+    EXPECT_THROW(static_cast<void>(Globe::get_cell(GlobeCoord(0.0, 0.0), Globe::maximum_level + 1)), OptionInvalid);
+    EXPECT_THROW(static_cast<void>(Globe::get_cell_center(48, 1)), OptionInvalid);
+}
+
+TEST(Globe, equal_area) {
+    Globe globe_foo(1.0, 1);
+    mt19937 rng(8675309);
+    vector<int> counts(globe_foo.get_cell_count(), 0);
+    const auto samples = 480000;
+
+    for (auto i = 0; i < samples; i++)
+        counts[Globe::get_cell(random_coord(rng), 1)]++;
+    for (auto count : counts)
+        EXPECT_NEAR(count, samples / counts.size(), 500);
+}
+
+TEST(Globe, get_agents_in_radius) {
+    Globe globe_foo(Globe::earth_radius, 5);
+    vector<AgentID> agent_ids(5000);
+    mt19937 rng(8675309);
+
+    for (auto& agent_id : agent_ids)
+        static_cast<void>(globe_foo.add_agent(agent_id, random_coord(rng)));
+
+    vector<GlobeCoord> centers = {GlobeCoord(90.0, 0.0), GlobeCoord(-89.9, 45.0), GlobeCoord(0.0, 180.0),
+                                  GlobeCoord(10.0, -179.9), GlobeCoord(41.8, 2.2)};
+    for (auto i = 0; i < 20; i++)
+        centers.push_back(random_coord(rng));
+
+    for (auto radius : {0.0, 100.0, 800.0, 3000.0, 25000.0}) {
+        for (auto& center : centers) {
+            set<AgentID> expected;
+            for (auto& agent_id : agent_ids)
+                if (globe_foo.distance(center, globe_foo.get_location_by_agent(agent_id)) <= radius)
+                    expected.insert(agent_id);
+
+            auto found = globe_foo.get_agents_in_radius(center, radius);
+            EXPECT_EQ(found->size(), expected.size());
+            EXPECT_EQ(set<AgentID>(found->begin(), found->end()), expected);
+        }
+    }
+}
+
+TEST(Globe, rebuild_index) {
+    Globe globe_foo(1.0, 6);
+    Globe globe_bar(1.0, 6);
+    mt19937 rng(8675309);
+
+    for (auto i = 0; i < 50000; i++) {
+        const AgentID agent_id;
+        auto coord = random_coord(rng);
+        static_cast<void>(globe_foo.add_agent(agent_id, coord));
+        static_cast<void>(globe_bar.add_agent(agent_id, coord));
+    }
+
+    // A parallel rebuild orders agents the same as a serial one
+    Executor executor(3);
+    globe_foo.rebuild_index(&executor);
+    for (auto i = 0; i < 50; i++) {
+        auto center = random_coord(rng);
+        EXPECT_EQ(*globe_foo.get_agents_in_radius(center, 0.05), *globe_bar.get_agents_in_radius(center, 0.05));
+    }
+}
+
+TEST(Globe, for_each_agent_in_radius) {
+    Globe globe_foo;
+    const AgentID agent_id_foo, agent_id_bar;
+    auto count = 0;
+
+    static_cast<void>(globe_foo.add_agent(agent_id_foo, GlobeCoord(5.0, 5.0)));
+    static_cast<void>(globe_foo.add_agent(agent_id_bar, GlobeCoord(5.0, 5.5)));
+
+    EXPECT_FALSE(globe_foo.for_each_agent_in_radius(GlobeCoord(5.0, 5.0), 100.0, [&count](const AgentID) {
+        count++;
+        return false;
+    }));
+    EXPECT_EQ(count, 1);
+}
+
+int main(
+        int argc,
+        char** argv
+) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -23,12 +23,18 @@
  * SOFTWARE.
  */
 
+#include <memory>
+#include <vector>
+
+#include <kami/error.h>
 #include <kami/grid2d.h>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 using namespace kami;
+using namespace kami::error;
+using namespace std;
 
 class GridCoord2DTest
         : public ::testing::Test {
@@ -146,6 +152,35 @@ TEST_F(GridCoord2DTest, y) {
     EXPECT_FALSE(gridcoord2d_bar.y() == gridcoord2d_qu2.y());
 }
 
+TEST_F(GridCoord2DTest, distance) {
+    auto gridcoord2d_quux = make_shared<GridCoord2D>(3, -4);
+
+    EXPECT_DOUBLE_EQ(gridcoord2d_foo.distance(gridcoord2d_quux), 5.0);
+    EXPECT_DOUBLE_EQ(gridcoord2d_foo.distance(gridcoord2d_quux, GridDistanceType::Euclidean), 5.0);
+    EXPECT_DOUBLE_EQ(gridcoord2d_foo.distance(gridcoord2d_quux, GridDistanceType::Manhattan), 7.0);
+    EXPECT_DOUBLE_EQ(gridcoord2d_foo.distance(gridcoord2d_quux, GridDistanceType::Chebyshev), 4.0);
+    EXPECT_DOUBLE_EQ(gridcoord2d_qux.distance(GridCoord2D(0, 6), GridDistanceType::Manhattan), 5.0);
+
+    shared_ptr<Coord> coord_quux = gridcoord2d_quux;
+    EXPECT_DOUBLE_EQ(gridcoord2d_foo.distance(coord_quux), 5.0);
+}
+
+TEST_F(GridCoord2DTest, distance_batch) {
+    const vector<int> x = {3, -1, 0, 5, 1, -7, 2};
+    const vector<int> y = {-4, 1, 0, 5, -2, 3, 9};
+    vector<double> distances(x.size());
+
+    for (auto distance_type : {GridDistanceType::Euclidean, GridDistanceType::Manhattan,
+                               GridDistanceType::Chebyshev}) {
+        gridcoord2d_bar.distance(x, y, distances, distance_type);
+        for (size_t i = 0; i < x.size(); i++)
+            EXPECT_DOUBLE_EQ(distances[i], gridcoord2d_bar.distance(GridCoord2D(x[i], y[i]), distance_type));
+    }
+
+    const vector<int> y_short = {1, 2};
+    EXPECT_THROW(gridcoord2d_bar.distance(x, y_short, distances), OptionInvalid);
+}
+
 int main(
         int argc,
         char** argv
@@ -0,0 +1,100 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <memory>
+#include <unordered_set>
+
+#include <kami/grid3d.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace kami;
+using namespace std;
+
+class GridCoord3DTest
+        : public ::testing::Test {
+protected:
+    GridCoord3D gridcoord3d_foo = GridCoord3D(0, 0, 0);
+    GridCoord3D gridcoord3d_bar = GridCoord3D(1, 1, 1);
+    GridCoord3D gridcoord3d_baz = GridCoord3D(-1, -1, -1);
+    GridCoord3D gridcoord3d_qux = GridCoord3D(0, 0, 1);
+};
+
+TEST_F(GridCoord3DTest, DefaultConstructor) {
+    EXPECT_EQ(gridcoord3d_foo, gridcoord3d_foo);
+
+    EXPECT_NE(gridcoord3d_foo, gridcoord3d_bar);
+    EXPECT_NE(gridcoord3d_foo, gridcoord3d_baz);
+    EXPECT_NE(gridcoord3d_foo, gridcoord3d_qux);
+}
+
+TEST_F(GridCoord3DTest, to_string) {
+    EXPECT_THAT(gridcoord3d_foo.to_string(), "(0, 0, 0)");
+    EXPECT_THAT(gridcoord3d_baz.to_string(), "(-1, -1, -1)");
+    EXPECT_THAT(gridcoord3d_qux.to_string(), "(0, 0, 1)");
+}
+
+TEST_F(GridCoord3DTest, accessors) {
+    const GridCoord3D gridcoord3d_quux(2, 5, 7);
+
+    EXPECT_EQ(gridcoord3d_quux.x(), 2);
+    EXPECT_EQ(gridcoord3d_quux.y(), 5);
+    EXPECT_EQ(gridcoord3d_quux.z(), 7);
+}
+
+TEST_F(GridCoord3DTest, arithmetic) {
+    EXPECT_EQ(gridcoord3d_bar + gridcoord3d_qux, GridCoord3D(1, 1, 2));
+    EXPECT_EQ(gridcoord3d_bar - gridcoord3d_qux, GridCoord3D(1, 1, 0));
+    EXPECT_EQ(gridcoord3d_bar * 3.0, GridCoord3D(3, 3, 3));
+    EXPECT_EQ(2.0 * gridcoord3d_baz, GridCoord3D(-2, -2, -2));
+}
+
+TEST_F(GridCoord3DTest, distance) {
+    auto gridcoord3d_quux = make_shared<GridCoord3D>(3, -4, 12);
+
+    EXPECT_DOUBLE_EQ(gridcoord3d_foo.distance(gridcoord3d_quux), 13.0);
+    EXPECT_DOUBLE_EQ(gridcoord3d_foo.distance(gridcoord3d_quux, GridDistanceType::Euclidean), 13.0);
+    EXPECT_DOUBLE_EQ(gridcoord3d_foo.distance(gridcoord3d_quux, GridDistanceType::Manhattan), 19.0);
+    EXPECT_DOUBLE_EQ(gridcoord3d_foo.distance(gridcoord3d_quux, GridDistanceType::Chebyshev), 12.0);
+
+    shared_ptr<Coord> coord_quux = gridcoord3d_quux;
+    EXPECT_DOUBLE_EQ(gridcoord3d_foo.distance(coord_quux), 13.0);
+}
+
+TEST_F(GridCoord3DTest, hash) {
+    unordered_set<GridCoord3D> coords = {gridcoord3d_foo, gridcoord3d_bar, gridcoord3d_baz, gridcoord3d_foo};
+
+    EXPECT_EQ(coords.size(), 3);
+    EXPECT_EQ(coords.count(GridCoord3D(1, 1, 1)), 1);
+}
+
+int main(
+        int argc,
+        char** argv
+) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
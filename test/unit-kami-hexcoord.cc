@@ -0,0 +1,90 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <memory>
+
+#include <kami/hexgrid.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace kami;
+using namespace std;
+
+class HexCoordTest
+        : public ::testing::Test {
+protected:
+    HexCoord hexcoord_foo = HexCoord(0, 0);
+    HexCoord hexcoord_bar = HexCoord(1, 1);
+    HexCoord hexcoord_baz = HexCoord(-1, -1);
+    HexCoord hexcoord_qux = HexCoord(0, 1);
+};
+
+TEST_F(HexCoordTest, DefaultConstructor) {
+    EXPECT_EQ(hexcoord_foo, hexcoord_foo);
+
+    EXPECT_NE(hexcoord_foo, hexcoord_bar);
+    EXPECT_NE(hexcoord_foo, hexcoord_baz);
+    EXPECT_NE(hexcoord_foo, hexcoord_qux);
+}
+
+TEST_F(HexCoordTest, to_string) {
+    EXPECT_THAT(hexcoord_foo.to_string(), "(0, 0)");
+    EXPECT_THAT(hexcoord_baz.to_string(), "(-1, -1)");
+    EXPECT_THAT(hexcoord_qux.to_string(), "(0, 1)");
+}
+
+TEST_F(HexCoordTest, accessors) {
+    const HexCoord hexcoord_quux(2, 5);
+
+    EXPECT_EQ(hexcoord_quux.q(), 2);
+    EXPECT_EQ(hexcoord_quux.r(), 5);
+    EXPECT_EQ(hexcoord_quux.s(), -7);
+}
+
+TEST_F(HexCoordTest, arithmetic) {
+    EXPECT_EQ(hexcoord_bar + hexcoord_qux, HexCoord(1, 2));
+    EXPECT_EQ(hexcoord_bar - hexcoord_qux, HexCoord(1, 0));
+}
+
+TEST_F(HexCoordTest, distance) {
+    auto hexcoord_quux = make_shared<HexCoord>(3, -1);
+    shared_ptr<Coord> coord_quux = hexcoord_quux;
+
+    EXPECT_EQ(hexcoord_foo.distance(*hexcoord_quux), 3);
+    EXPECT_DOUBLE_EQ(hexcoord_foo.distance(coord_quux), 3.0);
+    EXPECT_EQ(hexcoord_foo.distance(hexcoord_bar), 2);
+    EXPECT_EQ(hexcoord_bar.distance(hexcoord_baz), 4);
+    for (auto& direction : HexCoord::directions)
+        EXPECT_EQ(hexcoord_foo.distance(direction), 1);
+}
+
+int main(
+        int argc,
+        char** argv
+) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,228 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <kami/agent.h>
+#include <kami/error.h>
+#include <kami/executor.h>
+#include <kami/island.h>
+#include <kami/population.h>
+#include <kami/sequential.h>
+
+#include <gtest/gtest.h>
+
+using namespace kami;
+using namespace kami::error;
+using namespace std;
+
+class TestAgent
+        : public Agent {
+public:
+    int steps = 0;
+
+    AgentID step(shared_ptr<Model> model) override {
+        steps++;
+        return get_agent_id();
+    }
+};
+
+class TestIsland
+        : public Island {
+public:
+    size_t index = 0;
+    size_t emigrants = 1;
+    bool stray = false;
+    bool unknown = false;
+    vector<AgentID> departures;
+    vector<AgentID> arrivals;
+
+    unique_ptr<vector<Migrant>> emigrate(size_t island_count) override {
+        auto migrants = make_unique<vector<Migrant>>();
+        auto agent_list = get_population()->get_agent_list();
+
+        for (size_t i = 0; i < emigrants && i < agent_list->size(); i++)
+            migrants->push_back({(*agent_list)[i], stray ? island_count : (index + 1) % island_count});
+        if (unknown)
+            migrants->push_back({AgentID(), (index + 1) % island_count});
+        return migrants;
+    }
+
+    AgentID depart(const shared_ptr<Agent>& agent) override {
+        // The agent is still in the population while it departs
+        static_cast<void>(get_population()->get_agent_by_id(agent->get_agent_id()));
+        departures.push_back(agent->get_agent_id());
+        return agent->get_agent_id();
+    }
+
+    AgentID immigrate(const shared_ptr<Agent>& agent) override {
+        arrivals.push_back(agent->get_agent_id());
+        return agent->get_agent_id();
+    }
+};
+
+class ArchipelagoTest
+        : public ::testing::Test {
+protected:
+    shared_ptr<Archipelago> archipelago_foo = make_shared<Archipelago>(make_shared<Executor>(3));
+    vector<shared_ptr<TestIsland>> islands;
+    vector<shared_ptr<TestAgent>> agents;
+
+    void SetUp() override {
+        for (size_t i = 0; i < 4; i++) {
+            auto island = make_shared<TestIsland>();
+            auto population = make_shared<Population>();
+
+            island->set_population(population);
+            island->set_scheduler(make_shared<SequentialScheduler>());
+            for (auto j = 0; j < 5; j++) {
+                auto agent = make_shared<TestAgent>();
+                population->add_agent(agent);
+                agents.push_back(agent);
+            }
+
+            island->index = archipelago_foo->add_island(island);
+            islands.push_back(island);
+        }
+    }
+};
+
+TEST(Archipelago, DefaultConstructor) {
+    // There is really no way this can go wrong, but
+    // we add this check anyway in case of future
+    // changes.
+    EXPECT_NO_THROW(
+            const Archipelago archipelago_foo
+    );
+}
+
+TEST_F(ArchipelagoTest, add_island) {
+    EXPECT_EQ(archipelago_foo->get_island_count(), 4);
+    EXPECT_EQ(archipelago_foo->get_island(2), islands[2]);
+    EXPECT_THROW(auto island_nul = archipelago_foo->get_island(4), ResourceNotAvailable);
+    EXPECT_THROW(archipelago_foo->add_island(nullptr), ResourceNotAvailable);
+
+    // Every island shares the archipelago's executor
+    for (auto& island : islands)
+        EXPECT_EQ(island->get_executor(), archipelago_foo->get_executor());
+}
+
+TEST_F(ArchipelagoTest, step) {
+    for (auto i = 0; i < 3; i++)
+        archipelago_foo->step();
+
+    EXPECT_EQ(archipelago_foo->get_step_id(), 3);
+    for (auto& agent : agents)
+        EXPECT_EQ(agent->steps, 3);
+
+    // No migration by default
+    for (auto& island : islands)
+        EXPECT_TRUE(island->arrivals.empty());
+}
+
+TEST_F(ArchipelagoTest, migrate) {
+    auto moved = islands[0]->get_population()->get_agent_list()->front();
+
+    EXPECT_EQ(archipelago_foo->migrate(), 4);
+    for (auto& island : islands) {
+        EXPECT_EQ(island->get_population()->get_agent_list()->size(), 5);
+        EXPECT_EQ(island->arrivals.size(), 1);
+    }
+
+    EXPECT_THROW(auto agent_nul = islands[0]->get_population()->get_agent_by_id(moved), AgentNotFound);
+    EXPECT_NO_THROW(auto agent_foo = islands[1]->get_population()->get_agent_by_id(moved));
+    EXPECT_EQ(islands[0]->departures, vector<AgentID>({moved}));
+    EXPECT_EQ(islands[1]->arrivals.front(), moved);
+}
+
+TEST_F(ArchipelagoTest, migrate_order) {
+    // Everything lands on one island, in island order
+    for (auto& island : islands) {
+        island->index = 2;
+        island->emigrants = 2;
+    }
+
+    EXPECT_EQ(archipelago_foo->migrate(), 8);
+    EXPECT_EQ(islands[3]->arrivals.size(), 8);
+    for (size_t i = 0; i < 8; i++)
+        EXPECT_EQ(islands[3]->arrivals[i], agents[(i / 2) * 5 + i % 2]->get_agent_id());
+    EXPECT_EQ(islands[3]->get_population()->get_agent_list()->size(), 11);
+}
+
+TEST_F(ArchipelagoTest, migrate_invalid) {
+    auto populations_unchanged = [this]() {
+        for (size_t i = 0; i < islands.size(); i++) {
+            EXPECT_EQ(islands[i]->get_population()->get_agent_list()->size(), 5);
+            EXPECT_TRUE(islands[i]->departures.empty());
+            EXPECT_TRUE(islands[i]->arrivals.empty());
+            for (size_t j = 0; j < 5; j++)
+                EXPECT_NO_THROW(auto agent_foo = islands[i]->get_population()->get_agent_by_id(
+                        agents[i * 5 + j]->get_agent_id()));
+        }
+    };
+
+    // The last island's stray migrant is found after the other islands
+    // have chosen theirs, and no agent may leave its domain or population
+    islands[3]->stray = true;
+    EXPECT_THROW(archipelago_foo->migrate(), OptionInvalid);
+    populations_unchanged();
+
+    islands[3]->stray = false;
+    islands[3]->unknown = true;
+    EXPECT_THROW(archipelago_foo->migrate(), AgentNotFound);
+    populations_unchanged();
+
+    islands[3]->unknown = false;
+    EXPECT_EQ(archipelago_foo->migrate(), 4);
+}
+
+TEST_F(ArchipelagoTest, set_migration_interval) {
+    EXPECT_EQ(archipelago_foo->get_migration_interval(), 0);
+    EXPECT_EQ(archipelago_foo->set_migration_interval(2), 2);
+    EXPECT_EQ(archipelago_foo->get_migration_interval(), 2);
+
+    archipelago_foo->step();
+    for (auto& island : islands)
+        EXPECT_TRUE(island->arrivals.empty());
+
+    archipelago_foo->step();
+    for (auto& island : islands)
+        EXPECT_EQ(island->arrivals.size(), 1);
+
+    archipelago_foo->step();
+    archipelago_foo->step();
+    for (auto& island : islands)
+        EXPECT_EQ(island->arrivals.size(), 2);
+}
+
+int main(
+        int argc,
+        char** argv
+) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,201 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <kami/agent.h>
+#include <kami/continuous2d.h>
+#include <kami/error.h>
+#include <kami/executor.h>
+#include <kami/kdtree2d.h>
+
+#include <gtest/gtest.h>
+
+using namespace kami;
+using namespace kami::error;
+using namespace std;
+
+namespace {
+
+    // Brute-force nearest distances, for checking the tree
+    vector<double> nearest_distances(
+            const ContinuousSpace2D& space,
+            const vector<AgentID>& agent_ids,
+            const ContinuousCoord2D& coord,
+            size_t k,
+            AgentID exclude
+    ) {
+        vector<double> distances;
+        for (auto& agent_id : agent_ids)
+            if (agent_id != exclude)
+                distances.push_back(space.distance(coord, space.get_location_by_agent(agent_id)));
+        sort(distances.begin(), distances.end());
+        distances.resize(min(k, distances.size()));
+        return distances;
+    }
+
+}  // namespace
+
+TEST(KDTree2D, DefaultConstructor) {
+    const KDTree2D kdtree2d_foo;
+
+    EXPECT_EQ(kdtree2d_foo.size(), 0);
+    EXPECT_TRUE(kdtree2d_foo.get_nearest(ContinuousCoord2D(0.0, 0.0), 3)->empty());
+    EXPECT_TRUE(kdtree2d_foo.get_agents_in_radius(ContinuousCoord2D(0.0, 0.0), 3.0)->empty());
+}
+
+TEST(KDTree2D, build) {
+    KDTree2D kdtree2d_foo;
+    const vector<AgentID> agent_ids(3);
+    const vector<double> x = {0.0, 1.0, 5.0}, y = {0.0, 1.0, 5.0};
+
+    kdtree2d_foo.build(agent_ids, x, y);
+    EXPECT_EQ(kdtree2d_foo.size(), 3);
+    EXPECT_EQ(set<AgentID>(kdtree2d_foo.get_agent_ids().begin(), kdtree2d_foo.get_agent_ids().end()),
+              set<AgentID>(agent_ids.begin(), agent_ids.end()));
+    EXPECT_EQ(*kdtree2d_foo.get_nearest(ContinuousCoord2D(4.0, 4.0), 2), vector<AgentID>({agent_ids[2], agent_ids[1]}));
+    EXPECT_THROW(kdtree2d_foo.build(agent_ids, x, vector<double>(2)), OptionInvalid);
+}
+
+TEST(KDTree2D, get_agents_in_radius) {
+    for (auto wrap : {false, true}) {
+        ContinuousSpace2D continuous2d_foo(20.0, 15.0, 1.0, wrap, wrap);
+        vector<AgentID> agent_ids(3000);
+        mt19937 rng(8675309);
+        normal_distribution<double> dist(5.0, 2.0);
+
+        // Crowd the agents into a corner, where uniform bins do poorly
+        for (auto& agent_id : agent_ids)
+            static_cast<void>(continuous2d_foo.add_agent(
+                    agent_id, ContinuousCoord2D(clamp(dist(rng), 0.0, 19.9), clamp(dist(rng), 0.0, 14.9))));
+
+        Executor executor(3);
+        KDTree2D kdtree2d_foo;
+        kdtree2d_foo.build(continuous2d_foo, &executor);
+
+        for (auto radius : {0.25, 1.0, 6.0, 40.0}) {
+            for (auto i = 0; i < 20; i++) {
+                const ContinuousCoord2D center(clamp(dist(rng), 0.0, 19.9), clamp(dist(rng), 0.0, 14.9));
+                auto expected = continuous2d_foo.get_agents_in_radius(center, radius);
+                auto found = kdtree2d_foo.get_agents_in_radius(center, radius);
+
+                EXPECT_EQ(set<AgentID>(found->begin(), found->end()), set<AgentID>(expected->begin(), expected->end()));
+                EXPECT_EQ(found->size(), expected->size());
+            }
+        }
+    }
+}
+
+TEST(KDTree2D, nearest) {
+    for (auto wrap : {false, true}) {
+        ContinuousSpace2D continuous2d_foo(20.0, 15.0, 1.0, wrap, wrap);
+        vector<AgentID> agent_ids(2000);
+        mt19937 rng(8675309);
+        uniform_real_distribution<double> x_dist(0.0, 20.0), y_dist(0.0, 15.0);
+
+        for (auto& agent_id : agent_ids)
+            static_cast<void>(continuous2d_foo.add_agent(agent_id, ContinuousCoord2D(x_dist(rng), y_dist(rng))));
+
+        KDTree2D kdtree2d_foo;
+        kdtree2d_foo.build(continuous2d_foo);
+
+        vector<AgentID> found_ids(8);
+        vector<double> found_distances(8);
+        for (auto i = 0; i < 50; i++) {
+            const ContinuousCoord2D center(x_dist(rng), y_dist(rng));
+            auto exclude = agent_ids[static_cast<size_t>(i)];
+            auto count = kdtree2d_foo.nearest(center, 8, found_ids, found_distances, exclude);
+
+            ASSERT_EQ(count, 8);
+            auto expected = nearest_distances(continuous2d_foo, agent_ids, center, 8, exclude);
+            for (size_t j = 0; j < count; j++) {
+                EXPECT_DOUBLE_EQ(found_distances[j], expected[j]);
+                EXPECT_NE(found_ids[j], exclude);
+                EXPECT_NEAR(continuous2d_foo.distance(center, continuous2d_foo.get_location_by_agent(found_ids[j])),
+                            found_distances[j], 1e-12);
+            }
+        }
+
+        EXPECT_THROW(static_cast<void>(kdtree2d_foo.nearest(ContinuousCoord2D(0.0, 0.0), 9, found_ids,
+                                                            found_distances)), OptionInvalid);
+    }
+}
+
+TEST(KDTree2D, nearest_all) {
+    ContinuousSpace2D continuous2d_foo(100.0, 100.0, 1.0, true, true);
+    vector<AgentID> agent_ids(20000);
+    mt19937 rng(8675309);
+    uniform_real_distribution<double> dist(0.0, 100.0);
+
+    for (auto& agent_id : agent_ids)
+        static_cast<void>(continuous2d_foo.add_agent(agent_id, ContinuousCoord2D(dist(rng), dist(rng))));
+
+    Executor executor(3);
+    KDTree2D kdtree2d_foo, kdtree2d_bar;
+    kdtree2d_foo.build(continuous2d_foo, &executor);
+    kdtree2d_bar.build(continuous2d_foo);
+
+    // A parallel build gives the same tree as a serial one
+    EXPECT_TRUE(equal(kdtree2d_foo.get_agent_ids().begin(), kdtree2d_foo.get_agent_ids().end(),
+                      kdtree2d_bar.get_agent_ids().begin()));
+
+    const size_t k = 4;
+    vector<AgentID> found_ids(agent_ids.size() * k);
+    vector<double> found_distances(agent_ids.size() * k);
+    kdtree2d_foo.nearest_all(k, found_ids, found_distances, &executor);
+
+    auto tree_ids = kdtree2d_foo.get_agent_ids();
+    for (size_t i = 0; i < tree_ids.size(); i += 997) {
+        auto expected = nearest_distances(continuous2d_foo, agent_ids,
+                                          continuous2d_foo.get_location_by_agent(tree_ids[i]), k, tree_ids[i]);
+        for (size_t j = 0; j < k; j++)
+            EXPECT_DOUBLE_EQ(found_distances[i * k + j], expected[j]);
+    }
+
+    // Rows are padded when there are too few other agents
+    KDTree2D kdtree2d_baz;
+    const vector<AgentID> few_ids(2);
+    kdtree2d_baz.build(few_ids, vector<double>({0.0, 3.0}), vector<double>({0.0, 4.0}));
+    vector<AgentID> few_found(2 * k);
+    vector<double> few_distances(2 * k);
+    kdtree2d_baz.nearest_all(k, few_found, few_distances);
+    EXPECT_DOUBLE_EQ(few_distances[0], 5.0);
+    EXPECT_EQ(few_found[1], AgentID::null());
+    EXPECT_EQ(few_distances[1], numeric_limits<double>::infinity());
+}
+
+int main(
+        int argc,
+        char** argv
+) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
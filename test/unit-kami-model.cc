@@ -27,6 +27,7 @@
 
 #include <kami/agent.h>
 #include <kami/error.h>
+#include <kami/executor.h>
 #include <kami/model.h>
 #include <kami/multigrid2d.h>
 #include <kami/population.h>
@@ -129,6 +130,29 @@ TEST(Model, get_domain) {
     EXPECT_EQ(grid2_bar, grid2_baz);
 }
 
+TEST(Model, set_executor) {
+    auto model_foo = make_shared<TestModel>();
+    auto executor_foo = make_shared<Executor>(1);
+
+    auto executor_bar = model_foo->set_executor(executor_foo);
+    EXPECT_EQ(executor_foo, executor_bar);
+}
+
+TEST(Model, get_executor) {
+    auto model_foo = make_shared<TestModel>();
+    auto executor_foo = make_shared<Executor>(1);
+
+    auto executor_nul = model_foo->get_executor();
+    EXPECT_TRUE(executor_nul);
+    EXPECT_EQ(executor_nul, model_foo->get_executor());
+
+    auto executor_bar = model_foo->set_executor(executor_foo);
+    auto executor_baz = model_foo->get_executor();
+
+    EXPECT_EQ(executor_foo, executor_baz);
+    EXPECT_EQ(executor_bar, executor_baz);
+}
+
 int main(
         int argc,
         char** argv
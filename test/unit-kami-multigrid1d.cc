@@ -25,6 +25,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <random>
 #include <set>
 #include <unordered_set>
 
@@ -399,6 +400,89 @@ TEST(MultiGrid1D, get_neighborhood) {
     }
 }
 
+TEST(MultiGrid1D, for_each_agent_in_neighborhood) {
+    const AgentID agent_id_foo, agent_id_bar, agent_id_baz, agent_id_qux;
+    MultiGrid1D multigrid1d_foo(10, true);
+
+    static_cast<void>(multigrid1d_foo.add_agent(agent_id_foo, GridCoord1D(0)));
+    static_cast<void>(multigrid1d_foo.add_agent(agent_id_bar, GridCoord1D(1)));
+    static_cast<void>(multigrid1d_foo.add_agent(agent_id_baz, GridCoord1D(1)));
+    static_cast<void>(multigrid1d_foo.add_agent(agent_id_qux, GridCoord1D(4)));
+
+    {
+        set<AgentID> rval;
+
+        EXPECT_TRUE(multigrid1d_foo.for_each_agent_in_neighborhood(GridCoord1D(0), false, 1,
+                                                                   [&rval](const AgentID agent_id) {
+                                                                       rval.insert(agent_id);
+                                                                   }));
+        EXPECT_EQ(rval, set<AgentID>({agent_id_bar, agent_id_baz}));
+    }
+    {
+        set<AgentID> rval;
+
+        multigrid1d_foo.for_each_agent_in_neighborhood(GridCoord1D(9), true, 5,
+                                                       [&agent_id_bar](const AgentID agent_id) {
+                                                           return agent_id != agent_id_bar;
+                                                       },
+                                                       [&rval](const AgentID agent_id) {
+                                                           rval.insert(agent_id);
+                                                       });
+        EXPECT_EQ(rval, set<AgentID>({agent_id_foo, agent_id_baz, agent_id_qux}));
+    }
+    {
+        auto count = 0;
+
+        EXPECT_FALSE(multigrid1d_foo.for_each_agent_in_neighborhood(GridCoord1D(2), true, 3,
+                                                                    [&count](const AgentID agent_id) {
+                                                                        return ++count < 2;
+                                                                    }));
+        EXPECT_EQ(count, 2);
+    }
+}
+
+TEST(MultiGrid1D, random_neighbor_cell) {
+    mt19937 rng(42);
+
+    {
+        MultiGrid1D multigrid1d_foo(10, false);
+        unordered_set<GridCoord1D> rval;
+
+        for (auto i = 0; i < 100; i++)
+            rval.insert(multigrid1d_foo.random_neighbor_cell(GridCoord1D(0), false, rng).value());
+        EXPECT_EQ(rval, unordered_set<GridCoord1D>({GridCoord1D(1)}));
+    }
+    {
+        MultiGrid1D multigrid1d_foo(10, true);
+        unordered_set<GridCoord1D> rval;
+
+        for (auto i = 0; i < 500; i++)
+            rval.insert(multigrid1d_foo.random_neighbor_cell(GridCoord1D(5), false, 3, rng).value());
+        EXPECT_EQ(rval, unordered_set<GridCoord1D>({GridCoord1D(2), GridCoord1D(3), GridCoord1D(4), GridCoord1D(6),
+                                                    GridCoord1D(7), GridCoord1D(8)}));
+    }
+}
+
+TEST(MultiGrid1D, random_agent_at) {
+    const AgentID agent_id_foo, agent_id_bar, agent_id_baz;
+    mt19937 rng(42);
+    MultiGrid1D multigrid1d_foo(10, true);
+
+    EXPECT_FALSE(multigrid1d_foo.random_agent_at(GridCoord1D(2), rng));
+
+    static_cast<void>(multigrid1d_foo.add_agent(agent_id_foo, GridCoord1D(2)));
+    EXPECT_EQ(multigrid1d_foo.random_agent_at(GridCoord1D(2), rng), agent_id_foo);
+    EXPECT_FALSE(multigrid1d_foo.random_other_agent_at(GridCoord1D(2), agent_id_foo, rng));
+
+    static_cast<void>(multigrid1d_foo.add_agent(agent_id_bar, GridCoord1D(2)));
+    static_cast<void>(multigrid1d_foo.add_agent(agent_id_baz, GridCoord1D(2)));
+
+    set<AgentID> oval;
+    for (auto i = 0; i < 200; i++)
+        oval.insert(multigrid1d_foo.random_other_agent_at(GridCoord1D(2), agent_id_bar, rng).value());
+    EXPECT_EQ(oval, set<AgentID>({agent_id_foo, agent_id_baz}));
+}
+
 TEST(MultiGrid1D, get_location_by_agent) {
     const AgentID agent_id_foo, agent_id_bar;
     const GridCoord1D coord2(2), coord3(3);
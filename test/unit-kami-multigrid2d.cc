@@ -25,8 +25,10 @@
 
 #include <algorithm>
 #include <iterator>
+#include <random>
 #include <set>
 #include <unordered_set>
+#include <vector>
 
 #include <kami/agent.h>
 #include <kami/error.h>
@@ -62,8 +64,10 @@ TEST(MultiGrid2D, add_agent) {
         EXPECT_EQ(agent_id_baz, agent_id_bar);
     }
     {
-        auto agent_id_baz = multigrid2d_foo.add_agent(agent_id_bar, coord3);
-        EXPECT_EQ(agent_id_baz, agent_id_bar);
+        EXPECT_THROW(auto agent_id_baz = multigrid2d_foo.add_agent(agent_id_bar, coord3), OptionInvalid);
+        EXPECT_THROW(auto agent_id_baz = multigrid2d_foo.add_agent(agent_id_bar, coord2), OptionInvalid);
+        EXPECT_EQ(multigrid2d_foo.get_location_by_agent(agent_id_bar), coord2);
+        EXPECT_EQ(multigrid2d_foo.get_location_contents(coord2)->size(), 2);
     }
 }
 
@@ -218,6 +222,154 @@ TEST(MultiGrid2D, move_agent) {
     }
 }
 
+TEST(MultiGrid2D, move_agents) {
+    const AgentID agent_id_foo, agent_id_bar, agent_id_baz;
+    const GridCoord2D coord2(2, 5), coord3(3, 7);
+    MultiGrid2D multigrid2d_foo(10, 10, true, true);
+
+    static_cast<void>(multigrid2d_foo.add_agent(agent_id_foo, coord2));
+    static_cast<void>(multigrid2d_foo.add_agent(agent_id_bar, coord2));
+
+    auto moved = multigrid2d_foo.move_agents({{agent_id_foo, coord3}, {agent_id_bar, coord3}});
+    EXPECT_EQ(*moved, vector<AgentID>({agent_id_foo, agent_id_bar}));
+    EXPECT_EQ(*multigrid2d_foo.get_location_contents(coord3), set<AgentID>({agent_id_foo, agent_id_bar}));
+
+    EXPECT_THROW(auto moved_nul = multigrid2d_foo.move_agents({{agent_id_foo, coord2}, {agent_id_baz, coord2}}),
+                 AgentNotFound);
+    EXPECT_TRUE(multigrid2d_foo.is_location_empty(coord2));
+}
+
+TEST(MultiGrid2D, get_location_contents) {
+    const AgentID agent_id_foo, agent_id_bar, agent_id_baz, agent_id_qux;
+    const GridCoord2D coord2(2, 5), coord3(3, 7);
+
+    MultiGrid2D multigrid2d_foo(10, 10, true, true);
+
+    // Enough agents to spill from inline storage
+    for (auto& agent_id : {agent_id_foo, agent_id_bar, agent_id_baz, agent_id_qux})
+        static_cast<void>(multigrid2d_foo.add_agent(agent_id, coord2));
+    EXPECT_EQ(*multigrid2d_foo.get_location_contents(coord2),
+              set<AgentID>({agent_id_foo, agent_id_bar, agent_id_baz, agent_id_qux}));
+    EXPECT_TRUE(multigrid2d_foo.get_location_contents(coord3)->empty());
+    EXPECT_THROW(auto contents = multigrid2d_foo.get_location_contents(GridCoord2D(10, 5)), LocationUnavailable);
+
+    static_cast<void>(multigrid2d_foo.delete_agent(agent_id_bar));
+    static_cast<void>(multigrid2d_foo.move_agent(agent_id_foo, coord3));
+
+    auto view = multigrid2d_foo.get_location_view(coord2);
+    EXPECT_EQ(set<AgentID>(view.begin(), view.end()), set<AgentID>({agent_id_baz, agent_id_qux}));
+    view = multigrid2d_foo.get_location_view(coord3);
+    EXPECT_EQ(set<AgentID>(view.begin(), view.end()), set<AgentID>({agent_id_foo}));
+
+    // Slots stay consistent after swap-removal
+    static_cast<void>(multigrid2d_foo.delete_agent(agent_id_qux, coord2));
+    static_cast<void>(multigrid2d_foo.delete_agent(agent_id_baz, coord2));
+    EXPECT_TRUE(multigrid2d_foo.is_location_empty(coord2));
+    EXPECT_THROW(static_cast<void>(multigrid2d_foo.delete_agent(agent_id_foo, coord2)), AgentNotFound);
+}
+
+TEST(MultiGrid2D, for_each_agent_in_neighborhood) {
+    const AgentID agent_id_foo, agent_id_bar, agent_id_baz, agent_id_qux;
+    MultiGrid2D multigrid2d_foo(10, 10, true, true);
+
+    static_cast<void>(multigrid2d_foo.add_agent(agent_id_foo, GridCoord2D(0, 0)));
+    static_cast<void>(multigrid2d_foo.add_agent(agent_id_bar, GridCoord2D(9, 9)));
+    static_cast<void>(multigrid2d_foo.add_agent(agent_id_baz, GridCoord2D(9, 9)));
+    static_cast<void>(multigrid2d_foo.add_agent(agent_id_qux, GridCoord2D(2, 0)));
+
+    {
+        set<AgentID> rval;
+
+        EXPECT_TRUE(multigrid2d_foo.for_each_agent_in_neighborhood(
+                GridCoord2D(0, 0), false, GridNeighborhoodType::Moore, 1, [&rval](const AgentID agent_id) {
+                    rval.insert(agent_id);
+                }));
+        EXPECT_EQ(rval, set<AgentID>({agent_id_bar, agent_id_baz}));
+    }
+    {
+        set<AgentID> rval;
+
+        multigrid2d_foo.for_each_agent_in_neighborhood(
+                GridCoord2D(0, 0), true, GridNeighborhoodType::Euclidean, 2,
+                [&agent_id_baz](const AgentID agent_id) {
+                    return agent_id != agent_id_baz;
+                },
+                [&rval](const AgentID agent_id) {
+                    rval.insert(agent_id);
+                });
+        EXPECT_EQ(rval, set<AgentID>({agent_id_foo, agent_id_bar, agent_id_qux}));
+    }
+    {
+        auto count = 0;
+
+        EXPECT_FALSE(multigrid2d_foo.for_each_agent_in_neighborhood(
+                GridCoord2D(0, 0), true, GridNeighborhoodType::Moore, 3, [&count](const AgentID agent_id) {
+                    return ++count < 3;
+                }));
+        EXPECT_EQ(count, 3);
+    }
+}
+
+TEST(MultiGrid2D, random_neighbor_cell) {
+    mt19937 rng(42);
+
+    {
+        // Interior and edge cells each see every neighbor, and only those
+        MultiGrid2D multigrid2d_foo(10, 10, false, false);
+
+        for (auto& coord : {GridCoord2D(5, 5), GridCoord2D(0, 0), GridCoord2D(9, 4)}) {
+            auto tval = *multigrid2d_foo.get_neighborhood(coord, false, GridNeighborhoodType::Moore);
+            unordered_set<GridCoord2D> rval;
+
+            for (auto i = 0; i < 500; i++) {
+                auto cell = multigrid2d_foo.random_neighbor_cell(coord, false, GridNeighborhoodType::Moore, rng);
+                ASSERT_TRUE(cell);
+                rval.insert(cell.value());
+            }
+            EXPECT_EQ(rval, tval);
+        }
+    }
+    {
+        MultiGrid2D multigrid2d_foo(10, 10, true, true);
+        unordered_set<GridCoord2D> rval;
+
+        for (auto i = 0; i < 2000; i++)
+            rval.insert(multigrid2d_foo.random_neighbor_cell(GridCoord2D(0, 0), true, GridNeighborhoodType::Euclidean,
+                                                             2, rng).value());
+        EXPECT_EQ(rval.size(), 13);
+    }
+    {
+        MultiGrid2D multigrid2d_foo(1, 1, false, false);
+        EXPECT_FALSE(multigrid2d_foo.random_neighbor_cell(GridCoord2D(0, 0), false, GridNeighborhoodType::Moore, rng));
+    }
+}
+
+TEST(MultiGrid2D, random_agent_at) {
+    const AgentID agent_id_foo, agent_id_bar, agent_id_baz;
+    const GridCoord2D coord2(2, 5), coord3(3, 7);
+    mt19937 rng(42);
+    MultiGrid2D multigrid2d_foo(10, 10, true, true);
+
+    EXPECT_FALSE(multigrid2d_foo.random_agent_at(coord2, rng));
+    EXPECT_THROW(auto agent_id = multigrid2d_foo.random_agent_at(GridCoord2D(10, 5), rng), LocationInvalid);
+
+    static_cast<void>(multigrid2d_foo.add_agent(agent_id_foo, coord2));
+    EXPECT_EQ(multigrid2d_foo.random_agent_at(coord2, rng), agent_id_foo);
+    EXPECT_FALSE(multigrid2d_foo.random_other_agent_at(coord2, agent_id_foo, rng));
+    EXPECT_FALSE(multigrid2d_foo.random_other_agent_at(coord3, agent_id_foo, rng));
+
+    static_cast<void>(multigrid2d_foo.add_agent(agent_id_bar, coord2));
+    static_cast<void>(multigrid2d_foo.add_agent(agent_id_baz, coord2));
+
+    set<AgentID> rval, oval;
+    for (auto i = 0; i < 200; i++) {
+        rval.insert(multigrid2d_foo.random_agent_at(coord2, rng).value());
+        oval.insert(multigrid2d_foo.random_other_agent_at(coord2, agent_id_bar, rng).value());
+    }
+    EXPECT_EQ(rval, set<AgentID>({agent_id_foo, agent_id_bar, agent_id_baz}));
+    EXPECT_EQ(oval, set<AgentID>({agent_id_foo, agent_id_baz}));
+}
+
 TEST(MultiGrid2D, get_neighborhood_VonNeumann) {
     const AgentID agent_id_foo, agent_id_bar;
     const GridCoord2D coord0(0, 0), coord1(1, 1), coord2(2, 5), coord3(3, 7), coord9(9, 4);
@@ -0,0 +1,137 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <set>
+#include <vector>
+
+#include <kami/agent.h>
+#include <kami/error.h>
+#include <kami/multigrid3d.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace kami;
+using namespace kami::error;
+using namespace std;
+
+TEST(MultiGrid3D, DefaultConstructor) {
+    EXPECT_NO_THROW(
+            MultiGrid3D multigrid3d_foo(10, 10, 10, true, true, true);
+    );
+}
+
+TEST(MultiGrid3D, add_agent) {
+    MultiGrid3D multigrid3d_foo(10, 10, 10, true, true, true);
+    const AgentID agent_id_foo, agent_id_bar;
+    const GridCoord3D coord2(2, 5, 7);
+
+    EXPECT_EQ(multigrid3d_foo.add_agent(agent_id_foo, coord2), agent_id_foo);
+    EXPECT_EQ(multigrid3d_foo.add_agent(agent_id_bar, coord2), agent_id_bar);
+    EXPECT_THROW(auto agent_id_baz = multigrid3d_foo.add_agent(agent_id_bar, GridCoord3D(-1, 0, 0)),
+                 LocationInvalid);
+    EXPECT_EQ(*multigrid3d_foo.get_location_contents(coord2), set<AgentID>({agent_id_foo, agent_id_bar}));
+
+    // An agent already on the grid is not placed a second time
+    EXPECT_THROW(auto agent_id_baz = multigrid3d_foo.add_agent(agent_id_bar, GridCoord3D(1, 1, 1)), OptionInvalid);
+    EXPECT_THROW(auto agent_id_baz = multigrid3d_foo.add_agent(agent_id_bar, coord2), OptionInvalid);
+    EXPECT_TRUE(multigrid3d_foo.is_location_empty(GridCoord3D(1, 1, 1)));
+    EXPECT_EQ(multigrid3d_foo.get_location_contents(coord2)->size(), 2);
+}
+
+TEST(MultiGrid3D, delete_agent) {
+    MultiGrid3D multigrid3d_foo(10, 10, 10, true, true, true);
+    const AgentID agent_id_foo, agent_id_bar;
+    const GridCoord3D coord2(2, 5, 7), coord3(3, 7, 9);
+
+    static_cast<void>(multigrid3d_foo.add_agent(agent_id_foo, coord2));
+    static_cast<void>(multigrid3d_foo.add_agent(agent_id_bar, coord2));
+
+    EXPECT_THROW(auto agent_id_baz = multigrid3d_foo.delete_agent(agent_id_foo, coord3), AgentNotFound);
+    EXPECT_EQ(multigrid3d_foo.delete_agent(agent_id_foo), agent_id_foo);
+    EXPECT_EQ(*multigrid3d_foo.get_location_contents(coord2), set<AgentID>({agent_id_bar}));
+    EXPECT_EQ(multigrid3d_foo.delete_agent(agent_id_bar, coord2), agent_id_bar);
+    EXPECT_TRUE(multigrid3d_foo.is_location_empty(coord2));
+}
+
+TEST(MultiGrid3D, move_agent) {
+    MultiGrid3D multigrid3d_foo(10, 10, 10, true, true, true);
+    const AgentID agent_id_foo, agent_id_bar;
+    const GridCoord3D coord2(2, 5, 7), coord3(3, 7, 9);
+
+    static_cast<void>(multigrid3d_foo.add_agent(agent_id_foo, coord2));
+    static_cast<void>(multigrid3d_foo.add_agent(agent_id_bar, coord3));
+
+    EXPECT_EQ(multigrid3d_foo.move_agent(agent_id_foo, coord3), agent_id_foo);
+    EXPECT_EQ(multigrid3d_foo.get_location_by_agent(agent_id_foo), coord3);
+    EXPECT_TRUE(multigrid3d_foo.is_location_empty(coord2));
+    EXPECT_EQ(*multigrid3d_foo.get_location_contents(coord3), set<AgentID>({agent_id_foo, agent_id_bar}));
+
+    EXPECT_THROW(auto agent_id_baz = multigrid3d_foo.move_agent(agent_id_foo, GridCoord3D(10, 0, 0)),
+                 LocationInvalid);
+    EXPECT_EQ(multigrid3d_foo.get_location_by_agent(agent_id_foo), coord3);
+}
+
+TEST(MultiGrid3D, for_each_agent_in_neighborhood) {
+    MultiGrid3D multigrid3d_foo(10, 10, 10, false, false, false);
+    const AgentID agent_id_foo, agent_id_bar, agent_id_baz, agent_id_qux;
+    const GridCoord3D coord(5, 5, 5);
+
+    static_cast<void>(multigrid3d_foo.add_agent(agent_id_foo, coord));
+    static_cast<void>(multigrid3d_foo.add_agent(agent_id_bar, GridCoord3D(5, 5, 6)));
+    static_cast<void>(multigrid3d_foo.add_agent(agent_id_baz, GridCoord3D(5, 6, 6)));
+    static_cast<void>(multigrid3d_foo.add_agent(agent_id_qux, GridCoord3D(6, 6, 6)));
+
+    auto collect = [&](GridNeighborhoodType neighborhood_type) {
+        set<AgentID> agent_ids;
+        multigrid3d_foo.for_each_agent_in_neighborhood(coord, false, neighborhood_type, 1,
+                                                       [&agent_ids](const AgentID agent_id) {
+                                                           agent_ids.insert(agent_id);
+                                                       });
+        return agent_ids;
+    };
+
+    EXPECT_EQ(collect(GridNeighborhoodType::VonNeumann), set<AgentID>({agent_id_bar}));
+    EXPECT_EQ(collect(GridNeighborhoodType::Edge), set<AgentID>({agent_id_bar, agent_id_baz}));
+    EXPECT_EQ(collect(GridNeighborhoodType::Moore), set<AgentID>({agent_id_bar, agent_id_baz, agent_id_qux}));
+
+    set<AgentID> agent_ids;
+    multigrid3d_foo.for_each_agent_in_neighborhood(coord, true, GridNeighborhoodType::Moore, 1,
+                                                   [&agent_id_baz](const AgentID agent_id) {
+                                                       return agent_id != agent_id_baz;
+                                                   },
+                                                   [&agent_ids](const AgentID agent_id) {
+                                                       agent_ids.insert(agent_id);
+                                                   });
+    EXPECT_EQ(agent_ids, set<AgentID>({agent_id_foo, agent_id_bar, agent_id_qux}));
+}
+
+int main(
+        int argc,
+        char** argv
+) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,127 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <set>
+#include <vector>
+
+#include <kami/agent.h>
+#include <kami/error.h>
+#include <kami/multihexgrid.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace kami;
+using namespace kami::error;
+using namespace std;
+
+TEST(MultiHexGrid, DefaultConstructor) {
+    EXPECT_NO_THROW(
+            MultiHexGrid multihexgrid_foo(10, 10, true, true);
+    );
+    EXPECT_THROW(MultiHexGrid multihexgrid_foo(10, 9, false, true), OptionInvalid);
+}
+
+TEST(MultiHexGrid, add_agent) {
+    MultiHexGrid multihexgrid_foo(10, 10, true, true);
+    const AgentID agent_id_foo, agent_id_bar;
+    const HexCoord coord2(2, 5);
+
+    EXPECT_EQ(multihexgrid_foo.add_agent(agent_id_foo, coord2), agent_id_foo);
+    EXPECT_EQ(multihexgrid_foo.add_agent(agent_id_bar, coord2), agent_id_bar);
+    EXPECT_THROW(auto agent_id_baz = multihexgrid_foo.add_agent(agent_id_bar, HexCoord(0, -1)), LocationInvalid);
+    EXPECT_EQ(*multihexgrid_foo.get_location_contents(coord2), set<AgentID>({agent_id_foo, agent_id_bar}));
+
+    // An agent already on the grid is not placed a second time
+    EXPECT_THROW(auto agent_id_baz = multihexgrid_foo.add_agent(agent_id_bar, HexCoord(1, 1)), OptionInvalid);
+    EXPECT_THROW(auto agent_id_baz = multihexgrid_foo.add_agent(agent_id_bar, coord2), OptionInvalid);
+    EXPECT_TRUE(multihexgrid_foo.is_location_empty(HexCoord(1, 1)));
+    EXPECT_EQ(multihexgrid_foo.get_location_contents(coord2)->size(), 2);
+}
+
+TEST(MultiHexGrid, delete_agent) {
+    MultiHexGrid multihexgrid_foo(10, 10, true, true);
+    const AgentID agent_id_foo, agent_id_bar;
+    const HexCoord coord2(2, 5), coord3(3, 7);
+
+    static_cast<void>(multihexgrid_foo.add_agent(agent_id_foo, coord2));
+    static_cast<void>(multihexgrid_foo.add_agent(agent_id_bar, coord2));
+
+    EXPECT_THROW(auto agent_id_baz = multihexgrid_foo.delete_agent(agent_id_foo, coord3), AgentNotFound);
+    EXPECT_EQ(multihexgrid_foo.delete_agent(agent_id_foo), agent_id_foo);
+    EXPECT_EQ(*multihexgrid_foo.get_location_contents(coord2), set<AgentID>({agent_id_bar}));
+    EXPECT_EQ(multihexgrid_foo.delete_agent(agent_id_bar, coord2), agent_id_bar);
+    EXPECT_TRUE(multihexgrid_foo.is_location_empty(coord2));
+}
+
+TEST(MultiHexGrid, move_agent) {
+    MultiHexGrid multihexgrid_foo(10, 10, true, true);
+    const AgentID agent_id_foo, agent_id_bar;
+    const HexCoord coord2(2, 5), coord3(3, 7);
+
+    static_cast<void>(multihexgrid_foo.add_agent(agent_id_foo, coord2));
+    static_cast<void>(multihexgrid_foo.add_agent(agent_id_bar, coord3));
+
+    EXPECT_EQ(multihexgrid_foo.move_agent(agent_id_foo, coord3), agent_id_foo);
+    EXPECT_EQ(multihexgrid_foo.get_location_by_agent(agent_id_foo), coord3);
+    EXPECT_TRUE(multihexgrid_foo.is_location_empty(coord2));
+    EXPECT_EQ(*multihexgrid_foo.get_location_contents(coord3), set<AgentID>({agent_id_foo, agent_id_bar}));
+
+    EXPECT_THROW(auto agent_id_baz = multihexgrid_foo.move_agent(agent_id_foo, HexCoord(10, 0)), LocationInvalid);
+    EXPECT_EQ(multihexgrid_foo.get_location_by_agent(agent_id_foo), coord3);
+}
+
+TEST(MultiHexGrid, for_each_agent_in_neighborhood) {
+    MultiHexGrid multihexgrid_foo(10, 10, true, true);
+    const AgentID agent_id_foo, agent_id_bar, agent_id_baz, agent_id_qux;
+    const HexCoord coord(0, 0);
+
+    static_cast<void>(multihexgrid_foo.add_agent(agent_id_foo, coord));
+    static_cast<void>(multihexgrid_foo.add_agent(agent_id_bar, HexCoord(5, 9)));
+    static_cast<void>(multihexgrid_foo.add_agent(agent_id_baz, HexCoord(5, 9)));
+    static_cast<void>(multihexgrid_foo.add_agent(agent_id_qux, HexCoord(2, 0)));
+
+    auto collect = [&](bool include_center, unsigned int radius) {
+        set<AgentID> agent_ids;
+        multihexgrid_foo.for_each_agent_in_neighborhood(coord, include_center, radius,
+                                                        [&agent_ids](const AgentID agent_id) {
+                                                            agent_ids.insert(agent_id);
+                                                        });
+        return agent_ids;
+    };
+
+    EXPECT_EQ(collect(false, 1), set<AgentID>({agent_id_bar, agent_id_baz}));
+    EXPECT_EQ(collect(true, 1), set<AgentID>({agent_id_foo, agent_id_bar, agent_id_baz}));
+    EXPECT_EQ(collect(false, 2), set<AgentID>({agent_id_bar, agent_id_baz, agent_id_qux}));
+    EXPECT_EQ(collect(true, 0), set<AgentID>({agent_id_foo}));
+}
+
+int main(
+        int argc,
+        char** argv
+) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,128 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <memory>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <kami/agent.h>
+#include <kami/csrgraph.h>
+#include <kami/error.h>
+#include <kami/multinetwork.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace kami;
+using namespace kami::error;
+using namespace std;
+
+namespace {
+
+    shared_ptr<CSRGraph> make_graph() {
+        const vector<pair<unsigned int, unsigned int>> edges = {{0, 1}, {1, 2}, {2, 3}, {3, 0}};
+        return make_shared<CSRGraph>(4, edges);
+    }
+
+}  // namespace
+
+TEST(MultiNetwork, DefaultConstructor) {
+    EXPECT_NO_THROW(
+            MultiNetwork multinetwork_foo(make_graph());
+    );
+}
+
+TEST(MultiNetwork, add_agent) {
+    MultiNetwork multinetwork_foo(make_graph());
+    const AgentID agent_id_foo, agent_id_bar;
+    const NodeCoord coord2(2);
+
+    EXPECT_EQ(multinetwork_foo.add_agent(agent_id_foo, coord2), agent_id_foo);
+    EXPECT_EQ(multinetwork_foo.add_agent(agent_id_bar, coord2), agent_id_bar);
+    EXPECT_THROW(auto agent_id_baz = multinetwork_foo.add_agent(agent_id_bar, NodeCoord(4)), LocationInvalid);
+    EXPECT_EQ(*multinetwork_foo.get_location_contents(coord2), set<AgentID>({agent_id_foo, agent_id_bar}));
+
+    // An agent already on the network is not placed a second time
+    EXPECT_THROW(auto agent_id_baz = multinetwork_foo.add_agent(agent_id_bar, NodeCoord(1)), OptionInvalid);
+    EXPECT_THROW(auto agent_id_baz = multinetwork_foo.add_agent(agent_id_bar, coord2), OptionInvalid);
+    EXPECT_TRUE(multinetwork_foo.is_location_empty(NodeCoord(1)));
+    EXPECT_EQ(multinetwork_foo.get_location_contents(coord2)->size(), 2);
+}
+
+TEST(MultiNetwork, delete_agent) {
+    MultiNetwork multinetwork_foo(make_graph());
+    const AgentID agent_id_foo, agent_id_bar;
+    const NodeCoord coord2(2), coord3(3);
+
+    static_cast<void>(multinetwork_foo.add_agent(agent_id_foo, coord2));
+    static_cast<void>(multinetwork_foo.add_agent(agent_id_bar, coord2));
+
+    EXPECT_THROW(auto agent_id_baz = multinetwork_foo.delete_agent(agent_id_foo, coord3), AgentNotFound);
+    EXPECT_EQ(multinetwork_foo.delete_agent(agent_id_foo), agent_id_foo);
+    EXPECT_EQ(*multinetwork_foo.get_location_contents(coord2), set<AgentID>({agent_id_bar}));
+    EXPECT_EQ(multinetwork_foo.delete_agent(agent_id_bar, coord2), agent_id_bar);
+    EXPECT_TRUE(multinetwork_foo.is_location_empty(coord2));
+}
+
+TEST(MultiNetwork, move_agent) {
+    MultiNetwork multinetwork_foo(make_graph());
+    const AgentID agent_id_foo, agent_id_bar;
+    const NodeCoord coord2(2), coord3(3);
+
+    static_cast<void>(multinetwork_foo.add_agent(agent_id_foo, coord2));
+    static_cast<void>(multinetwork_foo.add_agent(agent_id_bar, coord3));
+
+    EXPECT_EQ(multinetwork_foo.move_agent(agent_id_foo, coord3), agent_id_foo);
+    EXPECT_EQ(multinetwork_foo.get_location_by_agent(agent_id_foo), coord3);
+    EXPECT_TRUE(multinetwork_foo.is_location_empty(coord2));
+    EXPECT_EQ(*multinetwork_foo.get_location_contents(coord3), set<AgentID>({agent_id_foo, agent_id_bar}));
+
+    EXPECT_THROW(auto agent_id_baz = multinetwork_foo.move_agent(agent_id_foo, NodeCoord(4)), LocationInvalid);
+    EXPECT_EQ(multinetwork_foo.get_location_by_agent(agent_id_foo), coord3);
+}
+
+TEST(MultiNetwork, random_agent_at) {
+    MultiNetwork multinetwork_foo(make_graph());
+    const AgentID agent_id_foo, agent_id_bar;
+    const NodeCoord coord2(2);
+    mt19937 rng(8675309);
+
+    EXPECT_FALSE(multinetwork_foo.random_agent_at(coord2, rng).has_value());
+    static_cast<void>(multinetwork_foo.add_agent(agent_id_foo, coord2));
+    EXPECT_EQ(multinetwork_foo.random_agent_at(coord2, rng), agent_id_foo);
+    EXPECT_FALSE(multinetwork_foo.random_other_agent_at(coord2, agent_id_foo, rng).has_value());
+    static_cast<void>(multinetwork_foo.add_agent(agent_id_bar, coord2));
+    EXPECT_EQ(multinetwork_foo.random_other_agent_at(coord2, agent_id_foo, rng), agent_id_bar);
+}
+
+int main(
+        int argc,
+        char** argv
+) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
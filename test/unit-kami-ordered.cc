@@ -0,0 +1,164 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <kami/agent.h>
+#include <kami/error.h>
+#include <kami/executor.h>
+#include <kami/ordered.h>
+#include <kami/population.h>
+
+#include <gtest/gtest.h>
+
+using namespace kami;
+using namespace kami::error;
+using namespace std;
+
+class TestAgent
+        : public Agent {
+public:
+    explicit TestAgent(double wealth)
+            :wealth(wealth) {
+    }
+
+    AgentID step(shared_ptr<Model> model) override {
+        return get_agent_id();
+    }
+
+    double wealth;
+};
+
+class TestModel
+        : public Model {
+public:
+    shared_ptr<vector<AgentID>> retval;
+
+    shared_ptr<Model> step() override {
+        retval = _sched->step(shared_from_this());
+        return shared_from_this();
+    }
+
+    shared_ptr<Model> step(unique_ptr<vector<AgentID>> agent_list) {
+        retval = _sched->step(shared_from_this(), std::move(agent_list));
+        return shared_from_this();
+    }
+};
+
+class OrderedSchedulerTest
+        : public ::testing::Test {
+protected:
+    shared_ptr<TestModel> mod = nullptr;
+    shared_ptr<Population> pop_foo = nullptr;
+    shared_ptr<OrderedScheduler> sched_foo = nullptr;
+
+    void SetUp() override {
+        mod = make_shared<TestModel>();
+        pop_foo = make_shared<Population>();
+        sched_foo = make_shared<OrderedScheduler>([](const shared_ptr<Agent>& agent) {
+            return static_pointer_cast<TestAgent>(agent)->wealth;
+        });
+
+        // Domain is not required for this test
+        static_cast<void>(mod->set_population(pop_foo));
+        static_cast<void>(mod->set_scheduler(sched_foo));
+        static_cast<void>(mod->set_executor(make_shared<Executor>(2)));
+
+        for (auto wealth : {3.0, -1.0, 2.0, 3.0, 0.5, -1.0, 2.0, 10.0})
+            static_cast<void>(pop_foo->add_agent(make_shared<TestAgent>(wealth)));
+    }
+
+    vector<double> wealth_of(const vector<AgentID>& agent_list) {
+        vector<double> wealth;
+        for (auto& agent_id : agent_list)
+            wealth.push_back(static_pointer_cast<TestAgent>(pop_foo->get_agent_by_id(agent_id))->wealth);
+        return wealth;
+    }
+};
+
+TEST(OrderedScheduler, DefaultConstructor) {
+    // There is really no way this can go wrong, but
+    // we add this check anyway in case of future
+    // changes.
+    EXPECT_NO_THROW(
+            const OrderedScheduler sched_foo([](const shared_ptr<Agent>&) { return 0.0; });
+    );
+    EXPECT_THROW(
+            const OrderedScheduler sched_foo(nullptr),
+            OptionInvalid
+    );
+}
+
+TEST_F(OrderedSchedulerTest, step_ascending) {
+    mod->step();
+
+    auto rval = mod->retval;
+    EXPECT_EQ(rval->size(), 8);
+    EXPECT_EQ(wealth_of(*rval), vector<double>({-1.0, -1.0, 0.5, 2.0, 2.0, 3.0, 3.0, 10.0}));
+    for (size_t i = 1; i < rval->size(); i++)
+        if (wealth_of(*rval)[i] == wealth_of(*rval)[i - 1]) {
+            EXPECT_TRUE((*rval)[i - 1] < (*rval)[i]);
+        }
+}
+
+TEST_F(OrderedSchedulerTest, step_descending) {
+    EXPECT_FALSE(sched_foo->get_descending());
+    EXPECT_TRUE(sched_foo->set_descending(true));
+    EXPECT_TRUE(sched_foo->get_descending());
+    mod->step();
+
+    auto rval = mod->retval;
+    EXPECT_EQ(wealth_of(*rval), vector<double>({10.0, 3.0, 3.0, 2.0, 2.0, 0.5, -1.0, -1.0}));
+
+    // Ties are still broken in AgentID order
+    for (size_t i = 1; i < rval->size(); i++)
+        if (wealth_of(*rval)[i] == wealth_of(*rval)[i - 1]) {
+            EXPECT_TRUE((*rval)[i - 1] < (*rval)[i]);
+        }
+}
+
+TEST_F(OrderedSchedulerTest, step_interface1) {
+    // The order of the list given does not affect the result
+    auto tval = pop_foo->get_agent_list();
+    auto aval = pop_foo->get_agent_list();
+    reverse(aval->begin(), aval->end());
+
+    mod->step(std::move(aval));
+    auto rval = mod->retval;
+    mod->step(std::move(tval));
+
+    EXPECT_EQ(*rval, *mod->retval);
+}
+
+int main(
+        int argc,
+        char** argv
+) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -194,6 +194,26 @@ TEST(Population, get_agent_list) {
     }
 }
 
+TEST(Population, get_revision) {
+    Population population_foo;
+    auto agent_foo = make_shared<TestAgent>(8675309);
+    auto agent_bar = make_shared<TestAgent>(1729);
+
+    auto revision_foo = population_foo.get_revision();
+    static_cast<void>(population_foo.add_agent(agent_foo));
+    auto revision_bar = population_foo.get_revision();
+    EXPECT_NE(revision_foo, revision_bar);
+
+    // Adding the same agent again changes nothing
+    static_cast<void>(population_foo.add_agent(agent_foo));
+    EXPECT_EQ(population_foo.get_revision(), revision_bar);
+
+    static_cast<void>(population_foo.add_agent(agent_bar));
+    static_cast<void>(population_foo.delete_agent(agent_bar->get_agent_id()));
+    EXPECT_NE(population_foo.get_revision(), revision_bar);
+    EXPECT_THROW(static_cast<void>(population_foo.delete_agent(agent_bar->get_agent_id())), ResourceNotAvailable);
+}
+
 int main(
         int argc,
         char** argv
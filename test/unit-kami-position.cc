@@ -35,11 +35,20 @@ class PositionTest
 protected:
     Position pos_foo = GridCoord1D(5);
     Position pos_bar = GridCoord2D(2, 5);
+    Position pos_baz = GridCoord3D(2, 5, 1);
+    Position pos_qux = HexCoord(2, 5);
+    Position pos_quux = NodeCoord(5);
 };
 
 TEST_F(PositionTest, DefaultConstructor) {
     EXPECT_EQ(pos_foo, pos_foo);
     EXPECT_NE(pos_foo, pos_bar);
+    EXPECT_NE(pos_bar, pos_baz);
+    EXPECT_EQ(pos_baz, Position(GridCoord3D(2, 5, 1)));
+    EXPECT_NE(pos_bar, pos_qux);
+    EXPECT_EQ(pos_qux, Position(HexCoord(2, 5)));
+    EXPECT_NE(pos_foo, pos_quux);
+    EXPECT_EQ(pos_quux, Position(NodeCoord(5)));
 }
 
 int main(
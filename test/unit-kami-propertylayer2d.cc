@@ -0,0 +1,175 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <random>
+#include <vector>
+
+#include <kami/error.h>
+#include <kami/executor.h>
+#include <kami/grid.h>
+#include <kami/propertylayer2d.h>
+#include <kami/sologrid2d.h>
+#include <kami/stencil.h>
+
+#include <gtest/gtest.h>
+
+using namespace kami;
+using namespace kami::error;
+using namespace std;
+
+namespace {
+
+    // The sum over a neighborhood, one cell at a time
+    double neighborhood_sum(
+            const PropertyLayer2D<double>& layer,
+            const GridCoord2D& coord,
+            GridNeighborhoodType neighborhood_type,
+            int radius,
+            bool include_center
+    ) {
+        double total = 0.0;
+
+        for (auto dy = -radius; dy <= radius; dy++)
+            for (auto dx = -radius; dx <= radius; dx++) {
+                if (!stencil::contains(neighborhood_type, radius, dx, dy) || (!include_center && dx == 0 && dy == 0))
+                    continue;
+                const GridCoord2D other(coord.x() + dx, coord.y() + dy);
+                if (layer.is_location_valid(other))
+                    total += layer.get(other);
+            }
+        return total;
+    }
+
+}  // namespace
+
+TEST(PropertyLayer2D, DefaultConstructor) {
+    EXPECT_NO_THROW(
+            PropertyLayer2D<double> layer_foo(10, 5);
+    );
+    EXPECT_THROW(PropertyLayer2D<double> layer_foo(0, 5), OptionInvalid);
+
+    const PropertyLayer2D<int> layer_foo(10, 5, true, false, 7);
+    EXPECT_EQ(layer_foo.get_maximum_x(), 10);
+    EXPECT_EQ(layer_foo.get_maximum_y(), 5);
+    EXPECT_TRUE(layer_foo.get_wrap_x());
+    EXPECT_FALSE(layer_foo.get_wrap_y());
+    EXPECT_EQ(layer_foo.get_values().size(), 50);
+    EXPECT_EQ(layer_foo.sum(), 350);
+
+    const SoloGrid2D sologrid2d_foo(8, 6, false, true);
+    const PropertyLayer2D<float> layer_bar(sologrid2d_foo, 1.5f);
+    EXPECT_EQ(layer_bar.get_maximum_x(), 8);
+    EXPECT_EQ(layer_bar.get_maximum_y(), 6);
+    EXPECT_FALSE(layer_bar.get_wrap_x());
+    EXPECT_TRUE(layer_bar.get_wrap_y());
+    EXPECT_FLOAT_EQ(layer_bar.get(GridCoord2D(3, 4)), 1.5f);
+}
+
+TEST(PropertyLayer2D, get) {
+    PropertyLayer2D<double> layer_foo(10, 5, true, false);
+
+    layer_foo.set(GridCoord2D(3, 2), 4.5);
+    EXPECT_DOUBLE_EQ(layer_foo.get(GridCoord2D(3, 2)), 4.5);
+    EXPECT_DOUBLE_EQ(layer_foo.get(GridCoord2D(13, 2)), 4.5);
+    EXPECT_DOUBLE_EQ(layer_foo.get(GridCoord2D(-7, 2)), 4.5);
+    EXPECT_DOUBLE_EQ(layer_foo.get_values()[2 * 10 + 3], 4.5);
+
+    layer_foo.at(GridCoord2D(3, 2)) += 1.0;
+    EXPECT_DOUBLE_EQ(layer_foo.get(GridCoord2D(3, 2)), 5.5);
+
+    EXPECT_TRUE(layer_foo.is_location_valid(GridCoord2D(-1, 0)));
+    EXPECT_FALSE(layer_foo.is_location_valid(GridCoord2D(0, 5)));
+    EXPECT_THROW(static_cast<void>(layer_foo.get(GridCoord2D(0, -1))), LocationInvalid);
+    EXPECT_THROW(layer_foo.set(GridCoord2D(0, 5), 1.0), LocationInvalid);
+}
+
+TEST(PropertyLayer2D, kernels) {
+    PropertyLayer2D<double> layer_foo(300, 200);
+    PropertyLayer2D<double> layer_bar(300, 200);
+    Executor executor(3);
+
+    layer_foo.fill(2.0, &executor);
+    layer_bar.fill(2.0);
+    EXPECT_DOUBLE_EQ(layer_foo.sum(), 2.0 * 60000);
+
+    layer_foo.scale(3.0, &executor);
+    layer_foo.add(1.0, &executor);
+    EXPECT_DOUBLE_EQ(layer_foo.get(GridCoord2D(299, 199)), 7.0);
+
+    layer_foo.add(layer_bar, 0.5, &executor);
+    EXPECT_DOUBLE_EQ(layer_foo.get(GridCoord2D(0, 0)), 8.0);
+
+    layer_foo.evaporate(0.25, &executor);
+    EXPECT_DOUBLE_EQ(layer_foo.get(GridCoord2D(150, 100)), 6.0);
+
+    layer_foo.apply([](double value) { return value * value; }, &executor);
+    EXPECT_DOUBLE_EQ(layer_foo.sum(), 36.0 * 60000);
+
+    const PropertyLayer2D<double> layer_baz(10, 10);
+    EXPECT_THROW(layer_foo.add(layer_baz), OptionInvalid);
+    EXPECT_THROW(layer_foo.evaporate(1.5), OptionInvalid);
+
+    PropertyLayer2D<int> layer_qux(4, 4, false, false, 9);
+    layer_qux.evaporate(0.5);
+    EXPECT_EQ(layer_qux.get(GridCoord2D(1, 1)), 4);
+}
+
+TEST(PropertyLayer2D, neighborhood_sum) {
+    mt19937 rng(8675309);
+    uniform_real_distribution<double> dist(0.0, 1.0);
+    Executor executor(3);
+
+    for (auto wrap : {false, true}) {
+        PropertyLayer2D<double> layer_foo(23, 17, wrap, wrap);
+        PropertyLayer2D<double> layer_bar(23, 17, wrap, wrap);
+        for (auto& value : layer_foo.get_values())
+            value = dist(rng);
+
+        for (auto neighborhood_type : {GridNeighborhoodType::VonNeumann, GridNeighborhoodType::Moore,
+                                       GridNeighborhoodType::Euclidean})
+            for (auto radius : {0, 1, 3})
+                for (auto include_center : {false, true}) {
+                    layer_foo.neighborhood_sum(layer_bar, neighborhood_type, radius, include_center, &executor);
+                    for (auto y = 0; y < 17; y++)
+                        for (auto x = 0; x < 23; x++)
+                            EXPECT_NEAR(layer_bar.get(GridCoord2D(x, y)),
+                                        neighborhood_sum(layer_foo, GridCoord2D(x, y), neighborhood_type, radius,
+                                                         include_center), 1e-12);
+                }
+    }
+
+    PropertyLayer2D<double> layer_foo(5, 5);
+    PropertyLayer2D<double> layer_bar(5, 6);
+    EXPECT_THROW(layer_foo.neighborhood_sum(layer_foo, GridNeighborhoodType::Moore), OptionInvalid);
+    EXPECT_THROW(layer_foo.neighborhood_sum(layer_bar, GridNeighborhoodType::Moore), OptionInvalid);
+}
+
+int main(
+        int argc,
+        char** argv
+) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,125 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <kami/error.h>
+#include <kami/executor.h>
+#include <kami/radix.h>
+
+#include <gtest/gtest.h>
+
+using namespace kami;
+using namespace kami::error;
+using namespace std;
+
+TEST(Radix, radix_key_double) {
+    const vector<double> values = {-numeric_limits<double>::infinity(), -1e300, -2.5, -1.0, -1e-300, 0.0, 1e-300,
+                                   1.0, 2.5, 1e300, numeric_limits<double>::infinity(),
+                                   numeric_limits<double>::quiet_NaN()};
+
+    for (size_t i = 1; i < values.size(); i++)
+        EXPECT_LT(radix_key(values[i - 1]), radix_key(values[i]));
+    EXPECT_EQ(radix_key(-0.0), radix_key(0.0));
+
+    // A NaN made at run time on x86 has its sign bit set
+    volatile double zero = 0.0;
+    const auto negative_nan = copysign(numeric_limits<double>::quiet_NaN(), -1.0);
+    EXPECT_TRUE(signbit(negative_nan));
+    EXPECT_LT(radix_key(numeric_limits<double>::infinity()), radix_key(negative_nan));
+    EXPECT_EQ(radix_key(negative_nan), radix_key(numeric_limits<double>::quiet_NaN()));
+    EXPECT_EQ(radix_key(zero / zero), radix_key(numeric_limits<double>::quiet_NaN()));
+}
+
+TEST(Radix, radix_key_integer) {
+    const vector<int64_t> values = {numeric_limits<int64_t>::min(), -5, -1, 0, 1, 5, numeric_limits<int64_t>::max()};
+
+    for (size_t i = 1; i < values.size(); i++)
+        EXPECT_LT(radix_key(values[i - 1]), radix_key(values[i]));
+}
+
+TEST(Radix, radix_sort) {
+    for (auto thread_count : {0u, 3u}) {
+        Executor executor_foo(thread_count);
+        mt19937 rng(Constants::JENNYS_NUMBER);
+        uniform_int_distribution<uint64_t> dist(0, 1000);
+
+        // Large enough to be split among threads, with many ties
+        vector<uint64_t> keys(100000);
+        for (auto& key : keys)
+            key = dist(rng) << 40;
+        vector<size_t> values(keys.size());
+        iota(values.begin(), values.end(), 0);
+
+        auto tkeys = keys;
+        vector<size_t> tvalues(keys.size());
+        iota(tvalues.begin(), tvalues.end(), 0);
+        stable_sort(tvalues.begin(), tvalues.end(), [&tkeys](size_t lhs, size_t rhs) {
+            return tkeys[lhs] < tkeys[rhs];
+        });
+        sort(tkeys.begin(), tkeys.end());
+
+        radix_sort(keys, values, &executor_foo);
+        EXPECT_EQ(keys, tkeys);
+        EXPECT_EQ(values, tvalues);
+    }
+}
+
+TEST(Radix, radix_sort_small) {
+    {
+        vector<uint64_t> keys = {3, 1, 2, 1};
+        vector<size_t> values = {0, 1, 2, 3};
+
+        radix_sort(keys, values);
+        EXPECT_EQ(keys, vector<uint64_t>({1, 1, 2, 3}));
+        EXPECT_EQ(values, vector<size_t>({1, 3, 2, 0}));
+    }
+    {
+        vector<uint64_t> keys;
+        vector<size_t> values;
+
+        EXPECT_NO_THROW(radix_sort(keys, values));
+    }
+    {
+        vector<uint64_t> keys = {1, 2};
+        vector<size_t> values = {0};
+
+        EXPECT_THROW(radix_sort(keys, values), OptionInvalid);
+    }
+}
+
+int main(
+        int argc,
+        char** argv
+) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
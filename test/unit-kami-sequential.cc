@@ -28,6 +28,7 @@
 #include <vector>
 
 #include <kami/agent.h>
+#include <kami/error.h>
 #include <kami/population.h>
 #include <kami/sequential.h>
 
@@ -45,6 +46,42 @@ public:
     }
 };
 
+class OtherTestAgent
+        : public Agent {
+public:
+    AgentID step(shared_ptr<Model> model) override {
+        return get_agent_id();
+    }
+};
+
+class DeletingTestAgent
+        : public Agent {
+public:
+    AgentID target;
+
+    AgentID step(shared_ptr<Model> model) override {
+        static_cast<void>(model->get_population()->delete_agent(target));
+        return get_agent_id();
+    }
+};
+
+class SelfDeletingTestAgent
+        : public Agent {
+public:
+    static inline bool destroyed = false;
+    static inline bool alive_after_delete = false;
+
+    ~SelfDeletingTestAgent() {
+        destroyed = true;
+    }
+
+    AgentID step(shared_ptr<Model> model) override {
+        static_cast<void>(model->get_population()->delete_agent(get_agent_id()));
+        alive_after_delete = !destroyed;
+        return get_agent_id();
+    }
+};
+
 class TestModel
         : public Model {
 public:
@@ -130,6 +167,83 @@ TEST_F(SequentialSchedulerTest, step_10000) {
     }
 }
 
+TEST_F(SequentialSchedulerTest, step_group_by_type) {
+    auto sched_foo = static_pointer_cast<SequentialScheduler>(mod->get_scheduler());
+    auto pop_foo = mod->get_population();
+
+    // Interleave a second class of agent with the first
+    vector<AgentID> first, second;
+    auto agent_list = pop_foo->get_agent_list();
+    for (auto& agent_id : *agent_list) {
+        first.push_back(agent_id);
+        auto agent_foo = make_shared<OtherTestAgent>();
+        second.push_back(pop_foo->add_agent(agent_foo));
+    }
+
+    EXPECT_FALSE(sched_foo->get_group_by_type());
+    mod->step();
+    EXPECT_EQ(mod->retval->size(), 20);
+    EXPECT_EQ(*mod->retval, *pop_foo->get_agent_list());
+
+    EXPECT_TRUE(sched_foo->set_group_by_type(true));
+    EXPECT_TRUE(sched_foo->get_group_by_type());
+    auto tval = first;
+    tval.insert(tval.end(), second.begin(), second.end());
+    for (auto i = 0; i < 3; i++) {
+        mod->step();
+        EXPECT_EQ(*mod->retval, tval);
+    }
+
+    // Changes to the population are picked up
+    static_cast<void>(pop_foo->delete_agent(first.front()));
+    auto agent_foo = make_shared<TestAgent>();
+    static_cast<void>(pop_foo->add_agent(agent_foo));
+    tval.erase(tval.begin());
+    tval.insert(tval.begin() + 9, agent_foo->get_agent_id());
+    mod->step();
+    EXPECT_EQ(*mod->retval, tval);
+
+    // Explicit agent lists are executed as given
+    auto aval = pop_foo->get_agent_list();
+    auto bval = *aval;
+    mod->step(std::move(aval));
+    EXPECT_EQ(*mod->retval, bval);
+}
+
+TEST_F(SequentialSchedulerTest, step_group_by_type_delete_agent) {
+    auto sched_foo = static_pointer_cast<SequentialScheduler>(mod->get_scheduler());
+    auto pop_foo = mod->get_population();
+    static_cast<void>(sched_foo->set_group_by_type(true));
+
+    // The deleting agent is grouped before the agent it deletes, so the
+    // deleted agent is looked up rather than stepped through a stale
+    // cached pointer
+    auto agent_foo = make_shared<DeletingTestAgent>();
+    static_cast<void>(pop_foo->add_agent(agent_foo));
+    auto agent_id_bar = pop_foo->add_agent(make_shared<OtherTestAgent>());
+    agent_foo->target = agent_id_bar;
+
+    EXPECT_THROW(mod->step(), kami::error::AgentNotFound);
+    EXPECT_THROW(auto agent_baz = pop_foo->get_agent_by_id(agent_id_bar), kami::error::AgentNotFound);
+}
+
+TEST_F(SequentialSchedulerTest, step_group_by_type_delete_self) {
+    auto sched_foo = static_pointer_cast<SequentialScheduler>(mod->get_scheduler());
+    auto pop_foo = mod->get_population();
+    static_cast<void>(sched_foo->set_group_by_type(true));
+
+    // The scheduler keeps an agent alive through its own step, even once
+    // the population has let it go
+    auto agent_foo = make_shared<SelfDeletingTestAgent>();
+    auto agent_id_foo = pop_foo->add_agent(agent_foo);
+    agent_foo.reset();
+
+    mod->step();
+    EXPECT_EQ(mod->retval->size(), 11);
+    EXPECT_TRUE(SelfDeletingTestAgent::alive_after_delete);
+    EXPECT_THROW(auto agent_baz = pop_foo->get_agent_by_id(agent_id_foo), kami::error::AgentNotFound);
+}
+
 int main(
         int argc,
         char** argv
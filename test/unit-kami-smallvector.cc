@@ -0,0 +1,115 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include <kami/smallvector.h>
+
+#include <gtest/gtest.h>
+
+using namespace kami;
+using namespace std;
+
+TEST(SmallVector, DefaultConstructor) {
+    const SmallVector<int, 2> smallvector_foo;
+
+    EXPECT_EQ(smallvector_foo.size(), 0);
+    EXPECT_TRUE(smallvector_foo.empty());
+    EXPECT_EQ(smallvector_foo.capacity(), 2);
+}
+
+TEST(SmallVector, push_back) {
+    SmallVector<int, 2> smallvector_foo;
+
+    for (auto i = 0; i < 10; i++)
+        smallvector_foo.push_back(i);
+
+    EXPECT_EQ(smallvector_foo.size(), 10);
+    EXPECT_GE(smallvector_foo.capacity(), 10);
+    EXPECT_EQ(vector<int>(smallvector_foo.begin(), smallvector_foo.end()),
+              vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    EXPECT_EQ(smallvector_foo.back(), 9);
+}
+
+TEST(SmallVector, pop_back) {
+    SmallVector<int, 2> smallvector_foo;
+
+    smallvector_foo.push_back(1);
+    smallvector_foo.push_back(2);
+    smallvector_foo.push_back(3);
+    smallvector_foo.pop_back();
+    EXPECT_EQ(smallvector_foo.size(), 2);
+    EXPECT_EQ(smallvector_foo.back(), 2);
+
+    smallvector_foo.clear();
+    EXPECT_TRUE(smallvector_foo.empty());
+}
+
+TEST(SmallVector, copy) {
+    SmallVector<int, 2> smallvector_foo, smallvector_bar;
+
+    for (auto i = 0; i < 5; i++)
+        smallvector_foo.push_back(i);
+
+    auto smallvector_baz = smallvector_foo;
+    smallvector_bar = smallvector_foo;
+    smallvector_foo[0] = 7;
+
+    EXPECT_EQ(smallvector_baz.size(), 5);
+    EXPECT_EQ(smallvector_baz[0], 0);
+    EXPECT_EQ(smallvector_bar.size(), 5);
+    EXPECT_EQ(smallvector_bar[4], 4);
+}
+
+TEST(SmallVector, move) {
+    SmallVector<int, 2> smallvector_foo, smallvector_bar;
+
+    smallvector_foo.push_back(1);
+    auto smallvector_baz = std::move(smallvector_foo);
+    EXPECT_EQ(smallvector_baz.size(), 1);
+    EXPECT_EQ(smallvector_baz[0], 1);
+
+    for (auto i = 0; i < 5; i++)
+        smallvector_bar.push_back(i);
+    smallvector_baz = std::move(smallvector_bar);
+    EXPECT_EQ(smallvector_baz.size(), 5);
+    EXPECT_EQ(smallvector_baz[4], 4);
+    EXPECT_EQ(smallvector_bar.size(), 0);
+
+    vector<SmallVector<int, 2>> cells(3);
+    cells[1].push_back(3);
+    cells.resize(100);
+    EXPECT_EQ(cells[1][0], 3);
+}
+
+int main(
+        int argc,
+        char** argv
+) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -27,6 +27,7 @@
 #include <iterator>
 #include <set>
 #include <unordered_set>
+#include <vector>
 
 #include <kami/agent.h>
 #include <kami/error.h>
@@ -395,6 +396,69 @@ TEST(SoloGrid1D, get_neighborhood) {
     }
 }
 
+TEST(SoloGrid1D, for_each_neighbor) {
+    {
+        SoloGrid1D sologrid1d_foo(10, true);
+        vector<GridCoord1D> rval;
+
+        sologrid1d_foo.for_each_neighbor(GridCoord1D(5), true, [&rval](const GridCoord1D& coord) {
+            rval.push_back(coord);
+        });
+        EXPECT_EQ(rval, vector<GridCoord1D>({GridCoord1D(4), GridCoord1D(5), GridCoord1D(6)}));
+    }
+    {
+        SoloGrid1D sologrid1d_foo(10, true);
+        vector<GridCoord1D> rval;
+
+        sologrid1d_foo.for_each_neighbor(GridCoord1D(0), false, [&rval](const GridCoord1D& coord) {
+            rval.push_back(coord);
+        });
+        EXPECT_EQ(rval, vector<GridCoord1D>({GridCoord1D(9), GridCoord1D(1)}));
+    }
+    {
+        SoloGrid1D sologrid1d_foo(10, false);
+        vector<GridCoord1D> rval;
+
+        sologrid1d_foo.for_each_neighbor(GridCoord1D(9), false, [&rval](const GridCoord1D& coord) {
+            rval.push_back(coord);
+        });
+        EXPECT_EQ(rval, vector<GridCoord1D>({GridCoord1D(8)}));
+    }
+    {
+        SoloGrid1D sologrid1d_foo(10, false);
+        auto count = 0;
+
+        EXPECT_FALSE(sologrid1d_foo.for_each_neighbor(GridCoord1D(5), true, [&count](const GridCoord1D& coord) {
+            return ++count < 2;
+        }));
+        EXPECT_EQ(count, 2);
+    }
+}
+
+TEST(SoloGrid1D, for_each_neighbor_radius) {
+    {
+        SoloGrid1D sologrid1d_foo(20, false);
+        vector<GridCoord1D> rval;
+
+        sologrid1d_foo.for_each_neighbor(GridCoord1D(2), false, 3, [&rval](const GridCoord1D& coord) {
+            rval.push_back(coord);
+        });
+        EXPECT_EQ(rval, vector<GridCoord1D>({GridCoord1D(0), GridCoord1D(1), GridCoord1D(3), GridCoord1D(4),
+                                             GridCoord1D(5)}));
+    }
+    {
+        SoloGrid1D sologrid1d_foo(20, true);
+        vector<GridCoord1D> rval;
+
+        sologrid1d_foo.for_each_neighbor(GridCoord1D(18), true, 6, [&rval](const GridCoord1D& coord) {
+            rval.push_back(coord);
+        });
+        ASSERT_EQ(rval.size(), 13);
+        EXPECT_EQ(rval.front(), GridCoord1D(12));
+        EXPECT_EQ(rval.back(), GridCoord1D(4));
+    }
+}
+
 TEST(SoloGrid1D, get_location_by_agent) {
     const AgentID agent_id_foo, agent_id_bar;
     const GridCoord1D coord2(2), coord3(3);
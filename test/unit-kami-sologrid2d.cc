@@ -24,12 +24,20 @@
  */
 
 #include <algorithm>
+#include <cmath>
+#include <cstdlib>
 #include <iterator>
+#include <map>
+#include <random>
 #include <set>
+#include <span>
+#include <utility>
 #include <unordered_set>
+#include <vector>
 
 #include <kami/agent.h>
 #include <kami/error.h>
+#include <kami/executor.h>
 #include <kami/sologrid2d.h>
 
 #include <gmock/gmock.h>
@@ -209,6 +217,115 @@ TEST(SoloGrid2D, move_agent) {
         auto agent_id_baz = sologrid2d_foo.move_agent(agent_id_foo, coord7);
         EXPECT_EQ(agent_id_baz, agent_id_foo);
     }
+    {
+        SoloGrid2D sologrid2d_foo(10, 10, true, true);
+
+        static_cast<void>(sologrid2d_foo.add_agent(agent_id_foo, coord2));
+        static_cast<void>(sologrid2d_foo.add_agent(agent_id_bar, coord7));
+        EXPECT_THROW(auto agent_id_baz = sologrid2d_foo.move_agent(agent_id_foo, coord7), LocationUnavailable);
+        EXPECT_EQ(sologrid2d_foo.get_location_by_agent(agent_id_foo), coord2);
+        EXPECT_EQ(sologrid2d_foo.get_location_by_agent(agent_id_bar), coord7);
+
+        static_cast<void>(sologrid2d_foo.delete_agent(agent_id_bar));
+        static_cast<void>(sologrid2d_foo.move_agent(agent_id_foo, coord7));
+        EXPECT_TRUE(sologrid2d_foo.is_location_empty(coord2));
+        EXPECT_EQ(*sologrid2d_foo.get_location_contents(coord7), set<AgentID>({agent_id_foo}));
+    }
+}
+
+TEST(SoloGrid2D, move_agents) {
+    const AgentID agent_id_foo, agent_id_bar, agent_id_baz, agent_id_qux;
+    const GridCoord2D coord1(1, 1), coord2(2, 5), coord3(3, 7), coord4(4, 4), coord5(5, 5);
+
+    {
+        SoloGrid2D sologrid2d_foo(10, 10, true, true);
+
+        static_cast<void>(sologrid2d_foo.add_agent(agent_id_foo, coord1));
+        static_cast<void>(sologrid2d_foo.add_agent(agent_id_bar, coord2));
+        static_cast<void>(sologrid2d_foo.add_agent(agent_id_baz, coord3));
+        static_cast<void>(sologrid2d_foo.add_agent(agent_id_qux, coord4));
+
+        // bar and baz compete for coord5, qux cannot take foo's cell even
+        // though foo is leaving it, and foo stays put
+        auto moved = sologrid2d_foo.move_agents({{agent_id_foo, coord1}, {agent_id_bar, coord5},
+                                                 {agent_id_baz, coord5}, {agent_id_qux, coord1}});
+        EXPECT_EQ(*moved, vector<AgentID>({agent_id_foo, agent_id_bar}));
+        EXPECT_EQ(sologrid2d_foo.get_location_by_agent(agent_id_foo), coord1);
+        EXPECT_EQ(sologrid2d_foo.get_location_by_agent(agent_id_bar), coord5);
+        EXPECT_EQ(sologrid2d_foo.get_location_by_agent(agent_id_baz), coord3);
+        EXPECT_EQ(sologrid2d_foo.get_location_by_agent(agent_id_qux), coord4);
+        EXPECT_TRUE(sologrid2d_foo.is_location_empty(coord2));
+        EXPECT_FALSE(sologrid2d_foo.is_location_empty(coord5));
+    }
+    {
+        SoloGrid2D sologrid2d_foo(10, 10, true, true);
+
+        static_cast<void>(sologrid2d_foo.add_agent(agent_id_foo, coord1));
+        static_cast<void>(sologrid2d_foo.add_agent(agent_id_bar, coord2));
+
+        auto moved = sologrid2d_foo.move_agents({{agent_id_foo, coord5, 1.0}, {agent_id_bar, coord5, 2.0}},
+                                                GridConflictPolicy::Priority);
+        EXPECT_EQ(*moved, vector<AgentID>({agent_id_bar}));
+        EXPECT_EQ(sologrid2d_foo.get_location_by_agent(agent_id_bar), coord5);
+    }
+    {
+        // Random winners depend on the seed but not the order of the batch
+        SoloGrid2D sologrid2d_foo(10, 10, true, true), sologrid2d_bar(10, 10, true, true);
+
+        for (auto sologrid2d : {&sologrid2d_foo, &sologrid2d_bar}) {
+            static_cast<void>(sologrid2d->add_agent(agent_id_foo, coord1));
+            static_cast<void>(sologrid2d->add_agent(agent_id_bar, coord2));
+            static_cast<void>(sologrid2d->add_agent(agent_id_baz, coord3));
+        }
+
+        Executor executor(2);
+        auto moved_foo = sologrid2d_foo.move_agents({{agent_id_foo, coord5}, {agent_id_bar, coord5},
+                                                     {agent_id_baz, coord5}}, GridConflictPolicy::Random, 7);
+        auto moved_bar = sologrid2d_bar.move_agents({{agent_id_baz, coord5}, {agent_id_foo, coord5},
+                                                     {agent_id_bar, coord5}}, GridConflictPolicy::Random, 7,
+                                                    &executor);
+        ASSERT_EQ(moved_foo->size(), 1);
+        EXPECT_EQ(*moved_foo, *moved_bar);
+        EXPECT_EQ(*sologrid2d_foo.get_location_contents(coord5), set<AgentID>({moved_foo->front()}));
+    }
+    {
+        // Invalid batches leave the grid untouched
+        SoloGrid2D sologrid2d_foo(10, 10, false, false);
+
+        static_cast<void>(sologrid2d_foo.add_agent(agent_id_foo, coord1));
+        static_cast<void>(sologrid2d_foo.add_agent(agent_id_bar, coord2));
+
+        EXPECT_THROW(auto moved = sologrid2d_foo.move_agents({{agent_id_foo, coord5}, {agent_id_bar, GridCoord2D(10, 5)}}),
+                     LocationInvalid);
+        EXPECT_THROW(auto moved = sologrid2d_foo.move_agents({{agent_id_foo, coord5}, {agent_id_baz, coord3}}),
+                     AgentNotFound);
+        EXPECT_THROW(auto moved = sologrid2d_foo.move_agents({{agent_id_foo, coord5}, {agent_id_foo, coord3}}),
+                     OptionInvalid);
+        EXPECT_EQ(sologrid2d_foo.get_location_by_agent(agent_id_foo), coord1);
+        EXPECT_TRUE(sologrid2d_foo.is_location_empty(coord5));
+    }
+    {
+        // A large batch on many threads matches the single-threaded result
+        SoloGrid2D sologrid2d_foo(64, 64, true, true), sologrid2d_bar(64, 64, true, true);
+        vector<AgentID> agent_ids(1000);
+        vector<GridMove2D> moves;
+        mt19937 rng(3);
+
+        for (auto i = 0; i < 1000; i++) {
+            GridCoord2D coord(i % 64, i / 64);
+            static_cast<void>(sologrid2d_foo.add_agent(agent_ids[i], coord));
+            static_cast<void>(sologrid2d_bar.add_agent(agent_ids[i], coord));
+            moves.push_back({agent_ids[i], GridCoord2D(static_cast<int>(rng() % 64), static_cast<int>(rng() % 64)),
+                             static_cast<double>(rng() % 5)});
+        }
+
+        Executor executor(4);
+        auto moved_foo = sologrid2d_foo.move_agents(moves, GridConflictPolicy::Priority);
+        auto moved_bar = sologrid2d_bar.move_agents(moves, GridConflictPolicy::Priority, 0, &executor);
+        EXPECT_EQ(*moved_foo, *moved_bar);
+        for (auto& agent_id : agent_ids)
+            EXPECT_EQ(sologrid2d_foo.get_location_by_agent(agent_id), sologrid2d_bar.get_location_by_agent(agent_id));
+    }
 }
 
 TEST(SoloGrid2D, get_neighborhood_VonNeumann) {
@@ -1071,6 +1188,221 @@ TEST(SoloGrid2D, get_neighborhood_Moore) {
     }
 }
 
+TEST(SoloGrid2D, for_each_neighbor) {
+    const GridCoord2D coord0(0, 0), coord3(3, 7);
+
+    {
+        SoloGrid2D sologrid2d_foo(10, 10, true, true);
+        vector<GridCoord2D> rval;
+
+        sologrid2d_foo.for_each_neighbor(coord3, true, GridNeighborhoodType::Moore, [&rval](const GridCoord2D& coord) {
+            rval.push_back(coord);
+        });
+
+        // Interior cells come in row-major scan order
+        EXPECT_EQ(rval, vector<GridCoord2D>({GridCoord2D(2, 6), GridCoord2D(3, 6), GridCoord2D(4, 6),
+                                             GridCoord2D(2, 7), GridCoord2D(3, 7), GridCoord2D(4, 7),
+                                             GridCoord2D(2, 8), GridCoord2D(3, 8), GridCoord2D(4, 8)}));
+    }
+    {
+        SoloGrid2D sologrid2d_foo(10, 10, true, true);
+        vector<GridCoord2D> rval;
+
+        sologrid2d_foo.for_each_neighbor(coord0, false, GridNeighborhoodType::VonNeumann,
+                                         [&rval](const GridCoord2D& coord) {
+                                             rval.push_back(coord);
+                                         });
+        EXPECT_EQ(rval, vector<GridCoord2D>({GridCoord2D(0, 9), GridCoord2D(9, 0), GridCoord2D(1, 0),
+                                             GridCoord2D(0, 1)}));
+    }
+    {
+        // Wrapping in one dimension only
+        SoloGrid2D sologrid2d_foo(10, 10, true, false);
+        unordered_set<GridCoord2D> rval;
+
+        sologrid2d_foo.for_each_neighbor(coord0, false, GridNeighborhoodType::Moore, [&rval](const GridCoord2D& coord) {
+            rval.insert(coord);
+        });
+        EXPECT_EQ(rval, unordered_set<GridCoord2D>({GridCoord2D(9, 0), GridCoord2D(1, 0), GridCoord2D(9, 1),
+                                                    GridCoord2D(0, 1), GridCoord2D(1, 1)}));
+        EXPECT_EQ(rval, *sologrid2d_foo.get_neighborhood(coord0, false, GridNeighborhoodType::Moore));
+    }
+    {
+        // Returning false ends the visit
+        SoloGrid2D sologrid2d_foo(10, 10, false, false);
+        auto count = 0;
+
+        auto completed = sologrid2d_foo.for_each_neighbor(coord3, false, GridNeighborhoodType::Moore,
+                                                          [&count](const GridCoord2D& coord) {
+                                                              return ++count < 3;
+                                                          });
+        EXPECT_FALSE(completed);
+        EXPECT_EQ(count, 3);
+    }
+}
+
+TEST(SoloGrid2D, for_each_neighbor_radius) {
+    SoloGrid2D sologrid2d_foo(20, 20, true, false);
+
+    for (auto neighborhood_type : {GridNeighborhoodType::Moore, GridNeighborhoodType::VonNeumann,
+                                   GridNeighborhoodType::Euclidean})
+        for (auto radius : {0u, 2u, 3u, 6u})
+            for (auto& coord : {GridCoord2D(10, 10), GridCoord2D(1, 1), GridCoord2D(19, 18)}) {
+                vector<GridCoord2D> rval;
+                set<pair<int, int>> tval;
+
+                sologrid2d_foo.for_each_neighbor(coord, false, neighborhood_type, radius,
+                                                 [&rval](const GridCoord2D& neighbor) {
+                                                     rval.push_back(neighbor);
+                                                 });
+
+                auto r = static_cast<int>(radius);
+                for (auto dy = -r; dy <= r; dy++)
+                    for (auto dx = -r; dx <= r; dx++) {
+                        auto x = (coord.x() + dx + 20) % 20, y = coord.y() + dy;
+                        auto inside = neighborhood_type == GridNeighborhoodType::Moore ||
+                                      (neighborhood_type == GridNeighborhoodType::VonNeumann &&
+                                       abs(dx) + abs(dy) <= r) ||
+                                      (neighborhood_type == GridNeighborhoodType::Euclidean &&
+                                       dx * dx + dy * dy <= r * r);
+                        if (inside && (dx != 0 || dy != 0) && y >= 0 && y < 20)
+                            tval.insert({x, y});
+                    }
+
+                set<pair<int, int>> rset;
+                for (auto& neighbor : rval)
+                    rset.insert({neighbor.x(), neighbor.y()});
+                EXPECT_EQ(rval.size(), tval.size());
+                EXPECT_EQ(rset, tval);
+            }
+}
+
+TEST(SoloGrid2D, distance) {
+    const SoloGrid2D sologrid2d_foo(10, 8, true, false);
+    const SoloGrid2D sologrid2d_bar(10, 8, false, false);
+
+    EXPECT_DOUBLE_EQ(sologrid2d_foo.distance(GridCoord2D(1, 1), GridCoord2D(9, 4)), sqrt(13.0));
+    EXPECT_DOUBLE_EQ(sologrid2d_bar.distance(GridCoord2D(1, 1), GridCoord2D(9, 4)), sqrt(73.0));
+    EXPECT_DOUBLE_EQ(sologrid2d_foo.distance(GridCoord2D(1, 1), GridCoord2D(9, 7), GridDistanceType::Manhattan),
+                     8.0);
+    EXPECT_DOUBLE_EQ(sologrid2d_foo.distance(GridCoord2D(0, 0), GridCoord2D(25, 0), GridDistanceType::Chebyshev),
+                     5.0);
+}
+
+TEST(SoloGrid2D, get_distances) {
+    mt19937 rng(8675309);
+    uniform_int_distribution<int> x_dist(0, 22), y_dist(0, 16);
+    vector<int> x(1000), y(1000);
+    vector<double> distances(1000);
+
+    for (size_t i = 0; i < x.size(); i++) {
+        x[i] = x_dist(rng);
+        y[i] = y_dist(rng);
+    }
+
+    for (auto wrap : {false, true}) {
+        const SoloGrid2D sologrid2d_foo(23, 17, wrap, wrap);
+        const GridCoord2D origin(x_dist(rng), y_dist(rng));
+
+        for (auto distance_type : {GridDistanceType::Euclidean, GridDistanceType::Manhattan,
+                                   GridDistanceType::Chebyshev}) {
+            sologrid2d_foo.get_distances(origin, x, y, distances, distance_type);
+            for (size_t i = 0; i < x.size(); i++)
+                EXPECT_DOUBLE_EQ(distances[i],
+                                 sologrid2d_foo.distance(origin, GridCoord2D(x[i], y[i]), distance_type));
+        }
+
+        EXPECT_THROW(sologrid2d_foo.get_distances(origin, x, y, span<double>(distances).first(10)), OptionInvalid);
+    }
+}
+
+TEST(SoloGrid2D, random_empty_cell) {
+    SoloGrid2D sologrid2d_foo(4, 3, false, false);
+    mt19937 rng(8675309);
+    vector<AgentID> agent_ids(12);
+
+    EXPECT_EQ(sologrid2d_foo.get_empty_cell_count(), 12);
+
+    // Leave two cells empty, by every kind of change
+    for (auto i = 0; i < 12; i++)
+        static_cast<void>(sologrid2d_foo.add_agent(agent_ids[i], GridCoord2D(i % 4, i / 4)));
+    static_cast<void>(sologrid2d_foo.delete_agent(agent_ids[5]));
+    static_cast<void>(sologrid2d_foo.delete_agent(agent_ids[9]));
+    static_cast<void>(sologrid2d_foo.move_agent(agent_ids[0], GridCoord2D(1, 2)));
+    static_cast<void>(sologrid2d_foo.move_agents({GridMove2D{agent_ids[1], GridCoord2D(0, 0)}},
+                                                 GridConflictPolicy::First));
+    EXPECT_EQ(sologrid2d_foo.get_empty_cell_count(), 2);
+    set<pair<int, int>> empty;
+    for (auto i = 0; i < 50; i++) {
+        auto coord = sologrid2d_foo.random_empty_cell(rng);
+        empty.insert({coord->x(), coord->y()});
+    }
+    EXPECT_EQ(empty, (set<pair<int, int>>{{1, 0}, {1, 1}}));
+
+    static_cast<void>(sologrid2d_foo.add_agent(agent_ids[5], GridCoord2D(1, 1)));
+    static_cast<void>(sologrid2d_foo.add_agent(agent_ids[9], GridCoord2D(1, 0)));
+    EXPECT_EQ(sologrid2d_foo.get_empty_cell_count(), 0);
+    EXPECT_FALSE(sologrid2d_foo.random_empty_cell(rng).has_value());
+}
+
+TEST(SoloGrid2D, random_empty_cell_uniform) {
+    SoloGrid2D sologrid2d_foo(10, 10, false, false);
+    mt19937 rng(8675309);
+    map<int, int> counts;
+
+    for (auto x = 0; x < 10; x++)
+        for (auto y = 0; y < 10; y++)
+            if (x != y)
+                static_cast<void>(sologrid2d_foo.add_agent(AgentID(), GridCoord2D(x, y)));
+
+    for (auto i = 0; i < 10000; i++) {
+        auto coord = sologrid2d_foo.random_empty_cell(rng);
+        ASSERT_TRUE(coord.has_value());
+        ASSERT_EQ(coord->x(), coord->y());
+        counts[coord->x()]++;
+    }
+    EXPECT_EQ(counts.size(), 10);
+    for (auto [x, count] : counts)
+        EXPECT_NEAR(count, 1000, 150);
+}
+
+TEST(SoloGrid2D, add_agents_randomly) {
+    SoloGrid2D sologrid2d_foo(20, 20, true, true);
+    mt19937 rng(8675309);
+    vector<AgentID> agent_ids(390);
+    const AgentID agent_id_foo;
+
+    static_cast<void>(sologrid2d_foo.add_agent(agent_id_foo, GridCoord2D(3, 4)));
+    EXPECT_THROW(auto agent_id_bar = sologrid2d_foo.add_agent(agent_id_foo, GridCoord2D(5, 5)), OptionInvalid);
+
+    auto coords = sologrid2d_foo.add_agents_randomly(agent_ids, rng);
+    ASSERT_EQ(coords->size(), agent_ids.size());
+    EXPECT_EQ(sologrid2d_foo.get_empty_cell_count(), 9);
+    set<pair<int, int>> distinct;
+    for (size_t i = 0; i < agent_ids.size(); i++) {
+        EXPECT_EQ(sologrid2d_foo.get_location_by_agent(agent_ids[i]), (*coords)[i]);
+        distinct.insert({(*coords)[i].x(), (*coords)[i].y()});
+    }
+    EXPECT_EQ(distinct.size(), agent_ids.size());
+    EXPECT_EQ(distinct.count({3, 4}), 0);
+
+    // Failed batches leave the grid unchanged
+    vector<AgentID> agent_ids_foo(10);
+    EXPECT_THROW(auto coords_foo = sologrid2d_foo.add_agents_randomly(agent_ids_foo, rng), LocationUnavailable);
+    vector<AgentID> agent_ids_bar = {AgentID(), agent_id_foo};
+    EXPECT_THROW(auto coords_foo = sologrid2d_foo.add_agents_randomly(agent_ids_bar, rng), OptionInvalid);
+    EXPECT_EQ(sologrid2d_foo.get_empty_cell_count(), 9);
+
+    // Every empty cell is still found
+    set<pair<int, int>> empty;
+    for (auto i = 0; i < 1000; i++) {
+        auto coord = sologrid2d_foo.random_empty_cell(rng);
+        EXPECT_TRUE(sologrid2d_foo.is_location_empty(*coord));
+        empty.insert({coord->x(), coord->y()});
+    }
+    EXPECT_EQ(empty.size(), 9);
+}
+
 TEST(SoloGrid2D, get_location_by_agent) {
     const AgentID agent_id_foo, agent_id_bar;
     const GridCoord2D coord2(2, 5);
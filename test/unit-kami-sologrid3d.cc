@@ -0,0 +1,193 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <unordered_set>
+#include <vector>
+
+#include <kami/agent.h>
+#include <kami/error.h>
+#include <kami/sologrid3d.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace kami;
+using namespace kami::error;
+using namespace std;
+
+TEST(SoloGrid3D, DefaultConstructor) {
+    EXPECT_NO_THROW(
+            SoloGrid3D sologrid3d_foo(10, 10, 10, true, true, true);
+    );
+}
+
+TEST(SoloGrid3D, add_agent) {
+    SoloGrid3D sologrid3d_foo(10, 10, 10, true, true, true);
+    const AgentID agent_id_foo, agent_id_bar;
+    const GridCoord3D coord2(2, 5, 7), coord3(3, 7, 9);
+
+    {
+        auto agent_id_baz = sologrid3d_foo.add_agent(agent_id_foo, coord2);
+        EXPECT_EQ(agent_id_baz, agent_id_foo);
+    }
+    {
+        EXPECT_THROW(auto agent_id_baz = sologrid3d_foo.add_agent(agent_id_bar, coord2), LocationUnavailable);
+    }
+    {
+        EXPECT_THROW(auto agent_id_baz = sologrid3d_foo.add_agent(agent_id_bar, GridCoord3D(2, 5, 10)),
+                     LocationInvalid);
+    }
+    {
+        auto agent_id_baz = sologrid3d_foo.add_agent(agent_id_bar, coord3);
+        EXPECT_EQ(agent_id_baz, agent_id_bar);
+        EXPECT_EQ(*sologrid3d_foo.get_location_contents(coord3), set<AgentID>({agent_id_bar}));
+    }
+    {
+        // An agent already on the grid is not placed a second time
+        const GridCoord3D coord4(4, 4, 4);
+        EXPECT_THROW(auto agent_id_baz = sologrid3d_foo.add_agent(agent_id_bar, coord4), OptionInvalid);
+        EXPECT_TRUE(sologrid3d_foo.is_location_empty(coord4));
+        static_cast<void>(sologrid3d_foo.delete_agent(agent_id_bar));
+        EXPECT_TRUE(sologrid3d_foo.is_location_empty(coord3));
+    }
+}
+
+TEST(SoloGrid3D, delete_agent) {
+    SoloGrid3D sologrid3d_foo(10, 10, 10, true, true, true);
+    const AgentID agent_id_foo, agent_id_bar;
+    const GridCoord3D coord2(2, 5, 7);
+
+    static_cast<void>(sologrid3d_foo.add_agent(agent_id_foo, coord2));
+    EXPECT_THROW(auto agent_id_baz = sologrid3d_foo.delete_agent(agent_id_bar, coord2), AgentNotFound);
+    EXPECT_EQ(sologrid3d_foo.delete_agent(agent_id_foo), agent_id_foo);
+    EXPECT_TRUE(sologrid3d_foo.is_location_empty(coord2));
+    EXPECT_THROW(auto loc = sologrid3d_foo.get_location_by_agent(agent_id_foo), AgentNotFound);
+}
+
+TEST(SoloGrid3D, is_location_valid) {
+    SoloGrid3D sologrid3d_foo(10, 6, 5, true, true, true);
+
+    EXPECT_TRUE(sologrid3d_foo.is_location_valid(GridCoord3D(0, 0, 0)));
+    EXPECT_TRUE(sologrid3d_foo.is_location_valid(GridCoord3D(9, 5, 4)));
+    EXPECT_FALSE(sologrid3d_foo.is_location_valid(GridCoord3D(10, 5, 4)));
+    EXPECT_FALSE(sologrid3d_foo.is_location_valid(GridCoord3D(9, 6, 4)));
+    EXPECT_FALSE(sologrid3d_foo.is_location_valid(GridCoord3D(9, 5, 5)));
+    EXPECT_FALSE(sologrid3d_foo.is_location_valid(GridCoord3D(0, 0, -1)));
+}
+
+TEST(SoloGrid3D, move_agent) {
+    SoloGrid3D sologrid3d_foo(10, 10, 10, true, true, true);
+    const AgentID agent_id_foo, agent_id_bar;
+    const GridCoord3D coord2(2, 5, 7), coord3(3, 7, 9);
+
+    static_cast<void>(sologrid3d_foo.add_agent(agent_id_foo, coord2));
+    static_cast<void>(sologrid3d_foo.add_agent(agent_id_bar, coord3));
+
+    EXPECT_THROW(auto agent_id_baz = sologrid3d_foo.move_agent(agent_id_foo, coord3), LocationUnavailable);
+    EXPECT_EQ(sologrid3d_foo.get_location_by_agent(agent_id_foo), coord2);
+
+    EXPECT_EQ(sologrid3d_foo.move_agent(agent_id_foo, GridCoord3D(9, 9, 9)), agent_id_foo);
+    EXPECT_EQ(sologrid3d_foo.get_location_by_agent(agent_id_foo), GridCoord3D(9, 9, 9));
+    EXPECT_TRUE(sologrid3d_foo.is_location_empty(coord2));
+    EXPECT_FALSE(sologrid3d_foo.is_location_empty(GridCoord3D(9, 9, 9)));
+}
+
+TEST(SoloGrid3D, get_location_by_agent) {
+    // Lengths that are not multiples of the brick size exercise padding
+    SoloGrid3D sologrid3d_foo(7, 5, 9, false, false, false);
+    vector<AgentID> agent_ids;
+
+    for (auto z = 0; z < 9; z++)
+        for (auto y = 0; y < 5; y++)
+            for (auto x = 0; x < 7; x++) {
+                agent_ids.emplace_back();
+                static_cast<void>(sologrid3d_foo.add_agent(agent_ids.back(), GridCoord3D(x, y, z)));
+            }
+
+    auto i = 0;
+    for (auto z = 0; z < 9; z++)
+        for (auto y = 0; y < 5; y++)
+            for (auto x = 0; x < 7; x++)
+                EXPECT_EQ(sologrid3d_foo.get_location_by_agent(agent_ids[i++]), GridCoord3D(x, y, z));
+}
+
+TEST(SoloGrid3D, get_neighborhood) {
+    SoloGrid3D sologrid3d_foo(10, 10, 10, false, false, false);
+
+    {
+        const GridCoord3D coord(5, 5, 5);
+
+        EXPECT_EQ(sologrid3d_foo.get_neighborhood(coord, false, GridNeighborhoodType::VonNeumann)->size(), 6);
+        EXPECT_EQ(sologrid3d_foo.get_neighborhood(coord, false, GridNeighborhoodType::Edge)->size(), 18);
+        EXPECT_EQ(sologrid3d_foo.get_neighborhood(coord, false, GridNeighborhoodType::Moore)->size(), 26);
+        EXPECT_EQ(sologrid3d_foo.get_neighborhood(coord, true, GridNeighborhoodType::Moore)->size(), 27);
+    }
+    {
+        const GridCoord3D coord(0, 0, 0);
+        auto rval = sologrid3d_foo.get_neighborhood(coord, false, GridNeighborhoodType::VonNeumann);
+
+        EXPECT_EQ(*rval, unordered_set<GridCoord3D>({GridCoord3D(1, 0, 0), GridCoord3D(0, 1, 0),
+                                                      GridCoord3D(0, 0, 1)}));
+        EXPECT_EQ(sologrid3d_foo.get_neighborhood(coord, false, GridNeighborhoodType::Edge)->size(), 6);
+        EXPECT_EQ(sologrid3d_foo.get_neighborhood(coord, false, GridNeighborhoodType::Moore)->size(), 7);
+    }
+}
+
+TEST(SoloGrid3D, get_neighborhood_wrap) {
+    SoloGrid3D sologrid3d_foo(10, 10, 10, true, false, true);
+    const GridCoord3D coord(0, 0, 9);
+    auto rval = sologrid3d_foo.get_neighborhood(coord, false, GridNeighborhoodType::VonNeumann);
+
+    EXPECT_EQ(*rval, unordered_set<GridCoord3D>({GridCoord3D(1, 0, 9), GridCoord3D(9, 0, 9),
+                                                  GridCoord3D(0, 1, 9), GridCoord3D(0, 0, 8),
+                                                  GridCoord3D(0, 0, 0)}));
+}
+
+TEST(SoloGrid3D, for_each_neighbor_radius) {
+    SoloGrid3D sologrid3d_foo(20, 20, 20, false, false, false);
+    const GridCoord3D coord(10, 10, 10);
+    auto count = 0;
+
+    sologrid3d_foo.for_each_neighbor(coord, true, GridNeighborhoodType::Moore, 2, [&count](const GridCoord3D&) {
+        count++;
+    });
+    EXPECT_EQ(count, 125);
+
+    count = 0;
+    sologrid3d_foo.for_each_neighbor(coord, false, GridNeighborhoodType::VonNeumann, 2,
+                                     [&count](const GridCoord3D& neighbor) {
+                                         count++;
+                                         return count < 5;
+                                     });
+    EXPECT_EQ(count, 5);
+}
+
+int main(
+        int argc,
+        char** argv
+) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
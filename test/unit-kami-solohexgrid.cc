@@ -0,0 +1,229 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <set>
+#include <unordered_set>
+#include <vector>
+
+#include <kami/agent.h>
+#include <kami/error.h>
+#include <kami/solohexgrid.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace kami;
+using namespace kami::error;
+using namespace std;
+
+TEST(SoloHexGrid, DefaultConstructor) {
+    EXPECT_NO_THROW(
+            SoloHexGrid solohexgrid_foo(10, 10, true, true);
+    );
+    EXPECT_THROW(SoloHexGrid solohexgrid_foo(10, 9, false, true), OptionInvalid);
+}
+
+TEST(SoloHexGrid, add_agent) {
+    SoloHexGrid solohexgrid_foo(10, 10, true, true);
+    const AgentID agent_id_foo, agent_id_bar;
+    const HexCoord coord2(2, 5), coord3(-1, 7);
+
+    {
+        auto agent_id_baz = solohexgrid_foo.add_agent(agent_id_foo, coord2);
+        EXPECT_EQ(agent_id_baz, agent_id_foo);
+    }
+    {
+        EXPECT_THROW(auto agent_id_baz = solohexgrid_foo.add_agent(agent_id_bar, coord2), LocationUnavailable);
+    }
+    {
+        EXPECT_THROW(auto agent_id_baz = solohexgrid_foo.add_agent(agent_id_bar, HexCoord(2, 10)), LocationInvalid);
+    }
+    {
+        auto agent_id_baz = solohexgrid_foo.add_agent(agent_id_bar, coord3);
+        EXPECT_EQ(agent_id_baz, agent_id_bar);
+        EXPECT_EQ(*solohexgrid_foo.get_location_contents(coord3), set<AgentID>({agent_id_bar}));
+    }
+    {
+        // An agent already on the grid is not placed a second time
+        const HexCoord coord4(1, 1);
+        EXPECT_THROW(auto agent_id_baz = solohexgrid_foo.add_agent(agent_id_bar, coord4), OptionInvalid);
+        EXPECT_TRUE(solohexgrid_foo.is_location_empty(coord4));
+        static_cast<void>(solohexgrid_foo.delete_agent(agent_id_bar));
+        EXPECT_TRUE(solohexgrid_foo.is_location_empty(coord3));
+    }
+}
+
+TEST(SoloHexGrid, delete_agent) {
+    SoloHexGrid solohexgrid_foo(10, 10, true, true);
+    const AgentID agent_id_foo, agent_id_bar;
+    const HexCoord coord2(2, 5);
+
+    static_cast<void>(solohexgrid_foo.add_agent(agent_id_foo, coord2));
+    EXPECT_THROW(auto agent_id_baz = solohexgrid_foo.delete_agent(agent_id_bar, coord2), AgentNotFound);
+    EXPECT_EQ(solohexgrid_foo.delete_agent(agent_id_foo), agent_id_foo);
+    EXPECT_TRUE(solohexgrid_foo.is_location_empty(coord2));
+    EXPECT_THROW(auto loc = solohexgrid_foo.get_location_by_agent(agent_id_foo), AgentNotFound);
+}
+
+TEST(SoloHexGrid, is_location_valid) {
+    SoloHexGrid solohexgrid_foo(10, 6, false, false);
+
+    // Rows are shoved, so the first column of row `r` has `q` of `-r / 2`
+    EXPECT_TRUE(solohexgrid_foo.is_location_valid(HexCoord(0, 0)));
+    EXPECT_TRUE(solohexgrid_foo.is_location_valid(HexCoord(9, 0)));
+    EXPECT_TRUE(solohexgrid_foo.is_location_valid(HexCoord(-2, 5)));
+    EXPECT_TRUE(solohexgrid_foo.is_location_valid(HexCoord(7, 5)));
+    EXPECT_FALSE(solohexgrid_foo.is_location_valid(HexCoord(-3, 5)));
+    EXPECT_FALSE(solohexgrid_foo.is_location_valid(HexCoord(8, 5)));
+    EXPECT_FALSE(solohexgrid_foo.is_location_valid(HexCoord(0, 6)));
+    EXPECT_FALSE(solohexgrid_foo.is_location_valid(HexCoord(0, -1)));
+}
+
+TEST(SoloHexGrid, move_agent) {
+    SoloHexGrid solohexgrid_foo(10, 10, true, true);
+    const AgentID agent_id_foo, agent_id_bar;
+    const HexCoord coord2(2, 5), coord3(3, 7);
+
+    static_cast<void>(solohexgrid_foo.add_agent(agent_id_foo, coord2));
+    static_cast<void>(solohexgrid_foo.add_agent(agent_id_bar, coord3));
+
+    EXPECT_THROW(auto agent_id_baz = solohexgrid_foo.move_agent(agent_id_foo, coord3), LocationUnavailable);
+    EXPECT_EQ(solohexgrid_foo.get_location_by_agent(agent_id_foo), coord2);
+
+    EXPECT_EQ(solohexgrid_foo.move_agent(agent_id_foo, HexCoord(5, 9)), agent_id_foo);
+    EXPECT_EQ(solohexgrid_foo.get_location_by_agent(agent_id_foo), HexCoord(5, 9));
+    EXPECT_TRUE(solohexgrid_foo.is_location_empty(coord2));
+    EXPECT_FALSE(solohexgrid_foo.is_location_empty(HexCoord(5, 9)));
+}
+
+TEST(SoloHexGrid, get_location_by_agent) {
+    SoloHexGrid solohexgrid_foo(7, 5, false, false);
+    vector<AgentID> agent_ids;
+
+    for (auto r = 0; r < 5; r++)
+        for (auto q = -r / 2; q < 7 - r / 2; q++) {
+            agent_ids.emplace_back();
+            static_cast<void>(solohexgrid_foo.add_agent(agent_ids.back(), HexCoord(q, r)));
+        }
+
+    auto i = 0;
+    for (auto r = 0; r < 5; r++)
+        for (auto q = -r / 2; q < 7 - r / 2; q++)
+            EXPECT_EQ(solohexgrid_foo.get_location_by_agent(agent_ids[i++]), HexCoord(q, r));
+}
+
+TEST(SoloHexGrid, get_neighborhood) {
+    SoloHexGrid solohexgrid_foo(10, 10, false, false);
+
+    {
+        const HexCoord coord(3, 5);
+        auto rval = solohexgrid_foo.get_neighborhood(coord, false);
+
+        EXPECT_EQ(*rval, unordered_set<HexCoord>({HexCoord(4, 5), HexCoord(4, 4), HexCoord(3, 4),
+                                                   HexCoord(2, 5), HexCoord(2, 6), HexCoord(3, 6)}));
+        EXPECT_EQ(solohexgrid_foo.get_neighborhood(coord, true)->size(), 7);
+    }
+    {
+        const HexCoord coord(0, 0);
+        auto rval = solohexgrid_foo.get_neighborhood(coord, false);
+
+        EXPECT_EQ(*rval, unordered_set<HexCoord>({HexCoord(1, 0), HexCoord(0, 1)}));
+    }
+    EXPECT_THROW(auto rval = solohexgrid_foo.get_neighborhood(HexCoord(0, 10), false), LocationInvalid);
+}
+
+TEST(SoloHexGrid, get_neighborhood_wrap) {
+    SoloHexGrid solohexgrid_foo(10, 10, true, true);
+    const HexCoord coord(0, 0);
+    auto rval = solohexgrid_foo.get_neighborhood(coord, false);
+
+    // Row -1 wraps to row 9, which is shoved right, and column -1 to 9
+    EXPECT_EQ(*rval, unordered_set<HexCoord>({HexCoord(1, 0), HexCoord(-4, 9), HexCoord(5, 9),
+                                               HexCoord(9, 0), HexCoord(9, 1), HexCoord(0, 1)}));
+    for (auto& neighbor : *rval)
+        EXPECT_EQ(solohexgrid_foo.distance(coord, neighbor), 1);
+}
+
+TEST(SoloHexGrid, for_each_neighbor_radius) {
+    SoloHexGrid solohexgrid_foo(20, 20, true, true);
+
+    for (auto& coord : {HexCoord(5, 10), HexCoord(0, 0), HexCoord(10, 19)}) {
+        for (auto radius : {0u, 1u, 2u, 3u}) {
+            unordered_set<HexCoord> cells;
+            auto count = 0;
+
+            solohexgrid_foo.for_each_neighbor(coord, true, radius, [&](const HexCoord& cell) {
+                EXPECT_LE(solohexgrid_foo.distance(coord, cell), static_cast<int>(radius));
+                cells.insert(cell);
+                count++;
+            });
+            EXPECT_EQ(count, 1 + 3 * radius * (radius + 1));
+            EXPECT_EQ(cells.size(), count);
+        }
+    }
+
+    auto count = 0;
+    solohexgrid_foo.for_each_neighbor(HexCoord(5, 10), false, 2, [&count](const HexCoord&) {
+        count++;
+        return count < 5;
+    });
+    EXPECT_EQ(count, 5);
+}
+
+TEST(SoloHexGrid, for_each_agent_in_neighborhood) {
+    SoloHexGrid solohexgrid_foo(10, 10, false, false);
+    const AgentID agent_id_foo, agent_id_bar, agent_id_baz;
+    const HexCoord coord(3, 5);
+
+    static_cast<void>(solohexgrid_foo.add_agent(agent_id_foo, coord));
+    static_cast<void>(solohexgrid_foo.add_agent(agent_id_bar, HexCoord(2, 6)));
+    static_cast<void>(solohexgrid_foo.add_agent(agent_id_baz, HexCoord(1, 6)));
+
+    for (auto radius : {1u, 2u}) {
+        set<AgentID> agent_ids;
+        solohexgrid_foo.for_each_agent_in_neighborhood(coord, false, radius, [&agent_ids](const AgentID agent_id) {
+            agent_ids.insert(agent_id);
+        });
+        EXPECT_EQ(agent_ids, radius == 1 ? set<AgentID>({agent_id_bar}) : set<AgentID>({agent_id_bar, agent_id_baz}));
+    }
+
+    set<AgentID> agent_ids;
+    solohexgrid_foo.for_each_agent_in_neighborhood(coord, true, 2,
+                                                   [&agent_id_bar](const AgentID agent_id) {
+                                                       return agent_id != agent_id_bar;
+                                                   },
+                                                   [&agent_ids](const AgentID agent_id) {
+                                                       agent_ids.insert(agent_id);
+                                                   });
+    EXPECT_EQ(agent_ids, set<AgentID>({agent_id_foo, agent_id_baz}));
+}
+
+int main(
+        int argc,
+        char** argv
+) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
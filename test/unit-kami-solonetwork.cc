@@ -0,0 +1,167 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <memory>
+#include <random>
+#include <set>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <kami/agent.h>
+#include <kami/csrgraph.h>
+#include <kami/error.h>
+#include <kami/solonetwork.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace kami;
+using namespace kami::error;
+using namespace std;
+
+namespace {
+
+    // A ring of six nodes with a chord from 0 to 3, and an isolated node 6
+    shared_ptr<CSRGraph> make_graph() {
+        const vector<pair<unsigned int, unsigned int>> edges = {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 5}, {5, 0},
+                                                                {0, 3}};
+        return make_shared<CSRGraph>(7, edges);
+    }
+
+}  // namespace
+
+TEST(SoloNetwork, DefaultConstructor) {
+    EXPECT_NO_THROW(
+            SoloNetwork solonetwork_foo(make_graph());
+    );
+    EXPECT_THROW(SoloNetwork solonetwork_foo(nullptr), OptionInvalid);
+}
+
+TEST(SoloNetwork, add_agent) {
+    SoloNetwork solonetwork_foo(make_graph());
+    const AgentID agent_id_foo, agent_id_bar;
+    const NodeCoord coord2(2), coord3(3);
+
+    EXPECT_EQ(solonetwork_foo.add_agent(agent_id_foo, coord2), agent_id_foo);
+    EXPECT_THROW(auto agent_id_baz = solonetwork_foo.add_agent(agent_id_bar, coord2), LocationUnavailable);
+    EXPECT_THROW(auto agent_id_baz = solonetwork_foo.add_agent(agent_id_bar, NodeCoord(7)), LocationInvalid);
+    EXPECT_EQ(solonetwork_foo.add_agent(agent_id_bar, coord3), agent_id_bar);
+    EXPECT_EQ(*solonetwork_foo.get_location_contents(coord3), set<AgentID>({agent_id_bar}));
+    EXPECT_EQ(solonetwork_foo.get_location_by_agent(agent_id_bar), coord3);
+
+    // An agent already on the network is reported as such, not as an
+    // occupied node
+    EXPECT_THROW(auto agent_id_baz = solonetwork_foo.add_agent(agent_id_bar, NodeCoord(0)), OptionInvalid);
+    EXPECT_TRUE(solonetwork_foo.is_location_empty(NodeCoord(0)));
+}
+
+TEST(SoloNetwork, delete_agent) {
+    SoloNetwork solonetwork_foo(make_graph());
+    const AgentID agent_id_foo, agent_id_bar;
+    const NodeCoord coord2(2);
+
+    static_cast<void>(solonetwork_foo.add_agent(agent_id_foo, coord2));
+    EXPECT_THROW(auto agent_id_baz = solonetwork_foo.delete_agent(agent_id_bar, coord2), AgentNotFound);
+    EXPECT_EQ(solonetwork_foo.delete_agent(agent_id_foo), agent_id_foo);
+    EXPECT_TRUE(solonetwork_foo.is_location_empty(coord2));
+    EXPECT_THROW(auto loc = solonetwork_foo.get_location_by_agent(agent_id_foo), AgentNotFound);
+}
+
+TEST(SoloNetwork, move_agent) {
+    SoloNetwork solonetwork_foo(make_graph());
+    const AgentID agent_id_foo, agent_id_bar;
+    const NodeCoord coord2(2), coord3(3);
+
+    static_cast<void>(solonetwork_foo.add_agent(agent_id_foo, coord2));
+    static_cast<void>(solonetwork_foo.add_agent(agent_id_bar, coord3));
+
+    EXPECT_THROW(auto agent_id_baz = solonetwork_foo.move_agent(agent_id_foo, coord3), LocationUnavailable);
+    EXPECT_EQ(solonetwork_foo.get_location_by_agent(agent_id_foo), coord2);
+
+    EXPECT_EQ(solonetwork_foo.move_agent(agent_id_foo, NodeCoord(6)), agent_id_foo);
+    EXPECT_EQ(solonetwork_foo.get_location_by_agent(agent_id_foo), NodeCoord(6));
+    EXPECT_TRUE(solonetwork_foo.is_location_empty(coord2));
+    EXPECT_FALSE(solonetwork_foo.is_location_empty(NodeCoord(6)));
+}
+
+TEST(SoloNetwork, get_neighborhood) {
+    SoloNetwork solonetwork_foo(make_graph());
+    const AgentID agent_id_foo;
+
+    static_cast<void>(solonetwork_foo.add_agent(agent_id_foo, NodeCoord(0)));
+    EXPECT_EQ(*solonetwork_foo.get_neighborhood(agent_id_foo, false),
+              unordered_set<NodeCoord>({NodeCoord(1), NodeCoord(3), NodeCoord(5)}));
+    EXPECT_EQ(*solonetwork_foo.get_neighborhood(NodeCoord(2), true),
+              unordered_set<NodeCoord>({NodeCoord(1), NodeCoord(2), NodeCoord(3)}));
+    EXPECT_TRUE(solonetwork_foo.get_neighborhood(NodeCoord(6), false)->empty());
+    EXPECT_THROW(auto rval = solonetwork_foo.get_neighborhood(NodeCoord(7), false), LocationInvalid);
+}
+
+TEST(SoloNetwork, for_each_agent_in_neighborhood) {
+    SoloNetwork solonetwork_foo(make_graph());
+    const AgentID agent_id_foo, agent_id_bar, agent_id_baz;
+
+    static_cast<void>(solonetwork_foo.add_agent(agent_id_foo, NodeCoord(0)));
+    static_cast<void>(solonetwork_foo.add_agent(agent_id_bar, NodeCoord(3)));
+    static_cast<void>(solonetwork_foo.add_agent(agent_id_baz, NodeCoord(4)));
+
+    set<AgentID> agent_ids;
+    solonetwork_foo.for_each_agent_in_neighborhood(NodeCoord(0), false, [&agent_ids](const AgentID agent_id) {
+        agent_ids.insert(agent_id);
+    });
+    EXPECT_EQ(agent_ids, set<AgentID>({agent_id_bar}));
+
+    agent_ids.clear();
+    solonetwork_foo.for_each_agent_in_neighborhood(NodeCoord(3), true,
+                                                   [&agent_id_bar](const AgentID agent_id) {
+                                                       return agent_id != agent_id_bar;
+                                                   },
+                                                   [&agent_ids](const AgentID agent_id) {
+                                                       agent_ids.insert(agent_id);
+                                                   });
+    EXPECT_EQ(agent_ids, set<AgentID>({agent_id_foo, agent_id_baz}));
+}
+
+TEST(SoloNetwork, random_neighbor_cell) {
+    SoloNetwork solonetwork_foo(make_graph());
+    mt19937 rng(8675309);
+
+    set<unsigned int> nodes;
+    for (auto i = 0; i < 200; i++)
+        nodes.insert(solonetwork_foo.random_neighbor_cell(NodeCoord(0), true, rng)->node());
+    EXPECT_EQ(nodes, set<unsigned int>({0, 1, 3, 5}));
+
+    EXPECT_FALSE(solonetwork_foo.random_neighbor_cell(NodeCoord(6), false, rng).has_value());
+    EXPECT_EQ(solonetwork_foo.random_neighbor_cell(NodeCoord(6), true, rng), NodeCoord(6));
+}
+
+int main(
+        int argc,
+        char** argv
+) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,283 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <random>
+#include <set>
+#include <span>
+#include <unordered_set>
+#include <vector>
+
+#include <kami/agent.h>
+#include <kami/error.h>
+#include <kami/multigrid2d.h>
+#include <kami/sparsemultigrid2d.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace kami;
+using namespace kami::error;
+using namespace std;
+
+TEST(SparseMultiGrid2D, DefaultConstructor) {
+    EXPECT_NO_THROW(
+            SparseMultiGrid2D sparsemultigrid2d_foo(10, 10, true, true);
+    );
+    EXPECT_NO_THROW(
+            SparseMultiGrid2D sparsemultigrid2d_foo(1000000, 1000000, true, true);
+    );
+}
+
+TEST(SparseMultiGrid2D, add_agent) {
+    SparseMultiGrid2D sparsemultigrid2d_foo(10, 10, true, true);
+    const AgentID agent_id_foo, agent_id_bar;
+    const GridCoord2D coord2(2, 5), coord3(3, 7);
+
+    {
+        auto agent_id_baz = sparsemultigrid2d_foo.add_agent(agent_id_foo, coord2);
+        EXPECT_EQ(agent_id_baz, agent_id_foo);
+    }
+    {
+        auto agent_id_baz = sparsemultigrid2d_foo.add_agent(agent_id_bar, coord2);
+        EXPECT_EQ(agent_id_baz, agent_id_bar);
+    }
+    {
+        EXPECT_THROW(auto agent_id_baz = sparsemultigrid2d_foo.add_agent(agent_id_bar, coord3), OptionInvalid);
+        EXPECT_THROW(auto agent_id_baz = sparsemultigrid2d_foo.add_agent(agent_id_bar, coord2), OptionInvalid);
+        EXPECT_EQ(sparsemultigrid2d_foo.get_location_by_agent(agent_id_bar), coord2);
+        EXPECT_EQ(sparsemultigrid2d_foo.get_location_view(coord2).size(), 2);
+    }
+    {
+        EXPECT_THROW(auto agent_id_baz = sparsemultigrid2d_foo.add_agent(AgentID(), GridCoord2D(10, 0)),
+                     LocationInvalid);
+    }
+}
+
+TEST(SparseMultiGrid2D, delete_agent) {
+    const AgentID agent_id_foo, agent_id_bar;
+    const GridCoord2D coord2(2, 5), coord3(3, 7);
+
+    {
+        SparseMultiGrid2D sparsemultigrid2d_foo(10, 10, true, true);
+
+        static_cast<void>(sparsemultigrid2d_foo.add_agent(agent_id_foo, coord2));
+        static_cast<void>(sparsemultigrid2d_foo.add_agent(agent_id_bar, coord2));
+        auto agent_id_baz = sparsemultigrid2d_foo.delete_agent(agent_id_foo);
+        EXPECT_EQ(agent_id_baz, agent_id_foo);
+        EXPECT_THAT(sparsemultigrid2d_foo.get_location_view(coord2), testing::ElementsAre(agent_id_bar));
+    }
+    {
+        SparseMultiGrid2D sparsemultigrid2d_foo(10, 10, true, true);
+
+        static_cast<void>(sparsemultigrid2d_foo.add_agent(agent_id_foo, coord2));
+        EXPECT_THROW(auto agent_id_baz = sparsemultigrid2d_foo.delete_agent(agent_id_foo, coord3), AgentNotFound);
+        EXPECT_THROW(auto agent_id_baz = sparsemultigrid2d_foo.delete_agent(agent_id_bar), AgentNotFound);
+    }
+}
+
+TEST(SparseMultiGrid2D, move_agent) {
+    const AgentID agent_id_foo, agent_id_bar;
+    const GridCoord2D coord2(2, 5), coord3(300, 700);
+
+    {
+        SparseMultiGrid2D sparsemultigrid2d_foo(1000, 1000, true, true);
+
+        static_cast<void>(sparsemultigrid2d_foo.add_agent(agent_id_foo, coord2));
+        auto agent_id_baz = sparsemultigrid2d_foo.move_agent(agent_id_foo, coord3);
+        EXPECT_EQ(agent_id_baz, agent_id_foo);
+        EXPECT_EQ(sparsemultigrid2d_foo.get_location_by_agent(agent_id_foo), coord3);
+        EXPECT_TRUE(sparsemultigrid2d_foo.is_location_empty(coord2));
+        EXPECT_FALSE(sparsemultigrid2d_foo.is_location_empty(coord3));
+        EXPECT_EQ(sparsemultigrid2d_foo.get_tile_count(), 1);
+    }
+    {
+        SparseMultiGrid2D sparsemultigrid2d_foo(1000, 1000, true, true);
+
+        static_cast<void>(sparsemultigrid2d_foo.add_agent(agent_id_foo, coord2));
+        EXPECT_THROW(auto agent_id_baz = sparsemultigrid2d_foo.move_agent(agent_id_bar, coord3), AgentNotFound);
+        EXPECT_THROW(auto agent_id_baz = sparsemultigrid2d_foo.move_agent(agent_id_foo, GridCoord2D(1000, 0)),
+                     LocationInvalid);
+        EXPECT_EQ(sparsemultigrid2d_foo.get_location_by_agent(agent_id_foo), coord2);
+    }
+}
+
+TEST(SparseMultiGrid2D, get_location_contents) {
+    SparseMultiGrid2D sparsemultigrid2d_foo(1000000, 1000000, true, true);
+    const AgentID agent_id_foo, agent_id_bar;
+    const GridCoord2D coord2(999999, 5), coord3(3, 999999);
+
+    static_cast<void>(sparsemultigrid2d_foo.add_agent(agent_id_foo, coord2));
+    static_cast<void>(sparsemultigrid2d_foo.add_agent(agent_id_bar, coord2));
+
+    {
+        auto agent_list_foo = sparsemultigrid2d_foo.get_location_contents(coord2);
+        EXPECT_EQ(*agent_list_foo, set<AgentID>({agent_id_foo, agent_id_bar}));
+    }
+    {
+        auto agent_list_foo = sparsemultigrid2d_foo.get_location_contents(coord3);
+        EXPECT_TRUE(agent_list_foo->empty());
+        EXPECT_TRUE(sparsemultigrid2d_foo.get_location_view(coord3).empty());
+    }
+    {
+        EXPECT_THROW(auto agent_list_foo = sparsemultigrid2d_foo.get_location_contents(GridCoord2D(-1, 0)),
+                     LocationUnavailable);
+    }
+}
+
+TEST(SparseMultiGrid2D, get_tile_count) {
+    SparseMultiGrid2D sparsemultigrid2d_foo(1000000, 1000000, true, true);
+    vector<AgentID> agents(1000);
+
+    EXPECT_EQ(sparsemultigrid2d_foo.get_tile_count(), 0);
+
+    // Agents spread along a diagonal each claim their own tile
+    for (auto i = 0; i < 1000; i++)
+        static_cast<void>(sparsemultigrid2d_foo.add_agent(agents[i], GridCoord2D(i * 997, i * 991)));
+    EXPECT_EQ(sparsemultigrid2d_foo.get_tile_count(), 1000);
+
+    // Tiles are freed as they empty, including through moves
+    for (auto i = 0; i < 500; i++)
+        static_cast<void>(sparsemultigrid2d_foo.delete_agent(agents[i]));
+    EXPECT_EQ(sparsemultigrid2d_foo.get_tile_count(), 500);
+    for (auto i = 500; i < 1000; i++)
+        static_cast<void>(sparsemultigrid2d_foo.move_agent(agents[i], GridCoord2D(i % 64, 0)));
+    EXPECT_EQ(sparsemultigrid2d_foo.get_tile_count(), 1);
+
+    for (auto i = 500; i < 1000; i++)
+        EXPECT_EQ(sparsemultigrid2d_foo.get_location_by_agent(agents[i]), GridCoord2D(i % 64, 0));
+}
+
+TEST(SparseMultiGrid2D, for_each_tile) {
+    SparseMultiGrid2D sparsemultigrid2d_foo(1000, 1000, true, true);
+    const AgentID agent_id_foo, agent_id_bar, agent_id_baz;
+
+    static_cast<void>(sparsemultigrid2d_foo.add_agent(agent_id_foo, GridCoord2D(1, 1)));
+    static_cast<void>(sparsemultigrid2d_foo.add_agent(agent_id_bar, GridCoord2D(63, 63)));
+    static_cast<void>(sparsemultigrid2d_foo.add_agent(agent_id_baz, GridCoord2D(999, 130)));
+
+    unordered_set<GridCoord2D> origins;
+    EXPECT_TRUE(sparsemultigrid2d_foo.for_each_tile([&origins](const GridCoord2D& origin) {
+        origins.insert(origin);
+    }));
+    EXPECT_EQ(origins, unordered_set<GridCoord2D>({GridCoord2D(0, 0), GridCoord2D(960, 128)}));
+
+    auto visited = 0;
+    EXPECT_FALSE(sparsemultigrid2d_foo.for_each_tile([&visited](const GridCoord2D&) {
+        visited++;
+        return false;
+    }));
+    EXPECT_EQ(visited, 1);
+}
+
+TEST(SparseMultiGrid2D, for_each_occupied_cell) {
+    SparseMultiGrid2D sparsemultigrid2d_foo(1000000, 1000000, true, true);
+    const AgentID agent_id_foo, agent_id_bar, agent_id_baz;
+
+    static_cast<void>(sparsemultigrid2d_foo.add_agent(agent_id_foo, GridCoord2D(5, 7)));
+    static_cast<void>(sparsemultigrid2d_foo.add_agent(agent_id_bar, GridCoord2D(5, 7)));
+    static_cast<void>(sparsemultigrid2d_foo.add_agent(agent_id_baz, GridCoord2D(123456, 654321)));
+
+    unordered_set<GridCoord2D> cells;
+    size_t agents = 0;
+    EXPECT_TRUE(sparsemultigrid2d_foo.for_each_occupied_cell(
+            [&cells, &agents](const GridCoord2D& coord, span<const AgentID> contents) {
+                cells.insert(coord);
+                agents += contents.size();
+            }));
+    EXPECT_EQ(cells, unordered_set<GridCoord2D>({GridCoord2D(5, 7), GridCoord2D(123456, 654321)}));
+    EXPECT_EQ(agents, 3);
+}
+
+TEST(SparseMultiGrid2D, for_each_agent_in_neighborhood) {
+    // Compare against a dense grid, on a grid whose sides are not a
+    // multiple of the tile length, so neighborhoods cross tile edges,
+    // partial tiles, and the wrapped edges of the grid
+    for (auto wrap : {true, false}) {
+        SparseMultiGrid2D sparsemultigrid2d_foo(150, 100, wrap, wrap);
+        MultiGrid2D multigrid2d_foo(150, 100, wrap, wrap);
+        mt19937 rng(42);
+        uniform_int_distribution<int> x_dist(0, 149), y_dist(0, 99);
+        vector<AgentID> agents(400);
+
+        for (auto& agent_id : agents) {
+            GridCoord2D coord(x_dist(rng), y_dist(rng));
+            static_cast<void>(sparsemultigrid2d_foo.add_agent(agent_id, coord));
+            static_cast<void>(multigrid2d_foo.add_agent(agent_id, coord));
+        }
+
+        for (auto i = 0; i < 300; i++) {
+            GridCoord2D coord(x_dist(rng), y_dist(rng));
+            auto radius = static_cast<unsigned int>(i % 4);
+            auto type = i % 2 == 0 ? GridNeighborhoodType::Moore : GridNeighborhoodType::VonNeumann;
+            auto include_center = i % 3 != 0;
+
+            multiset<AgentID> sparse_found, dense_found;
+            EXPECT_TRUE(sparsemultigrid2d_foo.for_each_agent_in_neighborhood(
+                    coord, include_center, type, radius,
+                    [&sparse_found](const AgentID agent_id) { sparse_found.insert(agent_id); }));
+            EXPECT_TRUE(multigrid2d_foo.for_each_agent_in_neighborhood(
+                    coord, include_center, type, radius,
+                    [&dense_found](const AgentID agent_id) { dense_found.insert(agent_id); }));
+            EXPECT_EQ(sparse_found, dense_found);
+        }
+    }
+    {
+        SparseMultiGrid2D sparsemultigrid2d_foo(1000000, 1000000, true, true);
+        const AgentID agent_id_foo, agent_id_bar;
+
+        static_cast<void>(sparsemultigrid2d_foo.add_agent(agent_id_foo, GridCoord2D(0, 0)));
+        static_cast<void>(sparsemultigrid2d_foo.add_agent(agent_id_bar, GridCoord2D(999999, 999999)));
+
+        multiset<AgentID> found;
+        EXPECT_TRUE(sparsemultigrid2d_foo.for_each_agent_in_neighborhood(
+                GridCoord2D(0, 999999), true, GridNeighborhoodType::Moore, 1,
+                [&found](const AgentID agent_id) { found.insert(agent_id); }));
+        EXPECT_EQ(found, multiset<AgentID>({agent_id_foo, agent_id_bar}));
+
+        auto visited = 0;
+        EXPECT_FALSE(sparsemultigrid2d_foo.for_each_agent_in_neighborhood(
+                GridCoord2D(0, 999999), true, GridNeighborhoodType::Moore, 1,
+                [&visited](const AgentID) {
+                    visited++;
+                    return false;
+                }));
+        EXPECT_EQ(visited, 1);
+
+        found.clear();
+        EXPECT_TRUE(sparsemultigrid2d_foo.for_each_agent_in_neighborhood(
+                GridCoord2D(0, 999999), true, GridNeighborhoodType::Moore, 1,
+                [&agent_id_foo](const AgentID agent_id) { return agent_id == agent_id_foo; },
+                [&found](const AgentID agent_id) { found.insert(agent_id); }));
+        EXPECT_EQ(found, multiset<AgentID>({agent_id_foo}));
+    }
+}
+
+int main(
+        int argc,
+        char** argv
+) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
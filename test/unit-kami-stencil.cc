@@ -0,0 +1,146 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <kami/grid.h>
+#include <kami/stencil.h>
+
+#include <gtest/gtest.h>
+
+using namespace kami;
+using namespace std;
+
+static_assert(stencil::moore_2d.size() == 9);
+static_assert(stencil::vonneumann_2d.size() == 5);
+static_assert(stencil::stencil_2d<GridNeighborhoodType::Euclidean, 1>.size() == 5);
+static_assert(stencil::stencil_2d<GridNeighborhoodType::Moore, 4>.size() == 81);
+static_assert(stencil::stencil_1d<3>.size() == 7);
+
+TEST(Stencil, size_2d) {
+    EXPECT_EQ(stencil::size_2d(GridNeighborhoodType::Moore, 0), 1);
+    EXPECT_EQ(stencil::size_2d(GridNeighborhoodType::Moore, 3), 49);
+    EXPECT_EQ(stencil::size_2d(GridNeighborhoodType::VonNeumann, 3), 25);
+    EXPECT_EQ(stencil::size_2d(GridNeighborhoodType::Euclidean, 2), 13);
+    EXPECT_EQ(stencil::size_2d(GridNeighborhoodType::Euclidean, 3), 29);
+    EXPECT_EQ(stencil::size_2d(GridNeighborhoodType::Edge, 2), 25);
+}
+
+TEST(Stencil, size_3d) {
+    EXPECT_EQ(stencil::size_3d(GridNeighborhoodType::VonNeumann, 1), 7);
+    EXPECT_EQ(stencil::size_3d(GridNeighborhoodType::Edge, 1), 19);
+    EXPECT_EQ(stencil::size_3d(GridNeighborhoodType::Moore, 1), 27);
+    EXPECT_EQ(stencil::size_3d(GridNeighborhoodType::Euclidean, 1), 7);
+    EXPECT_EQ(stencil::size_3d(GridNeighborhoodType::Moore, 2), 125);
+    EXPECT_EQ(stencil::size_3d(GridNeighborhoodType::VonNeumann, 2), 25);
+}
+
+TEST(Stencil, get_3d) {
+    const auto& offsets = stencil::get_3d(GridNeighborhoodType::Edge, 1);
+    const auto& expected = stencil::stencil_3d<GridNeighborhoodType::Edge, 1>;
+
+    ASSERT_EQ(offsets.size(), expected.size());
+    for (size_t i = 0; i < offsets.size(); i++) {
+        EXPECT_EQ(offsets[i].dx, expected[i].dx);
+        EXPECT_EQ(offsets[i].dy, expected[i].dy);
+        EXPECT_EQ(offsets[i].dz, expected[i].dz);
+    }
+    EXPECT_EQ(stencil::get_3d(GridNeighborhoodType::Euclidean, 3).size(),
+              stencil::size_3d(GridNeighborhoodType::Euclidean, 3));
+}
+
+TEST(Stencil, scan_order) {
+    const auto& offsets = stencil::get_2d(GridNeighborhoodType::Euclidean, 7);
+
+    EXPECT_TRUE(is_sorted(offsets.begin(), offsets.end(), [](const GridOffset2D& lhs, const GridOffset2D& rhs) {
+        return lhs.dy < rhs.dy || (lhs.dy == rhs.dy && lhs.dx < rhs.dx);
+    }));
+    for (auto& offset : offsets)
+        EXPECT_LE(offset.dx * offset.dx + offset.dy * offset.dy, 49);
+}
+
+TEST(Stencil, get_2d) {
+    // Cached stencils match those generated at compile time
+    for (auto neighborhood_type : {GridNeighborhoodType::Moore, GridNeighborhoodType::VonNeumann,
+                                   GridNeighborhoodType::Euclidean}) {
+        const auto& offsets = stencil::get_2d(neighborhood_type, 1);
+        EXPECT_EQ(offsets.size(), stencil::size_2d(neighborhood_type, 1));
+    }
+
+    const auto& offsets = stencil::get_2d(GridNeighborhoodType::VonNeumann, 4);
+    const auto& expected = stencil::stencil_2d<GridNeighborhoodType::VonNeumann, 4>;
+    ASSERT_EQ(offsets.size(), expected.size());
+    for (size_t i = 0; i < offsets.size(); i++) {
+        EXPECT_EQ(offsets[i].dx, expected[i].dx);
+        EXPECT_EQ(offsets[i].dy, expected[i].dy);
+    }
+
+    // The cache returns the same stencil each time
+    EXPECT_EQ(&stencil::get_2d(GridNeighborhoodType::Moore, 9), &stencil::get_2d(GridNeighborhoodType::Moore, 9));
+}
+
+TEST(Stencil, get_1d) {
+    const auto& offsets = stencil::get_1d(6);
+
+    ASSERT_EQ(offsets.size(), 13);
+    EXPECT_EQ(offsets.front().dx, -6);
+    EXPECT_EQ(offsets.back().dx, 6);
+}
+
+TEST(Stencil, get_2d_concurrent) {
+    // Threads racing to generate and read the same stencils all see one
+    // copy of each
+    vector<vector<const vector<GridOffset2D>*>> found(8);
+    vector<thread> threads;
+    for (auto& stencils : found)
+        threads.emplace_back([&stencils]() {
+            for (unsigned int radius = 10; radius < 40; radius++)
+                stencils.push_back(&stencil::get_2d(GridNeighborhoodType::Euclidean, radius));
+        });
+    for (auto& t : threads)
+        t.join();
+
+    for (auto& stencils : found)
+        EXPECT_EQ(stencils, found.front());
+    EXPECT_EQ(found.front().back()->size(), stencil::size_2d(GridNeighborhoodType::Euclidean, 39));
+}
+
+TEST(Stencil, wrap) {
+    EXPECT_EQ(stencil::wrap(3, 10), 3);
+    EXPECT_EQ(stencil::wrap(-1, 10), 9);
+    EXPECT_EQ(stencil::wrap(10, 10), 0);
+    EXPECT_EQ(stencil::wrap(-12, 5), 3);
+    EXPECT_EQ(stencil::wrap(23, 5), 3);
+}
+
+int main(
+        int argc,
+        char** argv
+) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
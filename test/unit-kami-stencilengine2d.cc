@@ -0,0 +1,189 @@
+/*-
+ * Copyright (c) 2023 The Johns Hopkins University Applied Physics
+ * Laboratory LLC
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <random>
+#include <vector>
+
+#include <kami/error.h>
+#include <kami/executor.h>
+#include <kami/propertylayer2d.h>
+#include <kami/stencilengine2d.h>
+
+#include <gtest/gtest.h>
+
+using namespace kami;
+using namespace kami::error;
+using namespace std;
+
+namespace {
+
+    // The kernel applied at one cell, one offset at a time, with cells
+    // beyond a bounded edge standing in for the center
+    double apply_at(
+            const PropertyLayer2D<double>& layer,
+            const StencilKernel2D<double>& kernel,
+            int x,
+            int y
+    ) {
+        auto radius = kernel.get_radius();
+        double total = 0.0;
+
+        for (auto dy = -radius; dy <= radius; dy++)
+            for (auto dx = -radius; dx <= radius; dx++) {
+                const GridCoord2D coord(x + dx, y + dy);
+                if (layer.is_location_valid(coord))
+                    total += kernel.get_weight(dx, dy) * layer.get(coord);
+                else
+                    total += kernel.get_weight(dx, dy) * layer.get(GridCoord2D(x, y));
+            }
+        return total;
+    }
+
+}  // namespace
+
+TEST(StencilKernel2D, DefaultConstructor) {
+    const StencilKernel2D<double> kernel_foo({0, 1, 0, 1, -4, 1, 0, 1, 0});
+    EXPECT_EQ(kernel_foo.get_radius(), 1);
+    EXPECT_EQ(kernel_foo.get_weights().size(), 9);
+    EXPECT_DOUBLE_EQ(kernel_foo.get_weight(0, 0), -4.0);
+    EXPECT_DOUBLE_EQ(kernel_foo.get_weight(1, 0), 1.0);
+    EXPECT_DOUBLE_EQ(kernel_foo.get_weight(2, 0), 0.0);
+
+    const vector<double> weights(25, 1.0);
+    const StencilKernel2D<double> kernel_bar(weights);
+    EXPECT_EQ(kernel_bar.get_radius(), 2);
+    EXPECT_DOUBLE_EQ(kernel_bar.get_weight(-2, 2), 1.0);
+
+    EXPECT_THROW(StencilKernel2D<double> kernel_baz({1, 2, 3}), OptionInvalid);
+}
+
+TEST(StencilKernel2D, diffusion) {
+    const auto kernel_foo = StencilKernel2D<double>::diffusion(0.5);
+
+    EXPECT_DOUBLE_EQ(kernel_foo.get_weight(0, 0), 0.5);
+    EXPECT_DOUBLE_EQ(kernel_foo.get_weight(-1, 1), 0.0625);
+    EXPECT_THROW(auto kernel_bar = StencilKernel2D<double>::diffusion(-0.1), OptionInvalid);
+}
+
+TEST(StencilEngine2D, DefaultConstructor) {
+    const StencilEngine2D<double> engine_foo;
+    EXPECT_GT(engine_foo.get_tile_x(), 0);
+    EXPECT_GT(engine_foo.get_tile_y(), 0);
+    EXPECT_THROW(StencilEngine2D<double> engine_bar(0, 4), OptionInvalid);
+}
+
+TEST(StencilEngine2D, apply) {
+    mt19937 rng(8675309);
+    uniform_real_distribution<double> dist(-1.0, 1.0);
+    Executor executor(3);
+
+    vector<double> weights_3(9), weights_5(25);
+    for (auto& weight : weights_3)
+        weight = dist(rng);
+    for (auto& weight : weights_5)
+        weight = dist(rng);
+    const StencilKernel2D<double> kernel_3(weights_3), kernel_5(weights_5);
+
+    // Small tiles, and grids narrower than a kernel, exercise every edge
+    for (auto [maximum_x, maximum_y] : {pair{37u, 29u}, pair{3u, 4u}, pair{1u, 6u}})
+        for (auto wrap_x : {false, true})
+            for (auto wrap_y : {false, true}) {
+                PropertyLayer2D<double> layer_foo(maximum_x, maximum_y, wrap_x, wrap_y);
+                PropertyLayer2D<double> layer_bar(maximum_x, maximum_y, wrap_x, wrap_y);
+                for (auto& value : layer_foo.get_values())
+                    value = dist(rng);
+
+                for (const auto* kernel : {&kernel_3, &kernel_5})
+                    for (auto [tile_x, tile_y] : {pair{7u, 5u}, pair{512u, 32u}}) {
+                        const StencilEngine2D<double> engine_foo(tile_x, tile_y);
+                        engine_foo.apply(layer_foo, layer_bar, *kernel, &executor);
+                        for (auto y = 0; y < static_cast<int>(maximum_y); y++)
+                            for (auto x = 0; x < static_cast<int>(maximum_x); x++)
+                                EXPECT_NEAR(layer_bar.get(GridCoord2D(x, y)), apply_at(layer_foo, *kernel, x, y),
+                                            1e-12);
+                    }
+            }
+
+    const StencilEngine2D<double> engine_foo;
+    PropertyLayer2D<double> layer_foo(5, 5);
+    PropertyLayer2D<double> layer_bar(6, 5);
+    EXPECT_THROW(engine_foo.apply(layer_foo, layer_foo, kernel_3), OptionInvalid);
+    EXPECT_THROW(engine_foo.apply(layer_foo, layer_bar, kernel_3), OptionInvalid);
+}
+
+TEST(StencilEngine2D, step) {
+    mt19937 rng(8675309);
+    uniform_real_distribution<double> dist(0.0, 1.0);
+    Executor executor(3);
+    const auto kernel = StencilKernel2D<double>::diffusion(0.3);
+
+    PropertyLayer2D<double> layer_foo(100, 80, true, true);
+    for (auto& value : layer_foo.get_values())
+        value = dist(rng);
+    auto layer_bar = layer_foo;
+    PropertyLayer2D<double> layer_baz(100, 80, true, true);
+    const auto total = layer_foo.sum();
+
+    // Stepping matches applying once per step
+    StencilEngine2D<double> engine_foo(16, 8);
+    engine_foo.step(layer_foo, kernel, 3, &executor);
+    for (auto i = 0; i < 3; i++) {
+        engine_foo.apply(layer_bar, layer_baz, kernel);
+        swap(layer_bar, layer_baz);
+    }
+    for (auto i = 0; i < 100 * 80; i++)
+        EXPECT_DOUBLE_EQ(layer_foo.get_values()[i], layer_bar.get_values()[i]);
+
+    // Diffusion on a torus conserves the total
+    EXPECT_NEAR(layer_foo.sum(), total, 1e-9);
+    EXPECT_TRUE(layer_foo.get_wrap_x());
+
+    // So does diffusion on bounded grids, or wrapped in one dimension,
+    // as cells keep the share they cannot give over an edge
+    for (auto [wrap_x, wrap_y] : {pair{false, false}, pair{true, false}, pair{false, true}}) {
+        PropertyLayer2D<double> layer_qux(37, 29, wrap_x, wrap_y);
+        for (auto& value : layer_qux.get_values())
+            value = dist(rng);
+        const auto total_qux = layer_qux.sum();
+
+        engine_foo.step(layer_qux, kernel, 20, &executor);
+        EXPECT_NEAR(layer_qux.sum(), total_qux, 1e-9);
+    }
+
+    // A lone corner cell keeps the shares of its five missing neighbors
+    PropertyLayer2D<double> layer_quux(4, 4);
+    layer_quux.set(GridCoord2D(0, 0), 8.0);
+    engine_foo.step(layer_quux, StencilKernel2D<double>::diffusion(0.5));
+    EXPECT_DOUBLE_EQ(layer_quux.get(GridCoord2D(0, 0)), 8.0 * (0.5 + 5 * 0.0625));
+    EXPECT_DOUBLE_EQ(layer_quux.get(GridCoord2D(1, 1)), 0.5);
+}
+
+int main(
+        int argc,
+        char** argv
+) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}